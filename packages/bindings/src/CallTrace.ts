@@ -0,0 +1,311 @@
+import type { Ptr } from './types'
+
+// Records every cheap ABI call into the binary trace format described in
+// canvaskit_cheap_trace.h, for native replay with canvaskit_cheap_replay.
+
+const TRACE_MAGIC = 0x52544b43 // "CKTR"
+const TRACE_VERSION = 1
+
+const enum TraceRecord {
+  Define = 1,
+  Call = 2,
+  Frame = 3,
+}
+
+const enum TraceArg {
+  Null = 0,
+  Int = 1,
+  Float = 2,
+  Handle = 3,
+  Blob = 4,
+  Out = 5,
+  Pixels = 6,
+}
+
+// Calls whose arguments are all scalars or handles need no spec: integers are recorded
+// as Int and everything else as Float, and the replayer converts by parameter type.
+// Specs list one entry per argument:
+//   s            scalar/handle (default)
+//   b<size>      input buffer, recorded by value
+//   o<size>      output buffer, only its size is recorded
+//   p<size>      caller-owned pixels that must outlive the call
+// where <size> is a byte count: N, aK (value of argument K) or a product such as aK*N.
+// A leading 'h=' marks calls that return a handle later calls may refer to.
+const SPECS: Record<string, string> = {
+  MakePaint: 'h=',
+  MakePath: 'h=',
+  Path_addPolygon: 's,b(a2*8),s,s',
+  Path_getBounds: 's,o16',
+  Path_snapshot: 'h=s',
+  Path_transform: 's,b36',
+  SkPath_getBounds: 's,o16',
+  SkPath_copy: 'h=s',
+  SkPath_makeTransform: 'h=s,b36',
+  PathMaskCache_getStats: 'o16',
+
+  MakeCanvasSurface: 'h=s,s',
+  MakeSWCanvasSurface: 'h=s,s',
+  MakeSWCanvasSurfaceWrapPixels: 'h=p(a3*a2),s,s,s,s',
+  Surface_peekPixels: 's,o4',
+  Surface_getDamageRect: 's,o16',
+  Surface_getCanvas: 'h=s',
+  Surface_makeImageSnapshot: 'h=s',
+  Surface_encodeToPNG: 'h=s',
+  Surface_encode: 'h=s,s,s,s,s',
+  Surface_encodeToBuffer: 's,s,s,s,s,o(a6),s',
+  MakeSurfaceEncoder: 'h=s,s,s,s,s',
+  SurfaceEncoder_read: 's,o(a2),s',
+  Surface_readPixelsRGBA8888: 's,s,s,s,s,o(a4*a6),s',
+
+  Canvas_concat: 's,b36',
+  Canvas_setMatrix: 's,b36',
+  Canvas_drawRects: 's,b(a2*16),s,s',
+  Canvas_drawRectsWithColors: 's,b(a3*16),b(a3*4),s,s',
+  Canvas_drawPoints: 's,s,b(a3*8),s,s',
+  Canvas_drawAtlas: 's,s,b(a5*16),b(a5*16),b(a5*4),s,s,s,s,b16,s',
+  Canvas_submitCommands: 's,b(a2),s',
+
+  MakePictureRecorder: 'h=',
+  PictureRecorder_begin: 'h=s,s,s,s,s,s',
+  PictureRecorder_finish: 'h=s',
+  Canvas_drawPicture: 's,s,b36,s',
+  Picture_cullRect: 's,o16',
+
+  Image_readPixelsRGBA8888: 's,s,s,s,s,o(a4*a6),s',
+  Image_encodeToPNG: 'h=s',
+  Image_encode: 'h=s,s,s,s,s',
+  MakeImageFromEncoded: 'h=b(a1),s',
+  MakeImageFromEncodedWithTargetSize: 'h=b(a1),s,s,s',
+
+  MakeColorShader: 'h=s',
+  MakeLinearGradientShader: 'h=s,s,s,s,b(a6*4),b(a6*4),s,s',
+  MakeBlendColorFilter: 'h=s,s',
+  MakeFont: 'h=',
+  MakeTypefaceFromData: 'h=b(a1),s,s',
+  MakeTextBlobFromText: 'h=b(a1),s,s,s',
+
+  MakeParagraphFromText: 'h=b(a1),s,b(a3),s,s,s,s,s,s',
+  MakeParagraphFromTextWithEllipsis: 'h=b(a1),s,b(a3),s,s,s,s,s,s,b(a10),s',
+  MakeParagraphBuilder: 'h=b(a1),s,s,s,s,s',
+  MakeParagraphBuilderWithEllipsis: 'h=b(a1),s,s,s,s,s,b(a7),s',
+  MakeFontRegistry: 'h=',
+  FontRegistry_registerFont: 's,b(a2),s,s,b(a5),s',
+  FontRegistry_serializeGlyphCache: 'h=s',
+  FontRegistry_preloadGlyphCache: 's,b(a2),s',
+  MakeParagraphFromTextWithRegistry: 'h=s,b(a2),s,s,s,s,s,s,b(a9),s',
+  MakeParagraphBuilderWithRegistry: 'h=s,s,s,s,s,b(a6),s',
+  ParagraphBuilder_addText: 's,b(a2),s',
+  ParagraphBuilder_build: 'h=s,s',
+  Paragraph_getLineMetrics: 's,o(a2*48),s',
+  Paragraph_getGlyphClusters: 's,o(a3*16),o(a3*12),s',
+  Paragraph_getRectsForRange: 's,s,s,s,s,o(a6*20),s',
+  Paragraph_getGlyphPositionsAtCoordinates: 's,b(a2*8),s,o(a2*8)',
+  Paragraph_getWordBoundaries: 's,o(a2*4),s',
+}
+
+type SizeFn = (args: any[]) => number
+
+interface ArgSpec {
+  kind: 's' | 'b' | 'o' | 'p'
+  size: SizeFn | null
+}
+
+interface CallSpec {
+  returnsHandle: boolean
+  args: ArgSpec[]
+}
+
+function compileSize(expr: string): SizeFn {
+  const factors = expr.replace(/[()]/g, '').split('*').map((f) => {
+    if (f.startsWith('a')) {
+      const index = Number(f.slice(1)) | 0
+      return (args: any[]) => Number(args[index]) | 0
+    }
+    const value = Number(f) | 0
+    return () => value
+  })
+  return (args) => factors.reduce((acc, f) => acc * f(args), 1)
+}
+
+function compileSpec(spec: string): CallSpec {
+  const returnsHandle = spec.startsWith('h=')
+  const body = returnsHandle ? spec.slice(2) : spec
+  const args: ArgSpec[] = body
+    ? body.split(',').map((token) => {
+        const kind = token[0] as ArgSpec['kind']
+        return { kind, size: kind === 's' ? null : compileSize(token.slice(1)) }
+      })
+    : []
+  return { returnsHandle, args }
+}
+
+export interface CallTraceMemory {
+  getBytes(byteOffset: Ptr, length: number): Uint8Array
+}
+
+export class CallTraceRecorder {
+  #memory: CallTraceMemory
+  #bytes = new Uint8Array(1 << 16)
+  #view = new DataView(this.#bytes.buffer)
+  #length = 0
+
+  #ids: Map<string, number> = new Map()
+  #specs: Map<string, CallSpec | null> = new Map()
+  #calls = 0
+  #frames = 0
+
+  constructor(memory: CallTraceMemory) {
+    this.#memory = memory
+    this.#u32(TRACE_MAGIC)
+    this.#u32(TRACE_VERSION)
+  }
+
+  get calls(): number {
+    return this.#calls
+  }
+
+  get frames(): number {
+    return this.#frames
+  }
+
+  get byteLength(): number {
+    return this.#length
+  }
+
+  // Records the call and its result; `call` performs the actual Wasm invocation.
+  record(name: string, args: any[], call: () => any): any {
+    const id = this.#define(name)
+    const spec = this.#spec(name)
+
+    this.#u8(TraceRecord.Call)
+    this.#u16(id)
+    this.#u8(args.length)
+    for (let i = 0; i < args.length; i++) {
+      this.#arg(args, i, spec?.args[i] ?? null)
+    }
+
+    const result = call()
+    if (spec?.returnsHandle && result) {
+      this.#u8(TraceArg.Handle)
+      this.#u32(Number(result) >>> 0)
+    } else {
+      this.#u8(TraceArg.Null)
+    }
+    this.#calls++
+    return result
+  }
+
+  markFrame(): void {
+    this.#reserve(1)
+    this.#u8(TraceRecord.Frame)
+    this.#frames++
+  }
+
+  // Returns a copy of the trace recorded so far.
+  finish(): Uint8Array {
+    return this.#bytes.slice(0, this.#length)
+  }
+
+  #define(name: string): number {
+    let id = this.#ids.get(name)
+    if (id !== undefined) return id
+
+    id = this.#ids.size
+    this.#ids.set(name, id)
+    const encoded = new TextEncoder().encode(name).subarray(0, 255)
+    this.#u8(TraceRecord.Define)
+    this.#u16(id)
+    this.#u8(encoded.length)
+    this.#raw(encoded)
+    return id
+  }
+
+  #spec(name: string): CallSpec | null {
+    let spec = this.#specs.get(name)
+    if (spec === undefined) {
+      const source = SPECS[name]
+      spec = source !== undefined ? compileSpec(source) : null
+      this.#specs.set(name, spec)
+    }
+    return spec
+  }
+
+  #arg(args: any[], index: number, spec: ArgSpec | null): void {
+    const value = args[index]
+    if (!spec || spec.kind === 's') {
+      const n = Number(value)
+      if (Number.isInteger(n)) {
+        this.#u8(TraceArg.Int)
+        this.#u32(n >>> 0)
+      } else {
+        this.#u8(TraceArg.Float)
+        this.#f32(n)
+      }
+      return
+    }
+
+    const ptr = Number(value) >>> 0
+    const size = Math.max(0, spec.size!(args))
+    if (!ptr) {
+      this.#u8(TraceArg.Null)
+      return
+    }
+    switch (spec.kind) {
+      case 'b':
+        this.#u8(TraceArg.Blob)
+        this.#u32(size)
+        this.#raw(this.#memory.getBytes(ptr, size))
+        break
+      case 'o':
+        this.#u8(TraceArg.Out)
+        this.#u32(size)
+        break
+      case 'p':
+        this.#u8(TraceArg.Pixels)
+        this.#u32(size)
+        break
+    }
+  }
+
+  #reserve(bytes: number): void {
+    const need = this.#length + bytes
+    if (need <= this.#bytes.length) return
+
+    let size = this.#bytes.length << 1
+    while (size < need) size <<= 1
+    const next = new Uint8Array(size)
+    next.set(this.#bytes.subarray(0, this.#length))
+    this.#bytes = next
+    this.#view = new DataView(next.buffer)
+  }
+
+  #u8(value: number): void {
+    this.#reserve(1)
+    this.#view.setUint8(this.#length, value)
+    this.#length += 1
+  }
+
+  #u16(value: number): void {
+    this.#reserve(2)
+    this.#view.setUint16(this.#length, value, true)
+    this.#length += 2
+  }
+
+  #u32(value: number): void {
+    this.#reserve(4)
+    this.#view.setUint32(this.#length, value >>> 0, true)
+    this.#length += 4
+  }
+
+  #f32(value: number): void {
+    this.#reserve(4)
+    this.#view.setFloat32(this.#length, value, true)
+    this.#length += 4
+  }
+
+  #raw(bytes: Uint8Array): void {
+    this.#reserve(bytes.length)
+    this.#bytes.set(bytes, this.#length)
+    this.#length += bytes.length
+  }
+}
@@ -10,11 +10,14 @@ import { ShaderApi } from './api/ShaderApi'
 import { PathEffectApi } from './api/PathEffectApi'
 import { ColorFilterApi } from './api/ColorFilterApi'
 import { MaskFilterApi } from './api/MaskFilterApi'
+import { FontRegistryApi } from './api/FontRegistryApi'
+import { PictureApi } from './api/PictureApi'
 
 import type { Imports, Ptr } from './types'
 
 import invariant from 'invariant'
 import { WasmApi } from './WasmApi'
+import { CallTraceRecorder } from './CallTrace'
 
 export type { Imports, Ptr }
 
@@ -30,6 +33,8 @@ export type CanvasKit = WasmApi & {
   ParagraphBuilder: ParagraphBuilderApi
   Shader: ShaderApi
   PathEffect: PathEffectApi
+  FontRegistry: FontRegistryApi
+  Picture: PictureApi
 
   getWebGLContext?: (canvas: any, attrs?: Record<string, any>) => number
   makeWebGLContext?: (ctx: number) => any | null
@@ -54,6 +59,8 @@ async function makeWasmApi(input: string): Promise<CanvasKit> {
   api.ParagraphBuilder = new ParagraphBuilderApi(wasmApi)
   api.Shader = new ShaderApi(wasmApi)
   api.PathEffect = new PathEffectApi(wasmApi)
+  api.FontRegistry = new FontRegistryApi(wasmApi)
+  api.Picture = new PictureApi(wasmApi)
 
   return api
 }
@@ -142,6 +149,31 @@ export class CanvasKitApi {
     return this.#api.PathEffect
   }
 
+  static get FontRegistry () {
+    invariant(this.#api !== null, 'CanvasKitApi not initialized. Call CanvasKitApi.ready() first.')
+    return this.#api.FontRegistry
+  }
+
+  static get Picture () {
+    invariant(this.#api !== null, 'CanvasKitApi not initialized. Call CanvasKitApi.ready() first.')
+    return this.#api.Picture
+  }
+
+  // Starts recording every ABI call for replay with canvaskit_cheap_replay.
+  static startCallTrace(): CallTraceRecorder {
+    invariant(this.#api !== null, 'CanvasKitApi not initialized. Call CanvasKitApi.ready() first.')
+    const recorder = new CallTraceRecorder(this.#api)
+    this.#api.setCallTrace(recorder)
+    return recorder
+  }
+
+  // Stops recording and returns the trace bytes.
+  static stopCallTrace(recorder: CallTraceRecorder): Uint8Array {
+    invariant(this.#api !== null, 'CanvasKitApi not initialized. Call CanvasKitApi.ready() first.')
+    this.#api.setCallTrace(null)
+    return recorder.finish()
+  }
+
   static invoke(name: string, ...args: any[]): any {
     invariant(this.#api !== null, 'CanvasKitApi not initialized. Call CanvasKitApi.ready() first.')
     return this.#api.invoke(name, ...args)
@@ -0,0 +1,354 @@
+import { CanvasKitApi } from './CanvasKitApi'
+import type { Ptr } from './types'
+
+// Opcodes understood by Canvas_submitCommands (see canvaskit_cheap_bindings.h).
+export enum CommandOp {
+  Clear = 1,
+  Save = 2,
+  SaveLayer = 3,
+  Restore = 4,
+  RestoreToCount = 5,
+  Translate = 6,
+  Scale = 7,
+  Rotate = 8,
+  Concat = 9,
+  SetMatrix = 10,
+  ClipRect = 11,
+  DrawRect = 12,
+  DrawPath = 13,
+  DrawSkPath = 14,
+  DrawCircle = 15,
+  DrawLine = 16,
+  DrawOval = 17,
+  DrawArc = 18,
+  DrawPaint = 19,
+  DrawImage = 20,
+  DrawImageRect = 21,
+  DrawTextBlob = 22,
+  DrawParagraph = 23,
+  DrawPicture = 24,
+  DrawSkPathCached = 25,
+
+  PaintSetColor = 64,
+  PaintSetAntiAlias = 65,
+  PaintSetStyle = 66,
+  PaintSetStrokeWidth = 67,
+  PaintSetStrokeCap = 68,
+  PaintSetStrokeJoin = 69,
+  PaintSetAlphaf = 70,
+  PaintSetBlendMode = 71,
+  PaintSetShader = 72,
+  PaintSetColorFilter = 73,
+
+  PathSetFillType = 128,
+  PathMoveTo = 129,
+  PathLineTo = 130,
+  PathQuadTo = 131,
+  PathCubicTo = 132,
+  PathClose = 133,
+  PathReset = 134,
+  PathAddRect = 135,
+  PathAddCircle = 136,
+  PathAddOval = 137,
+  PathAddRRectXY = 138,
+  PathAddArc = 139,
+  PathArcToOval = 140,
+}
+
+// Records canvas/paint/path operations into a word stream and replays them with a
+// single Canvas_submitCommands call. Handles are encoded as (lo, hi) word pairs.
+export class CommandBuffer {
+  #u32: Uint32Array
+  #f32: Float32Array
+  #length = 0
+
+  #ptr: Ptr = 0
+  #capacity = 0
+  #count = 0
+
+  constructor(initialWords: number = 4096) {
+    this.#u32 = new Uint32Array(Math.max(16, initialWords | 0))
+    this.#f32 = new Float32Array(this.#u32.buffer)
+  }
+
+  get count(): number {
+    return this.#count
+  }
+
+  get byteLength(): number {
+    return this.#length << 2
+  }
+
+  reset(): void {
+    this.#length = 0
+    this.#count = 0
+  }
+
+  #reserve(words: number): void {
+    const need = this.#length + words
+    if (need <= this.#u32.length) return
+
+    let size = this.#u32.length << 1
+    while (size < need) size <<= 1
+    const next = new Uint32Array(size)
+    next.set(this.#u32.subarray(0, this.#length))
+    this.#u32 = next
+    this.#f32 = new Float32Array(next.buffer)
+  }
+
+  #header(op: CommandOp, words: number): void {
+    this.#reserve(words)
+    this.#u32[this.#length++] = (op | (words << 16)) >>> 0
+    this.#count++
+  }
+
+  #u(value: number): void {
+    this.#u32[this.#length++] = value >>> 0
+  }
+
+  #f(value: number): void {
+    this.#f32[this.#length++] = +value
+  }
+
+  #h(ptr: Ptr | null): void {
+    this.#u32[this.#length++] = (ptr ?? 0) >>> 0
+    this.#u32[this.#length++] = 0
+  }
+
+  clear(argb: number): void {
+    this.#header(CommandOp.Clear, 2)
+    this.#u(argb)
+  }
+
+  save(): void {
+    this.#header(CommandOp.Save, 1)
+  }
+
+  saveLayer(l: number, t: number, r: number, b: number, hasBounds: boolean, paint: Ptr | null): void {
+    this.#header(CommandOp.SaveLayer, 8)
+    this.#f(l)
+    this.#f(t)
+    this.#f(r)
+    this.#f(b)
+    this.#u(hasBounds ? 1 : 0)
+    this.#h(paint)
+  }
+
+  restore(): void {
+    this.#header(CommandOp.Restore, 1)
+  }
+
+  restoreToCount(saveCount: number): void {
+    this.#header(CommandOp.RestoreToCount, 2)
+    this.#u(saveCount | 0)
+  }
+
+  translate(dx: number, dy: number): void {
+    this.#header(CommandOp.Translate, 3)
+    this.#f(dx)
+    this.#f(dy)
+  }
+
+  scale(sx: number, sy: number): void {
+    this.#header(CommandOp.Scale, 3)
+    this.#f(sx)
+    this.#f(sy)
+  }
+
+  rotate(degrees: number): void {
+    this.#header(CommandOp.Rotate, 2)
+    this.#f(degrees)
+  }
+
+  concat(m9: ArrayLike<number>): void {
+    this.#header(CommandOp.Concat, 10)
+    for (let i = 0; i < 9; i++) this.#f(m9[i]!)
+  }
+
+  setMatrix(m9: ArrayLike<number>): void {
+    this.#header(CommandOp.SetMatrix, 10)
+    for (let i = 0; i < 9; i++) this.#f(m9[i]!)
+  }
+
+  clipRect(l: number, t: number, r: number, b: number, clipOp: number, doAA: boolean): void {
+    this.#header(CommandOp.ClipRect, 7)
+    this.#f(l)
+    this.#f(t)
+    this.#f(r)
+    this.#f(b)
+    this.#u(clipOp | 0)
+    this.#u(doAA ? 1 : 0)
+  }
+
+  drawRect(l: number, t: number, r: number, b: number, paint: Ptr): void {
+    this.#header(CommandOp.DrawRect, 7)
+    this.#f(l)
+    this.#f(t)
+    this.#f(r)
+    this.#f(b)
+    this.#h(paint)
+  }
+
+  drawPath(path: Ptr, paint: Ptr): void {
+    this.#header(CommandOp.DrawPath, 5)
+    this.#h(path)
+    this.#h(paint)
+  }
+
+  drawSkPath(skPath: Ptr, paint: Ptr): void {
+    this.#header(CommandOp.DrawSkPath, 5)
+    this.#h(skPath)
+    this.#h(paint)
+  }
+
+  drawSkPathCached(skPath: Ptr, paint: Ptr): void {
+    this.#header(CommandOp.DrawSkPathCached, 5)
+    this.#h(skPath)
+    this.#h(paint)
+  }
+
+  drawCircle(cx: number, cy: number, radius: number, paint: Ptr): void {
+    this.#header(CommandOp.DrawCircle, 6)
+    this.#f(cx)
+    this.#f(cy)
+    this.#f(radius)
+    this.#h(paint)
+  }
+
+  drawLine(x0: number, y0: number, x1: number, y1: number, paint: Ptr): void {
+    this.#header(CommandOp.DrawLine, 7)
+    this.#f(x0)
+    this.#f(y0)
+    this.#f(x1)
+    this.#f(y1)
+    this.#h(paint)
+  }
+
+  drawOval(l: number, t: number, r: number, b: number, paint: Ptr): void {
+    this.#header(CommandOp.DrawOval, 7)
+    this.#f(l)
+    this.#f(t)
+    this.#f(r)
+    this.#f(b)
+    this.#h(paint)
+  }
+
+  drawPaint(paint: Ptr): void {
+    this.#header(CommandOp.DrawPaint, 3)
+    this.#h(paint)
+  }
+
+  drawImage(image: Ptr, x: number, y: number, filterMode: number, mipmapMode: number, paint: Ptr | null): void {
+    this.#header(CommandOp.DrawImage, 9)
+    this.#h(image)
+    this.#f(x)
+    this.#f(y)
+    this.#u(filterMode | 0)
+    this.#u(mipmapMode | 0)
+    this.#h(paint)
+  }
+
+  drawImageRect(
+    image: Ptr,
+    src: ArrayLike<number>,
+    dst: ArrayLike<number>,
+    filterMode: number,
+    mipmapMode: number,
+    paint: Ptr | null
+  ): void {
+    this.#header(CommandOp.DrawImageRect, 15)
+    this.#h(image)
+    for (let i = 0; i < 4; i++) this.#f(src[i]!)
+    for (let i = 0; i < 4; i++) this.#f(dst[i]!)
+    this.#u(filterMode | 0)
+    this.#u(mipmapMode | 0)
+    this.#h(paint)
+  }
+
+  drawTextBlob(blob: Ptr, x: number, y: number, paint: Ptr): void {
+    this.#header(CommandOp.DrawTextBlob, 7)
+    this.#h(blob)
+    this.#f(x)
+    this.#f(y)
+    this.#h(paint)
+  }
+
+  drawParagraph(paragraph: Ptr, x: number, y: number): void {
+    this.#header(CommandOp.DrawParagraph, 5)
+    this.#h(paragraph)
+    this.#f(x)
+    this.#f(y)
+  }
+
+  drawPicture(picture: Ptr, paint: Ptr | null): void {
+    this.#header(CommandOp.DrawPicture, 5)
+    this.#h(picture)
+    this.#h(paint)
+  }
+
+  paintSetColor(paint: Ptr, argb: number): void {
+    this.#header(CommandOp.PaintSetColor, 4)
+    this.#h(paint)
+    this.#u(argb)
+  }
+
+  paintSetAlphaf(paint: Ptr, a: number): void {
+    this.#header(CommandOp.PaintSetAlphaf, 4)
+    this.#h(paint)
+    this.#f(a)
+  }
+
+  paintSetStrokeWidth(paint: Ptr, width: number): void {
+    this.#header(CommandOp.PaintSetStrokeWidth, 4)
+    this.#h(paint)
+    this.#f(width)
+  }
+
+  pathMoveTo(path: Ptr, x: number, y: number): void {
+    this.#header(CommandOp.PathMoveTo, 5)
+    this.#h(path)
+    this.#f(x)
+    this.#f(y)
+  }
+
+  pathLineTo(path: Ptr, x: number, y: number): void {
+    this.#header(CommandOp.PathLineTo, 5)
+    this.#h(path)
+    this.#f(x)
+    this.#f(y)
+  }
+
+  pathClose(path: Ptr): void {
+    this.#header(CommandOp.PathClose, 3)
+    this.#h(path)
+  }
+
+  pathReset(path: Ptr): void {
+    this.#header(CommandOp.PathReset, 3)
+    this.#h(path)
+  }
+
+  // Copies the recorded stream into Wasm memory and replays it on `canvas`.
+  // Returns the number of commands executed; the buffer is reset afterwards.
+  submit(canvas: Ptr): number {
+    const byteLength = this.byteLength
+    if (byteLength === 0) return 0
+
+    if (this.#capacity < byteLength) {
+      if (this.#ptr) CanvasKitApi.free(this.#ptr)
+      this.#capacity = this.#u32.byteLength
+      this.#ptr = CanvasKitApi.malloc(this.#capacity)
+    }
+
+    CanvasKitApi.setBytes(this.#ptr, new Uint8Array(this.#u32.buffer, 0, byteLength))
+    const executed = CanvasKitApi.Canvas.submitCommands(canvas, this.#ptr, byteLength)
+    this.reset()
+    return executed
+  }
+
+  dispose(): void {
+    if (this.#ptr) CanvasKitApi.free(this.#ptr)
+    this.#ptr = 0
+    this.#capacity = 0
+  }
+}
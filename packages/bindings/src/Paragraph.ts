@@ -2,7 +2,7 @@ import invariant from 'invariant'
 
 import { ManagedObj, ManagedObjRegistry, Ptr } from './ManagedObj'
 import { CanvasKitApi } from './CanvasKitApi'
-import { TextAlign } from './enums'
+import { RectHeightStyle, RectWidthStyle, TextAlign } from './enums'
 
 export interface ParagraphFromTextOptions {
   fontBytes: Uint8Array
@@ -14,6 +14,43 @@ export interface ParagraphFromTextOptions {
   ellipsis?: string | null
 }
 
+// Floats per line in Paragraph.getLineMetrics(): startIndex, endIndex,
+// endExcludingWhitespaces, endIncludingNewline, hardBreak, ascent, descent, height,
+// width, left, baseline, lineNumber.
+export const LINE_METRICS_STRIDE = 12
+
+// Floats per box in Paragraph.getRectsForRange(): left, top, right, bottom, direction.
+export const TEXT_BOX_STRIDE = 5
+
+// Glyph clusters in visual order as structure-of-arrays. `bounds` holds `count` lefts,
+// then tops, rights and bottoms; `info` holds `count` text starts, then text ends and
+// line numbers. Text offsets are UTF-16 code units.
+export interface GlyphClusters {
+  count: number
+  bounds: Float32Array
+  info: Uint32Array
+}
+
+// Runs a bulk paragraph query twice: once for the item count, then into a scratch buffer
+// of exactly that size.
+function queryPacked<T>(
+  itemBytes: number,
+  query: (outPtr: number, capacity: number) => number,
+  read: (outPtr: number, count: number) => T,
+  empty: T,
+): T {
+  const count = query(0, 0)
+  if (count <= 0) return empty
+
+  const outPtr = CanvasKitApi.malloc(count * itemBytes) as number
+  try {
+    query(outPtr, count)
+    return read(outPtr >>> 0, count)
+  } finally {
+    CanvasKitApi.free(outPtr >>> 0)
+  }
+}
+
 class ParagraphPtr extends Ptr {
   constructor(ptr?: number) {
     super(ptr ?? -1)
@@ -71,6 +108,75 @@ class ParagraphPtr extends Ptr {
     invariant(!this.isDeleted(), 'ParagraphPtr is deleted')
     return CanvasKitApi.Paragraph.getLongestLine(this.raw)
   }
+
+  getLineMetrics(): Float32Array {
+    invariant(!this.isDeleted(), 'ParagraphPtr is deleted')
+    return queryPacked(
+      LINE_METRICS_STRIDE * 4,
+      (ptr, capacity) => CanvasKitApi.Paragraph.getLineMetrics(this.raw, ptr, capacity),
+      (ptr, count) => CanvasKitApi.getFloat32Array(ptr, count * LINE_METRICS_STRIDE).slice(),
+      new Float32Array(),
+    )
+  }
+
+  getGlyphClusters(): GlyphClusters {
+    invariant(!this.isDeleted(), 'ParagraphPtr is deleted')
+    const count = CanvasKitApi.Paragraph.getGlyphClusters(this.raw, 0, 0, 0)
+    if (count <= 0) return { count: 0, bounds: new Float32Array(), info: new Uint32Array() }
+
+    const boundsPtr = CanvasKitApi.malloc(count * 4 * 4) as number
+    const infoPtr = CanvasKitApi.malloc(count * 3 * 4) as number
+    try {
+      CanvasKitApi.Paragraph.getGlyphClusters(this.raw, boundsPtr, infoPtr, count)
+      return {
+        count,
+        bounds: CanvasKitApi.getFloat32Array(boundsPtr >>> 0, count * 4).slice(),
+        info: CanvasKitApi.getUint32Array(infoPtr >>> 0, count * 3).slice(),
+      }
+    } finally {
+      CanvasKitApi.free(boundsPtr >>> 0)
+      CanvasKitApi.free(infoPtr >>> 0)
+    }
+  }
+
+  getRectsForRange(start: number, end: number, heightStyle: RectHeightStyle, widthStyle: RectWidthStyle): Float32Array {
+    invariant(!this.isDeleted(), 'ParagraphPtr is deleted')
+    return queryPacked(
+      TEXT_BOX_STRIDE * 4,
+      (ptr, capacity) =>
+        CanvasKitApi.Paragraph.getRectsForRange(this.raw, start, end, heightStyle, widthStyle, ptr, capacity),
+      (ptr, count) => CanvasKitApi.getFloat32Array(ptr, count * TEXT_BOX_STRIDE).slice(),
+      new Float32Array(),
+    )
+  }
+
+  // `xy` holds x, y pairs; returns position, affinity pairs.
+  getGlyphPositionsAtCoordinates(xy: ArrayLike<number>): Int32Array {
+    invariant(!this.isDeleted(), 'ParagraphPtr is deleted')
+    const count = xy.length >> 1
+    if (count === 0) return new Int32Array()
+
+    const xyPtr = CanvasKitApi.malloc(count * 2 * 4) as number
+    const outPtr = CanvasKitApi.malloc(count * 2 * 4) as number
+    try {
+      CanvasKitApi.setFloat32Array(xyPtr >>> 0, xy.length === count * 2 ? xy : Array.prototype.slice.call(xy, 0, count * 2))
+      CanvasKitApi.Paragraph.getGlyphPositionsAtCoordinates(this.raw, xyPtr, count, outPtr)
+      return new Int32Array(CanvasKitApi.getUint32Array(outPtr >>> 0, count * 2).slice().buffer)
+    } finally {
+      CanvasKitApi.free(xyPtr >>> 0)
+      CanvasKitApi.free(outPtr >>> 0)
+    }
+  }
+
+  getWordBoundaries(): Uint32Array {
+    invariant(!this.isDeleted(), 'ParagraphPtr is deleted')
+    return queryPacked(
+      4,
+      (ptr, capacity) => CanvasKitApi.Paragraph.getWordBoundaries(this.raw, ptr, capacity),
+      (ptr, count) => CanvasKitApi.getUint32Array(ptr, count).slice(),
+      new Uint32Array(),
+    )
+  }
 }
 
 export class Paragraph extends ManagedObj {
@@ -164,6 +270,36 @@ export class Paragraph extends ManagedObj {
     return this.ptr.getLongestLine()
   }
 
+  // Packed line metrics, LINE_METRICS_STRIDE floats per line.
+  getLineMetrics(): Float32Array {
+    return this.ptr.getLineMetrics()
+  }
+
+  // Cached natively until the next layout().
+  getGlyphClusters(): GlyphClusters {
+    return this.ptr.getGlyphClusters()
+  }
+
+  // Packed boxes, TEXT_BOX_STRIDE floats per box; offsets are UTF-16 code units.
+  getRectsForRange(
+    start: number,
+    end: number,
+    heightStyle: RectHeightStyle = RectHeightStyle.Tight,
+    widthStyle: RectWidthStyle = RectWidthStyle.Tight,
+  ): Float32Array {
+    return this.ptr.getRectsForRange(start, end, heightStyle, widthStyle)
+  }
+
+  // Hit-tests all points in one call; see Affinity for the second value of each pair.
+  getGlyphPositionsAtCoordinates(xy: ArrayLike<number>): Int32Array {
+    return this.ptr.getGlyphPositionsAtCoordinates(xy)
+  }
+
+  // Ascending UTF-16 word boundaries, from 0 to the text length.
+  getWordBoundaries(): Uint32Array {
+    return this.ptr.getWordBoundaries()
+  }
+
   dispose(): void {
     this.ptr.deleteLater()
     super.dispose()
@@ -4,11 +4,21 @@ import { ManagedObj, ManagedObjRegistry, Ptr } from './ManagedObj'
 import { CanvasKitApi } from './CanvasKitApi'
 import { Canvas, CanvasPtr } from './Canvas'
 import { Image, ImagePtr } from './Image'
+import type { EncodedImageFormat } from './enums'
 
 function readU8Copy(ptr: number, len: number): Uint8Array {
   return CanvasKitApi.getBytes(ptr >>> 0, len).slice()
 }
 
+export interface EncodeOptions {
+  // JPEG/WebP quality in [0, 100].
+  quality?: number
+  // PNG zlib level in [0, 9]; -1 keeps the zlib default.
+  zlibLevel?: number
+  // PNG SkPngEncoder::FilterFlag bits; 0 disables filtering.
+  filterFlags?: number
+}
+
 function encodeDataToBytes(dataPtr: number): Uint8Array {
   if (!dataPtr) return new Uint8Array()
 
@@ -105,6 +115,54 @@ export class SurfacePtr extends Ptr {
     const dataPtr = CanvasKitApi.Surface.encodeToPng(this.raw)
     return encodeDataToBytes(dataPtr)
   }
+
+  encodeBytes(format: EncodedImageFormat, options: EncodeOptions = {}): Uint8Array {
+    invariant(!this.isDeleted(), 'SurfacePtr is deleted')
+    const dataPtr = CanvasKitApi.Surface.encode(
+      this.raw,
+      format,
+      options.quality ?? 90,
+      options.zlibLevel ?? -1,
+      options.filterFlags ?? 0
+    )
+    return encodeDataToBytes(dataPtr)
+  }
+
+  // Streams the encoded image to `onChunk` a few rows at a time, so neither side holds a
+  // full copy of the output. Chunks are copies and may be retained. Returns false on failure.
+  encodeChunks(
+    format: EncodedImageFormat,
+    onChunk: (chunk: Uint8Array) => void,
+    options: EncodeOptions = {},
+    rowsPerStep: number = 64,
+    chunkBytes: number = 64 * 1024
+  ): boolean {
+    invariant(!this.isDeleted(), 'SurfacePtr is deleted')
+    const encoder = CanvasKitApi.Surface.makeEncoder(
+      this.raw,
+      format,
+      options.quality ?? 90,
+      options.zlibLevel ?? -1,
+      options.filterFlags ?? 0
+    )
+    if (!encoder) return false
+
+    const buf = CanvasKitApi.malloc(chunkBytes)
+    try {
+      while (!CanvasKitApi.Surface.encoderIsDone(encoder)) {
+        if (CanvasKitApi.Surface.encoderEncodeRows(encoder, rowsPerStep) < 0) return false
+        for (;;) {
+          const n = CanvasKitApi.Surface.encoderRead(encoder, buf, chunkBytes)
+          if (n <= 0) break
+          onChunk(readU8Copy(buf, n))
+        }
+      }
+      return true
+    } finally {
+      CanvasKitApi.free(buf)
+      CanvasKitApi.Surface.deleteEncoder(encoder)
+    }
+  }
 }
 
 export class Surface extends ManagedObj {
@@ -162,6 +220,20 @@ export class Surface extends ManagedObj {
     return this.ptr.encodeToPngBytes()
   }
 
+  encodeBytes(format: EncodedImageFormat, options?: EncodeOptions): Uint8Array {
+    return this.ptr.encodeBytes(format, options)
+  }
+
+  encodeChunks(
+    format: EncodedImageFormat,
+    onChunk: (chunk: Uint8Array) => void,
+    options?: EncodeOptions,
+    rowsPerStep?: number,
+    chunkBytes?: number
+  ): boolean {
+    return this.ptr.encodeChunks(format, onChunk, options, rowsPerStep, chunkBytes)
+  }
+
   dispose(): void {
     this.ptr.deleteLater()
     super.dispose()
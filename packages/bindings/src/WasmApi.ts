@@ -1,5 +1,6 @@
 import invariant from 'invariant'
 import type { Ptr } from './types'
+import type { CallTraceRecorder } from './CallTrace'
 import { EmscriptenGL, type WebGLContextLike } from './webgl/EmscriptenGL'
 
 function isNodeLike(): boolean {
@@ -13,6 +14,7 @@ function isProbablyUrl(input: string): boolean {
 export class WasmApi {
   #exports: Map<string, any> = new Map()
   #runner: any
+  #callTrace: CallTraceRecorder | null = null
 
   #envImpl: Record<string, any> | null = null
   #gotFuncGlobals: Map<string, WebAssembly.Global> = new Map()
@@ -165,11 +167,20 @@ export class WasmApi {
     return this.resolve(name) !== null
   }
 
+  // Routes every ABI call except malloc/free through `recorder` until cleared with null.
+  setCallTrace(recorder: CallTraceRecorder | null): void {
+    this.#callTrace = recorder
+  }
+
   invoke(name: string, ...args: any[]): any {
     const fn = this.resolve(name)
     if (!fn) {
       throw new Error(`Wasm export not found: ${name}`)
     }
+    const trace = this.#callTrace
+    if (trace !== null && name !== 'malloc' && name !== 'free') {
+      return trace.record(name, args, () => fn(...args))
+    }
     return fn(...args)
   }
 
@@ -1,6 +1,6 @@
 import { Api } from './Api'
 import type { Ptr } from '../types'
-import type { ClipOp, FilterMode, MipmapMode } from '../enums'
+import type { BlendMode, ClipOp, FilterMode, MipmapMode } from '../enums'
 
 export class CanvasApi extends Api {
   clear(canvas: Ptr, argb: number): void {
@@ -93,6 +93,11 @@ export class CanvasApi extends Api {
     this.invoke('Canvas_drawSkPath', canvas, skPath, paint)
   }
 
+  // Draws through the native coverage-mask cache; best for small paths redrawn every frame.
+  drawSkPathCached(canvas: Ptr, skPath: Ptr, paint: Ptr): void {
+    this.invoke('Canvas_drawSkPathCached', canvas, skPath, paint)
+  }
+
   drawCircle(canvas: Ptr, cx: number, cy: number, radius: number, paint: Ptr): void {
     this.invoke('Canvas_drawCircle', canvas, +cx, +cy, +radius, paint)
   }
@@ -181,6 +186,52 @@ export class CanvasApi extends Api {
     )
   }
 
+  // `ltrbPtr` points at count * 4 floats.
+  drawRects(canvas: Ptr, ltrbPtr: Ptr, count: number, paint: Ptr): void {
+    this.invoke('Canvas_drawRects', canvas, ltrbPtr >>> 0, count | 0, paint)
+  }
+
+  // Per-rect ARGB colors (count u32s) replace the paint color.
+  drawRectsWithColors(canvas: Ptr, ltrbPtr: Ptr, colorsPtr: Ptr, count: number, paint: Ptr): void {
+    this.invoke('Canvas_drawRectsWithColors', canvas, ltrbPtr >>> 0, colorsPtr >>> 0, count | 0, paint)
+  }
+
+  // mode: 0 points, 1 lines, 2 polygon. `xyPtr` points at count * 2 floats.
+  drawPoints(canvas: Ptr, mode: number, xyPtr: Ptr, count: number, paint: Ptr): void {
+    this.invoke('Canvas_drawPoints', canvas, mode | 0, xyPtr >>> 0, count | 0, paint)
+  }
+
+  // rsxforms: [scos, ssin, tx, ty] per sprite; texRects: [l, t, r, b] per sprite.
+  // colorsPtr and cullLTRB4Ptr may be 0.
+  drawAtlas(
+    canvas: Ptr,
+    image: Ptr,
+    rsxformsPtr: Ptr,
+    texRectsPtr: Ptr,
+    colorsPtr: Ptr,
+    count: number,
+    blendMode: BlendMode,
+    filterMode: FilterMode,
+    mipmapMode: MipmapMode,
+    cullLTRB4Ptr: Ptr = 0,
+    paint: Ptr = 0
+  ): void {
+    this.invoke(
+      'Canvas_drawAtlas',
+      canvas,
+      image,
+      rsxformsPtr >>> 0,
+      texRectsPtr >>> 0,
+      colorsPtr >>> 0,
+      count | 0,
+      blendMode | 0,
+      filterMode | 0,
+      mipmapMode | 0,
+      cullLTRB4Ptr >>> 0,
+      paint
+    )
+  }
+
   drawTextBlob(canvas: Ptr, blob: Ptr, x: number, y: number, paint: Ptr): void {
     this.invoke('Canvas_drawTextBlob', canvas, blob, +x, +y, paint)
   }
@@ -188,4 +239,8 @@ export class CanvasApi extends Api {
   drawParagraph(canvas: Ptr, paragraph: Ptr, x: number, y: number): void {
     this.invoke('Canvas_drawParagraph', canvas, paragraph, +x, +y)
   }
+
+  submitCommands(canvas: Ptr, bufPtr: Ptr, byteLength: number): number {
+    return this.invoke('Canvas_submitCommands', canvas, bufPtr >>> 0, byteLength | 0) | 0
+  }
 }
@@ -0,0 +1,104 @@
+import { Api } from './Api'
+import type { Ptr } from '../types'
+import type { TextAlign } from '../enums'
+
+export class FontRegistryApi extends Api {
+  make(): Ptr {
+    return this.invoke('MakeFontRegistry') as Ptr
+  }
+
+  delete(registry: Ptr): void {
+    this.invoke('DeleteFontRegistry', registry >>> 0)
+  }
+
+  registerFont(
+    registry: Ptr,
+    bytesPtr: Ptr,
+    size: number,
+    ttcIndex: number = 0,
+    familyUtf8Ptr: Ptr = 0,
+    familyByteLength: number = 0,
+  ): boolean {
+    return (
+      (this.invoke(
+        'FontRegistry_registerFont',
+        registry >>> 0,
+        bytesPtr >>> 0,
+        size | 0,
+        ttcIndex | 0,
+        familyUtf8Ptr >>> 0,
+        familyByteLength | 0,
+      ) | 0) === 1
+    )
+  }
+
+  countFamilies(registry: Ptr): number {
+    return this.invoke('FontRegistry_countFamilies', registry >>> 0) | 0
+  }
+
+  clearCaches(registry: Ptr): void {
+    this.invoke('FontRegistry_clearCaches', registry >>> 0)
+  }
+
+  // Returns an SkData* (caller must DeleteData) holding the glyph images rasterized so far
+  // with the registry's fonts, or 0 when there are none.
+  serializeGlyphCache(registry: Ptr): Ptr {
+    return this.invoke('FontRegistry_serializeGlyphCache', registry >>> 0) as Ptr
+  }
+
+  // Loads a snapshot saved by serializeGlyphCache in an earlier run. Register the fonts first;
+  // entries for fonts whose data changed are skipped. Returns the number of strikes loaded.
+  preloadGlyphCache(registry: Ptr, bytesPtr: Ptr, size: number): number {
+    return (
+      this.invoke('FontRegistry_preloadGlyphCache', registry >>> 0, bytesPtr >>> 0, size | 0) | 0
+    )
+  }
+
+  makeParagraph(
+    registry: Ptr,
+    utf8Ptr: Ptr,
+    byteLength: number,
+    fontSize: number,
+    wrapWidth: number,
+    color: number,
+    textAlign: TextAlign,
+    maxLines: number,
+    ellipsisUtf8Ptr: Ptr = 0,
+    ellipsisByteLength: number = 0,
+  ): Ptr {
+    return this.invoke(
+      'MakeParagraphFromTextWithRegistry',
+      registry >>> 0,
+      utf8Ptr >>> 0,
+      byteLength | 0,
+      +fontSize,
+      +wrapWidth,
+      color >>> 0,
+      (textAlign as unknown as number) | 0,
+      maxLines | 0,
+      ellipsisUtf8Ptr >>> 0,
+      ellipsisByteLength | 0,
+    ) as Ptr
+  }
+
+  makeParagraphBuilder(
+    registry: Ptr,
+    fontSize: number,
+    color: number,
+    textAlign: TextAlign,
+    maxLines: number,
+    ellipsisUtf8Ptr: Ptr = 0,
+    ellipsisByteLength: number = 0,
+  ): Ptr {
+    return this.invoke(
+      'MakeParagraphBuilderWithRegistry',
+      registry >>> 0,
+      +fontSize,
+      color >>> 0,
+      (textAlign as unknown as number) | 0,
+      maxLines | 0,
+      ellipsisUtf8Ptr >>> 0,
+      ellipsisByteLength | 0,
+    ) as Ptr
+  }
+}
@@ -1,4 +1,5 @@
 import type { Ptr } from '../types'
+import type { EncodedImageFormat } from '../enums'
 import { Api } from './Api'
 
 export class ImageApi extends Api {
@@ -6,6 +7,17 @@ export class ImageApi extends Api {
     return this.invoke('MakeImageFromEncoded', bytesPtr >>> 0, size | 0)
   }
 
+  // Lazily decoded at the smallest resolution covering targetWidth x targetHeight.
+  makeFromEncodedWithTargetSize(bytesPtr: Ptr, size: number, targetWidth: number, targetHeight: number): Ptr {
+    return this.invoke(
+      'MakeImageFromEncodedWithTargetSize',
+      bytesPtr >>> 0,
+      size | 0,
+      targetWidth | 0,
+      targetHeight | 0
+    )
+  }
+
   delete(image: Ptr): void {
     this.invoke('DeleteImage', image)
   }
@@ -25,4 +37,25 @@ export class ImageApi extends Api {
   encodeToPng(image: Ptr): Ptr {
     return this.invoke('Image_encodeToPNG', image)
   }
+
+  // Returns an SkData* (caller must DeleteData); see SurfaceApi.encode for the options.
+  encode(image: Ptr, format: EncodedImageFormat, quality = 90, zlibLevel = -1, filterFlags = 0): Ptr {
+    return this.invoke('Image_encode', image, format | 0, quality | 0, zlibLevel | 0, filterFlags | 0)
+  }
+
+  resourceCacheBytesUsed(): number {
+    return this.invoke('Graphics_getResourceCacheTotalBytesUsed') | 0
+  }
+
+  resourceCacheByteLimit(): number {
+    return this.invoke('Graphics_getResourceCacheTotalByteLimit') | 0
+  }
+
+  setResourceCacheByteLimit(bytes: number): number {
+    return this.invoke('Graphics_setResourceCacheTotalByteLimit', bytes | 0) | 0
+  }
+
+  purgeResourceCache(): void {
+    this.invoke('Graphics_purgeResourceCache')
+  }
 }
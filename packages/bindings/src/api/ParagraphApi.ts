@@ -1,6 +1,6 @@
 import { Api } from './Api'
 import type { Ptr } from '../types'
-import type { TextAlign } from '../enums'
+import type { RectHeightStyle, RectWidthStyle, TextAlign } from '../enums'
 
 export class ParagraphApi extends Api {
   makeFromText(
@@ -81,6 +81,56 @@ export class ParagraphApi extends Api {
     return +this.invoke('Paragraph_getLongestLine', paragraph >>> 0)
   }
 
+  // Bulk queries: each returns the total item count and writes at most `capacity` items.
+  getLineMetrics(paragraph: Ptr, outPtr: Ptr, capacity: number): number {
+    return this.invoke('Paragraph_getLineMetrics', paragraph >>> 0, outPtr >>> 0, capacity | 0) | 0
+  }
+
+  getGlyphClusters(paragraph: Ptr, outBoundsPtr: Ptr, outInfoPtr: Ptr, capacity: number): number {
+    return this.invoke(
+      'Paragraph_getGlyphClusters',
+      paragraph >>> 0,
+      outBoundsPtr >>> 0,
+      outInfoPtr >>> 0,
+      capacity | 0,
+    ) | 0
+  }
+
+  getRectsForRange(
+    paragraph: Ptr,
+    start: number,
+    end: number,
+    heightStyle: RectHeightStyle,
+    widthStyle: RectWidthStyle,
+    outPtr: Ptr,
+    capacity: number,
+  ): number {
+    return this.invoke(
+      'Paragraph_getRectsForRange',
+      paragraph >>> 0,
+      start | 0,
+      end | 0,
+      (heightStyle as unknown as number) | 0,
+      (widthStyle as unknown as number) | 0,
+      outPtr >>> 0,
+      capacity | 0,
+    ) | 0
+  }
+
+  getGlyphPositionsAtCoordinates(paragraph: Ptr, xyPtr: Ptr, count: number, outPtr: Ptr): number {
+    return this.invoke(
+      'Paragraph_getGlyphPositionsAtCoordinates',
+      paragraph >>> 0,
+      xyPtr >>> 0,
+      count | 0,
+      outPtr >>> 0,
+    ) | 0
+  }
+
+  getWordBoundaries(paragraph: Ptr, outPtr: Ptr, capacity: number): number {
+    return this.invoke('Paragraph_getWordBoundaries', paragraph >>> 0, outPtr >>> 0, capacity | 0) | 0
+  }
+
   delete(paragraph: Ptr): void {
     this.invoke('DeleteParagraph', paragraph >>> 0)
   }
@@ -105,4 +105,35 @@ export class PathApi extends Api {
   getSkPathBounds(skPath: Ptr, outLTRB4Ptr: Ptr): void {
     this.invoke('SkPath_getBounds', skPath, outLTRB4Ptr >>> 0)
   }
+
+  // New handle sharing the source's immutable data (same generation ID).
+  copySkPath(skPath: Ptr): Ptr {
+    return this.invoke('SkPath_copy', skPath)
+  }
+
+  // Transforms into a new handle; the source handle is left untouched.
+  makeTransform(skPath: Ptr, m9Ptr: Ptr): Ptr {
+    return this.invoke('SkPath_makeTransform', skPath, m9Ptr >>> 0)
+  }
+
+  getGenerationID(skPath: Ptr): number {
+    return this.invoke('SkPath_getGenerationID', skPath) >>> 0
+  }
+
+  getMaskCacheByteLimit(): number {
+    return this.invoke('PathMaskCache_getByteLimit') | 0
+  }
+
+  setMaskCacheByteLimit(bytes: number): number {
+    return this.invoke('PathMaskCache_setByteLimit', bytes | 0) | 0
+  }
+
+  purgeMaskCache(): void {
+    this.invoke('PathMaskCache_purge')
+  }
+
+  // Writes [hits, misses, entries, bytesUsed] as u32s.
+  getMaskCacheStats(outU32x4Ptr: Ptr): void {
+    this.invoke('PathMaskCache_getStats', outU32x4Ptr >>> 0)
+  }
 }
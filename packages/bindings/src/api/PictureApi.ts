@@ -0,0 +1,37 @@
+import { Api } from './Api'
+import type { Ptr } from '../types'
+
+export class PictureApi extends Api {
+  makeRecorder(): Ptr {
+    return this.invoke('MakePictureRecorder') as Ptr
+  }
+
+  deleteRecorder(recorder: Ptr): void {
+    this.invoke('DeletePictureRecorder', recorder >>> 0)
+  }
+
+  // Returns the recording canvas, owned by the recorder.
+  beginRecording(recorder: Ptr, l: number, t: number, r: number, b: number, useRTree: boolean = true): Ptr {
+    return this.invoke('PictureRecorder_begin', recorder >>> 0, +l, +t, +r, +b, useRTree ? 1 : 0) as Ptr
+  }
+
+  finishRecording(recorder: Ptr): Ptr {
+    return this.invoke('PictureRecorder_finish', recorder >>> 0) as Ptr
+  }
+
+  delete(picture: Ptr): void {
+    this.invoke('DeletePicture', picture >>> 0)
+  }
+
+  draw(canvas: Ptr, picture: Ptr, m9Ptr: Ptr = 0, paint: Ptr = 0): void {
+    this.invoke('Canvas_drawPicture', canvas, picture >>> 0, m9Ptr >>> 0, paint >>> 0)
+  }
+
+  cullRect(picture: Ptr, outLTRB4Ptr: Ptr): void {
+    this.invoke('Picture_cullRect', picture >>> 0, outLTRB4Ptr >>> 0)
+  }
+
+  approximateBytesUsed(picture: Ptr): number {
+    return this.invoke('Picture_approximateBytesUsed', picture >>> 0) | 0
+  }
+}
@@ -1,4 +1,5 @@
 import type { Ptr } from '../types'
+import type { ColorType, EncodedImageFormat } from '../enums'
 import { Api } from './Api'
 
 export class SurfaceApi extends Api {
@@ -10,6 +11,18 @@ export class SurfaceApi extends Api {
     return this.invoke('MakeSWCanvasSurface', w | 0, h | 0)
   }
 
+  // Draws into caller-owned memory; `pixels` must stay allocated until the surface is deleted.
+  makeSwWrapPixels(pixels: Ptr, w: number, h: number, rowBytes: number, colorType: ColorType): Ptr {
+    return this.invoke(
+      'MakeSWCanvasSurfaceWrapPixels',
+      pixels >>> 0,
+      w | 0,
+      h | 0,
+      rowBytes | 0,
+      (colorType as unknown as number) | 0,
+    )
+  }
+
   getCanvas(surface: Ptr): Ptr {
     return this.invoke('Surface_getCanvas', surface)
   }
@@ -34,11 +47,73 @@ export class SurfaceApi extends Api {
     return this.invoke('Surface_encodeToPNG', surface)
   }
 
+  // Returns an SkData* (caller must DeleteData). quality applies to JPEG/WebP, zlibLevel
+  // (-1 = default) and filterFlags (SkPngEncoder::FilterFlag bits) to PNG.
+  encode(surface: Ptr, format: EncodedImageFormat, quality = 90, zlibLevel = -1, filterFlags = 0): Ptr {
+    return this.invoke('Surface_encode', surface, format | 0, quality | 0, zlibLevel | 0, filterFlags | 0)
+  }
+
+  // Returns bytes written, 0 on failure, or -(required size) when dstCapacity is too small.
+  encodeToBuffer(
+    surface: Ptr,
+    format: EncodedImageFormat,
+    quality: number,
+    zlibLevel: number,
+    filterFlags: number,
+    dst: Ptr,
+    dstCapacity: number
+  ): number {
+    return (
+      this.invoke(
+        'Surface_encodeToBuffer',
+        surface,
+        format | 0,
+        quality | 0,
+        zlibLevel | 0,
+        filterFlags | 0,
+        dst >>> 0,
+        dstCapacity | 0
+      ) | 0
+    )
+  }
+
+  makeEncoder(surface: Ptr, format: EncodedImageFormat, quality = 90, zlibLevel = -1, filterFlags = 0): Ptr {
+    return this.invoke('MakeSurfaceEncoder', surface, format | 0, quality | 0, zlibLevel | 0, filterFlags | 0)
+  }
+
+  deleteEncoder(encoder: Ptr): void {
+    this.invoke('DeleteSurfaceEncoder', encoder)
+  }
+
+  // Returns the number of encoded bytes waiting to be read, or -1 on failure.
+  encoderEncodeRows(encoder: Ptr, rows: number): number {
+    return this.invoke('SurfaceEncoder_encodeRows', encoder, rows | 0) | 0
+  }
+
+  encoderRead(encoder: Ptr, dst: Ptr, dstCapacity: number): number {
+    return this.invoke('SurfaceEncoder_read', encoder, dst >>> 0, dstCapacity | 0) | 0
+  }
+
+  encoderIsDone(encoder: Ptr): boolean {
+    return (this.invoke('SurfaceEncoder_isDone', encoder) | 0) === 1
+  }
+
   readPixelsRgba8888(surface: Ptr, x: number, y: number, w: number, h: number, dst: Ptr, dstRowBytes: number): number {
     return this.invoke('Surface_readPixelsRGBA8888', surface, x | 0, y | 0, w | 0, h | 0, dst >>> 0, dstRowBytes | 0)
   }
 
-    delete(surface: Ptr): void {
+  // Returns the pixel address of a raster surface (0 for GPU surfaces) and writes the
+  // row stride as an i32 to outRowBytesPtr when non-zero.
+  peekPixels(surface: Ptr, outRowBytesPtr: Ptr = 0): Ptr {
+    return this.invoke('Surface_peekPixels', surface, outRowBytesPtr >>> 0)
+  }
+
+  // Writes the changed [l, t, r, b] (i32) since the previous call; false if nothing changed.
+  getDamageRect(surface: Ptr, outLTRB4Ptr: Ptr): boolean {
+    return (this.invoke('Surface_getDamageRect', surface, outLTRB4Ptr >>> 0) | 0) === 1
+  }
+
+  delete(surface: Ptr): void {
     this.invoke('DeleteSurface', surface)
   }
 }
@@ -55,6 +55,21 @@ export enum TileMode {
   Decal = 3,
 }
 
+// Color types accepted by SurfaceApi.makeSwWrapPixels (SkColorType values).
+export enum ColorType {
+  RGBA8888 = 4,
+  BGRA8888 = 6,
+  RGBA_F16 = 16,
+}
+
+// Output formats for Surface/Image encode entry points.
+export enum EncodedImageFormat {
+  PNG = 0,
+  JPEG = 1,
+  WebP = 2,
+  WebPLossless = 3,
+}
+
 export enum ClipOp {
   Difference = 0,
   Intersect = 1,
@@ -81,6 +96,27 @@ export enum TextAlign {
   End = 5,
 }
 
+// Box heights for Paragraph.getRectsForRange (skia::textlayout::RectHeightStyle).
+export enum RectHeightStyle {
+  Tight = 0,
+  Max = 1,
+  IncludeLineSpacingMiddle = 2,
+  IncludeLineSpacingTop = 3,
+  IncludeLineSpacingBottom = 4,
+  Strut = 5,
+}
+
+// Box widths for Paragraph.getRectsForRange (skia::textlayout::RectWidthStyle).
+export enum RectWidthStyle {
+  Tight = 0,
+  Max = 1,
+}
+
+export enum Affinity {
+  Upstream = 0,
+  Downstream = 1,
+}
+
 export enum BlendMode {
   Clear = 0,
   Src = 1,
@@ -1,6 +1,8 @@
 export * from './Path'
 export * from './Paint'
 export * from './Canvas'
+export * from './CommandBuffer'
+export * from './CallTrace'
 export * from './Image'
 export * from './Surface'
 export * from './Paragraph'
@@ -7,10 +7,17 @@
 
 #include "bench/Benchmark.h"
 #include "bench/BigPath.h"
+#include "include/core/SkCPUContext.h"
+#include "include/core/SkCPURecorder.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkSurface.h"
 #include "tools/ToolUtils.h"
 
+#include <memory>
+#include <optional>
+
 enum Align {
     kLeft_Align,
     kMiddle_Align,
@@ -26,15 +33,35 @@ class BigPathBench : public Benchmark {
     Align       fAlign;
     bool        fRound;
 
+    // When set, draws into a raster surface owned by a context using this rasterizer instead
+    // of the bench canvas, so the path rasterizers can be compared against each other.
+    std::optional<skcpu::Context::PathRasterizer> fRasterizer;
+    std::unique_ptr<const skcpu::Context> fContext;
+    std::unique_ptr<skcpu::Recorder> fRecorder;
+    sk_sp<SkSurface> fSurface;
+
 public:
-    BigPathBench(Align align, bool round) : fAlign(align), fRound(round) {
+    BigPathBench(Align align,
+                 bool round,
+                 std::optional<skcpu::Context::PathRasterizer> rasterizer = std::nullopt)
+            : fAlign(align), fRound(round), fRasterizer(rasterizer) {
         fName.printf("bigpath_%s", gAlignName[fAlign]);
         if (round) {
             fName.append("_round");
         }
+        if (fRasterizer) {
+            fName.append(*fRasterizer == skcpu::Context::PathRasterizer::kSparseStrips
+                                 ? "_sparsestrips"
+                                 : "_analytic");
+        }
     }
 
 protected:
+    bool isSuitableFor(Backend backend) override {
+        return fRasterizer ? backend == Backend::kNonRendering
+                           : backend != Backend::kNonRendering;
+    }
+
     const char* onGetName() override {
         return fName.c_str();
     }
@@ -43,9 +70,21 @@ protected:
         return SkISize::Make(640, 100);
     }
 
-    void onDelayedSetup() override { fPath = BenchUtils::make_big_path(); }
+    void onDelayedSetup() override {
+        fPath = BenchUtils::make_big_path();
+        if (fRasterizer) {
+            skcpu::Context::Options options;
+            options.fPathRasterizer = *fRasterizer;
+            fContext = skcpu::Context::Make(options);
+            fRecorder = fContext->makeRecorder();
+            fSurface = fRecorder->makeBitmapSurface(SkImageInfo::MakeN32Premul(this->getSize()));
+        }
+    }
 
     void onDraw(int loops, SkCanvas* canvas) override {
+        if (fSurface) {
+            canvas = fSurface->getCanvas();
+        }
         SkPaint paint;
         paint.setAntiAlias(true);
         paint.setStyle(SkPaint::kStroke_Style);
@@ -83,3 +122,8 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+DEF_BENCH( return new BigPathBench(kMiddle_Align, false, skcpu::Context::PathRasterizer::kAnalytic); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align, false, skcpu::Context::PathRasterizer::kSparseStrips); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align, true,  skcpu::Context::PathRasterizer::kAnalytic); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align, true,  skcpu::Context::PathRasterizer::kSparseStrips); )
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "src/core/SkRasterPipelineBlitterCache.h"
+
+// Many small solid-color draws whose paints change color and blend mode on every draw, as UI
+// content does. Blitter creation dominates, so this measures SkRasterPipelineBlitterCache.
+namespace {
+
+class BlitterCacheBench : public Benchmark {
+public:
+    BlitterCacheBench(SkColorType colorType, bool cached)
+            : fColorType(colorType), fCached(cached) {
+        fName.printf("blitter_cache_%s_%s",
+                     colorType == kRGBA_F16_SkColorType ? "f16" : "8888_p3",
+                     cached ? "cached" : "uncached");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        // A non-sRGB 8888 destination keeps the SrcOver draws off the legacy blitters, so every
+        // draw goes through SkRasterPipelineBlitter.
+        sk_sp<SkColorSpace> colorSpace =
+                fColorType == kRGBA_F16_SkColorType
+                        ? nullptr
+                        : SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                SkNamedGamut::kDisplayP3);
+        fSurface = SkSurfaces::Raster(SkImageInfo::Make(
+                256, 256, fColorType, kPremul_SkAlphaType, std::move(colorSpace)));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        constexpr int kDraws = 1000;
+        const SkBlendMode modes[] = {SkBlendMode::kSrcOver, SkBlendMode::kSrc,
+                                     SkBlendMode::kMultiply, SkBlendMode::kScreen};
+
+        SkRasterPipelineBlitterCache::ScopedEnabledOverride enabled(fCached);
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        for (int i = 0; i < loops; i++) {
+            for (int j = 0; j < kDraws; j++) {
+                paint.setColor(0xff000000 | (uint32_t)(j * 2654435761u >> 8));
+                paint.setAlphaf(j % 4 ? 1.0f : 0.5f);
+                paint.setBlendMode(modes[j % std::size(modes)]);
+                canvas->drawRect(SkRect::MakeXYWH((j % 50) * 5, (j / 50) * 5, 4, 4), paint);
+            }
+        }
+    }
+
+private:
+    SkString         fName;
+    SkColorType      fColorType;
+    bool             fCached;
+    sk_sp<SkSurface> fSurface;
+};
+
+}  // namespace
+
+DEF_BENCH(return new BlitterCacheBench(kRGBA_8888_SkColorType, true);)
+DEF_BENCH(return new BlitterCacheBench(kRGBA_8888_SkColorType, false);)
+DEF_BENCH(return new BlitterCacheBench(kRGBA_F16_SkColorType, true);)
+DEF_BENCH(return new BlitterCacheBench(kRGBA_F16_SkColorType, false);)
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <atomic>
+
+// Measures executor overhead on many tiny tasks, the shape SkTaskGroup::batch() and nested
+// parallel work produce. Each task does almost nothing, so time is dominated by submitting,
+// scheduling and completing work.
+namespace {
+
+enum class Pool { kFIFO, kLIFO, kWorkStealing };
+
+constexpr int kThreads = 4;
+
+class ExecutorBench : public Benchmark {
+public:
+    ExecutorBench(Pool pool, bool nested) : fPool(pool), fNested(nested) {
+        static const char* kPoolNames[] = {"fifo", "lifo", "workstealing"};
+        fName.printf("executor_%s_%s", kPoolNames[(int)pool], nested ? "nested" : "flat");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        switch (fPool) {
+            case Pool::kFIFO:
+                fExecutor = SkExecutor::MakeFIFOThreadPool(kThreads);
+                break;
+            case Pool::kLIFO:
+                fExecutor = SkExecutor::MakeLIFOThreadPool(kThreads);
+                break;
+            case Pool::kWorkStealing:
+                fExecutor = SkExecutor::MakeWorkStealingThreadPool(kThreads);
+                break;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        constexpr int kTasks = 1024;
+        constexpr int kOuterTasks = 32;
+
+        for (int i = 0; i < loops; i++) {
+            SkTaskGroup group(*fExecutor);
+            if (fNested) {
+                // Each task fans out into its own group and waits for it, as tiled work does.
+                for (int j = 0; j < kOuterTasks; j++) {
+                    group.add([this] {
+                        SkTaskGroup inner(*fExecutor);
+                        inner.batch(kTasks / kOuterTasks, [this](int k) {
+                            fCounter.fetch_add(k, std::memory_order_relaxed);
+                        });
+                        inner.wait();
+                    });
+                }
+            } else {
+                group.batch(kTasks, [this](int k) {
+                    fCounter.fetch_add(k, std::memory_order_relaxed);
+                });
+            }
+            group.wait();
+        }
+    }
+
+private:
+    const Pool                  fPool;
+    const bool                  fNested;
+    SkString                    fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::atomic<int>            fCounter{0};
+};
+
+}  // namespace
+
+DEF_BENCH(return new ExecutorBench(Pool::kFIFO, /*nested=*/false);)
+DEF_BENCH(return new ExecutorBench(Pool::kLIFO, /*nested=*/false);)
+DEF_BENCH(return new ExecutorBench(Pool::kWorkStealing, /*nested=*/false);)
+DEF_BENCH(return new ExecutorBench(Pool::kFIFO, /*nested=*/true);)
+DEF_BENCH(return new ExecutorBench(Pool::kLIFO, /*nested=*/true);)
+DEF_BENCH(return new ExecutorBench(Pool::kWorkStealing, /*nested=*/true);)
@@ -7,7 +7,10 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCPUContext.h"
+#include "include/core/SkCPURecorder.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathBuilder.h"
@@ -15,6 +18,7 @@
 #include "include/core/SkRRect.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
@@ -28,8 +32,12 @@
 using namespace skia_private;
 
 enum Flags {
-    kStroke_Flag = 1 << 0,
-    kBig_Flag    = 1 << 1
+    kStroke_Flag       = 1 << 0,
+    kBig_Flag          = 1 << 1,
+    // Draw into a raster surface owned by a skcpu::Context using the given path rasterizer,
+    // rather than into the bench canvas.
+    kAnalytic_Flag     = 1 << 2,
+    kSparseStrips_Flag = 1 << 3,
 };
 
 #define FLAGS00  Flags(0)
@@ -41,6 +49,10 @@ class PathBench : public Benchmark {
     SkPaint     fPaint;
     SkString    fName;
     Flags       fFlags;
+
+    std::unique_ptr<const skcpu::Context> fContext;
+    std::unique_ptr<skcpu::Recorder>      fRecorder;
+    sk_sp<SkSurface>                      fSurface;
 public:
     PathBench(Flags flags) : fFlags(flags) {
         fPaint.setStyle(flags & kStroke_Flag ? SkPaint::kStroke_Style :
@@ -54,15 +66,40 @@ public:
     virtual int complexity() { return 0; }
 
 protected:
+    bool isSuitableFor(Backend backend) override {
+        return this->usesContext() ? backend == Backend::kNonRendering
+                                   : backend != Backend::kNonRendering;
+    }
+
     const char* onGetName() override {
         fName.printf("path_%s_%s_",
                      fFlags & kStroke_Flag ? "stroke" : "fill",
                      fFlags & kBig_Flag ? "big" : "small");
         this->appendName(&fName);
+        if (fFlags & kAnalytic_Flag) {
+            fName.append("_analytic");
+        } else if (fFlags & kSparseStrips_Flag) {
+            fName.append("_sparsestrips");
+        }
         return fName.c_str();
     }
 
+    void onDelayedSetup() override {
+        if (this->usesContext()) {
+            skcpu::Context::Options options;
+            options.fPathRasterizer = fFlags & kSparseStrips_Flag
+                                              ? skcpu::Context::PathRasterizer::kSparseStrips
+                                              : skcpu::Context::PathRasterizer::kAnalytic;
+            fContext = skcpu::Context::Make(options);
+            fRecorder = fContext->makeRecorder();
+            fSurface = fRecorder->makeBitmapSurface(SkImageInfo::MakeN32Premul(this->getSize()));
+        }
+    }
+
     void onDraw(int loops, SkCanvas* canvas) override {
+        if (fSurface) {
+            canvas = fSurface->getCanvas();
+        }
         SkPaint paint(fPaint);
         this->setupPaint(&paint);
 
@@ -77,6 +114,8 @@ protected:
     }
 
 private:
+    bool usesContext() const { return fFlags & (kAnalytic_Flag | kSparseStrips_Flag); }
+
     using INHERITED = Benchmark;
 };
 
@@ -1171,6 +1210,13 @@ DEF_BENCH( return new AAAConcavePathBench(FLAGS10); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS00); )
 DEF_BENCH( return new AAAConvexPathBench(FLAGS10); )
 
+DEF_BENCH( return new AAAConcavePathBench(Flags(kBig_Flag | kAnalytic_Flag)); )
+DEF_BENCH( return new AAAConcavePathBench(Flags(kBig_Flag | kSparseStrips_Flag)); )
+DEF_BENCH( return new CirclePathBench(Flags(kBig_Flag | kAnalytic_Flag)); )
+DEF_BENCH( return new CirclePathBench(Flags(kBig_Flag | kSparseStrips_Flag)); )
+DEF_BENCH( return new LongCurvedPathBench(Flags(kAnalytic_Flag)); )
+DEF_BENCH( return new LongCurvedPathBench(Flags(kSparseStrips_Flag)); )
+
 DEF_BENCH( return new SawToothPathBench(FLAGS00); )
 DEF_BENCH( return new SawToothPathBench(FLAGS01); )
 
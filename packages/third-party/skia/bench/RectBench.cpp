@@ -9,12 +9,15 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/effects/SkGradientShader.h"
 #include "src/base/SkRandom.h"
 #include "tools/flags/CommandLineFlags.h"
 
+#include <algorithm>
+
 static DEFINE_double(strokeWidth, -1.0, "If set, use this stroke width in RectBench.");
 
 class RectBench : public Benchmark {
@@ -213,6 +216,52 @@ protected:
     const char* onGetName() override { return computeName("rrects"); }
 };
 
+// The shapes a typical UI is made of: cards and buttons, panels and tabs with mixed corners, and
+// circular avatars. Strokes of the circular-cornered shapes are borders.
+class UIRRectBench : public RectBench {
+public:
+    enum class Shape { kSimple, kNinePatch, kComplex, kCircle };
+
+    UIRRectBench(Shape shape, int shift, int stroke = 0)
+        : RectBench(shift, stroke), fShape(shape) {}
+
+protected:
+    void drawThisRect(SkCanvas* c, const SkRect& r, const SkPaint& p) override {
+        const SkScalar radius = std::min(r.width(), r.height()) / 4;
+        switch (fShape) {
+            case Shape::kSimple:
+                c->drawRoundRect(r, radius, radius, p);
+                break;
+            case Shape::kNinePatch: {
+                SkRRect rrect;
+                rrect.setNinePatch(r, radius, radius / 2, radius, radius / 2);
+                c->drawRRect(rrect, p);
+                break;
+            }
+            case Shape::kComplex: {
+                const SkVector radii[4] = {{radius, radius}, {radius / 2, radius / 2},
+                                           {0, 0}, {radius, radius}};
+                SkRRect rrect;
+                rrect.setRectRadii(r, radii);
+                c->drawRRect(rrect, p);
+                break;
+            }
+            case Shape::kCircle:
+                c->drawCircle(r.center(), std::min(r.width(), r.height()) / 2, p);
+                break;
+        }
+    }
+
+    const char* onGetName() override {
+        static const char* kNames[] = {"rrects_simple", "rrects_ninepatch", "rrects_complex",
+                                       "circles"};
+        return computeName(kNames[static_cast<int>(fShape)]);
+    }
+
+private:
+    Shape fShape;
+};
+
 class PointsBench : public RectBench {
 public:
     SkCanvas::PointMode fMode;
@@ -404,6 +453,16 @@ DEF_BENCH(return new RRectBench(1, 4);)
 DEF_BENCH(return new RRectBench(3);)
 DEF_BENCH(return new RRectBench(3, 4);)
 
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kSimple, 1);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kSimple, 3);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kSimple, 3, 2);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kNinePatch, 3);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kComplex, 3);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kComplex, 3, 2);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kCircle, 1);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kCircle, 3);)
+DEF_BENCH(return new UIRRectBench(UIRRectBench::Shape::kCircle, 3, 2);)
+
 DEF_BENCH(return new HairPointsBench(SkBlendMode::kSrcOver, 0.5f);)
 DEF_BENCH(return new HairPointsBench(SkBlendMode::kSrcOver, 1);)
 DEF_BENCH(return new HairPointsBench(SkBlendMode::kSrc, 0.5f);)
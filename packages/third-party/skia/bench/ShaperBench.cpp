@@ -6,10 +6,12 @@
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
 
 #include "modules/skshaper/include/SkShaper.h"
+#include "modules/skshaper/include/SkShaper_harfbuzz.h"
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cfloat>
+#include <cstring>
 
 namespace {
 struct ShaperBench : public Benchmark {
@@ -38,6 +40,48 @@ struct ShaperBench : public Benchmark {
 };
 }  // namespace
 
+#if defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+namespace {
+// Shapes short, repetitive UI labels one at a time, as a toolkit laying out buttons and list
+// items would, with and without the HarfBuzz shape cache.
+struct ShaperUILabelsBench : public Benchmark {
+    explicit ShaperUILabelsBench(bool cached) : fCached(cached) {}
+    std::unique_ptr<SkShaper> fShaper;
+    bool fCached;
+    const char* onGetName() override {
+        return fCached ? "shaper_ui_labels_cached" : "shaper_ui_labels";
+    }
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+    void onDelayedSetup() override { fShaper = SkShaper::Make(); }
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        SkShapers::HB::SetShapeCacheLimit(fCached ? 1024 : 0);
+    }
+    void onPerCanvasPostDraw(SkCanvas*) override { SkShapers::HB::SetShapeCacheLimit(0); }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fShaper) { return; }
+        static constexpr const char* kLabels[] = {
+            "OK", "Cancel", "Save changes", "Open", "Close window", "Settings", "Edit profile",
+            "View all", "Help", "Mark as read", "Archive", "Delete", "Reply to all", "Forward",
+            "Add to list", "Remove from list", "Show more", "Sign out",
+        };
+        SkFont font = ToolUtils::DefaultFont();
+        while (loops-- > 0) {
+            for (int i = 0; i < 10; ++i) {
+                for (const char* label : kLabels) {
+                    SkTextBlobBuilderRunHandler rh(label, {0, 0});
+                    fShaper->shape(label, strlen(label), font, true, FLT_MAX, &rh);
+                    (void)rh.makeBlob();
+                }
+            }
+        }
+    }
+};
+}  // namespace
+
+DEF_BENCH(return new ShaperUILabelsBench(false);)
+DEF_BENCH(return new ShaperUILabelsBench(true);)
+#endif  // defined(SK_SHAPER_HARFBUZZ_AVAILABLE)
+
 #define SHAPER_BENCH(X) DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_" #X);)
 SHAPER_BENCH(arabic)
 SHAPER_BENCH(armenian)
@@ -10,8 +10,11 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/chromium/SkChromeRemoteGlyphCache.h"
 #include "src/core/SkStrikeSpec.h"
@@ -22,6 +25,7 @@
 #include "tools/text/SkTextBlobTrace.h"
 
 #include <optional>
+#include <vector>
 
 using namespace skia_private;
 
@@ -118,10 +122,73 @@ private:
     SkString fName;
 };
 
+// Draws the same text from several threads at once, each into its own raster surface, so after the
+// first loop every lookup hits strikes and glyphs that are already in the cache. This measures how
+// well the strike cache and glyph lookups scale with the number of threads.
+class SkGlyphCacheMultiThreaded : public Benchmark {
+public:
+    explicit SkGlyphCacheMultiThreaded(int threads) : fThreads(threads) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheMultiThreaded_threads%d", fThreads);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        for (int i = 0; i < fThreads; i++) {
+            fSurfaces.push_back(SkSurfaces::Raster(SkImageInfo::MakeN32Premul(256, 256)));
+        }
+
+        // A few sizes so the strikes spread across the cache.
+        SkFont font = ToolUtils::DefaultFont();
+        font.setEdging(SkFont::Edging::kAntiAlias);
+        font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Normal()));
+        const char text[] = "The quick brown fox jumps over the lazy dog.";
+        for (SkScalar size : {11.0f, 12.0f, 14.0f, 16.0f}) {
+            font.setSize(size);
+            fBlobs.push_back(SkTextBlob::MakeFromString(text, font));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPaint paint;
+        for (int work = 0; work < loops; work++) {
+            SkTaskGroup(*fExecutor).batch(fThreads, [&](int threadIndex) {
+                SkCanvas* canvas = fSurfaces[threadIndex]->getCanvas();
+                for (int repeat = 0; repeat < 16; repeat++) {
+                    SkScalar y = 16;
+                    for (const sk_sp<SkTextBlob>& blob : fBlobs) {
+                        canvas->drawTextBlob(blob, 0, y, paint);
+                        y += 20;
+                    }
+                }
+            });
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+    const int fThreads;
+    SkString fName;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::vector<sk_sp<SkSurface>> fSurfaces;
+    std::vector<sk_sp<SkTextBlob>> fBlobs;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheMultiThreaded(1); )
+DEF_BENCH( return new SkGlyphCacheMultiThreaded(2); )
+DEF_BENCH( return new SkGlyphCacheMultiThreaded(4); )
+DEF_BENCH( return new SkGlyphCacheMultiThreaded(8); )
 
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
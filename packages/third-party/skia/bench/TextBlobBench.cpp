@@ -7,10 +7,13 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/base/SkTemplates.h"
@@ -109,3 +112,107 @@ class TextBlobMakeBench : public SkTextBlobBench {
     }
 };
 DEF_BENCH( return new TextBlobMakeBench(); )
+
+/*
+ * Measures glyph throughput for small UI text drawn into a raster surface. Solid color text under
+ * a rect clip is blitted a run at a time, so this tracks the per-glyph cost of that path.
+ */
+class TextBlobRasterGlyphsBench : public Benchmark {
+public:
+    TextBlobRasterGlyphsBench(SkColorType colorType, SkScalar textSize)
+            : fColorType(colorType), fTextSize(textSize) {
+        fName.printf("TextBlobRasterGlyphs_%s_%g",
+                     colorType == kRGBA_F16_SkColorType ? "F16" : "8888", textSize);
+    }
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        sk_sp<SkColorSpace> colorSpace = fColorType == kRGBA_F16_SkColorType
+                                                 ? SkColorSpace::MakeSRGBLinear()
+                                                 : nullptr;
+        fSurface = SkSurfaces::Raster(
+                SkImageInfo::Make(512, 512, fColorType, kPremul_SkAlphaType, colorSpace));
+
+        SkFont font(ToolUtils::CreatePortableTypeface("sans-serif", SkFontStyle()), fTextSize);
+        font.setSubpixel(true);
+        const char* text = "Keep your sentences short, but not overly so.";
+        fBlob = SkTextBlob::MakeFromText(text, strlen(text), font);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        paint.setColor(0xFF202124);
+        const int lines = SkScalarFloorToInt(512 / fTextSize);
+        for (int i = 0; i < loops; i++) {
+            for (int line = 1; line <= lines; ++line) {
+                canvas->drawTextBlob(fBlob, 4, line * fTextSize, paint);
+            }
+        }
+    }
+
+    SkColorType       fColorType;
+    SkScalar          fTextSize;
+    SkString          fName;
+    sk_sp<SkSurface>  fSurface;
+    sk_sp<SkTextBlob> fBlob;
+};
+DEF_BENCH( return new TextBlobRasterGlyphsBench(kN32_SkColorType, 12); )
+DEF_BENCH( return new TextBlobRasterGlyphsBench(kN32_SkColorType, 16); )
+DEF_BENCH( return new TextBlobRasterGlyphsBench(kRGBA_F16_SkColorType, 12); )
+DEF_BENCH( return new TextBlobRasterGlyphsBench(kRGBA_F16_SkColorType, 16); )
+
+/*
+ * Animates a text blob through 60 scales starting from an empty glyph cache, as a zoom or pinch
+ * would. Without scale bucketing every frame rasterizes a new strike.
+ */
+class TextBlobAnimatedScaleBench : public Benchmark {
+public:
+    explicit TextBlobAnimatedScaleBench(bool bucketing) : fBucketing(bucketing) {}
+
+private:
+    const char* onGetName() override {
+        return fBucketing ? "TextBlobAnimatedScale_bucketed" : "TextBlobAnimatedScale";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(512, 256));
+
+        SkFont font(ToolUtils::CreatePortableTypeface("sans-serif", SkFontStyle()), 14);
+        font.setSubpixel(true);
+        font.setScaleBucketing(fBucketing);
+        const char* text = "Keep your sentences short, but not overly so.";
+        fBlob = SkTextBlob::MakeFromText(text, strlen(text), font);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        constexpr int kFrames = 60;
+        SkCanvas* canvas = fSurface->getCanvas();
+        SkPaint paint;
+        for (int i = 0; i < loops; i++) {
+            SkGraphics::PurgeFontCache();
+            for (int frame = 0; frame < kFrames; ++frame) {
+                const SkScalar scale = 1 + frame / (SkScalar)kFrames;
+                SkAutoCanvasRestore acr(canvas, true);
+                canvas->scale(scale, scale);
+                canvas->drawTextBlob(fBlob, 4, 20, paint);
+            }
+        }
+    }
+
+    bool              fBucketing;
+    sk_sp<SkSurface>  fSurface;
+    sk_sp<SkTextBlob> fBlob;
+};
+DEF_BENCH( return new TextBlobAnimatedScaleBench(false); )
+DEF_BENCH( return new TextBlobAnimatedScaleBench(true); )
@@ -158,6 +158,7 @@ enum AtlasFlags {
     kColors_Flag = 1 << 0,
     kRotate_Flag = 1 << 1,
     kPersp_Flag  = 1 << 2,
+    kScale_Flag  = 1 << 3,
 };
 
 class AtlasBench : public Benchmark {
@@ -185,6 +186,9 @@ public:
         if (flags & kPersp_Flag) {
             fName.append("_persp");
         }
+        if (flags & kScale_Flag) {
+            fName.append("_scaled");
+        }
     }
     ~AtlasBench() override {}
 
@@ -204,6 +208,10 @@ protected:
             scos = 0.866025403784439f;  // sqrt(3)/2
             ssin = 0.5f;
         }
+        if (fFlags & kScale_Flag) {
+            scos *= 2;
+            ssin *= 2;
+        }
 
         SkRandom rand;
         for (int i = 0; i < N; ++i) {
@@ -236,6 +244,7 @@ private:
 //DEF_BENCH(return new AtlasBench(kColors_Flag);)
 DEF_BENCH(return new AtlasBench(0);)
 DEF_BENCH(return new AtlasBench(kRotate_Flag);)
+DEF_BENCH(return new AtlasBench(kScale_Flag);)
 DEF_BENCH(return new AtlasBench(kPersp_Flag);)
 DEF_BENCH(return new AtlasBench(kColors_Flag);)
 DEF_BENCH(return new AtlasBench(kColors_Flag | kRotate_Flag);)
@@ -11,12 +11,46 @@
 
 #include <memory>
 
+class SkExecutor;
+
 namespace skcpu {
 class Recorder;
 
 class SK_API Context {
 public:
-    struct Options {};
+    /** How Recorder::drawPicture splits a surface into independently rendered regions. */
+    struct TilePolicy {
+        enum class Split {
+            kBands,  //!< full-width bands fTileSize rows tall
+            kTiles,  //!< fTileSize x fTileSize squares
+        };
+        Split fSplit = Split::kBands;
+        int fTileSize = 128;
+    };
+
+    /** Scan converter used for anti-aliased path fills. */
+    enum class PathRasterizer {
+        kAnalytic,      //!< walks analytic edges a scanline at a time (the default)
+        kSparseStrips,  //!< bins edges into 4-row strips and blits their coverage in bulk;
+                        //!< faster on large, complex paths, with small differences at
+                        //!< self-intersections
+    };
+
+    struct Options {
+        /** When non-null, Recorder::drawPicture plays pictures back on this executor, one task
+         *  per tile (see its limitations). Not owned; it must outlive the context and every
+         *  recorder made from it.
+         */
+        SkExecutor* fExecutor = nullptr;
+        TilePolicy fTilePolicy;
+        PathRasterizer fPathRasterizer = PathRasterizer::kAnalytic;
+        /** When positive, image filters applied to layers larger than this many pixels on a side
+         *  are evaluated in square tiles of this size (in parallel when fExecutor is set), which
+         *  bounds the size of their intermediate images. Filters that can't be tiled exactly fall
+         *  back to whole-layer evaluation.
+         */
+        int fImageFilterTileSize = 0;
+    };
 
     std::unique_ptr<Recorder> makeRecorder() const;
 
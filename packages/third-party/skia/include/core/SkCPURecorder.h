@@ -13,6 +13,8 @@
 #include "include/private/base/SkAPI.h"
 
 class SkCanvas;
+class SkMatrix;
+class SkPicture;
 class SkSurface;
 class SkSurfaceProps;
 struct SkImageInfo;
@@ -54,6 +56,26 @@ public:
     sk_sp<SkSurface> makeBitmapSurface(const SkImageInfo& imageInfo,
                                        const SkSurfaceProps* surfaceProps = nullptr);
 
+    /** Draws picture into a bitmap surface, like surface->getCanvas()->drawPicture(picture,
+     *  matrix, nullptr).
+     *
+     *  If this recorder's context has an executor, the area of the surface the picture can
+     *  touch is split according to the context's TilePolicy and each tile is played back on the
+     *  executor into its own clipped canvas over the surface's pixels, using the picture's
+     *  bounding box hierarchy (if recorded with one) to skip work outside the tile. Returns when
+     *  every tile is done.
+     *
+     *  Falls back to drawing on the calling thread when there is no executor, when the surface
+     *  has no directly accessible pixels, or when its canvas has an open save/layer or a
+     *  non-rectangular clip. The canvas's matrix and rectangular clip are honored.
+     *
+     *  Each tile only sees its own pixels of the surface, so effects that read the destination
+     *  outside the area being drawn, such as backdrop image filters on saveLayer, see only the
+     *  tile's part of it and can differ near tile edges from drawing on the canvas. Pictures
+     *  using them should be drawn through surface->getCanvas() instead. Dithering matches.
+     */
+    void drawPicture(SkSurface* surface, const SkPicture* picture, const SkMatrix* matrix = nullptr);
+
 private:
     // TODO (b/412351769): Implement this so we can capture from a CPU Recorder.
     SkCanvas* makeCaptureCanvas(SkCanvas*) final { return nullptr; }
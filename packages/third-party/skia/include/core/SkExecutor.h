@@ -34,6 +34,13 @@ public:
                                                                    int threads = 0,
                                                                    bool allowBorrowing = true);
 
+    // A work-stealing pool for many small tasks: each thread keeps its own deque of work and idle
+    // threads steal from the others, so adding and running work takes no shared lock. Work added
+    // from a pool thread (e.g. by a task) goes to that thread's deque and is run LIFO there.
+    // It has a single work list; the workList argument to add() is ignored.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0,
+                                                                  bool allowBorrowing = true);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
@@ -135,6 +135,13 @@ public:
      */
     bool isBaselineSnap() const { return SkToBool(fFlags & kBaselineSnap_PrivFlag); }
 
+    /** Returns true if glyphs drawn by the raster backend may come from a nearby power-of-sqrt(2)
+        size and be resampled, instead of being rasterized at the exact device size.
+
+        @return  glyph sizes may be snapped to shared buckets
+     */
+    bool isScaleBucketing() const { return SkToBool(fFlags & kScaleBucketing_PrivFlag); }
+
     /** Sets whether to always hint glyphs.
         If forceAutoHinting is set, instructs the font manager to always hint glyphs.
 
@@ -178,6 +185,19 @@ public:
     */
     void setBaselineSnap(bool baselineSnap);
 
+    /** Requests that text whose scale is being animated is drawn from a small set of shared
+        power-of-sqrt(2) sizes on the raster backend. Glyph masks are rasterized once per bucket
+        and resampled with linear filtering to the device size, rather than being rasterized
+        again for every intermediate scale. Clear it when the animation settles so the final
+        frame is rasterized exactly.
+
+        Only applies to anti-aliased text drawn with a solid color under a uniform scale and
+        translate. LCD text is drawn as A8 while bucketing.
+
+        @param scaleBucketing  setting for drawing glyphs from shared size buckets
+    */
+    void setScaleBucketing(bool scaleBucketing);
+
     /** Whether edge pixels draw opaque or with partial transparency.
     */
     Edging getEdging() const { return (Edging)fEdging; }
@@ -540,6 +560,7 @@ private:
         kLinearMetrics_PrivFlag         = 1 << 3,
         kEmbolden_PrivFlag              = 1 << 4,
         kBaselineSnap_PrivFlag          = 1 << 5,
+        kScaleBucketing_PrivFlag        = 1 << 6,
     };
 
     static constexpr unsigned kAllFlags = kForceAutoHinting_PrivFlag
@@ -547,7 +568,8 @@ private:
                                         | kSubpixel_PrivFlag
                                         | kLinearMetrics_PrivFlag
                                         | kEmbolden_PrivFlag
-                                        | kBaselineSnap_PrivFlag;
+                                        | kBaselineSnap_PrivFlag
+                                        | kScaleBucketing_PrivFlag;
 
     sk_sp<SkTypeface> fTypeface;
     SkScalar    fSize;
@@ -9,6 +9,7 @@
 #define SkGraphics_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkAPI.h"
 
 #include <cstddef>
@@ -19,6 +20,7 @@ class SkData;
 class SkImageGenerator;
 class SkOpenTypeSVGDecoder;
 class SkTraceMemoryDump;
+class SkTypeface;
 
 class SK_API SkGraphics {
 public:
@@ -96,6 +98,26 @@ public:
      */
     static void PurgePinnedFontCache();
 
+    /**
+     *  Returns a snapshot of the glyph images in the font cache that were rendered with any of
+     *  the given typefaces, or nullptr if there are none. Typefaces are identified in the
+     *  snapshot by a hash of their font data, so it can be saved and passed to
+     *  PreloadFontCache() by a later process to avoid rasterizing the same glyphs again at
+     *  startup. Typefaces that cannot provide their font data are not included.
+     */
+    static sk_sp<SkData> SerializeFontCache(SkSpan<const sk_sp<SkTypeface>> typefaces);
+
+    /**
+     *  Adds the glyph images in a snapshot from SerializeFontCache() to the font cache, so they
+     *  are drawn without being rasterized again. Entries whose font data does not match one of
+     *  the given typefaces are skipped, and a snapshot from a different Skia milestone or that
+     *  is corrupt is ignored. The snapshot does not identify the platform font backend, so
+     *  snapshots should be discarded when it may have changed, e.g. with a new FreeType or OS.
+     *  Returns the number of strikes that were added.
+     */
+    static int PreloadFontCache(const SkData& snapshot,
+                                SkSpan<const sk_sp<SkTypeface>> typefaces);
+
     /**
      *  This function returns the memory used for temporary images and other resources.
      */
@@ -126,6 +148,32 @@ public:
     static size_t GetResourceCacheSingleAllocationByteLimit();
     static size_t SetResourceCacheSingleAllocationByteLimit(size_t newLimit);
 
+    /**
+     *  By default, image filter results are cached per filter object, so re-creating an equivalent
+     *  filter (e.g. every frame) never reuses earlier results. When content addressing is enabled,
+     *  results are instead keyed on the structure and parameters of the filter DAG and the content
+     *  of its source, so unchanged drop shadows and backdrop blurs are only computed once. Raster
+     *  sources, including saveLayer contents, are keyed on their pixels, which are hashed on each
+     *  lookup; GPU-backed sources are keyed on their ID, so only image sources benefit there.
+     *  Changing the mode purges the image filter cache.
+     */
+    static void SetImageFilterCacheContentAddressed(bool contentAddressed);
+    static bool GetImageFilterCacheContentAddressed();
+
+    /**
+     *  These functions get the memory used by, and get/set the memory usage limit of, the image
+     *  filter cache. Least recently used results are purged when usage exceeds the limit.
+     */
+    static size_t GetImageFilterCacheTotalBytesUsed();
+    static size_t GetImageFilterCacheTotalByteLimit();
+    static size_t SetImageFilterCacheTotalByteLimit(size_t newLimit);
+
+    /**
+     *  The number of image filter cache lookups that found, or did not find, a cached result.
+     */
+    static uint64_t GetImageFilterCacheHitCount();
+    static uint64_t GetImageFilterCacheMissCount();
+
     /**
      *  Dumps memory usage of caches using the SkTraceMemoryDump interface. See SkTraceMemoryDump
      *  for usage of this method.
@@ -24,6 +24,7 @@ class GrDirectContext;
 class SkBitmap;
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkImageFilter;
 class SkImageGenerator;
@@ -797,6 +798,16 @@ public:
      */
     sk_sp<SkImage> withDefaultMipmaps() const;
 
+    /**
+     *  Like withDefaultMipmaps(), but raster images return immediately and build their mipmap
+     *  levels on 'executor', splitting large levels into row bands. Until the levels are ready,
+     *  hasMipmaps() returns false and draws that request mipmaps sample the base level instead, as
+     *  if SkMipmapMode::kNone were requested. 'executor' must outlive the build.
+     *
+     *  Other images, or a null 'executor', behave like withDefaultMipmaps().
+     */
+    sk_sp<SkImage> withDefaultMipmapsAsync(SkExecutor* executor) const;
+
     /** Returns raster image or lazy image. Copies SkImage backed by GPU texture into
         CPU memory if needed. Returns original SkImage if decoded in raster bitmap,
         or if encoded in a stream.
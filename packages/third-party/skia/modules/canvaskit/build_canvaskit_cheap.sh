@@ -25,6 +25,13 @@ source "${EMSDK_DIR}/emsdk_env.sh" >/dev/null 2>&1 || true
 
 EMXX="${EMXX:-${EMSDK_DIR}/upstream/emscripten/em++}"
 
+# SIMD=1 compiles the bindings with Wasm SIMD128. Pair it with a Skia build generated with
+# skia_canvaskit_enable_simd=true (compile.sh simd) so the raster pipeline uses it too.
+SIMD_FLAGS=()
+if [[ "${SIMD:-0}" == "1" ]]; then
+  SIMD_FLAGS=(-msimd128)
+fi
+
 if [[ ! -x "${EMXX}" ]]; then
   echo "error: em++ not found or not executable at ${EMXX}" >&2
   echo "hint: ensure EMSDK_DIR points at a valid emsdk checkout and run 'emsdk install' + 'emsdk activate'" >&2
@@ -54,6 +61,7 @@ fi
   -O3 \
   -std=c++20 \
   '-DSK_TRIVIAL_ABI=[[clang::trivial_abi]]' \
+  ${SIMD_FLAGS[@]+"${SIMD_FLAGS[@]}"} \
   -DSK_UNICODE_AVAILABLE \
   -DSK_UNICODE_ICU_IMPLEMENTATION \
   "${BASE_DIR}/src/canvaskit_bindings.cpp" \
@@ -82,7 +90,7 @@ fi
   -sSIDE_MODULE=0 \
   -sMALLOC=none \
   -sERROR_ON_UNDEFINED_SYMBOLS=0 \
-  -sEXPORTED_FUNCTIONS='["_malloc","_free","_SkPathFillType_Winding","_SkPathFillType_EvenOdd","_SkPathFillType_InverseWinding","_SkPathFillType_InverseEvenOdd","_SkPaintStyle_Fill","_SkPaintStyle_Stroke","_SkPaintStyle_StrokeAndFill","_SkFilterMode_Nearest","_SkFilterMode_Linear","_SkMipmapMode_None","_SkMipmapMode_Nearest","_SkMipmapMode_Linear","_SkClipOp_Difference","_SkClipOp_Intersect","_SkTextDirection_LTR","_SkTextDirection_RTL","_SkTextAlign_Left","_SkTextAlign_Right","_SkTextAlign_Center","_SkTextAlign_Justify","_SkTextAlign_Start","_SkTextAlign_End","_MakePaint","_DeletePaint","_Paint_setColor","_Paint_setAntiAlias","_Paint_setStyle","_Paint_setStrokeWidth","_Paint_setStrokeCap","_Paint_setStrokeJoin","_Paint_setAlphaf","_Paint_setBlendMode","_Paint_setShader","_Paint_setColorFilter","_MakePath","_DeletePath","_Path_setFillType","_Path_moveTo","_Path_lineTo","_Path_quadTo","_Path_cubicTo","_Path_close","_Path_reset","_Path_addRect","_Path_addCircle","_Path_addOval","_Path_addRRectXY","_Path_addPolygon","_Path_addArc","_Path_arcToOval","_Path_snapshot","_DeleteSkPath","_Path_transform","_Path_getBounds","_SkPath_getBounds","_MakeCanvasSurface","_MakeSWCanvasSurface","_DeleteSurface","_Surface_getCanvas","_Surface_flush","_Surface_width","_Surface_height","_Surface_makeImageSnapshot","_Surface_encodeToPNG","_Surface_readPixelsRGBA8888","_Canvas_clear","_Canvas_getSaveCount","_Canvas_drawRect","_Canvas_drawPath","_Canvas_drawSkPath","_Canvas_drawCircle","_Canvas_drawOval","_Canvas_drawLine","_Canvas_drawArc","_Canvas_drawPaint","_Canvas_drawImage","_Canvas_drawImageWithPaint","_Canvas_drawImageRect","_Canvas_drawImageRectWithPaint","_Canvas_drawTextBlob","_Canvas_drawParagraph","_Canvas_save","_Canvas_saveLayer","_Canvas_restore","_Canvas_restoreToCount","_Canvas_translate","_Canvas_scale","_Canvas_rotate","_Canvas_concat","_Canvas_setMatrix","_Canvas_clipRect","_DeleteImage","_Image_width","_Image_height","_Image_readPixelsRGBA8888","_Image_encodeToPNG","_MakeImageFromEncoded","_DeleteData","_Data_bytes","_Data_size","_DeleteShader","_MakeColorShader","_MakeLinearGradientShader","_DeleteColorFilter","_MakeBlendColorFilter","_MakeFont","_DeleteFont","_Font_setSize","_Font_setEdging","_MakeTypefaceFromData","_DeleteTypeface","_Font_setTypeface","_DeleteTextBlob","_MakeTextBlobFromText","_MakeParagraphFromText","_MakeParagraphFromTextWithEllipsis","_MakeParagraphBuilder","_MakeParagraphBuilderWithEllipsis","_ParagraphBuilder_pushStyle","_ParagraphBuilder_pop","_ParagraphBuilder_addText","_ParagraphBuilder_build","_DeleteParagraphBuilder","_Paragraph_layout","_Paragraph_getHeight","_Paragraph_getMaxWidth","_Paragraph_getMinIntrinsicWidth","_Paragraph_getMaxIntrinsicWidth","_Paragraph_getLongestLine","_DeleteParagraph"]' \
+  -sEXPORTED_FUNCTIONS='["_malloc","_free","_SkPathFillType_Winding","_SkPathFillType_EvenOdd","_SkPathFillType_InverseWinding","_SkPathFillType_InverseEvenOdd","_SkPaintStyle_Fill","_SkPaintStyle_Stroke","_SkPaintStyle_StrokeAndFill","_SkFilterMode_Nearest","_SkFilterMode_Linear","_SkMipmapMode_None","_SkMipmapMode_Nearest","_SkMipmapMode_Linear","_SkClipOp_Difference","_SkClipOp_Intersect","_SkTextDirection_LTR","_SkTextDirection_RTL","_SkTextAlign_Left","_SkTextAlign_Right","_SkTextAlign_Center","_SkTextAlign_Justify","_SkTextAlign_Start","_SkTextAlign_End","_SkColorType_RGBA8888","_SkColorType_BGRA8888","_SkColorType_RGBA_F16","_MakePaint","_DeletePaint","_Paint_setColor","_Paint_setAntiAlias","_Paint_setStyle","_Paint_setStrokeWidth","_Paint_setStrokeCap","_Paint_setStrokeJoin","_Paint_setAlphaf","_Paint_setBlendMode","_Paint_setShader","_Paint_setColorFilter","_MakePath","_DeletePath","_Path_setFillType","_Path_moveTo","_Path_lineTo","_Path_quadTo","_Path_cubicTo","_Path_close","_Path_reset","_Path_addRect","_Path_addCircle","_Path_addOval","_Path_addRRectXY","_Path_addPolygon","_Path_addArc","_Path_arcToOval","_Path_snapshot","_DeleteSkPath","_Path_transform","_Path_getBounds","_SkPath_getBounds","_SkPath_copy","_SkPath_makeTransform","_SkPath_getGenerationID","_PathMaskCache_getByteLimit","_PathMaskCache_setByteLimit","_PathMaskCache_purge","_PathMaskCache_getStats","_MakeCanvasSurface","_MakeSWCanvasSurface","_MakeSWCanvasSurfaceWrapPixels","_DeleteSurface","_Surface_peekPixels","_Surface_getDamageRect","_Surface_getCanvas","_Surface_flush","_Surface_width","_Surface_height","_Surface_makeImageSnapshot","_Surface_encodeToPNG","_Surface_encode","_Surface_encodeToBuffer","_MakeSurfaceEncoder","_DeleteSurfaceEncoder","_SurfaceEncoder_encodeRows","_SurfaceEncoder_read","_SurfaceEncoder_isDone","_Surface_readPixelsRGBA8888","_Canvas_clear","_Canvas_getSaveCount","_Canvas_drawRect","_Canvas_drawPath","_Canvas_drawSkPath","_Canvas_drawSkPathCached","_Canvas_drawCircle","_Canvas_drawOval","_Canvas_drawLine","_Canvas_drawArc","_Canvas_drawPaint","_Canvas_drawImage","_Canvas_drawImageWithPaint","_Canvas_drawImageRect","_Canvas_drawImageRectWithPaint","_Canvas_drawRects","_Canvas_drawRectsWithColors","_Canvas_drawPoints","_Canvas_drawAtlas","_Canvas_drawTextBlob","_Canvas_drawParagraph","_Canvas_submitCommands","_Canvas_save","_Canvas_saveLayer","_Canvas_restore","_Canvas_restoreToCount","_Canvas_translate","_Canvas_scale","_Canvas_rotate","_Canvas_concat","_Canvas_setMatrix","_Canvas_clipRect","_MakePictureRecorder","_DeletePictureRecorder","_PictureRecorder_begin","_PictureRecorder_finish","_DeletePicture","_Canvas_drawPicture","_Picture_cullRect","_Picture_approximateBytesUsed","_DeleteImage","_Image_width","_Image_height","_Image_readPixelsRGBA8888","_Image_encodeToPNG","_Image_encode","_MakeImageFromEncoded","_MakeImageFromEncodedWithTargetSize","_Graphics_getResourceCacheTotalBytesUsed","_Graphics_getResourceCacheTotalByteLimit","_Graphics_setResourceCacheTotalByteLimit","_Graphics_purgeResourceCache","_DeleteData","_Data_bytes","_Data_size","_DeleteShader","_MakeColorShader","_MakeLinearGradientShader","_DeleteColorFilter","_MakeBlendColorFilter","_MakeFont","_DeleteFont","_Font_setSize","_Font_setEdging","_MakeTypefaceFromData","_DeleteTypeface","_Font_setTypeface","_DeleteTextBlob","_MakeTextBlobFromText","_MakeParagraphFromText","_MakeParagraphFromTextWithEllipsis","_MakeParagraphBuilder","_MakeParagraphBuilderWithEllipsis","_MakeFontRegistry","_DeleteFontRegistry","_FontRegistry_registerFont","_FontRegistry_countFamilies","_FontRegistry_clearCaches","_FontRegistry_serializeGlyphCache","_FontRegistry_preloadGlyphCache","_MakeParagraphFromTextWithRegistry","_MakeParagraphBuilderWithRegistry","_ParagraphBuilder_pushStyle","_ParagraphBuilder_pop","_ParagraphBuilder_addText","_ParagraphBuilder_build","_DeleteParagraphBuilder","_Paragraph_layout","_Paragraph_getHeight","_Paragraph_getMaxWidth","_Paragraph_getMinIntrinsicWidth","_Paragraph_getMaxIntrinsicWidth","_Paragraph_getLongestLine","_Paragraph_getLineMetrics","_Paragraph_getGlyphClusters","_Paragraph_getRectsForRange","_Paragraph_getGlyphPositionsAtCoordinates","_Paragraph_getWordBoundaries","_DeleteParagraph"]' \
   --no-entry \
   -o "${OUT_DIR}/canvaskit.wasm"
 
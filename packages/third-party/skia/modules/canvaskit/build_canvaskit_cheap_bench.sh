@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+
+# Build a native (host) benchmark for the cheap C ABI.
+#
+# Output: $SKIA_DIR/out/canvaskit_cheap_bench/canvaskit_cheap_bench
+#
+# Requirements:
+# - A native Skia static build directory (default: out/Release), e.g.
+#     bin/gn gen out/Release --args='is_official_build=false is_debug=false'
+#     ninja -C out/Release skia skparagraph skshaper skunicode_core skunicode_icu
+
+set -euo pipefail
+
+BASE_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+SKIA_DIR="$(cd "${BASE_DIR}/../.." && pwd)"
+
+SKIA_BUILD_DIR="${SKIA_BUILD_DIR:-${SKIA_DIR}/out/Release}"
+OUT_DIR="${OUT_DIR:-${SKIA_DIR}/out/canvaskit_cheap_bench}"
+mkdir -p "${OUT_DIR}"
+
+CXX="${CXX:-clang++}"
+
+if [[ ! -f "${SKIA_BUILD_DIR}/libskia.a" ]]; then
+  echo "error: libskia.a not found in ${SKIA_BUILD_DIR}" >&2
+  echo "hint: build a native Skia first (see the header of this script)" >&2
+  exit 1
+fi
+
+"${CXX}" \
+  -O3 \
+  -std=c++20 \
+  -DSK_UNICODE_AVAILABLE \
+  -DSK_UNICODE_ICU_IMPLEMENTATION \
+  "${BASE_DIR}/src/canvaskit_bindings.cpp" \
+  "${BASE_DIR}/src/canvaskit_cheap_bench.cpp" \
+  -I"${SKIA_DIR}" \
+  -L"${SKIA_BUILD_DIR}" \
+  -Wl,--start-group \
+  -lskia -lskparagraph -lskshaper -lskunicode_core -lskunicode_icu \
+  -Wl,--end-group \
+  -lpthread -ldl -lfontconfig -lfreetype -lGL \
+  -o "${OUT_DIR}/canvaskit_cheap_bench"
+
+echo "ok: ${OUT_DIR}/canvaskit_cheap_bench"
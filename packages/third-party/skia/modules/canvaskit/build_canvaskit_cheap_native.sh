@@ -0,0 +1,66 @@
+#!/usr/bin/env bash
+
+# Build the cheap C ABI as a native shared library, plus the call-trace replayer.
+#
+# Output: $SKIA_DIR/out/canvaskit_cheap_native/
+#   libcanvaskit_cheap.so      the bindings, for profiling with perf/Instruments/VTune
+#   canvaskit_cheap_replay     replays a trace recorded with CanvasKitApi.startCallTrace()
+#
+# Requirements:
+# - A native Skia static build directory (default: out/ReleasePIC) built as position
+#   independent code so it can be linked into a shared library, e.g.
+#     bin/gn gen out/ReleasePIC --args='is_official_build=false is_debug=false extra_cflags=["-fPIC"]'
+#     ninja -C out/ReleasePIC skia skparagraph skshaper skunicode_core skunicode_icu
+#
+# Set SANITIZE to build with a sanitizer, e.g. SANITIZE=address or SANITIZE=undefined.
+# For meaningful reports Skia itself should be built with the same sanitizer
+# (extra_cflags=["-fPIC", "-fsanitize=address"]).
+
+set -euo pipefail
+
+BASE_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+SKIA_DIR="$(cd "${BASE_DIR}/../.." && pwd)"
+
+SKIA_BUILD_DIR="${SKIA_BUILD_DIR:-${SKIA_DIR}/out/ReleasePIC}"
+OUT_DIR="${OUT_DIR:-${SKIA_DIR}/out/canvaskit_cheap_native}"
+mkdir -p "${OUT_DIR}"
+
+CXX="${CXX:-clang++}"
+
+if [[ ! -f "${SKIA_BUILD_DIR}/libskia.a" ]]; then
+  echo "error: libskia.a not found in ${SKIA_BUILD_DIR}" >&2
+  echo "hint: build a native Skia with -fPIC first (see the header of this script)" >&2
+  exit 1
+fi
+
+FLAGS=(-O2 -g -std=c++20)
+if [[ -n "${SANITIZE:-}" ]]; then
+  FLAGS+=("-fsanitize=${SANITIZE}" -fno-omit-frame-pointer)
+fi
+
+"${CXX}" \
+  "${FLAGS[@]}" \
+  -shared \
+  -fPIC \
+  -DSK_UNICODE_AVAILABLE \
+  -DSK_UNICODE_ICU_IMPLEMENTATION \
+  "${BASE_DIR}/src/canvaskit_bindings.cpp" \
+  -I"${SKIA_DIR}" \
+  -L"${SKIA_BUILD_DIR}" \
+  -Wl,--start-group \
+  -lskia -lskparagraph -lskshaper -lskunicode_core -lskunicode_icu \
+  -Wl,--end-group \
+  -lpthread -ldl -lfontconfig -lfreetype -lGL \
+  -o "${OUT_DIR}/libcanvaskit_cheap.so"
+
+"${CXX}" \
+  "${FLAGS[@]}" \
+  "${BASE_DIR}/src/canvaskit_cheap_replay.cpp" \
+  -I"${SKIA_DIR}" \
+  -L"${OUT_DIR}" \
+  -lcanvaskit_cheap \
+  -Wl,-rpath,'$ORIGIN' \
+  -o "${OUT_DIR}/canvaskit_cheap_replay"
+
+echo "ok: ${OUT_DIR}/libcanvaskit_cheap.so"
+echo "ok: ${OUT_DIR}/canvaskit_cheap_replay"
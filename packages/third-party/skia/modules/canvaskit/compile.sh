@@ -103,6 +103,12 @@ if [[ $@ == *no_canvas* || $@ == *no_matrix* ]]; then
   ENABLE_CANVAS="false"
 fi
 
+ENABLE_SIMD="false"
+if [[ $@ == *simd* ]]; then
+  echo "Building with Wasm SIMD128"
+  ENABLE_SIMD="true"
+fi
+
 GN_FONT="skia_enable_fontmgr_custom_directory=false "
 WOFF2_FONT="skia_use_freetype_woff2=true"
 USE_FREETYPE="true"
@@ -284,6 +290,7 @@ echo "Compiling"
   skia_canvaskit_enable_paragraph=${ENABLE_PARAGRAPH} \
   skia_canvaskit_enable_bidi=${ENABLE_BIDI} \
   skia_canvaskit_enable_webgl=${ENABLE_WEBGL} \
-  skia_canvaskit_enable_webgpu=${ENABLE_WEBGPU}"
+  skia_canvaskit_enable_webgpu=${ENABLE_WEBGPU} \
+  skia_canvaskit_enable_simd=${ENABLE_SIMD}"
 
 ${NINJA} -C ${BUILD_DIR} canvaskit.js -k 10
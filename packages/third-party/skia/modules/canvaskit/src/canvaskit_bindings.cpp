@@ -1,17 +1,25 @@
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
+#include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
 #include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathBuilder.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkSamplingOptions.h"
@@ -22,7 +30,10 @@
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkGradientShader.h"
+#include "include/encode/SkEncoder.h"
+#include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
+#include "include/encode/SkWebpEncoder.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/ganesh/GrDirectContext.h"
 #include "include/gpu/ganesh/SkSurfaceGanesh.h"
@@ -35,17 +46,25 @@
 #include "modules/skparagraph/include/ParagraphBuilder.h"
 #include "modules/skparagraph/include/ParagraphStyle.h"
 #include "modules/skparagraph/include/TextStyle.h"
+#include "modules/skparagraph/include/TypefaceFontProvider.h"
 #include "modules/skunicode/include/SkUnicode.h"
 
+#include "modules/canvaskit/src/canvaskit_cheap_bindings.h"
+
 #if defined(SK_UNICODE_ICU_IMPLEMENTATION)
 #include "modules/skunicode/include/SkUnicode_icu.h"
 #endif
 
 #include <cstddef>
 #include <cstring>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <list>
 #include <memory>
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 extern "C" {
@@ -155,14 +174,28 @@ int SkTextAlign_End() {
   return static_cast<int>(skia::textlayout::TextAlign::kEnd);
 }
 
+int SkColorType_RGBA8888() {
+  return static_cast<int>(kRGBA_8888_SkColorType);
+}
+
+int SkColorType_BGRA8888() {
+  return static_cast<int>(kBGRA_8888_SkColorType);
+}
+
+int SkColorType_RGBA_F16() {
+  return static_cast<int>(kRGBA_F16_SkColorType);
+}
+
+#if defined(__EMSCRIPTEN__)
 // Provided by cheap runtime via WebAssemblyRunner imports.
 void* __libc_malloc(size_t size);
 void __libc_free(void* ptr);
 
 // Emscripten/GL shims may reference malloc/free even when using -sMALLOC=none.
-// We forward them to cheap's allocator.
+// We forward them to cheap's allocator. Native builds keep the system allocator.
 void* malloc(size_t size) { return __libc_malloc(size); }
 void free(void* ptr) { __libc_free(ptr); }
+#endif
 
 }  // extern "C"
 
@@ -170,11 +203,42 @@ namespace {
 
 namespace para = skia::textlayout;
 
+// Long-lived font state shared by every paragraph created from it. Font bytes are
+// parsed once into typefaces owned by the provider, and the single FontCollection
+// keeps its ParagraphCache, typeface lookups and shaper caches warm across paragraphs.
+struct CheapFontRegistry : public SkRefCnt {
+  sk_sp<para::TypefaceFontProvider> provider;
+  sk_sp<para::FontCollection> fontCollection;
+  sk_sp<SkUnicode> unicode;
+  // Every registered typeface, which is what glyph cache snapshots are keyed on.
+  std::vector<sk_sp<SkTypeface>> typefaces;
+  SkString defaultFamily;
+  // Set once a paragraph has been built, after which registering a font must drop
+  // cached family lookups that may have resolved to a fallback.
+  bool hasCachedLookups = false;
+};
+
+// Glyph clusters of a laid-out paragraph, as returned by Paragraph_getGlyphClusters.
+struct CheapGlyphClusters {
+  bool valid = false;
+  std::vector<float> left, top, right, bottom;
+  std::vector<uint32_t> textStart, textEnd, lineNumber;
+};
+
 struct CheapParagraph {
   std::unique_ptr<para::Paragraph> paragraph;
   sk_sp<para::FontCollection> fontCollection;
   sk_sp<SkUnicode> unicode;
   std::vector<sk_sp<SkData>> fontDatas;
+  sk_sp<CheapFontRegistry> registry;
+
+  // The UTF-8 text, kept for the bulk queries. Offset maps and word boundaries are
+  // built on first use; clusters depend on the layout and are reset by Paragraph_layout.
+  std::string text;
+  std::vector<uint32_t> utf16ForUtf8;
+  std::vector<uint32_t> utf8ForUtf16;
+  std::vector<uint32_t> wordBoundaries;
+  CheapGlyphClusters clusters;
 };
 
 struct CheapParagraphBuilder {
@@ -183,6 +247,8 @@ struct CheapParagraphBuilder {
   sk_sp<SkUnicode> unicode;
   std::vector<sk_sp<SkData>> fontDatas;
   SkString family;
+  sk_sp<CheapFontRegistry> registry;
+  std::string text;
 };
 
 sk_sp<SkUnicode> MakeUnicode() {
@@ -193,6 +259,37 @@ sk_sp<SkUnicode> MakeUnicode() {
 #endif
 }
 
+para::TextStyle MakeTextStyle(float fontSize, uint32_t color, const SkString& family) {
+  para::TextStyle ts;
+  ts.setColor(static_cast<SkColor>(color));
+  ts.setFontSize(fontSize);
+  if (!family.isEmpty()) {
+    std::vector<SkString> families;
+    families.push_back(family);
+    ts.setFontFamilies(std::move(families));
+  }
+  return ts;
+}
+
+para::ParagraphStyle MakeParagraphStyle(
+  const para::TextStyle& ts,
+  int textAlign,
+  int maxLines,
+  const char* ellipsisUtf8,
+  int ellipsisByteLength) {
+  para::ParagraphStyle ps;
+  ps.setTextStyle(ts);
+  ps.setTextAlign(static_cast<para::TextAlign>(textAlign));
+  if (maxLines > 0) {
+    ps.setMaxLines(static_cast<size_t>(maxLines));
+  }
+  if (ellipsisUtf8 && ellipsisByteLength > 0) {
+    SkString ellipsis(ellipsisUtf8, static_cast<size_t>(ellipsisByteLength));
+    ps.setEllipsis(ellipsis);
+  }
+  return ps;
+}
+
 sk_sp<const GrGLInterface> gInterface;
 sk_sp<GrDirectContext> gContext;
 
@@ -236,6 +333,617 @@ SkSurface* MakeRasterSurface(int width, int height) {
   return surface.get();
 }
 
+// Decodes through SkAndroidCodec at a fixed sample size, so only the reduced resolution
+// is ever materialized. JPEG sampling maps onto libjpeg-turbo DCT scaling; other formats
+// subsample while decoding. Wrapped with SkImages::DeferredFromGenerator, the decoded
+// pixels live in the budgeted SkResourceCache and are re-decoded on demand if purged.
+class SampledCodecImageGenerator final : public SkImageGenerator {
+ public:
+  static std::unique_ptr<SkImageGenerator> Make(sk_sp<SkData> data, int targetWidth, int targetHeight) {
+    std::unique_ptr<SkAndroidCodec> codec =
+        SkAndroidCodec::MakeFromCodec(SkCodec::MakeFromData(std::move(data)));
+    if (!codec) {
+      return nullptr;
+    }
+
+    int sampleSize = 1;
+    SkISize dims = codec->getInfo().dimensions();
+    if (targetWidth > 0 && targetHeight > 0) {
+      // Smallest supported decode that still covers the target, so the final draw
+      // only ever downsamples.
+      const float scale = std::max(static_cast<float>(targetWidth) / dims.width(),
+                                   static_cast<float>(targetHeight) / dims.height());
+      if (scale < 1) {
+        SkISize desired = SkISize::Make(std::max(1, static_cast<int>(std::ceil(dims.width() * scale))),
+                                        std::max(1, static_cast<int>(std::ceil(dims.height() * scale))));
+        sampleSize = codec->computeSampleSize(&desired);
+        dims = codec->getSampledDimensions(sampleSize);
+      }
+    }
+
+    const SkImageInfo info = SkImageInfo::Make(
+        dims,
+        codec->computeOutputColorType(kN32_SkColorType),
+        codec->computeOutputAlphaType(false),
+        codec->computeOutputColorSpace(kN32_SkColorType));
+    return std::unique_ptr<SkImageGenerator>(
+        new SampledCodecImageGenerator(info, std::move(codec), sampleSize));
+  }
+
+ protected:
+  bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes, const Options&) override {
+    SkAndroidCodec::AndroidOptions options;
+    options.fSampleSize = fSampleSize;
+    const SkCodec::Result r = fCodec->getAndroidPixels(info, pixels, rowBytes, &options);
+    return r == SkCodec::kSuccess || r == SkCodec::kIncompleteInput || r == SkCodec::kErrorInInput;
+  }
+
+ private:
+  SampledCodecImageGenerator(const SkImageInfo& info, std::unique_ptr<SkAndroidCodec> codec, int sampleSize)
+      : SkImageGenerator(info), fCodec(std::move(codec)), fSampleSize(sampleSize) {}
+
+  std::unique_ptr<SkAndroidCodec> fCodec;
+  const int fSampleSize;
+};
+
+// Coverage masks for immutable paths, keyed so that a mask is reused only when it would
+// rasterize to the same pixels: the device translate is split into an integer offset,
+// applied when blitting, and a quarter-pixel phase that is part of the key.
+class PathMaskCache {
+ public:
+  static constexpr int kSubpixelSteps = 4;
+  static constexpr int kMaxMaskDimension = 256;
+
+  struct Key {
+    uint32_t genID;
+    uint32_t flags;  // fill type | style << 2 | cap << 4 | join << 6 | aa << 8 | subpixel << 9
+    float scaleX, skewX, skewY, scaleY;
+    float strokeWidth, miter;
+
+    bool operator==(const Key& o) const {
+      return genID == o.genID && flags == o.flags && scaleX == o.scaleX && skewX == o.skewX &&
+             skewY == o.skewY && scaleY == o.scaleY && strokeWidth == o.strokeWidth &&
+             miter == o.miter;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& k) const {
+      uint32_t words[8];
+      static_assert(sizeof(words) == sizeof(Key), "Key must be tightly packed");
+      std::memcpy(words, &k, sizeof(words));
+      uint32_t h = 2166136261u;
+      for (uint32_t w : words) {
+        h = (h ^ w) * 16777619u;
+      }
+      return h;
+    }
+  };
+
+  struct Mask {
+    sk_sp<SkImage> image;
+    SkIPoint origin;  // mask top-left relative to the integer device translate
+  };
+
+  static PathMaskCache& Get() {
+    static PathMaskCache* gCache = new PathMaskCache;
+    return *gCache;
+  }
+
+  // Returns false if the draw can't be served from a mask; the caller then draws the path.
+  // Masks are drawn as images, so the blend mode and color filter reach every pixel of the
+  // mask's rectangle, covered or not; only SrcOver without a color filter leaves the uncovered
+  // ones alone.
+  bool draw(SkCanvas* canvas, const SkPath& path, const SkPaint& paint) {
+    if (paint.getShader() || paint.getPathEffect() || paint.getMaskFilter() ||
+        paint.getImageFilter() || !paint.isSrcOver() || paint.getColorFilter() ||
+        path.isInverseFillType()) {
+      return false;
+    }
+    const SkMatrix ctm = canvas->getTotalMatrix();
+    if (ctm.hasPerspective() || !ctm.isFinite()) {
+      return false;
+    }
+
+    const float tx = ctm.getTranslateX();
+    const float ty = ctm.getTranslateY();
+    float ix = std::floor(tx);
+    float iy = std::floor(ty);
+    int sx = static_cast<int>(std::lround((tx - ix) * kSubpixelSteps));
+    int sy = static_cast<int>(std::lround((ty - iy) * kSubpixelSteps));
+    if (sx == kSubpixelSteps) {
+      sx = 0;
+      ix += 1;
+    }
+    if (sy == kSubpixelSteps) {
+      sy = 0;
+      iy += 1;
+    }
+    if (!SkIsFinite(ix, iy) || std::fabs(ix) > (1 << 24) || std::fabs(iy) > (1 << 24)) {
+      return false;
+    }
+
+    const bool stroked = paint.getStyle() != SkPaint::kFill_Style;
+    Key key;
+    key.genID = path.getGenerationID();
+    key.flags = static_cast<uint32_t>(path.getFillType()) |
+                static_cast<uint32_t>(paint.getStyle()) << 2 |
+                (stroked ? static_cast<uint32_t>(paint.getStrokeCap()) << 4 |
+                           static_cast<uint32_t>(paint.getStrokeJoin()) << 6
+                         : 0) |
+                (paint.isAntiAlias() ? 1u : 0u) << 8 |
+                static_cast<uint32_t>(sx * kSubpixelSteps + sy) << 9;
+    // Adding +0 folds -0 into +0 so equal keys always hash equally.
+    key.scaleX = ctm.getScaleX() + 0.0f;
+    key.skewX = ctm.getSkewX() + 0.0f;
+    key.skewY = ctm.getSkewY() + 0.0f;
+    key.scaleY = ctm.getScaleY() + 0.0f;
+    key.strokeWidth = stroked ? paint.getStrokeWidth() + 0.0f : 0;
+    key.miter = stroked ? paint.getStrokeMiter() + 0.0f : 0;
+
+    const Mask* mask = this->find(key);
+    if (mask) {
+      fHits++;
+    } else {
+      fMisses++;
+      const SkMatrix local = SkMatrix::MakeAll(key.scaleX, key.skewX, sx / float(kSubpixelSteps),
+                                               key.skewY, key.scaleY, sy / float(kSubpixelSteps),
+                                               0, 0, 1);
+      std::optional<Mask> made = Rasterize(path, paint, local);
+      if (!made) {
+        return false;
+      }
+      mask = this->insert(key, std::move(*made));
+    }
+
+    if (!mask->image) {
+      return true;  // nothing visible
+    }
+    SkPaint blitPaint(paint);
+    blitPaint.setStyle(SkPaint::kFill_Style);
+    blitPaint.setAntiAlias(false);
+    canvas->save();
+    canvas->resetMatrix();
+    // Alpha-only images are drawn with the paint's color, so the mask acts as coverage.
+    canvas->drawImage(mask->image, ix + mask->origin.fX, iy + mask->origin.fY,
+                      SkSamplingOptions(), &blitPaint);
+    canvas->restore();
+    return true;
+  }
+
+  size_t byteLimit() const { return fByteLimit; }
+
+  size_t setByteLimit(size_t bytes) {
+    const size_t prev = fByteLimit;
+    fByteLimit = bytes;
+    this->purgeToLimit();
+    return prev;
+  }
+
+  void purge() {
+    fLRU.clear();
+    fMap.clear();
+    fBytesUsed = 0;
+  }
+
+  void getStats(uint32_t* out4) const {
+    out4[0] = fHits;
+    out4[1] = fMisses;
+    out4[2] = static_cast<uint32_t>(fMap.size());
+    out4[3] = static_cast<uint32_t>(fBytesUsed);
+  }
+
+ private:
+  using Entry = std::pair<Key, Mask>;
+
+  static std::optional<Mask> Rasterize(const SkPath& path, const SkPaint& paint, const SkMatrix& local) {
+    SkRect storage;
+    const SkRect& src = paint.canComputeFastBounds() ? paint.computeFastBounds(path.getBounds(), &storage)
+                                                     : path.getBounds();
+    SkIRect bounds = local.mapRect(src).roundOut().makeOutset(1, 1);
+    if (bounds.width() > kMaxMaskDimension || bounds.height() > kMaxMaskDimension) {
+      return std::nullopt;
+    }
+    if (bounds.isEmpty()) {
+      return Mask{nullptr, {0, 0}};
+    }
+
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(SkImageInfo::MakeA8(bounds.width(), bounds.height()))) {
+      return std::nullopt;
+    }
+    bitmap.eraseColor(SK_ColorTRANSPARENT);
+
+    SkPaint coverage;
+    coverage.setAntiAlias(paint.isAntiAlias());
+    coverage.setStyle(paint.getStyle());
+    coverage.setStrokeWidth(paint.getStrokeWidth());
+    coverage.setStrokeMiter(paint.getStrokeMiter());
+    coverage.setStrokeCap(paint.getStrokeCap());
+    coverage.setStrokeJoin(paint.getStrokeJoin());
+
+    SkCanvas maskCanvas(bitmap);
+    maskCanvas.translate(-bounds.fLeft, -bounds.fTop);
+    maskCanvas.concat(local);
+    maskCanvas.drawPath(path, coverage);
+
+    bitmap.setImmutable();
+    return Mask{bitmap.asImage(), {bounds.fLeft, bounds.fTop}};
+  }
+
+  static size_t MaskBytes(const Mask& mask) {
+    return mask.image ? static_cast<size_t>(mask.image->width()) * mask.image->height() : 0;
+  }
+
+  const Mask* find(const Key& key) {
+    auto it = fMap.find(key);
+    if (it == fMap.end()) {
+      return nullptr;
+    }
+    fLRU.splice(fLRU.begin(), fLRU, it->second);
+    return &it->second->second;
+  }
+
+  const Mask* insert(const Key& key, Mask mask) {
+    fBytesUsed += MaskBytes(mask);
+    fLRU.emplace_front(key, std::move(mask));
+    fMap[key] = fLRU.begin();
+    const Mask* inserted = &fLRU.front().second;
+    this->purgeToLimit();
+    // The newest mask is kept even if it alone exceeds the limit, so the pointer stays valid.
+    return inserted;
+  }
+
+  void purgeToLimit() {
+    while (fBytesUsed > fByteLimit && fLRU.size() > 1) {
+      const Entry& last = fLRU.back();
+      fBytesUsed -= MaskBytes(last.second);
+      fMap.erase(last.first);
+      fLRU.pop_back();
+    }
+  }
+
+  std::list<Entry> fLRU;  // most recently used first
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> fMap;
+  size_t fByteLimit = 2 * 1024 * 1024;
+  size_t fBytesUsed = 0;
+  uint32_t fHits = 0;
+  uint32_t fMisses = 0;
+};
+
+// Per-surface damage tracking for presenting raster surfaces. Pixels are hashed in
+// kTileWidth x kTileHeight tiles and compared against the hashes from the previous
+// query; the surface generation ID short-circuits frames with no draws at all.
+class SurfaceDamageTracker {
+ public:
+  static constexpr int kTileWidth = 64;
+  static constexpr int kTileHeight = 16;
+
+  static std::unordered_map<const SkSurface*, SurfaceDamageTracker>& Trackers() {
+    static auto* gTrackers = new std::unordered_map<const SkSurface*, SurfaceDamageTracker>;
+    return *gTrackers;
+  }
+
+  // Returns the region changed since the previous call (the whole surface on the first
+  // call) and makes the current contents the new baseline.
+  SkIRect update(SkSurface* surface) {
+    const SkIRect all = SkIRect::MakeWH(surface->width(), surface->height());
+    SkPixmap pixmap;
+    if (!surface->peekPixels(&pixmap)) {
+      fHashes.clear();
+      return all;
+    }
+
+    const uint32_t genID = surface->generationID();
+    const int tilesX = (pixmap.width() + kTileWidth - 1) / kTileWidth;
+    const int tilesY = (pixmap.height() + kTileHeight - 1) / kTileHeight;
+    const bool hasBaseline = fTilesX == tilesX && fTilesY == tilesY &&
+                             fHashes.size() == static_cast<size_t>(tilesX) * tilesY;
+    if (hasBaseline && genID == fGenID) {
+      return SkIRect::MakeEmpty();
+    }
+
+    fGenID = genID;
+    fTilesX = tilesX;
+    fTilesY = tilesY;
+    fHashes.resize(static_cast<size_t>(tilesX) * tilesY);
+
+    SkIRect damage = hasBaseline ? SkIRect::MakeEmpty() : all;
+    const size_t bpp = pixmap.info().bytesPerPixel();
+    for (int ty = 0; ty < tilesY; ty++) {
+      const int y0 = ty * kTileHeight;
+      const int y1 = std::min(y0 + kTileHeight, pixmap.height());
+      for (int tx = 0; tx < tilesX; tx++) {
+        const int x0 = tx * kTileWidth;
+        const int x1 = std::min(x0 + kTileWidth, pixmap.width());
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (int y = y0; y < y1; y++) {
+          h = HashBytes(h, static_cast<const uint8_t*>(pixmap.addr(x0, y)), (x1 - x0) * bpp);
+        }
+        uint64_t& slot = fHashes[static_cast<size_t>(ty) * tilesX + tx];
+        if (hasBaseline && slot != h) {
+          damage.join(SkIRect::MakeLTRB(x0, y0, x1, y1));
+        }
+        slot = h;
+      }
+    }
+    return damage;
+  }
+
+ private:
+  static uint64_t HashBytes(uint64_t h, const uint8_t* p, size_t n) {
+    constexpr uint64_t kMul = 0x9e3779b97f4a7c15ull;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+      uint64_t v;
+      std::memcpy(&v, p + i, sizeof(v));
+      h = (h ^ v) * kMul;
+      h ^= h >> 29;
+    }
+    for (; i < n; i++) {
+      h = (h ^ p[i]) * kMul;
+    }
+    return h;
+  }
+
+  uint32_t fGenID = 0;
+  int fTilesX = 0;
+  int fTilesY = 0;
+  std::vector<uint64_t> fHashes;
+};
+
+// Encoding for Surface_encode*/Image_encode. format: 0 PNG, 1 JPEG, 2 WebP lossy,
+// 3 WebP lossless.
+struct EncodeParams {
+  int format;
+  int quality;      // JPEG/WebP, [0, 100]
+  int zlibLevel;    // PNG, [0, 9]; negative selects the zlib default
+  int filterFlags;  // PNG, SkPngEncoder::FilterFlag bits; 0 selects kNone
+};
+
+bool ValidEncodeFormat(int format) {
+  return format >= 0 && format <= 3;
+}
+
+SkPngEncoder::Options ToPngOptions(const EncodeParams& params) {
+  SkPngEncoder::Options options;
+  options.fFilterFlags = params.filterFlags > 0
+                             ? static_cast<SkPngEncoder::FilterFlag>(params.filterFlags & 0xF8)
+                             : SkPngEncoder::FilterFlag::kNone;
+  if (params.zlibLevel >= 0) {
+    options.fZLibLevel = std::min(params.zlibLevel, 9);
+  }
+  return options;
+}
+
+SkJpegEncoder::Options ToJpegOptions(const EncodeParams& params) {
+  SkJpegEncoder::Options options;
+  options.fQuality = std::clamp(params.quality, 0, 100);
+  return options;
+}
+
+bool EncodePixmap(SkWStream* dst, const SkPixmap& src, const EncodeParams& params) {
+  switch (params.format) {
+    case 0:
+      return SkPngEncoder::Encode(dst, src, ToPngOptions(params));
+    case 1:
+      return SkJpegEncoder::Encode(dst, src, ToJpegOptions(params));
+    case 2:
+    case 3: {
+      SkWebpEncoder::Options options;
+      options.fCompression = params.format == 3 ? SkWebpEncoder::Compression::kLossless
+                                                : SkWebpEncoder::Compression::kLossy;
+      options.fQuality = static_cast<float>(std::clamp(params.quality, 0, 100));
+      return SkWebpEncoder::Encode(dst, src, options);
+    }
+    default:
+      return false;
+  }
+}
+
+// Row-incremental encoder, or nullptr for formats that only encode whole images (WebP).
+std::unique_ptr<SkEncoder> MakeRowEncoder(SkWStream* dst, const SkPixmap& src, const EncodeParams& params) {
+  switch (params.format) {
+    case 0:
+      return SkPngEncoder::Make(dst, src, ToPngOptions(params));
+    case 1:
+      return SkJpegEncoder::Make(dst, src, ToJpegOptions(params));
+    default:
+      return nullptr;
+  }
+}
+
+// Points `pixmap` at the surface's own pixels when it has them; otherwise reads back
+// into `owned`. Encoders accept any N32 layout, so no conversion is needed.
+bool PeekOrReadSurfacePixels(SkSurface* surface, SkPixmap* pixmap, std::unique_ptr<uint8_t[]>* owned) {
+  if (surface->peekPixels(pixmap)) {
+    return true;
+  }
+  const SkImageInfo info = SkImageInfo::MakeN32Premul(surface->width(), surface->height());
+  const size_t rowBytes = info.minRowBytes();
+  const size_t byteSize = info.computeByteSize(rowBytes);
+  if (byteSize == 0 || SkImageInfo::ByteSizeOverflowed(byteSize)) {
+    return false;
+  }
+  owned->reset(new uint8_t[byteSize]);
+  *pixmap = SkPixmap(info, owned->get(), rowBytes);
+  return surface->readPixels(*pixmap, 0, 0);
+}
+
+// Writes into a caller-owned buffer. Once full, keeps counting so the caller learns the
+// size it needs.
+class FixedBufferWStream final : public SkWStream {
+ public:
+  FixedBufferWStream(void* dst, size_t capacity)
+      : fDst(static_cast<uint8_t*>(dst)), fCapacity(capacity) {}
+
+  bool write(const void* buffer, size_t size) override {
+    if (fWritten + size <= fCapacity) {
+      std::memcpy(fDst + fWritten, buffer, size);
+    } else {
+      fOverflowed = true;
+    }
+    fWritten += size;
+    return true;
+  }
+
+  size_t bytesWritten() const override { return fWritten; }
+  bool overflowed() const { return fOverflowed; }
+
+ private:
+  uint8_t* fDst;
+  size_t fCapacity;
+  size_t fWritten = 0;
+  bool fOverflowed = false;
+};
+
+// Pending encoded bytes for SurfaceEncoder, drained by SurfaceEncoder_read().
+class ChunkWStream final : public SkWStream {
+ public:
+  bool write(const void* buffer, size_t size) override {
+    const uint8_t* bytes = static_cast<const uint8_t*>(buffer);
+    fPending.insert(fPending.end(), bytes, bytes + size);
+    fWritten += size;
+    return true;
+  }
+
+  size_t bytesWritten() const override { return fWritten; }
+  size_t pending() const { return fPending.size() - fReadOffset; }
+
+  size_t read(void* dst, size_t capacity) {
+    const size_t n = std::min(capacity, this->pending());
+    std::memcpy(dst, fPending.data() + fReadOffset, n);
+    fReadOffset += n;
+    if (fReadOffset == fPending.size()) {
+      fPending.clear();
+      fReadOffset = 0;
+    }
+    return n;
+  }
+
+ private:
+  std::vector<uint8_t> fPending;
+  size_t fReadOffset = 0;
+  size_t fWritten = 0;
+};
+
+// State behind a SurfaceEncoder handle. Members are ordered so the encoder, which keeps a
+// reference to `pixmap` and `stream`, is destroyed first.
+struct CheapSurfaceEncoder {
+  sk_sp<SkSurface> surface;
+  std::unique_ptr<uint8_t[]> owned;
+  SkPixmap pixmap;
+  EncodeParams params;
+  ChunkWStream stream;
+  std::unique_ptr<SkEncoder> encoder;
+  int rowsEncoded = 0;
+  bool failed = false;
+};
+
+// UTF-8 -> UTF-16 offsets, as ParagraphImpl maps them: every byte of a code point maps to
+// the code point's first UTF-16 unit, and the map has a trailing entry for the text end.
+void EnsureUtf16Mapping(CheapParagraph* p) {
+  if (!p->utf16ForUtf8.empty()) {
+    return;
+  }
+  const std::string& text = p->text;
+  p->utf16ForUtf8.reserve(text.size() + 1);
+  uint32_t utf16 = 0;
+  size_t i = 0;
+  while (i < text.size()) {
+    const uint8_t lead = static_cast<uint8_t>(text[i]);
+    const size_t length = std::min<size_t>(
+        lead < 0xC0 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4, text.size() - i);
+    p->utf16ForUtf8.insert(p->utf16ForUtf8.end(), length, utf16);
+    utf16 += length == 4 ? 2 : 1;
+    i += length;
+  }
+  p->utf16ForUtf8.push_back(utf16);
+}
+
+uint32_t Utf16Index(const CheapParagraph& p, uint32_t utf8) {
+  return p.utf16ForUtf8[std::min<size_t>(utf8, p.utf16ForUtf8.size() - 1)];
+}
+
+const std::vector<uint32_t>& EnsureWordBoundaries(CheapParagraph* p) {
+  if (!p->wordBoundaries.empty()) {
+    return p->wordBoundaries;
+  }
+  EnsureUtf16Mapping(p);
+  const uint32_t length = p->utf16ForUtf8.back();
+
+  // SkUnicode::getWords reports UTF-16 positions, as used by Paragraph::getWordBoundary.
+  std::vector<SkUnicode::Position> words;
+  if (p->unicode && !p->text.empty()) {
+    p->unicode->getWords(p->text.c_str(), SkToInt(p->text.size()), nullptr, &words);
+  }
+  p->wordBoundaries.push_back(0);
+  for (SkUnicode::Position word : words) {
+    const uint32_t offset = static_cast<uint32_t>(std::clamp<SkUnicode::Position>(word, 0, length));
+    if (offset > p->wordBoundaries.back()) {
+      p->wordBoundaries.push_back(offset);
+    }
+  }
+  if (p->wordBoundaries.back() != length) {
+    p->wordBoundaries.push_back(length);
+  }
+  return p->wordBoundaries;
+}
+
+// Collects glyph clusters from Paragraph::extendedVisit. A cluster spans from its first
+// glyph's position to the next cluster in the run (or the run's end) and covers its line's
+// ascent and descent; its text ends where the next cluster in logical order starts.
+const CheapGlyphClusters& EnsureGlyphClusters(CheapParagraph* p) {
+  CheapGlyphClusters& c = p->clusters;
+  if (c.valid) {
+    return c;
+  }
+  EnsureUtf16Mapping(p);
+
+  std::vector<para::LineMetrics> lines;
+  p->paragraph->getLineMetrics(lines);
+
+  p->paragraph->extendedVisit([&](int lineNumber, const para::Paragraph::ExtendedVisitorInfo* info) {
+    if (!info || info->count <= 0 || !info->utf8Starts) {
+      return;
+    }
+    float top = 0;
+    float bottom = 0;
+    if (lineNumber >= 0 && static_cast<size_t>(lineNumber) < lines.size()) {
+      const para::LineMetrics& m = lines[lineNumber];
+      top = static_cast<float>(m.fBaseline - m.fAscent);
+      bottom = static_cast<float>(m.fBaseline + m.fDescent);
+    }
+    const float runRight = info->origin.fX + info->positions[0].fX + info->advance.width();
+    for (int i = 0; i < info->count;) {
+      int next = i + 1;
+      while (next < info->count && info->utf8Starts[next] == info->utf8Starts[i]) {
+        next++;
+      }
+      c.left.push_back(info->origin.fX + info->positions[i].fX);
+      c.right.push_back(next < info->count ? info->origin.fX + info->positions[next].fX : runRight);
+      c.top.push_back(top);
+      c.bottom.push_back(bottom);
+      c.textStart.push_back(info->utf8Starts[i]);
+      c.lineNumber.push_back(static_cast<uint32_t>(lineNumber));
+      i = next;
+    }
+  });
+
+  std::vector<uint32_t> starts = c.textStart;
+  std::sort(starts.begin(), starts.end());
+  starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+  c.textEnd.resize(c.textStart.size());
+  for (size_t i = 0; i < c.textStart.size(); i++) {
+    auto next = std::upper_bound(starts.begin(), starts.end(), c.textStart[i]);
+    const uint32_t end = next != starts.end() ? *next : static_cast<uint32_t>(p->text.size());
+    c.textEnd[i] = Utf16Index(*p, end);
+    c.textStart[i] = Utf16Index(*p, c.textStart[i]);
+  }
+  c.valid = true;
+  return c;
+}
+
 SkFilterMode ToFilterMode(int filterMode) {
   // 0: nearest, 1: linear
   return filterMode == 1 ? SkFilterMode::kLinear : SkFilterMode::kNearest;
@@ -296,8 +1004,8 @@ void Paint_setColor(void* paint, uint32_t color) {
   static_cast<SkPaint*>(paint)->setColor(color);
 }
 
-void Paint_setAntiAlias(void* paint, bool aa) {
-  static_cast<SkPaint*>(paint)->setAntiAlias(aa);
+void Paint_setAntiAlias(void* paint, int aa) {
+  static_cast<SkPaint*>(paint)->setAntiAlias(aa != 0);
 }
 
 void Paint_setStyle(void* paint, int style) {
@@ -365,10 +1073,64 @@ void* MakeSWCanvasSurface(int width, int height) {
   return MakeRasterSurface(width, height);
 }
 
+// Raster surface drawing straight into caller-owned pixels (premultiplied). The memory
+// must outlive the surface. Caller must DeleteSurface().
+void* MakeSWCanvasSurfaceWrapPixels(void* pixels, int width, int height, int rowBytes, int colorType) {
+  if (!pixels || width <= 0 || height <= 0 || rowBytes <= 0) {
+    return nullptr;
+  }
+  const SkColorType ct = static_cast<SkColorType>(colorType);
+  if (ct != kRGBA_8888_SkColorType && ct != kBGRA_8888_SkColorType && ct != kRGBA_F16_SkColorType) {
+    return nullptr;
+  }
+  const SkImageInfo info = SkImageInfo::Make(width, height, ct, kPremul_SkAlphaType);
+  if (!info.validRowBytes(static_cast<size_t>(rowBytes))) {
+    return nullptr;
+  }
+  sk_sp<SkSurface> surface = SkSurfaces::WrapPixels(info, pixels, static_cast<size_t>(rowBytes));
+  if (!surface) {
+    return nullptr;
+  }
+  SkSafeRef(surface.get());
+  return surface.get();
+}
+
 void DeleteSurface(void* surface) {
+  SurfaceDamageTracker::Trackers().erase(static_cast<SkSurface*>(surface));
   SkSafeUnref(static_cast<SkSurface*>(surface));
 }
 
+// Address of the surface's pixels for hosts that present straight from Skia's memory,
+// or nullptr for GPU surfaces. Writes the row stride to outRowBytes when non-null.
+void* Surface_peekPixels(void* surface, int* outRowBytes) {
+  if (!surface) {
+    return nullptr;
+  }
+  SkPixmap pixmap;
+  if (!static_cast<SkSurface*>(surface)->peekPixels(&pixmap)) {
+    return nullptr;
+  }
+  if (outRowBytes) {
+    *outRowBytes = static_cast<int>(pixmap.rowBytes());
+  }
+  return pixmap.writable_addr();
+}
+
+// Writes the pixel bounds changed since the previous call (the whole surface on the
+// first call) to outLTRB4 and returns 1, or returns 0 if nothing changed.
+int Surface_getDamageRect(void* surface, int* outLTRB4) {
+  if (!surface || !outLTRB4) {
+    return 0;
+  }
+  SkSurface* s = static_cast<SkSurface*>(surface);
+  const SkIRect damage = SurfaceDamageTracker::Trackers()[s].update(s);
+  outLTRB4[0] = damage.fLeft;
+  outLTRB4[1] = damage.fTop;
+  outLTRB4[2] = damage.fRight;
+  outLTRB4[3] = damage.fBottom;
+  return damage.isEmpty() ? 0 : 1;
+}
+
 void* Surface_getCanvas(void* surface) {
   return static_cast<SkSurface*>(surface)->getCanvas();
 }
@@ -398,38 +1160,28 @@ void* Surface_makeImageSnapshot(void* surface) {
 
 // Encodes the surface pixels as PNG and returns a SkData*. Caller must DeleteData().
 void* Surface_encodeToPNG(void* surface) {
-  if (!surface) {
+  return Surface_encode(surface, 0, 100, -1, 0);
+}
+
+// Encodes straight from the surface's pixels (no intermediate copy for raster surfaces)
+// and returns a SkData*. Caller must DeleteData().
+void* Surface_encode(void* surface, int format, int quality, int zlibLevel, int filterFlags) {
+  if (!surface || !ValidEncodeFormat(format)) {
     return nullptr;
   }
   SkSurface* s = static_cast<SkSurface*>(surface);
-  const int w = s->width();
-  const int h = s->height();
-  if (w <= 0 || h <= 0) {
+  if (s->width() <= 0 || s->height() <= 0) {
     return nullptr;
   }
 
   SkPixmap pixmap;
   std::unique_ptr<uint8_t[]> owned;
-
-  // Prefer native pixmap (typically N32 premul) when available.
-  if (!s->peekPixels(&pixmap)) {
-    SkImageInfo info = SkImageInfo::MakeN32Premul(w, h);
-    const size_t rowBytes = info.minRowBytes();
-    const size_t byteSize = info.computeByteSize(rowBytes);
-    if (byteSize == 0) {
-      return nullptr;
-    }
-    owned.reset(new uint8_t[byteSize]);
-    pixmap = SkPixmap(info, owned.get(), rowBytes);
-    if (!s->readPixels(pixmap, 0, 0)) {
-      return nullptr;
-    }
+  if (!PeekOrReadSurfacePixels(s, &pixmap, &owned)) {
+    return nullptr;
   }
 
   SkDynamicMemoryWStream stream;
-  SkPngEncoder::Options options;
-  options.fFilterFlags = SkPngEncoder::FilterFlag::kNone;
-  if (!SkPngEncoder::Encode(&stream, pixmap, options)) {
+  if (!EncodePixmap(&stream, pixmap, {format, quality, zlibLevel, filterFlags})) {
     return nullptr;
   }
 
@@ -441,6 +1193,112 @@ void* Surface_encodeToPNG(void* surface) {
   return data.get();
 }
 
+// Encodes into dst. Returns the encoded size, 0 on failure, or -(required size) if
+// dstCapacity was too small (retry with a buffer at least that large).
+int Surface_encodeToBuffer(
+  void* surface,
+  int format,
+  int quality,
+  int zlibLevel,
+  int filterFlags,
+  void* dst,
+  int dstCapacity) {
+  if (!surface || !ValidEncodeFormat(format) || dstCapacity < 0 || (!dst && dstCapacity > 0)) {
+    return 0;
+  }
+  SkSurface* s = static_cast<SkSurface*>(surface);
+  if (s->width() <= 0 || s->height() <= 0) {
+    return 0;
+  }
+
+  SkPixmap pixmap;
+  std::unique_ptr<uint8_t[]> owned;
+  if (!PeekOrReadSurfacePixels(s, &pixmap, &owned)) {
+    return 0;
+  }
+
+  FixedBufferWStream stream(dst, static_cast<size_t>(dstCapacity));
+  if (!EncodePixmap(&stream, pixmap, {format, quality, zlibLevel, filterFlags}) ||
+      stream.bytesWritten() > static_cast<size_t>(INT32_MAX)) {
+    return 0;
+  }
+  const int written = static_cast<int>(stream.bytesWritten());
+  return stream.overflowed() ? -written : written;
+}
+
+// Chunked encoding: rows are encoded on demand and the output is drained with
+// SurfaceEncoder_read(), so only one chunk of output is buffered at a time. The surface
+// must not be drawn to until the encoder is deleted. Caller must DeleteSurfaceEncoder().
+void* MakeSurfaceEncoder(void* surface, int format, int quality, int zlibLevel, int filterFlags) {
+  if (!surface || !ValidEncodeFormat(format)) {
+    return nullptr;
+  }
+  SkSurface* s = static_cast<SkSurface*>(surface);
+  if (s->width() <= 0 || s->height() <= 0) {
+    return nullptr;
+  }
+
+  auto enc = std::make_unique<CheapSurfaceEncoder>();
+  enc->surface = sk_ref_sp(s);
+  enc->params = {format, quality, zlibLevel, filterFlags};
+  if (!PeekOrReadSurfacePixels(s, &enc->pixmap, &enc->owned)) {
+    return nullptr;
+  }
+  enc->encoder = MakeRowEncoder(&enc->stream, enc->pixmap, enc->params);
+  if (!enc->encoder && (format == 0 || format == 1)) {
+    return nullptr;
+  }
+  return enc.release();
+}
+
+void DeleteSurfaceEncoder(void* encoder) {
+  delete static_cast<CheapSurfaceEncoder*>(encoder);
+}
+
+// Encodes up to `rows` more rows (formats without row-incremental encoding, i.e. WebP,
+// encode the whole image on the first call). Returns the number of encoded bytes waiting
+// to be read, or -1 on failure.
+int SurfaceEncoder_encodeRows(void* encoder, int rows) {
+  if (!encoder || rows <= 0) {
+    return -1;
+  }
+  CheapSurfaceEncoder* enc = static_cast<CheapSurfaceEncoder*>(encoder);
+  const int height = enc->pixmap.height();
+  if (!enc->failed && enc->rowsEncoded < height) {
+    if (enc->encoder) {
+      enc->failed = !enc->encoder->encodeRows(rows);
+      enc->rowsEncoded = std::min(height, enc->rowsEncoded + rows);
+    } else {
+      enc->failed = !EncodePixmap(&enc->stream, enc->pixmap, enc->params);
+      enc->rowsEncoded = height;
+    }
+  }
+  if (enc->failed) {
+    return -1;
+  }
+  return static_cast<int>(std::min<size_t>(enc->stream.pending(), INT32_MAX));
+}
+
+// Copies up to dstCapacity pending bytes into dst and returns the number copied.
+int SurfaceEncoder_read(void* encoder, void* dst, int dstCapacity) {
+  if (!encoder || !dst || dstCapacity <= 0) {
+    return 0;
+  }
+  CheapSurfaceEncoder* enc = static_cast<CheapSurfaceEncoder*>(encoder);
+  return static_cast<int>(enc->stream.read(dst, static_cast<size_t>(dstCapacity)));
+}
+
+// Returns 1 once every row has been encoded and all output has been read.
+int SurfaceEncoder_isDone(void* encoder) {
+  if (!encoder) {
+    return 1;
+  }
+  CheapSurfaceEncoder* enc = static_cast<CheapSurfaceEncoder*>(encoder);
+  return enc->failed || (enc->rowsEncoded >= enc->pixmap.height() && enc->stream.pending() == 0)
+             ? 1
+             : 0;
+}
+
 // Read RGBA pixels into caller-provided buffer (dst). Returns 1 on success.
 int Surface_readPixelsRGBA8888(
   void* surface,
@@ -596,12 +1454,12 @@ void Canvas_clipRect(
   float right,
   float bottom,
   int clipOp,
-  bool doAA) {
+  int doAA) {
   if (!canvas) {
     return;
   }
   const SkRect rect = SkRect::MakeLTRB(left, top, right, bottom);
-  static_cast<SkCanvas*>(canvas)->clipRect(rect, static_cast<SkClipOp>(clipOp), doAA);
+  static_cast<SkCanvas*>(canvas)->clipRect(rect, static_cast<SkClipOp>(clipOp), doAA != 0);
 }
 
 void Canvas_drawImage(void* canvas, void* image, float x, float y, int filterMode, int mipmapMode) {
@@ -676,16 +1534,176 @@ void Canvas_drawImageRectWithPaint(
   if (!canvas || !image) {
     return;
   }
-  const SkRect src = SkRect::MakeLTRB(srcLeft, srcTop, srcRight, srcBottom);
-  const SkRect dst = SkRect::MakeLTRB(dstLeft, dstTop, dstRight, dstBottom);
-  SkSamplingOptions sampling(ToFilterMode(filterMode), ToMipmapMode(mipmapMode));
-  static_cast<SkCanvas*>(canvas)->drawImageRect(
-    static_cast<SkImage*>(image),
-    src,
-    dst,
-    sampling,
-    static_cast<SkPaint*>(paint),
-    SkCanvas::kFast_SrcRectConstraint);
+  const SkRect src = SkRect::MakeLTRB(srcLeft, srcTop, srcRight, srcBottom);
+  const SkRect dst = SkRect::MakeLTRB(dstLeft, dstTop, dstRight, dstBottom);
+  SkSamplingOptions sampling(ToFilterMode(filterMode), ToMipmapMode(mipmapMode));
+  static_cast<SkCanvas*>(canvas)->drawImageRect(
+    static_cast<SkImage*>(image),
+    src,
+    dst,
+    sampling,
+    static_cast<SkPaint*>(paint),
+    SkCanvas::kFast_SrcRectConstraint);
+}
+
+// Bulk draws. Arrays are tightly packed floats, as handed over from JS typed arrays.
+static_assert(sizeof(SkRect) == 4 * sizeof(float), "SkRect must be four packed floats");
+static_assert(sizeof(SkRSXform) == 4 * sizeof(float), "SkRSXform must be four packed floats");
+static_assert(sizeof(SkPoint) == 2 * sizeof(float), "SkPoint must be two packed floats");
+
+void Canvas_drawRects(void* canvas, const float* ltrb, int count, void* paint) {
+  if (!canvas || !ltrb || count <= 0 || !paint) {
+    return;
+  }
+  SkCanvas* c = static_cast<SkCanvas*>(canvas);
+  const SkPaint& p = *static_cast<SkPaint*>(paint);
+  const SkRect* rects = reinterpret_cast<const SkRect*>(ltrb);
+  for (int i = 0; i < count; i++) {
+    c->drawRect(rects[i], p);
+  }
+}
+
+// Per-rect colors (unpremultiplied ARGB) replace the paint color; everything else in
+// `paint` applies to every rect.
+void Canvas_drawRectsWithColors(void* canvas, const float* ltrb, const uint32_t* colors, int count, void* paint) {
+  if (!canvas || !ltrb || !colors || count <= 0 || !paint) {
+    return;
+  }
+  SkCanvas* c = static_cast<SkCanvas*>(canvas);
+  SkPaint p(*static_cast<SkPaint*>(paint));
+  const SkRect* rects = reinterpret_cast<const SkRect*>(ltrb);
+  for (int i = 0; i < count; i++) {
+    p.setColor(static_cast<SkColor>(colors[i]));
+    c->drawRect(rects[i], p);
+  }
+}
+
+// mode: 0 points, 1 lines (pairs), 2 polygon. `xy` holds count points.
+void Canvas_drawPoints(void* canvas, int mode, const float* xy, int count, void* paint) {
+  if (!canvas || !xy || count <= 0 || !paint || mode < 0 || mode > 2) {
+    return;
+  }
+  static_cast<SkCanvas*>(canvas)->drawPoints(
+    static_cast<SkCanvas::PointMode>(mode),
+    {reinterpret_cast<const SkPoint*>(xy), static_cast<size_t>(count)},
+    *static_cast<SkPaint*>(paint));
+}
+
+// rsxforms: [scos, ssin, tx, ty] per sprite; texRects: [l, t, r, b] per sprite in the atlas;
+// colors (optional): ARGB per sprite, combined with the sprite using blendMode.
+// cullLTRB4 (optional) bounds all sprites for quick rejection.
+void Canvas_drawAtlas(
+  void* canvas,
+  void* image,
+  const float* rsxforms,
+  const float* texRects,
+  const uint32_t* colors,
+  int count,
+  int blendMode,
+  int filterMode,
+  int mipmapMode,
+  const float* cullLTRB4,
+  void* paint) {
+  if (!canvas || !image || !rsxforms || !texRects || count <= 0) {
+    return;
+  }
+  const size_t n = static_cast<size_t>(count);
+  SkRect cull;
+  if (cullLTRB4) {
+    cull = SkRect::MakeLTRB(cullLTRB4[0], cullLTRB4[1], cullLTRB4[2], cullLTRB4[3]);
+  }
+  static_cast<SkCanvas*>(canvas)->drawAtlas(
+    static_cast<SkImage*>(image),
+    {reinterpret_cast<const SkRSXform*>(rsxforms), n},
+    {reinterpret_cast<const SkRect*>(texRects), n},
+    {reinterpret_cast<const SkColor*>(colors), colors ? n : 0},
+    static_cast<SkBlendMode>(blendMode),
+    SkSamplingOptions(ToFilterMode(filterMode), ToMipmapMode(mipmapMode)),
+    cullLTRB4 ? &cull : nullptr,
+    static_cast<SkPaint*>(paint));
+}
+
+// Picture
+void* MakePictureRecorder() {
+  return new SkPictureRecorder();
+}
+
+void DeletePictureRecorder(void* recorder) {
+  delete static_cast<SkPictureRecorder*>(recorder);
+}
+
+// Starts recording and returns the recording canvas (owned by the recorder).
+// With useRTree, the finished picture carries an R-tree so playback only visits the
+// ops that intersect the destination clip.
+void* PictureRecorder_begin(
+  void* recorder,
+  float left,
+  float top,
+  float right,
+  float bottom,
+  int useRTree) {
+  if (!recorder) {
+    return nullptr;
+  }
+  const SkRect bounds = SkRect::MakeLTRB(left, top, right, bottom);
+  SkRTreeFactory factory;
+  return static_cast<SkPictureRecorder*>(recorder)->beginRecording(
+      bounds, useRTree ? &factory : nullptr);
+}
+
+// Finishes recording. Caller must DeletePicture().
+void* PictureRecorder_finish(void* recorder) {
+  if (!recorder) {
+    return nullptr;
+  }
+  sk_sp<SkPicture> picture = static_cast<SkPictureRecorder*>(recorder)->finishRecordingAsPicture();
+  if (!picture) {
+    return nullptr;
+  }
+  SkSafeRef(picture.get());
+  return picture.get();
+}
+
+void DeletePicture(void* picture) {
+  SkSafeUnref(static_cast<SkPicture*>(picture));
+}
+
+// m9 and paint may be null.
+void Canvas_drawPicture(void* canvas, void* picture, const float* m9, void* paint) {
+  if (!canvas || !picture) {
+    return;
+  }
+  const SkMatrix matrix = MatrixFromPtr(m9);
+  static_cast<SkCanvas*>(canvas)->drawPicture(
+    static_cast<SkPicture*>(picture),
+    m9 ? &matrix : nullptr,
+    static_cast<SkPaint*>(paint));
+}
+
+void Picture_cullRect(void* picture, float* outLTRB4) {
+  if (!outLTRB4) {
+    return;
+  }
+  if (!picture) {
+    outLTRB4[0] = 0;
+    outLTRB4[1] = 0;
+    outLTRB4[2] = 0;
+    outLTRB4[3] = 0;
+    return;
+  }
+
+  const SkRect r = static_cast<SkPicture*>(picture)->cullRect();
+  outLTRB4[0] = r.fLeft;
+  outLTRB4[1] = r.fTop;
+  outLTRB4[2] = r.fRight;
+  outLTRB4[3] = r.fBottom;
+}
+
+int Picture_approximateBytesUsed(void* picture) {
+  if (!picture) {
+    return 0;
+  }
+  return static_cast<int>(static_cast<SkPicture*>(picture)->approximateBytesUsed());
 }
 
 // Image
@@ -771,6 +1789,45 @@ void* Image_encodeToPNG(void* image) {
   return data.get();
 }
 
+// Like Surface_encode(): raster images are encoded from their own pixels, others are read
+// back once. Caller must DeleteData().
+void* Image_encode(void* image, int format, int quality, int zlibLevel, int filterFlags) {
+  if (!image || !ValidEncodeFormat(format)) {
+    return nullptr;
+  }
+  SkImage* img = static_cast<SkImage*>(image);
+  if (img->width() <= 0 || img->height() <= 0) {
+    return nullptr;
+  }
+
+  SkPixmap pixmap;
+  std::unique_ptr<uint8_t[]> owned;
+  if (!img->peekPixels(&pixmap)) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(img->width(), img->height());
+    const size_t rowBytes = info.minRowBytes();
+    const size_t byteSize = info.computeByteSize(rowBytes);
+    if (byteSize == 0 || SkImageInfo::ByteSizeOverflowed(byteSize)) {
+      return nullptr;
+    }
+    owned.reset(new uint8_t[byteSize]);
+    pixmap = SkPixmap(info, owned.get(), rowBytes);
+    if (!img->readPixels(pixmap, 0, 0)) {
+      return nullptr;
+    }
+  }
+
+  SkDynamicMemoryWStream stream;
+  if (!EncodePixmap(&stream, pixmap, {format, quality, zlibLevel, filterFlags})) {
+    return nullptr;
+  }
+  sk_sp<SkData> data = stream.detachAsData();
+  if (!data) {
+    return nullptr;
+  }
+  SkSafeRef(data.get());
+  return data.get();
+}
+
 // Decodes an encoded image (png/jpg/webp...) from bytes. Caller must DeleteImage().
 void* MakeImageFromEncoded(const void* bytes, int size) {
   if (!bytes || size <= 0) {
@@ -815,6 +1872,53 @@ void* MakeImageFromEncoded(const void* bytes, int size) {
   return img.get();
 }
 
+// Decodes lazily at the smallest resolution that covers targetWidth x targetHeight
+// (aspect ratio preserved; pass 0 for full resolution). Nothing is decoded until the
+// image is first drawn or read. Image_width/height report the sampled size.
+// Caller must DeleteImage().
+void* MakeImageFromEncodedWithTargetSize(const void* bytes, int size, int targetWidth, int targetHeight) {
+  if (!bytes || size <= 0) {
+    return nullptr;
+  }
+  sk_sp<SkData> data = SkData::MakeWithCopy(bytes, static_cast<size_t>(size));
+  if (!data) {
+    return nullptr;
+  }
+
+  std::unique_ptr<SkImageGenerator> generator =
+      SampledCodecImageGenerator::Make(std::move(data), targetWidth, targetHeight);
+  if (!generator) {
+    return nullptr;
+  }
+  sk_sp<SkImage> img = SkImages::DeferredFromGenerator(std::move(generator));
+  if (!img) {
+    return nullptr;
+  }
+  SkSafeRef(img.get());
+  return img.get();
+}
+
+// Resource cache (holds decoded pixels of lazy images, among others).
+int Graphics_getResourceCacheTotalBytesUsed() {
+  return static_cast<int>(SkGraphics::GetResourceCacheTotalBytesUsed());
+}
+
+int Graphics_getResourceCacheTotalByteLimit() {
+  return static_cast<int>(SkGraphics::GetResourceCacheTotalByteLimit());
+}
+
+// Returns the previous limit.
+int Graphics_setResourceCacheTotalByteLimit(int bytes) {
+  if (bytes < 0) {
+    return Graphics_getResourceCacheTotalByteLimit();
+  }
+  return static_cast<int>(SkGraphics::SetResourceCacheTotalByteLimit(static_cast<size_t>(bytes)));
+}
+
+void Graphics_purgeResourceCache() {
+  SkGraphics::PurgeResourceCache();
+}
+
 void DeleteData(void* data) {
   SkSafeUnref(static_cast<SkData*>(data));
 }
@@ -1069,6 +2173,7 @@ void* MakeParagraphFromText(
   }
 
   handle->paragraph = std::move(paragraph);
+  handle->text.assign(utf8, static_cast<size_t>(byteLength));
   handle->fontCollection = std::move(fontCollection);
   handle->unicode = std::move(unicode);
   return handle.release();
@@ -1157,6 +2262,7 @@ void* MakeParagraphFromTextWithEllipsis(
   }
 
   handle->paragraph = std::move(paragraph);
+  handle->text.assign(utf8, static_cast<size_t>(byteLength));
   handle->fontCollection = std::move(fontCollection);
   handle->unicode = std::move(unicode);
   return handle.release();
@@ -1289,6 +2395,200 @@ void* MakeParagraphBuilderWithEllipsis(
   return handle.release();
 }
 
+// FontRegistry
+void* MakeFontRegistry() {
+  sk_sp<CheapFontRegistry> registry = sk_make_sp<CheapFontRegistry>();
+  registry->unicode = MakeUnicode();
+  if (!registry->unicode) {
+    return nullptr;
+  }
+  registry->provider = sk_make_sp<para::TypefaceFontProvider>();
+  registry->fontCollection = sk_make_sp<para::FontCollection>();
+  registry->fontCollection->setDefaultFontManager(registry->provider);
+  registry->fontCollection->enableFontFallback();
+  return registry.release();
+}
+
+void DeleteFontRegistry(void* registry) {
+  SkSafeUnref(static_cast<CheapFontRegistry*>(registry));
+}
+
+// Parses font bytes once and registers the typeface under its own family name, or
+// under `familyUtf8` when provided. Returns 1 on success.
+int FontRegistry_registerFont(
+  void* registry,
+  const void* bytes,
+  int size,
+  int ttcIndex,
+  const char* familyUtf8,
+  int familyByteLength) {
+  if (!registry || !bytes || size <= 0) {
+    return 0;
+  }
+  auto* r = static_cast<CheapFontRegistry*>(registry);
+
+  sk_sp<SkData> data = SkData::MakeWithCopy(bytes, static_cast<size_t>(size));
+  if (!data) {
+    return 0;
+  }
+  std::array<sk_sp<SkData>, 1> fonts = {data};
+  sk_sp<SkFontMgr> mgr = SkFontMgr_New_Custom_Data(SkSpan(fonts));
+  if (!mgr) {
+    return 0;
+  }
+  sk_sp<SkTypeface> tf = mgr->makeFromData(std::move(data), ttcIndex);
+  if (!tf) {
+    return 0;
+  }
+
+  r->typefaces.push_back(tf);
+
+  SkString family;
+  if (familyUtf8 && familyByteLength > 0) {
+    family.set(familyUtf8, static_cast<size_t>(familyByteLength));
+    r->provider->registerTypeface(std::move(tf), family);
+  } else {
+    tf->getFamilyName(&family);
+    r->provider->registerTypeface(std::move(tf));
+  }
+
+  if (r->defaultFamily.isEmpty()) {
+    r->defaultFamily = family;
+  }
+  if (r->hasCachedLookups) {
+    r->fontCollection->clearCaches();
+    r->hasCachedLookups = false;
+  }
+  return 1;
+}
+
+int FontRegistry_countFamilies(void* registry) {
+  if (!registry) {
+    return 0;
+  }
+  return static_cast<CheapFontRegistry*>(registry)->provider->countFamilies();
+}
+
+// Drops cached paragraph layouts, typeface lookups and shaper state. Registered fonts
+// are kept. Useful under memory pressure.
+void FontRegistry_clearCaches(void* registry) {
+  if (!registry) {
+    return;
+  }
+  auto* r = static_cast<CheapFontRegistry*>(registry);
+  r->fontCollection->clearCaches();
+  r->hasCachedLookups = false;
+}
+
+// Snapshots the glyph images rasterized so far with the registry's fonts. Returns an SkData
+// (DeleteData()) to store and pass to FontRegistry_preloadGlyphCache() on a later start, or
+// null when nothing has been rasterized.
+void* FontRegistry_serializeGlyphCache(void* registry) {
+  if (!registry) {
+    return nullptr;
+  }
+  auto* r = static_cast<CheapFontRegistry*>(registry);
+  sk_sp<SkData> snapshot = SkGraphics::SerializeFontCache(SkSpan(r->typefaces));
+  return snapshot.release();
+}
+
+// Loads a snapshot from FontRegistry_serializeGlyphCache() into the glyph cache. Only
+// entries whose font data matches a registered font are used, so register the fonts first.
+// Returns the number of strikes loaded; 0 for a snapshot from another Skia milestone or a
+// corrupt one.
+int FontRegistry_preloadGlyphCache(void* registry, const void* bytes, int size) {
+  if (!registry || !bytes || size <= 0) {
+    return 0;
+  }
+  auto* r = static_cast<CheapFontRegistry*>(registry);
+  sk_sp<SkData> snapshot = SkData::MakeWithoutCopy(bytes, static_cast<size_t>(size));
+  return SkGraphics::PreloadFontCache(*snapshot, SkSpan(r->typefaces));
+}
+
+// Same as MakeParagraphFromTextWithEllipsis, but resolves fonts through a shared
+// FontRegistry instead of per-paragraph font bytes. Pass ellipsisByteLength = 0 for none.
+void* MakeParagraphFromTextWithRegistry(
+  void* registry,
+  const char* utf8,
+  int byteLength,
+  float fontSize,
+  float wrapWidth,
+  uint32_t color,
+  int textAlign,
+  int maxLines,
+  const char* ellipsisUtf8,
+  int ellipsisByteLength) {
+  if (!registry || !utf8 || byteLength <= 0) {
+    return nullptr;
+  }
+  auto* r = static_cast<CheapFontRegistry*>(registry);
+
+  para::TextStyle ts = MakeTextStyle(fontSize, color, r->defaultFamily);
+  para::ParagraphStyle ps =
+      MakeParagraphStyle(ts, textAlign, maxLines, ellipsisUtf8, ellipsisByteLength);
+
+  std::unique_ptr<para::ParagraphBuilder> builder =
+      para::ParagraphBuilder::make(ps, r->fontCollection, r->unicode);
+  if (!builder) {
+    return nullptr;
+  }
+
+  builder->pushStyle(ts);
+  builder->addText(utf8, static_cast<size_t>(byteLength));
+  std::unique_ptr<para::Paragraph> paragraph = builder->Build();
+  if (!paragraph) {
+    return nullptr;
+  }
+  r->hasCachedLookups = true;
+
+  if (wrapWidth > 0) {
+    paragraph->layout(wrapWidth);
+  }
+
+  std::unique_ptr<CheapParagraph> handle = std::make_unique<CheapParagraph>();
+  handle->paragraph = std::move(paragraph);
+  handle->text.assign(utf8, static_cast<size_t>(byteLength));
+  handle->fontCollection = r->fontCollection;
+  handle->unicode = r->unicode;
+  handle->registry = sk_ref_sp(r);
+  return handle.release();
+}
+
+// Same as MakeParagraphBuilderWithEllipsis, but resolves fonts through a shared
+// FontRegistry. Pass ellipsisByteLength = 0 for none.
+void* MakeParagraphBuilderWithRegistry(
+  void* registry,
+  float fontSize,
+  uint32_t color,
+  int textAlign,
+  int maxLines,
+  const char* ellipsisUtf8,
+  int ellipsisByteLength) {
+  if (!registry) {
+    return nullptr;
+  }
+  auto* r = static_cast<CheapFontRegistry*>(registry);
+
+  std::unique_ptr<CheapParagraphBuilder> handle = std::make_unique<CheapParagraphBuilder>();
+  handle->registry = sk_ref_sp(r);
+  handle->fontCollection = r->fontCollection;
+  handle->unicode = r->unicode;
+  handle->family = r->defaultFamily;
+
+  para::TextStyle ts = MakeTextStyle(fontSize, color, handle->family);
+  para::ParagraphStyle ps =
+      MakeParagraphStyle(ts, textAlign, maxLines, ellipsisUtf8, ellipsisByteLength);
+
+  handle->builder = para::ParagraphBuilder::make(ps, handle->fontCollection, handle->unicode);
+  if (!handle->builder) {
+    return nullptr;
+  }
+  r->hasCachedLookups = true;
+
+  handle->builder->pushStyle(ts);
+  return handle.release();
+}
+
 void ParagraphBuilder_pushStyle(void* builder, float fontSize, uint32_t color) {
   if (!builder) return;
   auto* b = static_cast<CheapParagraphBuilder*>(builder);
@@ -1317,6 +2617,7 @@ void ParagraphBuilder_addText(void* builder, const char* utf8, int byteLength) {
   auto* b = static_cast<CheapParagraphBuilder*>(builder);
   if (!b->builder) return;
   b->builder->addText(utf8, static_cast<size_t>(byteLength));
+  b->text.append(utf8, static_cast<size_t>(byteLength));
 }
 
 void* ParagraphBuilder_build(void* builder, float wrapWidth) {
@@ -1332,9 +2633,11 @@ void* ParagraphBuilder_build(void* builder, float wrapWidth) {
 
   std::unique_ptr<CheapParagraph> handle = std::make_unique<CheapParagraph>();
   handle->paragraph = std::move(paragraph);
+  handle->text = std::move(b->text);
   handle->fontCollection = std::move(b->fontCollection);
   handle->unicode = std::move(b->unicode);
   handle->fontDatas = std::move(b->fontDatas);
+  handle->registry = std::move(b->registry);
   return handle.release();
 }
 
@@ -1347,6 +2650,7 @@ void Paragraph_layout(void* paragraph, float width) {
   auto* p = static_cast<CheapParagraph*>(paragraph);
   if (!p->paragraph) return;
   p->paragraph->layout(width);
+  p->clusters = CheapGlyphClusters();
 }
 
 float Paragraph_getHeight(void* paragraph) {
@@ -1384,6 +2688,120 @@ float Paragraph_getLongestLine(void* paragraph) {
   return p->paragraph->getLongestLine();
 }
 
+int Paragraph_getLineMetrics(void* paragraph, float* outMetrics, int capacity) {
+  if (!paragraph) return 0;
+  auto* p = static_cast<CheapParagraph*>(paragraph);
+  if (!p->paragraph) return 0;
+
+  std::vector<para::LineMetrics> lines;
+  p->paragraph->getLineMetrics(lines);
+  const int count = SkToInt(lines.size());
+  if (!outMetrics) return count;
+
+  const int n = std::min(count, std::max(capacity, 0));
+  for (int i = 0; i < n; i++) {
+    const para::LineMetrics& m = lines[i];
+    float* out = outMetrics + i * CheapParagraph_LineMetricsStride;
+    out[0] = static_cast<float>(m.fStartIndex);
+    out[1] = static_cast<float>(m.fEndIndex);
+    out[2] = static_cast<float>(m.fEndExcludingWhitespaces);
+    out[3] = static_cast<float>(m.fEndIncludingNewline);
+    out[4] = m.fHardBreak ? 1.0f : 0.0f;
+    out[5] = static_cast<float>(m.fAscent);
+    out[6] = static_cast<float>(m.fDescent);
+    out[7] = static_cast<float>(m.fHeight);
+    out[8] = static_cast<float>(m.fWidth);
+    out[9] = static_cast<float>(m.fLeft);
+    out[10] = static_cast<float>(m.fBaseline);
+    out[11] = static_cast<float>(m.fLineNumber);
+  }
+  return count;
+}
+
+int Paragraph_getGlyphClusters(void* paragraph, float* outBounds, uint32_t* outInfo, int capacity) {
+  if (!paragraph) return 0;
+  auto* p = static_cast<CheapParagraph*>(paragraph);
+  if (!p->paragraph) return 0;
+
+  const CheapGlyphClusters& c = EnsureGlyphClusters(p);
+  const int count = SkToInt(c.left.size());
+  const size_t n = static_cast<size_t>(std::min(count, std::max(capacity, 0)));
+  const size_t plane = static_cast<size_t>(std::max(capacity, 0));
+  if (outBounds && n) {
+    std::copy_n(c.left.data(), n, outBounds);
+    std::copy_n(c.top.data(), n, outBounds + plane);
+    std::copy_n(c.right.data(), n, outBounds + plane * 2);
+    std::copy_n(c.bottom.data(), n, outBounds + plane * 3);
+  }
+  if (outInfo && n) {
+    std::copy_n(c.textStart.data(), n, outInfo);
+    std::copy_n(c.textEnd.data(), n, outInfo + plane);
+    std::copy_n(c.lineNumber.data(), n, outInfo + plane * 2);
+  }
+  return count;
+}
+
+int Paragraph_getRectsForRange(
+  void* paragraph,
+  int start,
+  int end,
+  int heightStyle,
+  int widthStyle,
+  float* outBoxes,
+  int capacity) {
+  if (!paragraph || start < 0 || end <= start) return 0;
+  auto* p = static_cast<CheapParagraph*>(paragraph);
+  if (!p->paragraph) return 0;
+
+  const int h = std::clamp(heightStyle, 0, static_cast<int>(para::RectHeightStyle::kStrut));
+  const int w = std::clamp(widthStyle, 0, static_cast<int>(para::RectWidthStyle::kMax));
+  const std::vector<para::TextBox> boxes = p->paragraph->getRectsForRange(
+      static_cast<unsigned>(start),
+      static_cast<unsigned>(end),
+      static_cast<para::RectHeightStyle>(h),
+      static_cast<para::RectWidthStyle>(w));
+  const int count = SkToInt(boxes.size());
+  if (!outBoxes) return count;
+
+  const int n = std::min(count, std::max(capacity, 0));
+  for (int i = 0; i < n; i++) {
+    float* out = outBoxes + i * CheapParagraph_TextBoxStride;
+    out[0] = boxes[i].rect.fLeft;
+    out[1] = boxes[i].rect.fTop;
+    out[2] = boxes[i].rect.fRight;
+    out[3] = boxes[i].rect.fBottom;
+    out[4] = static_cast<float>(boxes[i].direction);
+  }
+  return count;
+}
+
+int Paragraph_getGlyphPositionsAtCoordinates(void* paragraph, const float* xy, int count, int32_t* outPositions) {
+  if (!paragraph || !xy || !outPositions || count <= 0) return 0;
+  auto* p = static_cast<CheapParagraph*>(paragraph);
+  if (!p->paragraph) return 0;
+
+  for (int i = 0; i < count; i++) {
+    const para::PositionWithAffinity hit =
+        p->paragraph->getGlyphPositionAtCoordinate(xy[i * 2], xy[i * 2 + 1]);
+    outPositions[i * 2] = hit.position;
+    outPositions[i * 2 + 1] = static_cast<int32_t>(hit.affinity);
+  }
+  return count;
+}
+
+int Paragraph_getWordBoundaries(void* paragraph, uint32_t* outOffsets, int capacity) {
+  if (!paragraph) return 0;
+  auto* p = static_cast<CheapParagraph*>(paragraph);
+  if (!p->paragraph) return 0;
+
+  const std::vector<uint32_t>& words = EnsureWordBoundaries(p);
+  const int count = SkToInt(words.size());
+  if (outOffsets) {
+    std::copy_n(words.data(), std::min(count, std::max(capacity, 0)), outOffsets);
+  }
+  return count;
+}
+
 void Canvas_drawParagraph(void* canvas, void* paragraph, float x, float y) {
   if (!canvas || !paragraph) return;
   auto* p = static_cast<CheapParagraph*>(paragraph);
@@ -1567,4 +2985,450 @@ void SkPath_getBounds(void* skPath, float* outLTRB4) {
   outLTRB4[3] = r.fBottom;
 }
 
+// New handle sharing the same SkPathData (and generation ID). Caller must DeleteSkPath().
+void* SkPath_copy(void* skPath) {
+  if (!skPath) {
+    return nullptr;
+  }
+  return new SkPath(*static_cast<SkPath*>(skPath));
+}
+
+// Transforms into a new handle, leaving the source untouched. Identity matrices share
+// the source's data. Caller must DeleteSkPath().
+void* SkPath_makeTransform(void* skPath, const float* m9) {
+  if (!skPath) {
+    return nullptr;
+  }
+  return new SkPath(static_cast<SkPath*>(skPath)->makeTransform(MatrixFromPtr(m9)));
+}
+
+uint32_t SkPath_getGenerationID(void* skPath) {
+  if (!skPath) {
+    return 0;
+  }
+  return static_cast<SkPath*>(skPath)->getGenerationID();
+}
+
+void Canvas_drawSkPathCached(void* canvas, void* skPath, void* paint) {
+  if (!canvas || !skPath || !paint) {
+    return;
+  }
+  SkCanvas* c = static_cast<SkCanvas*>(canvas);
+  const SkPath& p = *static_cast<SkPath*>(skPath);
+  const SkPaint& pt = *static_cast<SkPaint*>(paint);
+  if (!PathMaskCache::Get().draw(c, p, pt)) {
+    c->drawPath(p, pt);
+  }
+}
+
+int PathMaskCache_getByteLimit() {
+  return static_cast<int>(std::min<size_t>(PathMaskCache::Get().byteLimit(), INT32_MAX));
+}
+
+int PathMaskCache_setByteLimit(int bytes) {
+  const size_t prev = PathMaskCache::Get().setByteLimit(static_cast<size_t>(std::max(bytes, 0)));
+  return static_cast<int>(std::min<size_t>(prev, INT32_MAX));
+}
+
+void PathMaskCache_purge() {
+  PathMaskCache::Get().purge();
+}
+
+void PathMaskCache_getStats(uint32_t* out4) {
+  if (!out4) {
+    return;
+  }
+  PathMaskCache::Get().getStats(out4);
+}
+
+}  // extern "C"
+
+namespace {
+
+// Sequential reader over a Canvas_submitCommands() word stream. Callers validate the
+// command's word count before reading its arguments, so reads never run past the end.
+class CommandReader {
+ public:
+  CommandReader(const uint8_t* data, size_t words) : fData(data), fWords(words) {}
+
+  size_t remaining() const { return fWords - fPos; }
+
+  uint32_t u32() {
+    uint32_t v;
+    std::memcpy(&v, fData + fPos * 4, sizeof(v));
+    fPos++;
+    return v;
+  }
+
+  int i32() { return static_cast<int>(this->u32()); }
+
+  float f32() {
+    float v;
+    std::memcpy(&v, fData + fPos * 4, sizeof(v));
+    fPos++;
+    return v;
+  }
+
+  void* handle() {
+    const uint64_t lo = this->u32();
+    const uint64_t hi = this->u32();
+    return reinterpret_cast<void*>(static_cast<uintptr_t>((hi << 32) | lo));
+  }
+
+  void matrix(float m9[9]) {
+    for (int i = 0; i < 9; i++) {
+      m9[i] = this->f32();
+    }
+  }
+
+  void skip(size_t words) { fPos += words; }
+
+ private:
+  const uint8_t* fData;
+  size_t fWords;
+  size_t fPos = 0;
+};
+
+// Total word count (header included) of each opcode, or 0 for unknown opcodes.
+constexpr size_t CommandWordCount(uint32_t op) {
+  switch (op) {
+    case CheapCommand_Clear: return 2;
+    case CheapCommand_Save: return 1;
+    case CheapCommand_SaveLayer: return 8;
+    case CheapCommand_Restore: return 1;
+    case CheapCommand_RestoreToCount: return 2;
+    case CheapCommand_Translate: return 3;
+    case CheapCommand_Scale: return 3;
+    case CheapCommand_Rotate: return 2;
+    case CheapCommand_Concat: return 10;
+    case CheapCommand_SetMatrix: return 10;
+    case CheapCommand_ClipRect: return 7;
+    case CheapCommand_DrawRect: return 7;
+    case CheapCommand_DrawPath: return 5;
+    case CheapCommand_DrawSkPath: return 5;
+    case CheapCommand_DrawCircle: return 6;
+    case CheapCommand_DrawLine: return 7;
+    case CheapCommand_DrawOval: return 7;
+    case CheapCommand_DrawArc: return 10;
+    case CheapCommand_DrawPaint: return 3;
+    case CheapCommand_DrawImage: return 9;
+    case CheapCommand_DrawImageRect: return 15;
+    case CheapCommand_DrawTextBlob: return 7;
+    case CheapCommand_DrawParagraph: return 5;
+    case CheapCommand_DrawPicture: return 5;
+    case CheapCommand_DrawSkPathCached: return 5;
+
+    case CheapCommand_PaintSetColor: return 4;
+    case CheapCommand_PaintSetAntiAlias: return 4;
+    case CheapCommand_PaintSetStyle: return 4;
+    case CheapCommand_PaintSetStrokeWidth: return 4;
+    case CheapCommand_PaintSetStrokeCap: return 4;
+    case CheapCommand_PaintSetStrokeJoin: return 4;
+    case CheapCommand_PaintSetAlphaf: return 4;
+    case CheapCommand_PaintSetBlendMode: return 4;
+    case CheapCommand_PaintSetShader: return 5;
+    case CheapCommand_PaintSetColorFilter: return 5;
+
+    case CheapCommand_PathSetFillType: return 4;
+    case CheapCommand_PathMoveTo: return 5;
+    case CheapCommand_PathLineTo: return 5;
+    case CheapCommand_PathQuadTo: return 7;
+    case CheapCommand_PathCubicTo: return 9;
+    case CheapCommand_PathClose: return 3;
+    case CheapCommand_PathReset: return 3;
+    case CheapCommand_PathAddRect: return 7;
+    case CheapCommand_PathAddCircle: return 6;
+    case CheapCommand_PathAddOval: return 9;
+    case CheapCommand_PathAddRRectXY: return 11;
+    case CheapCommand_PathAddArc: return 9;
+    case CheapCommand_PathArcToOval: return 10;
+    default: return 0;
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+// Replays a command stream (see canvaskit_cheap_bindings.h for the layout).
+// Paint and path commands are dispatched through the same entry points as the
+// per-call ABI, so both paths behave identically.
+int Canvas_submitCommands(void* canvas, const uint8_t* buf, int len) {
+  if (!canvas || !buf || len <= 0) {
+    return 0;
+  }
+
+  CommandReader r(buf, static_cast<size_t>(len) / 4);
+  int executed = 0;
+  while (r.remaining() > 0) {
+    const uint32_t header = r.u32();
+    const uint32_t op = header & 0xffff;
+    const size_t words = header >> 16;
+    if (words == 0 || words != CommandWordCount(op) || words - 1 > r.remaining()) {
+      break;
+    }
+
+    switch (op) {
+      case CheapCommand_Clear: {
+        const uint32_t color = r.u32();
+        Canvas_clear(canvas, color);
+        break;
+      }
+      case CheapCommand_Save:
+        Canvas_save(canvas);
+        break;
+      case CheapCommand_SaveLayer: {
+        const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+        const int hasBounds = r.i32();
+        void* paint = r.handle();
+        Canvas_saveLayer(canvas, l, t, rt, b, hasBounds, paint);
+        break;
+      }
+      case CheapCommand_Restore:
+        Canvas_restore(canvas);
+        break;
+      case CheapCommand_RestoreToCount:
+        Canvas_restoreToCount(canvas, r.i32());
+        break;
+      case CheapCommand_Translate: {
+        const float dx = r.f32(), dy = r.f32();
+        Canvas_translate(canvas, dx, dy);
+        break;
+      }
+      case CheapCommand_Scale: {
+        const float sx = r.f32(), sy = r.f32();
+        Canvas_scale(canvas, sx, sy);
+        break;
+      }
+      case CheapCommand_Rotate:
+        Canvas_rotate(canvas, r.f32());
+        break;
+      case CheapCommand_Concat:
+      case CheapCommand_SetMatrix: {
+        float m9[9];
+        r.matrix(m9);
+        if (op == CheapCommand_Concat) {
+          Canvas_concat(canvas, m9);
+        } else {
+          Canvas_setMatrix(canvas, m9);
+        }
+        break;
+      }
+      case CheapCommand_ClipRect: {
+        const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+        const int clipOp = r.i32();
+        const int doAA = r.i32();
+        Canvas_clipRect(canvas, l, t, rt, b, clipOp, doAA);
+        break;
+      }
+      case CheapCommand_DrawRect: {
+        const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+        void* paint = r.handle();
+        if (paint) {
+          Canvas_drawRect(canvas, l, t, rt, b, paint);
+        }
+        break;
+      }
+      case CheapCommand_DrawPath: {
+        void* path = r.handle();
+        void* paint = r.handle();
+        if (path && paint) {
+          Canvas_drawPath(canvas, path, paint);
+        }
+        break;
+      }
+      case CheapCommand_DrawSkPath: {
+        void* skPath = r.handle();
+        void* paint = r.handle();
+        Canvas_drawSkPath(canvas, skPath, paint);
+        break;
+      }
+      case CheapCommand_DrawCircle: {
+        const float cx = r.f32(), cy = r.f32(), radius = r.f32();
+        void* paint = r.handle();
+        if (paint) {
+          Canvas_drawCircle(canvas, cx, cy, radius, paint);
+        }
+        break;
+      }
+      case CheapCommand_DrawLine: {
+        const float x0 = r.f32(), y0 = r.f32(), x1 = r.f32(), y1 = r.f32();
+        void* paint = r.handle();
+        if (paint) {
+          Canvas_drawLine(canvas, x0, y0, x1, y1, paint);
+        }
+        break;
+      }
+      case CheapCommand_DrawOval: {
+        const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+        Canvas_drawOval(canvas, l, t, rt, b, r.handle());
+        break;
+      }
+      case CheapCommand_DrawArc: {
+        const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+        const float start = r.f32(), sweep = r.f32();
+        const int useCenter = r.i32();
+        Canvas_drawArc(canvas, l, t, rt, b, start, sweep, useCenter, r.handle());
+        break;
+      }
+      case CheapCommand_DrawPaint:
+        Canvas_drawPaint(canvas, r.handle());
+        break;
+      case CheapCommand_DrawImage: {
+        void* image = r.handle();
+        const float x = r.f32(), y = r.f32();
+        const int filterMode = r.i32();
+        const int mipmapMode = r.i32();
+        Canvas_drawImageWithPaint(canvas, image, x, y, filterMode, mipmapMode, r.handle());
+        break;
+      }
+      case CheapCommand_DrawImageRect: {
+        void* image = r.handle();
+        const float sl = r.f32(), st = r.f32(), sr = r.f32(), sb = r.f32();
+        const float dl = r.f32(), dt = r.f32(), dr = r.f32(), db = r.f32();
+        const int filterMode = r.i32();
+        const int mipmapMode = r.i32();
+        Canvas_drawImageRectWithPaint(
+            canvas, image, sl, st, sr, sb, dl, dt, dr, db, filterMode, mipmapMode, r.handle());
+        break;
+      }
+      case CheapCommand_DrawTextBlob: {
+        void* blob = r.handle();
+        const float x = r.f32(), y = r.f32();
+        Canvas_drawTextBlob(canvas, blob, x, y, r.handle());
+        break;
+      }
+      case CheapCommand_DrawParagraph: {
+        void* paragraph = r.handle();
+        const float x = r.f32(), y = r.f32();
+        Canvas_drawParagraph(canvas, paragraph, x, y);
+        break;
+      }
+      case CheapCommand_DrawPicture: {
+        void* picture = r.handle();
+        Canvas_drawPicture(canvas, picture, nullptr, r.handle());
+        break;
+      }
+      case CheapCommand_DrawSkPathCached: {
+        void* skPath = r.handle();
+        void* paint = r.handle();
+        Canvas_drawSkPathCached(canvas, skPath, paint);
+        break;
+      }
+
+      case CheapCommand_PaintSetColor:
+      case CheapCommand_PaintSetAntiAlias:
+      case CheapCommand_PaintSetStyle:
+      case CheapCommand_PaintSetStrokeWidth:
+      case CheapCommand_PaintSetStrokeCap:
+      case CheapCommand_PaintSetStrokeJoin:
+      case CheapCommand_PaintSetAlphaf:
+      case CheapCommand_PaintSetBlendMode:
+      case CheapCommand_PaintSetShader:
+      case CheapCommand_PaintSetColorFilter: {
+        void* paint = r.handle();
+        if (!paint) {
+          r.skip(words - 3);
+          break;
+        }
+        switch (op) {
+          case CheapCommand_PaintSetColor: Paint_setColor(paint, r.u32()); break;
+          case CheapCommand_PaintSetAntiAlias: Paint_setAntiAlias(paint, r.i32()); break;
+          case CheapCommand_PaintSetStyle: Paint_setStyle(paint, r.i32()); break;
+          case CheapCommand_PaintSetStrokeWidth: Paint_setStrokeWidth(paint, r.f32()); break;
+          case CheapCommand_PaintSetStrokeCap: Paint_setStrokeCap(paint, r.i32()); break;
+          case CheapCommand_PaintSetStrokeJoin: Paint_setStrokeJoin(paint, r.i32()); break;
+          case CheapCommand_PaintSetAlphaf: Paint_setAlphaf(paint, r.f32()); break;
+          case CheapCommand_PaintSetBlendMode: Paint_setBlendMode(paint, r.i32()); break;
+          case CheapCommand_PaintSetShader: Paint_setShader(paint, r.handle()); break;
+          case CheapCommand_PaintSetColorFilter: Paint_setColorFilter(paint, r.handle()); break;
+        }
+        break;
+      }
+
+      default: {
+        // Path (builder) commands.
+        void* path = r.handle();
+        if (!path) {
+          r.skip(words - 3);
+          break;
+        }
+        switch (op) {
+          case CheapCommand_PathSetFillType:
+            Path_setFillType(path, r.i32());
+            break;
+          case CheapCommand_PathMoveTo: {
+            const float x = r.f32(), y = r.f32();
+            Path_moveTo(path, x, y);
+            break;
+          }
+          case CheapCommand_PathLineTo: {
+            const float x = r.f32(), y = r.f32();
+            Path_lineTo(path, x, y);
+            break;
+          }
+          case CheapCommand_PathQuadTo: {
+            const float x1 = r.f32(), y1 = r.f32(), x2 = r.f32(), y2 = r.f32();
+            Path_quadTo(path, x1, y1, x2, y2);
+            break;
+          }
+          case CheapCommand_PathCubicTo: {
+            const float x1 = r.f32(), y1 = r.f32(), x2 = r.f32(), y2 = r.f32();
+            const float x3 = r.f32(), y3 = r.f32();
+            Path_cubicTo(path, x1, y1, x2, y2, x3, y3);
+            break;
+          }
+          case CheapCommand_PathClose:
+            Path_close(path);
+            break;
+          case CheapCommand_PathReset:
+            Path_reset(path);
+            break;
+          case CheapCommand_PathAddRect: {
+            const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+            Path_addRect(path, l, t, rt, b);
+            break;
+          }
+          case CheapCommand_PathAddCircle: {
+            const float cx = r.f32(), cy = r.f32(), radius = r.f32();
+            Path_addCircle(path, cx, cy, radius);
+            break;
+          }
+          case CheapCommand_PathAddOval: {
+            const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+            const int dir = r.i32();
+            const int startIndex = r.i32();
+            Path_addOval(path, l, t, rt, b, dir, startIndex);
+            break;
+          }
+          case CheapCommand_PathAddRRectXY: {
+            const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+            const float rx = r.f32(), ry = r.f32();
+            const int dir = r.i32();
+            const int startIndex = r.i32();
+            Path_addRRectXY(path, l, t, rt, b, rx, ry, dir, startIndex);
+            break;
+          }
+          case CheapCommand_PathAddArc: {
+            const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+            const float start = r.f32(), sweep = r.f32();
+            Path_addArc(path, l, t, rt, b, start, sweep);
+            break;
+          }
+          case CheapCommand_PathArcToOval: {
+            const float l = r.f32(), t = r.f32(), rt = r.f32(), b = r.f32();
+            const float start = r.f32(), sweep = r.f32();
+            const int forceMoveTo = r.i32();
+            Path_arcToOval(path, l, t, rt, b, start, sweep, forceMoveTo);
+            break;
+          }
+        }
+        break;
+      }
+    }
+    executed++;
+  }
+  return executed;
+}
+
 }  // extern "C"
@@ -0,0 +1,279 @@
+// Native benchmarks for the cheap C ABI:
+// - per-call entry points vs Canvas_submitCommands().
+// - replaying a static scene every frame vs drawing it as an R-tree SkPicture.
+// - drawing small immutable paths (icons) directly vs through the coverage-mask cache.
+//
+// Build with modules/canvaskit/build_canvaskit_cheap_bench.sh, then run:
+//   canvaskit_cheap_bench [iterations]
+
+#include "modules/canvaskit/src/canvaskit_cheap_bindings.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Minimal encoder for the command stream described in canvaskit_cheap_bindings.h.
+class CommandEncoder {
+ public:
+  void reset() { fWords.clear(); }
+
+  const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(fWords.data()); }
+  int byteLength() const { return static_cast<int>(fWords.size() * 4); }
+
+  void save() { this->header(CheapCommand_Save, 1); }
+  void restore() { this->header(CheapCommand_Restore, 1); }
+
+  void translate(float dx, float dy) {
+    this->header(CheapCommand_Translate, 3);
+    this->f32(dx);
+    this->f32(dy);
+  }
+
+  void drawRect(float l, float t, float r, float b, void* paint) {
+    this->header(CheapCommand_DrawRect, 7);
+    this->f32(l);
+    this->f32(t);
+    this->f32(r);
+    this->f32(b);
+    this->handle(paint);
+  }
+
+  void paintSetColor(void* paint, uint32_t color) {
+    this->header(CheapCommand_PaintSetColor, 4);
+    this->handle(paint);
+    fWords.push_back(color);
+  }
+
+ private:
+  void header(CheapCommandOp op, uint32_t words) {
+    fWords.push_back(static_cast<uint32_t>(op) | (words << 16));
+  }
+
+  void f32(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    fWords.push_back(bits);
+  }
+
+  void handle(void* p) {
+    const uint64_t v = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(p));
+    fWords.push_back(static_cast<uint32_t>(v));
+    fWords.push_back(static_cast<uint32_t>(v >> 32));
+  }
+
+  std::vector<uint32_t> fWords;
+};
+
+constexpr int kRectsPerFrame = 10000;
+
+double NowMs() {
+  using namespace std::chrono;
+  return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+// One "UI frame": save/translate/setColor/drawRect/restore per item, the shape our
+// layer tree produces for simple boxes.
+void FramePerCall(void* canvas, void* paint) {
+  for (int i = 0; i < kRectsPerFrame; i++) {
+    const float x = static_cast<float>(i % 100) * 5;
+    const float y = static_cast<float>(i / 100) * 5;
+    Canvas_save(canvas);
+    Canvas_translate(canvas, x, y);
+    Paint_setColor(paint, 0xff000000 | static_cast<uint32_t>(i * 2654435761u >> 8));
+    Canvas_drawRect(canvas, 0, 0, 4, 4, paint);
+    Canvas_restore(canvas);
+  }
+}
+
+void FrameBatched(void* canvas, void* paint, CommandEncoder* enc) {
+  enc->reset();
+  for (int i = 0; i < kRectsPerFrame; i++) {
+    const float x = static_cast<float>(i % 100) * 5;
+    const float y = static_cast<float>(i / 100) * 5;
+    enc->save();
+    enc->translate(x, y);
+    enc->paintSetColor(paint, 0xff000000 | static_cast<uint32_t>(i * 2654435761u >> 8));
+    enc->drawRect(0, 0, 4, 4, paint);
+    enc->restore();
+  }
+  Canvas_submitCommands(canvas, enc->data(), enc->byteLength());
+}
+
+// A mostly static scene: a large grid of cells of which only a small scrolled window is
+// visible, as in a long list whose content does not change between frames.
+constexpr int kSceneCells = 200;
+constexpr float kCellSize = 8;
+constexpr float kViewportSize = 128;
+
+void DrawScene(void* canvas, void* paint) {
+  for (int y = 0; y < kSceneCells; y++) {
+    for (int x = 0; x < kSceneCells; x++) {
+      Paint_setColor(paint, 0xff000000 | static_cast<uint32_t>((x * 31 + y * 17) * 2654435761u >> 8));
+      Canvas_drawRect(canvas,
+                      x * kCellSize,
+                      y * kCellSize,
+                      x * kCellSize + kCellSize - 1,
+                      y * kCellSize + kCellSize - 1,
+                      paint);
+    }
+  }
+}
+
+void BeginViewport(void* canvas, int frame) {
+  const float scroll = static_cast<float>((frame * 7) % 1200);
+  Canvas_save(canvas);
+  Canvas_clipRect(canvas, 0, 0, kViewportSize, kViewportSize, SkClipOp_Intersect(), 0);
+  Canvas_translate(canvas, 0, -scroll);
+}
+
+// A 24px star icon, snapshotted once into an immutable SkPath handle.
+void* MakeIconPath() {
+  void* builder = MakePath();
+  for (int i = 0; i < 10; i++) {
+    const float radius = (i & 1) ? 5.0f : 12.0f;
+    const float angle = static_cast<float>(i) * 0.6283185f;
+    const float x = 12 + radius * std::sin(angle);
+    const float y = 12 - radius * std::cos(angle);
+    if (i == 0) {
+      Path_moveTo(builder, x, y);
+    } else {
+      Path_lineTo(builder, x, y);
+    }
+  }
+  Path_close(builder);
+  void* icon = Path_snapshot(builder);
+  DeletePath(builder);
+  return icon;
+}
+
+constexpr int kIconsPerFrame = 400;
+
+void FrameIcons(void* canvas, void* icon, void* paint, bool cached) {
+  for (int i = 0; i < kIconsPerFrame; i++) {
+    Canvas_save(canvas);
+    Canvas_translate(canvas, static_cast<float>(i % 20) * 25, static_cast<float>(i / 20) * 25);
+    if (cached) {
+      Canvas_drawSkPathCached(canvas, icon, paint);
+    } else {
+      Canvas_drawSkPath(canvas, icon, paint);
+    }
+    Canvas_restore(canvas);
+  }
+}
+
+void Report(const char* name, int iterations, double ops, double ms) {
+  std::printf("%-10s %8.2f ms total  %7.3f ms/frame  %6.1f ns/op\n",
+              name, ms, ms / iterations, ms * 1e6 / ops);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+  if (iterations <= 0) {
+    std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  void* surface = MakeSWCanvasSurface(512, 512);
+  if (!surface) {
+    std::fprintf(stderr, "error: MakeSWCanvasSurface failed\n");
+    return 1;
+  }
+  void* canvas = Surface_getCanvas(surface);
+  void* paint = MakePaint();
+  Paint_setAntiAlias(paint, 0);
+
+  CommandEncoder enc;
+
+  // Warm up both paths so lazily-initialized state doesn't skew the first run.
+  FramePerCall(canvas, paint);
+  FrameBatched(canvas, paint, &enc);
+
+  double t0 = NowMs();
+  for (int i = 0; i < iterations; i++) {
+    FramePerCall(canvas, paint);
+  }
+  const double perCallMs = NowMs() - t0;
+
+  t0 = NowMs();
+  for (int i = 0; i < iterations; i++) {
+    FrameBatched(canvas, paint, &enc);
+  }
+  const double batchedMs = NowMs() - t0;
+
+  const double ops = static_cast<double>(iterations) * kRectsPerFrame * 5;
+  std::printf("[commands] frames=%d rects/frame=%d stream=%d bytes/frame\n",
+              iterations, kRectsPerFrame, enc.byteLength());
+  Report("per-call", iterations, ops, perCallMs);
+  Report("batched", iterations, ops, batchedMs);
+  std::printf("batched/per-call: x%.2f\n", perCallMs / batchedMs);
+
+  // Static scene: replay every op each frame vs. draw a recorded R-tree picture.
+  void* recorder = MakePictureRecorder();
+  void* recording = PictureRecorder_begin(
+      recorder, 0, 0, kSceneCells * kCellSize, kSceneCells * kCellSize, 1);
+  DrawScene(recording, paint);
+  void* picture = PictureRecorder_finish(recorder);
+
+  t0 = NowMs();
+  for (int i = 0; i < iterations; i++) {
+    BeginViewport(canvas, i);
+    DrawScene(canvas, paint);
+    Canvas_restore(canvas);
+  }
+  const double replayMs = NowMs() - t0;
+
+  t0 = NowMs();
+  for (int i = 0; i < iterations; i++) {
+    BeginViewport(canvas, i);
+    Canvas_drawPicture(canvas, picture, nullptr, nullptr);
+    Canvas_restore(canvas);
+  }
+  const double pictureMs = NowMs() - t0;
+
+  std::printf("[picture] frames=%d cells=%d picture=%d bytes\n",
+              iterations, kSceneCells * kSceneCells, Picture_approximateBytesUsed(picture));
+  Report("replay", iterations, iterations, replayMs);
+  Report("picture", iterations, iterations, pictureMs);
+  std::printf("picture/replay: x%.2f\n", replayMs / pictureMs);
+
+  // Icons: scan-convert every draw vs. blit cached coverage masks.
+  void* icon = MakeIconPath();
+  Paint_setAntiAlias(paint, 1);
+  FrameIcons(canvas, icon, paint, true);
+
+  t0 = NowMs();
+  for (int i = 0; i < iterations; i++) {
+    FrameIcons(canvas, icon, paint, false);
+  }
+  const double iconDirectMs = NowMs() - t0;
+
+  t0 = NowMs();
+  for (int i = 0; i < iterations; i++) {
+    FrameIcons(canvas, icon, paint, true);
+  }
+  const double iconCachedMs = NowMs() - t0;
+
+  uint32_t stats[4];
+  PathMaskCache_getStats(stats);
+  const double iconOps = static_cast<double>(iterations) * kIconsPerFrame;
+  std::printf("[path masks] frames=%d icons/frame=%d hits=%u misses=%u entries=%u bytes=%u\n",
+              iterations, kIconsPerFrame, stats[0], stats[1], stats[2], stats[3]);
+  Report("direct", iterations, iconOps, iconDirectMs);
+  Report("cached", iterations, iconOps, iconCachedMs);
+  std::printf("cached/direct: x%.2f\n", iconDirectMs / iconCachedMs);
+
+  DeleteSkPath(icon);
+  DeletePicture(picture);
+  DeletePictureRecorder(recorder);
+  DeletePaint(paint);
+  DeleteSurface(surface);
+  return 0;
+}
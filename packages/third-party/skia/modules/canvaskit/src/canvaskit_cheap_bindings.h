@@ -48,6 +48,10 @@ int SkTextAlign_Justify();
 int SkTextAlign_Start();
 int SkTextAlign_End();
 
+int SkColorType_RGBA8888();
+int SkColorType_BGRA8888();
+int SkColorType_RGBA_F16();
+
 // Paint
 void* MakePaint();
 void DeletePaint(void* paint);
@@ -99,21 +103,72 @@ void Path_reset(void* path);
 void Path_getBounds(void* path, float* outLTRB4);
 
 // Path (snapshot)
+//
+// SkPath handles are immutable views of shared SkPathData: snapshot a builder once and
+// draw the handle many times. Copies and identity transforms share the same data and
+// therefore keep the same generation ID, which is what path-keyed caches look up.
 void* Path_snapshot(void* path);
 void DeleteSkPath(void* skPath);
 void Path_transform(void* skPath, const float* m9);
 void SkPath_getBounds(void* skPath, float* outLTRB4);
+void* SkPath_copy(void* skPath);
+void* SkPath_makeTransform(void* skPath, const float* m9);
+uint32_t SkPath_getGenerationID(void* skPath);
+
+// Path coverage-mask cache
+//
+// Canvas_drawSkPathCached() rasterizes the path's coverage into an A8 mask once per
+// (generation ID, fill type, 2x2 matrix, quarter-pixel translate, stroke params) and
+// blits the cached mask with the paint on later draws. Paints with a shader, path
+// effect, mask filter, image filter, color filter or a blend mode other than SrcOver,
+// perspective matrices and large masks fall back to Canvas_drawSkPath(). Masks are
+// evicted least-recently-used beyond the byte limit.
+void Canvas_drawSkPathCached(void* canvas, void* skPath, void* paint);
+int PathMaskCache_getByteLimit();
+int PathMaskCache_setByteLimit(int bytes);
+void PathMaskCache_purge();
+// Writes [hits, misses, entries, bytesUsed].
+void PathMaskCache_getStats(uint32_t* out4);
 
 // Surface
 void* MakeCanvasSurface(int width, int height);
 void* MakeSWCanvasSurface(int width, int height);
+// Draws into caller-owned premultiplied pixels (SkColorType_* above), so the host can
+// present from the shared buffer without a readback. `pixels` must outlive the surface.
+void* MakeSWCanvasSurfaceWrapPixels(void* pixels, int width, int height, int rowBytes, int colorType);
 void DeleteSurface(void* surface);
+// Raster surfaces only; returns nullptr for GPU surfaces.
+void* Surface_peekPixels(void* surface, int* outRowBytes);
+// Pixel bounds changed since the previous call (whole surface on the first call), found
+// by hashing 64x16 tiles. Returns 0 and an empty rect when nothing changed.
+int Surface_getDamageRect(void* surface, int* outLTRB4);
 void* Surface_getCanvas(void* surface);
 void Surface_flush(void* surface);
 int Surface_width(void* surface);
 int Surface_height(void* surface);
 void* Surface_makeImageSnapshot(void* surface);
 void* Surface_encodeToPNG(void* surface);
+// Encoding. format: 0 PNG, 1 JPEG, 2 WebP lossy, 3 WebP lossless. quality [0, 100] applies
+// to JPEG/WebP; zlibLevel [0, 9] (negative = default) and filterFlags
+// (SkPngEncoder::FilterFlag bits, 0 = none) apply to PNG. Raster surfaces are encoded
+// straight from their pixels.
+void* Surface_encode(void* surface, int format, int quality, int zlibLevel, int filterFlags);
+// Returns the encoded size, 0 on failure, or -(required size) if dst was too small.
+int Surface_encodeToBuffer(
+  void* surface,
+  int format,
+  int quality,
+  int zlibLevel,
+  int filterFlags,
+  void* dst,
+  int dstCapacity);
+// Chunked encoding: call SurfaceEncoder_encodeRows() and drain with SurfaceEncoder_read()
+// until SurfaceEncoder_isDone(). Don't draw to the surface while an encoder is alive.
+void* MakeSurfaceEncoder(void* surface, int format, int quality, int zlibLevel, int filterFlags);
+void DeleteSurfaceEncoder(void* encoder);
+int SurfaceEncoder_encodeRows(void* encoder, int rows);
+int SurfaceEncoder_read(void* encoder, void* dst, int dstCapacity);
+int SurfaceEncoder_isDone(void* encoder);
 int Surface_readPixelsRGBA8888(
   void* surface,
   int x,
@@ -182,6 +237,41 @@ void Canvas_clipRect(
   int clipOp,
   int doAA);
 
+
+// Bulk draws (structure-of-arrays inputs, e.g. straight from Float32Array/Uint32Array).
+// - ltrb: 4 floats per rect; xy: 2 floats per point.
+// - Canvas_drawPoints mode: 0 points, 1 lines, 2 polygon.
+// - Canvas_drawAtlas rsxforms: [scos, ssin, tx, ty] per sprite, texRects: [l, t, r, b] per
+//   sprite. colors and cullLTRB4 may be null. Unrotated sprites (ssin == 0) under a
+//   scale/translate matrix take a dedicated raster fast path.
+void Canvas_drawRects(void* canvas, const float* ltrb, int count, void* paint);
+void Canvas_drawRectsWithColors(void* canvas, const float* ltrb, const uint32_t* colors, int count, void* paint);
+void Canvas_drawPoints(void* canvas, int mode, const float* xy, int count, void* paint);
+void Canvas_drawAtlas(
+  void* canvas,
+  void* image,
+  const float* rsxforms,
+  const float* texRects,
+  const uint32_t* colors,
+  int count,
+  int blendMode,
+  int filterMode,
+  int mipmapMode,
+  const float* cullLTRB4,
+  void* paint);
+// Picture
+// Recording canvases are owned by the recorder and are valid until PictureRecorder_finish().
+void* MakePictureRecorder();
+void DeletePictureRecorder(void* recorder);
+// useRTree != 0 builds an R-tree so playback culls ops against the destination clip.
+void* PictureRecorder_begin(void* recorder, float left, float top, float right, float bottom, int useRTree);
+void* PictureRecorder_finish(void* recorder);
+void DeletePicture(void* picture);
+// m9 (3x3, same layout as Canvas_concat) and paint may be null.
+void Canvas_drawPicture(void* canvas, void* picture, const float* m9, void* paint);
+void Picture_cullRect(void* picture, float* outLTRB4);
+int Picture_approximateBytesUsed(void* picture);
+
 // Image / Data
 void DeleteImage(void* image);
 int Image_width(void* image);
@@ -195,7 +285,18 @@ int Image_readPixelsRGBA8888(
   void* dst,
   int dstRowBytes);
 void* Image_encodeToPNG(void* image);
+void* Image_encode(void* image, int format, int quality, int zlibLevel, int filterFlags);
 void* MakeImageFromEncoded(const void* bytes, int size);
+// Lazily decodes at the smallest resolution covering targetWidth x targetHeight (aspect
+// ratio preserved, 0 = full size). Decoded pixels are kept in the budgeted resource cache
+// and may be purged and re-decoded on demand.
+void* MakeImageFromEncodedWithTargetSize(const void* bytes, int size, int targetWidth, int targetHeight);
+
+// Resource cache (decoded lazy images and other CPU-side caches)
+int Graphics_getResourceCacheTotalBytesUsed();
+int Graphics_getResourceCacheTotalByteLimit();
+int Graphics_setResourceCacheTotalByteLimit(int bytes);
+void Graphics_purgeResourceCache();
 
 void DeleteData(void* data);
 const void* Data_bytes(void* data);
@@ -281,6 +382,58 @@ void* MakeParagraphBuilderWithEllipsis(
   int maxLines,
   const char* ellipsisUtf8,
   int ellipsisByteLength);
+// FontRegistry (SkParagraph)
+// A long-lived registry that parses font bytes once and owns a shared FontCollection,
+// TypefaceFontProvider and SkUnicode. Paragraphs built from it share the paragraph,
+// typeface and shaper caches. Paragraphs and builders keep the registry alive, so
+// DeleteFontRegistry() may be called while they are still in use.
+void* MakeFontRegistry();
+void DeleteFontRegistry(void* registry);
+// Registers a font (TTF/OTF/TTC). The family name defaults to the font's own and can be
+// overridden with familyUtf8. The first registered family becomes the default family.
+// Returns 1 on success.
+int FontRegistry_registerFont(
+  void* registry,
+  const void* bytes,
+  int size,
+  int ttcIndex,
+  const char* familyUtf8,
+  int familyByteLength);
+int FontRegistry_countFamilies(void* registry);
+// Drops cached layouts, typeface lookups and shaper state; registered fonts are kept.
+void FontRegistry_clearCaches(void* registry);
+// Glyph cache snapshots for fast cold starts. serialize returns an SkData (DeleteData()) with
+// the glyph images rasterized so far with the registry's fonts, or null. preload loads one
+// saved by an earlier run, skipping entries whose font data no longer matches a registered
+// font and ignoring snapshots from another Skia milestone; it returns the number of strikes
+// loaded.
+void* FontRegistry_serializeGlyphCache(void* registry);
+int FontRegistry_preloadGlyphCache(void* registry, const void* bytes, int size);
+
+// Same as MakeParagraphFromTextWithEllipsis, but fonts come from a FontRegistry.
+// Pass ellipsisByteLength = 0 for no ellipsis.
+void* MakeParagraphFromTextWithRegistry(
+  void* registry,
+  const char* utf8,
+  int byteLength,
+  float fontSize,
+  float wrapWidth,
+  uint32_t color,
+  int textAlign,
+  int maxLines,
+  const char* ellipsisUtf8,
+  int ellipsisByteLength);
+
+// Same as MakeParagraphBuilderWithEllipsis, but fonts come from a FontRegistry.
+void* MakeParagraphBuilderWithRegistry(
+  void* registry,
+  float fontSize,
+  uint32_t color,
+  int textAlign,
+  int maxLines,
+  const char* ellipsisUtf8,
+  int ellipsisByteLength);
+
 void ParagraphBuilder_pushStyle(void* builder, float fontSize, uint32_t color);
 void ParagraphBuilder_pop(void* builder);
 void ParagraphBuilder_addText(void* builder, const char* utf8, int byteLength);
@@ -294,9 +447,121 @@ float Paragraph_getMaxWidth(void* paragraph);
 float Paragraph_getMinIntrinsicWidth(void* paragraph);
 float Paragraph_getMaxIntrinsicWidth(void* paragraph);
 float Paragraph_getLongestLine(void* paragraph);
+
+// Bulk paragraph queries. Each fills a caller-provided buffer in one call and returns the
+// total number of items available, which may exceed `capacity`; only the first
+// min(total, capacity) items are written, so callers can size their buffer from a first
+// call with capacity 0. All text offsets are UTF-16 code units, as in the SkParagraph
+// API, except where noted.
+enum {
+  // Floats per line in Paragraph_getLineMetrics: startIndex, endIndex,
+  // endExcludingWhitespaces, endIncludingNewline, hardBreak (0/1), ascent, descent,
+  // height, width, left, baseline, lineNumber.
+  CheapParagraph_LineMetricsStride = 12,
+  // Floats per box in Paragraph_getRectsForRange: left, top, right, bottom,
+  // direction (0 = RTL, 1 = LTR).
+  CheapParagraph_TextBoxStride = 5,
+};
+int Paragraph_getLineMetrics(void* paragraph, float* outMetrics, int capacity);
+// Glyph clusters in visual order, as structure-of-arrays: `outBounds` holds four planes of
+// `capacity` floats (lefts, tops, rights, bottoms) spanning each cluster's advance and its
+// line's ascent/descent; `outInfo` holds three planes of `capacity` values (text start,
+// text end, line number). Either buffer may be null. Results are cached until the next
+// Paragraph_layout.
+int Paragraph_getGlyphClusters(void* paragraph, float* outBounds, uint32_t* outInfo, int capacity);
+// heightStyle/widthStyle are skia::textlayout::RectHeightStyle/RectWidthStyle values.
+int Paragraph_getRectsForRange(
+  void* paragraph,
+  int start,
+  int end,
+  int heightStyle,
+  int widthStyle,
+  float* outBoxes,
+  int capacity);
+// Hit-tests `count` points (x, y pairs in `xy`) and writes (position, affinity) pairs to
+// `outPositions`, affinity being 0 upstream / 1 downstream. Returns the number of points
+// written.
+int Paragraph_getGlyphPositionsAtCoordinates(void* paragraph, const float* xy, int count, int32_t* outPositions);
+// All word boundaries in ascending order, starting with 0 and ending with the text length.
+int Paragraph_getWordBoundaries(void* paragraph, uint32_t* outOffsets, int capacity);
 void DeleteParagraph(void* paragraph);
 void Canvas_drawParagraph(void* canvas, void* paragraph, float x, float y);
 
+// Command buffer
+//
+// Canvas_submitCommands() decodes a stream of little-endian 32-bit words and replays it
+// against `canvas` in a single call, so hot draw loops pay one JS->Wasm crossing per frame
+// instead of one per operation.
+//
+// Every command starts with a header word: the low 16 bits hold the opcode and the high
+// 16 bits hold the total number of words in the command (header included). Arguments
+// follow in the same order as the matching C entry point, minus the canvas:
+// - float args take one word (f32).
+// - int/enum/color args take one word (u32).
+// - handle args (paint, path, image, ...) take two words (lo, hi) so the stream layout is
+//   identical on wasm32 and on 64-bit native builds. A zero handle means "none".
+// - matrices take nine words (same order as Canvas_concat).
+//
+// Returns the number of commands executed. Decoding stops at the first unknown opcode,
+// word-count mismatch or truncated command.
+enum CheapCommandOp {
+  // Canvas
+  CheapCommand_Clear = 1,               // u32 color
+  CheapCommand_Save = 2,                //
+  CheapCommand_SaveLayer = 3,           // f32 l, t, r, b, u32 hasBounds, handle paint
+  CheapCommand_Restore = 4,             //
+  CheapCommand_RestoreToCount = 5,      // u32 saveCount
+  CheapCommand_Translate = 6,           // f32 dx, dy
+  CheapCommand_Scale = 7,               // f32 sx, sy
+  CheapCommand_Rotate = 8,              // f32 degrees
+  CheapCommand_Concat = 9,              // f32 m9[9]
+  CheapCommand_SetMatrix = 10,          // f32 m9[9]
+  CheapCommand_ClipRect = 11,           // f32 l, t, r, b, u32 clipOp, u32 doAA
+  CheapCommand_DrawRect = 12,           // f32 l, t, r, b, handle paint
+  CheapCommand_DrawPath = 13,           // handle path (builder), handle paint
+  CheapCommand_DrawSkPath = 14,         // handle skPath, handle paint
+  CheapCommand_DrawCircle = 15,         // f32 cx, cy, radius, handle paint
+  CheapCommand_DrawLine = 16,           // f32 x0, y0, x1, y1, handle paint
+  CheapCommand_DrawOval = 17,           // f32 l, t, r, b, handle paint
+  CheapCommand_DrawArc = 18,            // f32 l, t, r, b, start, sweep, u32 useCenter, handle paint
+  CheapCommand_DrawPaint = 19,          // handle paint
+  CheapCommand_DrawImage = 20,          // handle image, f32 x, y, u32 filter, mipmap, handle paint
+  CheapCommand_DrawImageRect = 21,      // handle image, f32 src[4], dst[4], u32 filter, mipmap, handle paint
+  CheapCommand_DrawTextBlob = 22,       // handle blob, f32 x, y, handle paint
+  CheapCommand_DrawParagraph = 23,      // handle paragraph, f32 x, y
+  CheapCommand_DrawPicture = 24,        // handle picture, handle paint
+  CheapCommand_DrawSkPathCached = 25,   // handle skPath, handle paint
+
+  // Paint
+  CheapCommand_PaintSetColor = 64,      // handle paint, u32 color
+  CheapCommand_PaintSetAntiAlias = 65,  // handle paint, u32 aa
+  CheapCommand_PaintSetStyle = 66,      // handle paint, u32 style
+  CheapCommand_PaintSetStrokeWidth = 67,// handle paint, f32 width
+  CheapCommand_PaintSetStrokeCap = 68,  // handle paint, u32 cap
+  CheapCommand_PaintSetStrokeJoin = 69, // handle paint, u32 join
+  CheapCommand_PaintSetAlphaf = 70,     // handle paint, f32 alpha
+  CheapCommand_PaintSetBlendMode = 71,  // handle paint, u32 mode
+  CheapCommand_PaintSetShader = 72,     // handle paint, handle shader
+  CheapCommand_PaintSetColorFilter = 73,// handle paint, handle colorFilter
+
+  // Path (builder)
+  CheapCommand_PathSetFillType = 128,   // handle path, u32 fillType
+  CheapCommand_PathMoveTo = 129,        // handle path, f32 x, y
+  CheapCommand_PathLineTo = 130,        // handle path, f32 x, y
+  CheapCommand_PathQuadTo = 131,        // handle path, f32 x1, y1, x2, y2
+  CheapCommand_PathCubicTo = 132,       // handle path, f32 x1, y1, x2, y2, x3, y3
+  CheapCommand_PathClose = 133,         // handle path
+  CheapCommand_PathReset = 134,         // handle path
+  CheapCommand_PathAddRect = 135,       // handle path, f32 l, t, r, b
+  CheapCommand_PathAddCircle = 136,     // handle path, f32 cx, cy, r
+  CheapCommand_PathAddOval = 137,       // handle path, f32 l, t, r, b, u32 dir, startIndex
+  CheapCommand_PathAddRRectXY = 138,    // handle path, f32 l, t, r, b, rx, ry, u32 dir, startIndex
+  CheapCommand_PathAddArc = 139,        // handle path, f32 l, t, r, b, start, sweep
+  CheapCommand_PathArcToOval = 140,     // handle path, f32 l, t, r, b, start, sweep, u32 forceMoveTo
+};
+
+int Canvas_submitCommands(void* canvas, const uint8_t* buf, int len);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,706 @@
+// Replays a cheap ABI call trace (see canvaskit_cheap_trace.h) against the native build of
+// the bindings and reports time spent per function, nanobench-style. GPU surfaces in the
+// trace are replayed as raster surfaces.
+//
+// Build with modules/canvaskit/build_canvaskit_cheap_native.sh, then run:
+//   canvaskit_cheap_replay trace.bin [--loops N]
+
+#include "modules/canvaskit/src/canvaskit_cheap_bindings.h"
+#include "modules/canvaskit/src/canvaskit_cheap_trace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Every function in canvaskit_cheap_bindings.h that a trace may refer to.
+#define CHEAP_TRACE_FUNCTIONS(X) \
+  X(SkPathFillType_Winding) \
+  X(SkPathFillType_EvenOdd) \
+  X(SkPathFillType_InverseWinding) \
+  X(SkPathFillType_InverseEvenOdd) \
+  X(SkPaintStyle_Fill) \
+  X(SkPaintStyle_Stroke) \
+  X(SkPaintStyle_StrokeAndFill) \
+  X(SkFilterMode_Nearest) \
+  X(SkFilterMode_Linear) \
+  X(SkMipmapMode_None) \
+  X(SkMipmapMode_Nearest) \
+  X(SkMipmapMode_Linear) \
+  X(SkTileMode_Clamp) \
+  X(SkTileMode_Repeat) \
+  X(SkTileMode_Mirror) \
+  X(SkTileMode_Decal) \
+  X(SkClipOp_Difference) \
+  X(SkClipOp_Intersect) \
+  X(SkTextDirection_LTR) \
+  X(SkTextDirection_RTL) \
+  X(SkTextAlign_Left) \
+  X(SkTextAlign_Right) \
+  X(SkTextAlign_Center) \
+  X(SkTextAlign_Justify) \
+  X(SkTextAlign_Start) \
+  X(SkTextAlign_End) \
+  X(SkColorType_RGBA8888) \
+  X(SkColorType_BGRA8888) \
+  X(SkColorType_RGBA_F16) \
+  X(MakePaint) \
+  X(DeletePaint) \
+  X(Paint_setColor) \
+  X(Paint_setAntiAlias) \
+  X(Paint_setStyle) \
+  X(Paint_setStrokeWidth) \
+  X(Paint_setStrokeCap) \
+  X(Paint_setStrokeJoin) \
+  X(Paint_setAlphaf) \
+  X(Paint_setBlendMode) \
+  X(Paint_setShader) \
+  X(Paint_setColorFilter) \
+  X(MakePath) \
+  X(DeletePath) \
+  X(Path_setFillType) \
+  X(Path_moveTo) \
+  X(Path_lineTo) \
+  X(Path_quadTo) \
+  X(Path_cubicTo) \
+  X(Path_addRect) \
+  X(Path_addCircle) \
+  X(Path_addOval) \
+  X(Path_addRRectXY) \
+  X(Path_addPolygon) \
+  X(Path_addArc) \
+  X(Path_arcToOval) \
+  X(Path_close) \
+  X(Path_reset) \
+  X(Path_getBounds) \
+  X(Path_snapshot) \
+  X(DeleteSkPath) \
+  X(Path_transform) \
+  X(SkPath_getBounds) \
+  X(SkPath_copy) \
+  X(SkPath_makeTransform) \
+  X(SkPath_getGenerationID) \
+  X(Canvas_drawSkPathCached) \
+  X(PathMaskCache_getByteLimit) \
+  X(PathMaskCache_setByteLimit) \
+  X(PathMaskCache_purge) \
+  X(PathMaskCache_getStats) \
+  X(MakeCanvasSurface) \
+  X(MakeSWCanvasSurface) \
+  X(MakeSWCanvasSurfaceWrapPixels) \
+  X(DeleteSurface) \
+  X(Surface_peekPixels) \
+  X(Surface_getDamageRect) \
+  X(Surface_getCanvas) \
+  X(Surface_flush) \
+  X(Surface_width) \
+  X(Surface_height) \
+  X(Surface_makeImageSnapshot) \
+  X(Surface_encodeToPNG) \
+  X(Surface_encode) \
+  X(Surface_encodeToBuffer) \
+  X(MakeSurfaceEncoder) \
+  X(DeleteSurfaceEncoder) \
+  X(SurfaceEncoder_encodeRows) \
+  X(SurfaceEncoder_read) \
+  X(SurfaceEncoder_isDone) \
+  X(Surface_readPixelsRGBA8888) \
+  X(Canvas_clear) \
+  X(Canvas_drawRect) \
+  X(Canvas_drawPath) \
+  X(Canvas_drawSkPath) \
+  X(Canvas_drawCircle) \
+  X(Canvas_drawLine) \
+  X(Canvas_drawImage) \
+  X(Canvas_drawImageWithPaint) \
+  X(Canvas_drawImageRect) \
+  X(Canvas_drawImageRectWithPaint) \
+  X(Canvas_drawTextBlob) \
+  X(Canvas_getSaveCount) \
+  X(Canvas_save) \
+  X(Canvas_saveLayer) \
+  X(Canvas_restore) \
+  X(Canvas_restoreToCount) \
+  X(Canvas_translate) \
+  X(Canvas_scale) \
+  X(Canvas_rotate) \
+  X(Canvas_drawOval) \
+  X(Canvas_drawArc) \
+  X(Canvas_drawPaint) \
+  X(Canvas_concat) \
+  X(Canvas_setMatrix) \
+  X(Canvas_clipRect) \
+  X(Canvas_drawRects) \
+  X(Canvas_drawRectsWithColors) \
+  X(Canvas_drawPoints) \
+  X(Canvas_drawAtlas) \
+  X(MakePictureRecorder) \
+  X(DeletePictureRecorder) \
+  X(PictureRecorder_begin) \
+  X(PictureRecorder_finish) \
+  X(DeletePicture) \
+  X(Canvas_drawPicture) \
+  X(Picture_cullRect) \
+  X(Picture_approximateBytesUsed) \
+  X(DeleteImage) \
+  X(Image_width) \
+  X(Image_height) \
+  X(Image_readPixelsRGBA8888) \
+  X(Image_encodeToPNG) \
+  X(Image_encode) \
+  X(MakeImageFromEncoded) \
+  X(MakeImageFromEncodedWithTargetSize) \
+  X(Graphics_getResourceCacheTotalBytesUsed) \
+  X(Graphics_getResourceCacheTotalByteLimit) \
+  X(Graphics_setResourceCacheTotalByteLimit) \
+  X(Graphics_purgeResourceCache) \
+  X(DeleteData) \
+  X(Data_bytes) \
+  X(Data_size) \
+  X(DeleteShader) \
+  X(MakeColorShader) \
+  X(MakeLinearGradientShader) \
+  X(DeleteColorFilter) \
+  X(MakeBlendColorFilter) \
+  X(MakeFont) \
+  X(DeleteFont) \
+  X(Font_setSize) \
+  X(Font_setEdging) \
+  X(MakeTypefaceFromData) \
+  X(DeleteTypeface) \
+  X(Font_setTypeface) \
+  X(DeleteTextBlob) \
+  X(MakeTextBlobFromText) \
+  X(MakeParagraphFromText) \
+  X(MakeParagraphFromTextWithEllipsis) \
+  X(MakeParagraphBuilder) \
+  X(MakeParagraphBuilderWithEllipsis) \
+  X(MakeFontRegistry) \
+  X(DeleteFontRegistry) \
+  X(FontRegistry_registerFont) \
+  X(FontRegistry_countFamilies) \
+  X(FontRegistry_clearCaches) \
+  X(FontRegistry_serializeGlyphCache) \
+  X(FontRegistry_preloadGlyphCache) \
+  X(MakeParagraphFromTextWithRegistry) \
+  X(MakeParagraphBuilderWithRegistry) \
+  X(ParagraphBuilder_pushStyle) \
+  X(ParagraphBuilder_pop) \
+  X(ParagraphBuilder_addText) \
+  X(ParagraphBuilder_build) \
+  X(DeleteParagraphBuilder) \
+  X(Paragraph_layout) \
+  X(Paragraph_getHeight) \
+  X(Paragraph_getMaxWidth) \
+  X(Paragraph_getMinIntrinsicWidth) \
+  X(Paragraph_getMaxIntrinsicWidth) \
+  X(Paragraph_getLongestLine) \
+  X(Paragraph_getLineMetrics) \
+  X(Paragraph_getGlyphClusters) \
+  X(Paragraph_getRectsForRange) \
+  X(Paragraph_getGlyphPositionsAtCoordinates) \
+  X(Paragraph_getWordBoundaries) \
+  X(DeleteParagraph) \
+  X(Canvas_drawParagraph) \
+  X(Canvas_submitCommands)
+
+namespace {
+
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : fPtr(data), fEnd(data + size) {}
+
+  bool ok() const { return fOk; }
+  bool atEnd() const { return fPtr >= fEnd; }
+
+  uint8_t u8() { return static_cast<uint8_t>(this->read(1)); }
+  uint16_t u16() { return static_cast<uint16_t>(this->read(2)); }
+  uint32_t u32() { return this->read(4); }
+
+  float f32() {
+    const uint32_t bits = this->u32();
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+  }
+
+  const uint8_t* bytes(size_t n) {
+    if (static_cast<size_t>(fEnd - fPtr) < n) {
+      fOk = false;
+      fPtr = fEnd;
+      return nullptr;
+    }
+    const uint8_t* p = fPtr;
+    fPtr += n;
+    return p;
+  }
+
+ private:
+  uint32_t read(size_t n) {
+    const uint8_t* p = this->bytes(n);
+    uint32_t v = 0;
+    for (size_t i = 0; p && i < n; i++) {
+      v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    }
+    return v;
+  }
+
+  const uint8_t* fPtr;
+  const uint8_t* fEnd;
+  bool fOk = true;
+};
+
+// State for one pass over the trace.
+class ReplayContext {
+ public:
+  void* lookup(uint32_t recorded, bool* mapped) {
+    if (!recorded) {
+      return nullptr;
+    }
+    auto it = fHandles.find(recorded);
+    if (it == fHandles.end()) {
+      *mapped = false;
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  void bind(uint32_t recorded, void* live) {
+    if (recorded && live) {
+      fHandles[recorded] = live;
+    }
+  }
+
+  // Zeroed, 4-byte aligned scratch that lives until the end of the current call, or for
+  // the whole pass if `persistent`.
+  uint8_t* alloc(size_t bytes, bool persistent) {
+    std::unique_ptr<uint32_t[]> storage(new uint32_t[(bytes + 3) / 4 + 1]());
+    uint8_t* p = reinterpret_cast<uint8_t*>(storage.get());
+    (persistent ? fPersistent : fCallScratch).push_back(std::move(storage));
+    return p;
+  }
+
+  void endCall() { fCallScratch.clear(); }
+
+ private:
+  std::unordered_map<uint32_t, void*> fHandles;
+  std::vector<std::unique_ptr<uint32_t[]>> fCallScratch;
+  std::vector<std::unique_ptr<uint32_t[]>> fPersistent;
+};
+
+struct Arg {
+  uint8_t tag = CheapTraceArg_Null;
+  uint32_t bits = 0;
+  uint8_t* ptr = nullptr;
+  uint32_t size = 0;
+};
+
+Arg DecodeArg(Reader& r, ReplayContext& ctx) {
+  Arg a;
+  a.tag = r.u8();
+  switch (a.tag) {
+    case CheapTraceArg_Null:
+      break;
+    case CheapTraceArg_Int:
+    case CheapTraceArg_Float:
+    case CheapTraceArg_Handle:
+      a.bits = r.u32();
+      break;
+    case CheapTraceArg_Blob: {
+      a.size = r.u32();
+      const uint8_t* src = r.bytes(a.size);
+      if (src) {
+        a.ptr = ctx.alloc(a.size, false);
+        std::memcpy(a.ptr, src, a.size);
+      }
+      break;
+    }
+    case CheapTraceArg_Out:
+    case CheapTraceArg_Pixels:
+      a.size = r.u32();
+      if (r.ok()) {
+        a.ptr = ctx.alloc(a.size, a.tag == CheapTraceArg_Pixels);
+      }
+      break;
+    default:
+      r.bytes(SIZE_MAX);  // unknown tag: poison the reader
+      break;
+  }
+  return a;
+}
+
+template <typename T>
+T ConvertArg(const Arg& a, ReplayContext& ctx, bool* mapped) {
+  if constexpr (std::is_pointer_v<T>) {
+    if (a.tag == CheapTraceArg_Int || a.tag == CheapTraceArg_Handle) {
+      return static_cast<T>(ctx.lookup(a.bits, mapped));
+    }
+    return reinterpret_cast<T>(a.ptr);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    if (a.tag == CheapTraceArg_Float) {
+      float v;
+      std::memcpy(&v, &a.bits, sizeof(v));
+      return static_cast<T>(v);
+    }
+    return static_cast<T>(static_cast<int32_t>(a.bits));
+  } else {
+    if (a.tag == CheapTraceArg_Float) {
+      float v;
+      std::memcpy(&v, &a.bits, sizeof(v));
+      return static_cast<T>(v);
+    }
+    return static_cast<T>(a.bits);
+  }
+}
+
+double NowNs() {
+  using namespace std::chrono;
+  return duration<double, std::nano>(steady_clock::now().time_since_epoch()).count();
+}
+
+enum class CallResult { kReplayed, kSkipped, kMalformed };
+
+using Thunk = CallResult (*)(Reader&, ReplayContext&, int argCount, double* ns);
+
+template <typename Sig, Sig Fn>
+struct Replayer;
+
+template <typename R, typename... A, R (*Fn)(A...)>
+struct Replayer<R (*)(A...), Fn> {
+  static CallResult Call(Reader& r, ReplayContext& ctx, int argCount, double* ns) {
+    if (argCount != static_cast<int>(sizeof...(A))) {
+      return CallResult::kMalformed;
+    }
+    // Braced initialization decodes the arguments left to right.
+    const Arg raw[sizeof...(A) + 1] = {(static_cast<void>(sizeof(A)), DecodeArg(r, ctx))...};
+    const Arg result = DecodeArg(r, ctx);
+    if (!r.ok()) {
+      return CallResult::kMalformed;
+    }
+    return Invoke(raw, result, ctx, ns, std::index_sequence_for<A...>{});
+  }
+
+  template <size_t... I>
+  static CallResult Invoke(const Arg* raw, const Arg& result, ReplayContext& ctx, double* ns,
+                           std::index_sequence<I...>) {
+    bool mapped = true;
+    std::tuple<A...> args{ConvertArg<A>(raw[I], ctx, &mapped)...};
+    if (!mapped) {
+      return CallResult::kSkipped;  // refers to an object whose creation was skipped
+    }
+
+    const double t0 = NowNs();
+    if constexpr (std::is_void_v<R>) {
+      std::apply(Fn, args);
+      *ns = NowNs() - t0;
+    } else {
+      R value = std::apply(Fn, args);
+      *ns = NowNs() - t0;
+      if constexpr (std::is_pointer_v<R>) {
+        if (result.tag == CheapTraceArg_Handle) {
+          ctx.bind(result.bits, const_cast<void*>(static_cast<const void*>(value)));
+        }
+      }
+    }
+    return CallResult::kReplayed;
+  }
+};
+
+// Word offsets of handle (lo, hi) pairs for each command, per the CheapCommandOp comments.
+int CommandHandleOffsets(uint32_t op, int out[2]) {
+  switch (op) {
+    case CheapCommand_SaveLayer: out[0] = 6; return 1;
+    case CheapCommand_DrawRect: out[0] = 5; return 1;
+    case CheapCommand_DrawPath:
+    case CheapCommand_DrawSkPath:
+    case CheapCommand_DrawPicture:
+    case CheapCommand_DrawSkPathCached: out[0] = 1; out[1] = 3; return 2;
+    case CheapCommand_DrawCircle: out[0] = 4; return 1;
+    case CheapCommand_DrawLine:
+    case CheapCommand_DrawOval: out[0] = 5; return 1;
+    case CheapCommand_DrawArc: out[0] = 8; return 1;
+    case CheapCommand_DrawPaint:
+    case CheapCommand_DrawParagraph: out[0] = 1; return 1;
+    case CheapCommand_DrawImage: out[0] = 1; out[1] = 7; return 2;
+    case CheapCommand_DrawImageRect: out[0] = 1; out[1] = 13; return 2;
+    case CheapCommand_DrawTextBlob: out[0] = 1; out[1] = 5; return 2;
+    case CheapCommand_PaintSetShader:
+    case CheapCommand_PaintSetColorFilter: out[0] = 1; out[1] = 3; return 2;
+    default:
+      if ((op >= CheapCommand_PaintSetColor && op <= CheapCommand_PaintSetBlendMode) ||
+          (op >= CheapCommand_PathSetFillType && op <= CheapCommand_PathArcToOval)) {
+        out[0] = 1;
+        return 1;
+      }
+      return 0;
+  }
+}
+
+// Rewrites recorded handles inside a command stream to the replayed objects. Returns false
+// if the stream references an object the replay doesn't know.
+bool RemapCommandHandles(uint8_t* buf, size_t len, ReplayContext& ctx) {
+  const size_t words = len / 4;
+  size_t pos = 0;
+  while (pos < words) {
+    uint32_t header;
+    std::memcpy(&header, buf + pos * 4, 4);
+    const uint32_t count = header >> 16;
+    if (count == 0 || pos + count > words) {
+      return true;  // Canvas_submitCommands stops here too
+    }
+    int offsets[2];
+    const int n = CommandHandleOffsets(header & 0xffff, offsets);
+    for (int i = 0; i < n; i++) {
+      if (static_cast<uint32_t>(offsets[i]) + 1 >= count) {
+        break;
+      }
+      uint8_t* slot = buf + (pos + offsets[i]) * 4;
+      uint32_t lo;
+      std::memcpy(&lo, slot, 4);
+      bool mapped = true;
+      const uint64_t live = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ctx.lookup(lo, &mapped)));
+      if (!mapped) {
+        return false;
+      }
+      const uint32_t words2[2] = {static_cast<uint32_t>(live), static_cast<uint32_t>(live >> 32)};
+      std::memcpy(slot, words2, 8);
+    }
+    pos += count;
+  }
+  return true;
+}
+
+CallResult ReplaySubmitCommands(Reader& r, ReplayContext& ctx, int argCount, double* ns) {
+  if (argCount != 3) {
+    return CallResult::kMalformed;
+  }
+  const Arg canvasArg = DecodeArg(r, ctx);
+  const Arg bufArg = DecodeArg(r, ctx);
+  const Arg lenArg = DecodeArg(r, ctx);
+  DecodeArg(r, ctx);  // result
+  if (!r.ok()) {
+    return CallResult::kMalformed;
+  }
+
+  bool mapped = true;
+  void* canvas = ConvertArg<void*>(canvasArg, ctx, &mapped);
+  const int len = std::min(ConvertArg<int>(lenArg, ctx, &mapped), static_cast<int>(bufArg.size));
+  if (!mapped || !bufArg.ptr || len <= 0 || !RemapCommandHandles(bufArg.ptr, len, ctx)) {
+    return CallResult::kSkipped;
+  }
+
+  const double t0 = NowNs();
+  Canvas_submitCommands(canvas, bufArg.ptr, len);
+  *ns = NowNs() - t0;
+  return CallResult::kReplayed;
+}
+
+struct FunctionEntry {
+  const char* name;
+  Thunk thunk;
+};
+
+const FunctionEntry kFunctions[] = {
+#define CHEAP_TRACE_ENTRY(name) {#name, &Replayer<decltype(&name), &name>::Call},
+    CHEAP_TRACE_FUNCTIONS(CHEAP_TRACE_ENTRY)
+#undef CHEAP_TRACE_ENTRY
+};
+
+Thunk FindThunk(const std::string& name) {
+  // Replays run on raster surfaces only.
+  if (name == "MakeCanvasSurface") {
+    return &Replayer<decltype(&MakeSWCanvasSurface), &MakeSWCanvasSurface>::Call;
+  }
+  if (name == "Canvas_submitCommands") {
+    return &ReplaySubmitCommands;
+  }
+  for (const FunctionEntry& f : kFunctions) {
+    if (name == f.name) {
+      return f.thunk;
+    }
+  }
+  return nullptr;
+}
+
+struct FunctionStats {
+  std::string name;
+  Thunk thunk = nullptr;
+  uint64_t calls = 0;
+  uint64_t skipped = 0;
+  double ns = 0;
+};
+
+struct PassStats {
+  uint64_t frames = 0;
+  double frameNs = 0;
+};
+
+// Replays the whole trace once. Returns false if the trace is malformed.
+bool ReplayOnce(const std::vector<uint8_t>& trace, std::vector<FunctionStats>* stats, PassStats* pass) {
+  Reader r(trace.data(), trace.size());
+  if (r.u32() != CheapTrace_Magic || r.u32() != CheapTrace_Version) {
+    std::fprintf(stderr, "error: not a cheap ABI trace (or unsupported version)\n");
+    return false;
+  }
+
+  ReplayContext ctx;
+  std::unordered_map<uint16_t, size_t> ids;  // trace id -> stats index
+  double frameStart = NowNs();
+
+  while (!r.atEnd()) {
+    const uint8_t record = r.u8();
+    if (record == CheapTraceRecord_Define) {
+      const uint16_t id = r.u16();
+      const uint8_t length = r.u8();
+      const uint8_t* name = r.bytes(length);
+      if (!name) {
+        break;
+      }
+      const std::string fn(reinterpret_cast<const char*>(name), length);
+      auto it = std::find_if(stats->begin(), stats->end(),
+                             [&](const FunctionStats& s) { return s.name == fn; });
+      if (it == stats->end()) {
+        stats->push_back({fn, FindThunk(fn)});
+        it = stats->end() - 1;
+        if (!it->thunk) {
+          std::fprintf(stderr, "warning: %s is not in this build; its calls are skipped\n", fn.c_str());
+        }
+      }
+      ids[id] = static_cast<size_t>(it - stats->begin());
+    } else if (record == CheapTraceRecord_Call) {
+      const uint16_t id = r.u16();
+      const int argCount = r.u8();
+      auto it = ids.find(id);
+      if (it == ids.end()) {
+        std::fprintf(stderr, "error: call to undefined function id %u\n", id);
+        return false;
+      }
+      FunctionStats& s = (*stats)[it->second];
+      double ns = 0;
+      CallResult result = CallResult::kSkipped;
+      if (s.thunk) {
+        result = s.thunk(r, ctx, argCount, &ns);
+      } else {
+        for (int i = 0; i <= argCount; i++) {
+          DecodeArg(r, ctx);
+        }
+        result = r.ok() ? CallResult::kSkipped : CallResult::kMalformed;
+      }
+      ctx.endCall();
+      if (result == CallResult::kMalformed) {
+        std::fprintf(stderr, "error: malformed call to %s\n", s.name.c_str());
+        return false;
+      }
+      if (result == CallResult::kSkipped) {
+        s.skipped++;
+      } else {
+        s.calls++;
+        s.ns += ns;
+      }
+    } else if (record == CheapTraceRecord_Frame) {
+      const double now = NowNs();
+      pass->frames++;
+      pass->frameNs += now - frameStart;
+      frameStart = now;
+    } else {
+      std::fprintf(stderr, "error: unknown record type %u\n", record);
+      return false;
+    }
+  }
+  if (!r.ok()) {
+    std::fprintf(stderr, "error: truncated trace\n");
+    return false;
+  }
+  return true;
+}
+
+bool ReadFile(const char* path, std::vector<uint8_t>* out) {
+  FILE* f = std::fopen(path, "rb");
+  if (!f) {
+    return false;
+  }
+  uint8_t chunk[1 << 16];
+  size_t n;
+  while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+    out->insert(out->end(), chunk, chunk + n);
+  }
+  std::fclose(f);
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* path = nullptr;
+  int loops = 1;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--loops") == 0 && i + 1 < argc) {
+      loops = std::atoi(argv[++i]);
+    } else if (!path) {
+      path = argv[i];
+    } else {
+      path = nullptr;
+      break;
+    }
+  }
+  if (!path || loops <= 0) {
+    std::fprintf(stderr, "usage: %s trace.bin [--loops N]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<uint8_t> trace;
+  if (!ReadFile(path, &trace)) {
+    std::fprintf(stderr, "error: cannot read %s\n", path);
+    return 1;
+  }
+
+  std::vector<FunctionStats> stats;
+  PassStats pass;
+  for (int i = 0; i < loops; i++) {
+    if (!ReplayOnce(trace, &stats, &pass)) {
+      return 1;
+    }
+  }
+
+  double totalNs = 0;
+  uint64_t totalCalls = 0;
+  for (const FunctionStats& s : stats) {
+    totalNs += s.ns;
+    totalCalls += s.calls;
+  }
+  std::sort(stats.begin(), stats.end(),
+            [](const FunctionStats& a, const FunctionStats& b) { return a.ns > b.ns; });
+
+  std::printf("[replay] trace=%s bytes=%zu loops=%d calls=%llu total=%.3f ms\n",
+              path, trace.size(), loops, static_cast<unsigned long long>(totalCalls), totalNs / 1e6);
+  if (pass.frames) {
+    std::printf("[frames] frames=%llu mean=%.3f ms/frame\n",
+                static_cast<unsigned long long>(pass.frames), pass.frameNs / pass.frames / 1e6);
+  }
+  std::printf("%10s %10s %12s %7s  %s\n", "calls", "mean_ns", "total_ms", "share", "function");
+  for (const FunctionStats& s : stats) {
+    if (!s.calls && !s.skipped) {
+      continue;
+    }
+    std::printf("%10llu %10.1f %12.3f %6.1f%%  %s",
+                static_cast<unsigned long long>(s.calls),
+                s.calls ? s.ns / s.calls : 0.0,
+                s.ns / 1e6,
+                totalNs > 0 ? 100.0 * s.ns / totalNs : 0.0,
+                s.name.c_str());
+    if (s.skipped) {
+      std::printf("  (%llu skipped)", static_cast<unsigned long long>(s.skipped));
+    }
+    std::printf("\n");
+  }
+  return 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// Binary call-trace format for the cheap C ABI.
+//
+// Traces are recorded on the host side of the ABI (see CallTrace.ts in the bindings
+// package) and replayed natively by canvaskit_cheap_replay against a raster surface.
+//
+// All integers are little-endian. A trace is the 8-byte header followed by records:
+//
+//   header:  u32 magic (CheapTrace_Magic), u32 version (CheapTrace_Version)
+//
+//   Define:  u8 CheapTraceRecord_Define, u16 id, u8 nameLength, name bytes
+//            Introduces a function name the first time it is called; later calls refer
+//            to it by id.
+//   Call:    u8 CheapTraceRecord_Call, u16 id, u8 argCount, args..., result
+//            Each arg and the result start with a CheapTraceArg tag:
+//              Null                  null pointer / no result
+//              Int     u32           int, uint32_t and enum arguments
+//              Float   f32
+//              Handle  u32           object handle as seen by the recorder; results of
+//                                    handle-returning calls are recorded so later
+//                                    arguments can be mapped onto replayed objects
+//              Blob    u32 n, bytes  input buffer contents at call time
+//              Out     u32 n         output buffer of n bytes (contents not recorded)
+//              Pixels  u32 n         caller-owned memory that must outlive the call
+//                                    (e.g. MakeSWCanvasSurfaceWrapPixels)
+//   Frame:   u8 CheapTraceRecord_Frame
+//            Frame boundary marker, used for per-frame timing.
+//
+// Handles embedded in Canvas_submitCommands streams are remapped by the replayer.
+
+#include <stdint.h>
+
+enum {
+  CheapTrace_Magic = 0x52544b43,  // "CKTR"
+  CheapTrace_Version = 1,
+};
+
+enum CheapTraceRecord {
+  CheapTraceRecord_Define = 1,
+  CheapTraceRecord_Call = 2,
+  CheapTraceRecord_Frame = 3,
+};
+
+enum CheapTraceArg {
+  CheapTraceArg_Null = 0,
+  CheapTraceArg_Int = 1,
+  CheapTraceArg_Float = 2,
+  CheapTraceArg_Handle = 3,
+  CheapTraceArg_Blob = 4,
+  CheapTraceArg_Out = 5,
+  CheapTraceArg_Pixels = 6,
+};
@@ -1421,12 +1421,14 @@ void ParagraphImpl::extendedVisit(const ExtendedVisitor& visitor) {
                     glyphBounds.reset(SkToInt(run->size()));
                     run->font().getBounds(run->glyphs(), glyphBounds, nullptr);
                     STArray<128, uint32_t> clusterStorage;
-                    const uint32_t* clusterPtr = run->clusterIndexes().data();
+                    // utf8Starts, like glyphs and positions, starts at context.pos and
+                    // holds count+1 values.
+                    const uint32_t* clusterPtr = run->clusterIndexes().data() + context.pos;
                     if (run->fClusterStart > 0) {
-                        clusterStorage.reset(context.size);
-                        for (size_t i = 0; i < context.size; ++i) {
+                        clusterStorage.reset(context.size + 1);
+                        for (size_t i = 0; i <= context.size; ++i) {
                           clusterStorage[i] =
-                              run->fClusterStart + run->fClusterIndexes[i];
+                              run->fClusterStart + run->fClusterIndexes[context.pos + i];
                         }
                         clusterPtr = &clusterStorage[0];
                     }
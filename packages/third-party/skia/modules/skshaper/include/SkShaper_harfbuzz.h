@@ -14,6 +14,7 @@
 #include "modules/skshaper/include/SkShaper.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 
 class SkFontMgr;
@@ -34,6 +35,22 @@ SKSHAPER_API std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(cons
                                                                             SkFourByteTag script);
 
 SKSHAPER_API void PurgeCaches();
+
+/**
+ *  Enables a process-wide cache of shaping results, holding at most maxEntries segments.
+ *  Runs are then shaped one space-delimited segment at a time, and a segment shaped before with
+ *  the same font, features, script, direction and language reuses its glyphs. Shaping a segment
+ *  without its neighbors loses any lookups that reach across spaces, so this is off by default.
+ *  A limit of 0 disables and empties the cache.
+ */
+SKSHAPER_API void SetShapeCacheLimit(int maxEntries);
+
+struct ShapeCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    int entries = 0;
+};
+SKSHAPER_API ShapeCacheStats GetShapeCacheStats();
 }  // namespace SkShapers::HB
 
 #endif
@@ -32,8 +32,10 @@
 #include "include/private/base/SkTypeTraits.h"
 #include "modules/skshaper/include/SkShaper.h"
 #include "modules/skunicode/include/SkUnicode.h"
+#include "src/base/SkFloatBits.h"
 #include "src/base/SkTDPQueue.h"
 #include "src/base/SkUTF.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkLRUCache.h"
 
 #if !defined(SK_DISABLE_LEGACY_SKSHAPER_FUNCTIONS)
@@ -43,11 +45,13 @@
 #include <hb-ot.h>
 #include <hb.h>
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -1292,6 +1296,214 @@ static HBLockedFaceCache get_hbFace_cache() {
     return HBLockedFaceCache(gHBFaceCache, gHBFaceCacheMutex);
 }
 
+// Reads the glyphs HarfBuzz left in the buffer, in logical order, into glyphs. Their clusters are
+// offset by clusterOffset. Returns the sum of their advances.
+SkVector read_shaped_glyphs(hb_buffer_t* buffer, const SkFont& font,
+                            ShapedGlyph glyphs[], uint32_t clusterOffset) {
+    unsigned len = hb_buffer_get_length(buffer);
+    hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
+    hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
+
+    // Undo skhb_position with (1.0/(1<<16)) and scale as needed.
+    AutoSTArray<32, SkGlyphID> glyphIDs(len);
+    for (unsigned i = 0; i < len; i++) {
+        glyphIDs[i] = info[i].codepoint;
+    }
+    AutoSTArray<32, SkRect> glyphBounds(len);
+    SkPaint p;
+    font.getBounds(glyphIDs, glyphBounds, &p);
+
+    double SkScalarFromHBPosX = +(1.52587890625e-5) * font.getScaleX();
+    double SkScalarFromHBPosY = -(1.52587890625e-5);  // HarfBuzz y-up, Skia y-down
+    SkVector advance = { 0, 0 };
+    for (unsigned i = 0; i < len; i++) {
+        ShapedGlyph& glyph = glyphs[i];
+        glyph.fID = info[i].codepoint;
+        glyph.fCluster = info[i].cluster + clusterOffset;
+        glyph.fOffset.fX = pos[i].x_offset * SkScalarFromHBPosX;
+        glyph.fOffset.fY = pos[i].y_offset * SkScalarFromHBPosY;
+        glyph.fAdvance.fX = pos[i].x_advance * SkScalarFromHBPosX;
+        glyph.fAdvance.fY = pos[i].y_advance * SkScalarFromHBPosY;
+
+        glyph.fHasVisual = !glyphBounds[i].isEmpty(); //!font->currentTypeface()->glyphBoundsAreZero(glyph.fID);
+#if SK_HB_VERSION_CHECK(1, 5, 0)
+        glyph.fUnsafeToBreak = info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK;
+#else
+        glyph.fUnsafeToBreak = false;
+#endif
+        glyph.fMustLineBreakBefore = false;
+
+        advance += glyph.fAdvance;
+    }
+    return advance;
+}
+
+// A space-delimited segment of a run shaped on its own. Clusters are relative to its start.
+struct ShapedSegment {
+    std::unique_ptr<ShapedGlyph[]> fGlyphs;
+    size_t fNumGlyphs;
+};
+
+struct ShapedSegmentKey {
+    ShapedSegmentKey(const SkFont& font, hb_direction_t direction, SkFourByteTag script,
+                     hb_language_t language, SkSpan<const hb_feature_t> features,
+                     const char* utf8, size_t utf8Bytes)
+            : fFont(font)
+            , fDirection(direction)
+            , fScript(script)
+            , fLanguage(language)
+            , fText(utf8, utf8Bytes) {
+        for (const hb_feature_t& feature : features) {
+            fFeatures.push_back(((uint64_t)feature.tag << 32) | feature.value);
+        }
+        const uint32_t fontKey[] = {
+            font.getTypeface()->uniqueID(),
+            SkFloat2Bits(font.getSize()),
+            SkFloat2Bits(font.getScaleX()),
+            SkFloat2Bits(font.getSkewX()),
+            (uint32_t)direction,
+            script,
+        };
+        fHash = SkChecksum::Hash32(fontKey, sizeof(fontKey));
+        fHash = SkChecksum::Hash32(fFeatures.data(), fFeatures.size() * sizeof(uint64_t), fHash);
+        fHash = SkChecksum::Hash32(utf8, utf8Bytes, fHash);
+    }
+
+    bool operator==(const ShapedSegmentKey& that) const {
+        return fHash      == that.fHash      &&
+               fFont      == that.fFont      &&
+               fDirection == that.fDirection &&
+               fScript    == that.fScript    &&
+               fLanguage  == that.fLanguage  &&
+               fFeatures  == that.fFeatures  &&
+               fText      == that.fText;
+    }
+
+    struct Hash {
+        uint32_t operator()(const ShapedSegmentKey& key) const { return key.fHash; }
+    };
+
+    // The typeface's unique ID also distinguishes its variation instances.
+    SkFont fFont;
+    hb_direction_t fDirection;
+    SkFourByteTag fScript;
+    hb_language_t fLanguage;  // HarfBuzz interns languages, so they compare by pointer.
+    std::vector<uint64_t> fFeatures;
+    SkString fText;
+    uint32_t fHash;
+};
+
+struct ShapeCache {
+    SkMutex fMutex;
+    std::unique_ptr<SkLRUCache<ShapedSegmentKey, ShapedSegment, ShapedSegmentKey::Hash>>
+            fSegments SK_GUARDED_BY(fMutex);
+    uint64_t fHits SK_GUARDED_BY(fMutex) = 0;
+    uint64_t fMisses SK_GUARDED_BY(fMutex) = 0;
+    std::atomic<bool> fEnabled{false};
+};
+static ShapeCache& get_shape_cache() {
+    static ShapeCache* gShapeCache = new ShapeCache;
+    return *gShapeCache;
+}
+
+ShapedSegment shape_segment(hb_buffer_t* buffer, hb_font_t* hbFont, const SkFont& font,
+                            const char* utf8Start, const char* utf8End,
+                            hb_direction_t direction, hb_script_t script, hb_language_t language,
+                            SkSpan<const hb_feature_t> features) {
+    hb_buffer_clear_contents(buffer);
+    hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
+    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+    const char* utf8Current = utf8Start;
+    while (utf8Current < utf8End) {
+        unsigned int cluster = utf8Current - utf8Start;
+        hb_codepoint_t u = utf8_next(&utf8Current, utf8End);
+        hb_buffer_add(buffer, u, cluster);
+    }
+    hb_buffer_set_direction(buffer, direction);
+    hb_buffer_set_script(buffer, script);
+    hb_buffer_set_language(buffer, language);
+    hb_buffer_guess_segment_properties(buffer);
+
+    hb_shape(hbFont, buffer, features.data(), features.size());
+    if (direction == HB_DIRECTION_RTL) {
+        hb_buffer_reverse(buffer);
+    }
+    unsigned len = hb_buffer_get_length(buffer);
+    ShapedSegment segment{std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]), len};
+    read_shaped_glyphs(buffer, font, segment.fGlyphs.get(), 0);
+    return segment;
+}
+
+// Shapes the run one space-delimited segment at a time, reusing segments found in the shape
+// cache. Returns false without touching the run if the cache is disabled.
+bool shape_with_segment_cache(ShapedRun* run, const char* utf8,
+                              const char* utf8Start, const char* utf8End,
+                              hb_buffer_t* buffer, hb_font_t* hbFont,
+                              hb_direction_t direction, hb_language_t language,
+                              SkSpan<const hb_feature_t> features) {
+    ShapeCache& cache = get_shape_cache();
+    if (!cache.fEnabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    const hb_script_t hbScript = hb_script_from_iso15924_tag((hb_tag_t)run->fScript);
+
+    STArray<64, ShapedGlyph> glyphs;
+    SkVector advance = { 0, 0 };
+    auto append = [&](const ShapedSegment& segment, uint32_t clusterOffset) {
+        for (size_t i = 0; i < segment.fNumGlyphs; ++i) {
+            ShapedGlyph& glyph = glyphs.push_back(segment.fGlyphs[i]);
+            glyph.fCluster += clusterOffset;
+            advance += glyph.fAdvance;
+        }
+    };
+
+    const char* segmentStart = utf8Start;
+    while (segmentStart < utf8End) {
+        // A space byte is never part of a multi-byte sequence.
+        const bool isSpace = *segmentStart == ' ';
+        const char* segmentEnd = segmentStart + 1;
+        while (segmentEnd < utf8End && (*segmentEnd == ' ') == isSpace) {
+            ++segmentEnd;
+        }
+        const uint32_t clusterOffset = SkTo<uint32_t>(segmentStart - utf8);
+        ShapedSegmentKey key(run->fFont, direction, run->fScript, language, features,
+                             segmentStart, segmentEnd - segmentStart);
+
+        bool found = false;
+        {
+            SkAutoMutexExclusive lock(cache.fMutex);
+            if (cache.fSegments) {
+                if (const ShapedSegment* segment = cache.fSegments->find(key)) {
+                    append(*segment, clusterOffset);
+                    found = true;
+                    ++cache.fHits;
+                } else {
+                    ++cache.fMisses;
+                }
+            }
+        }
+        if (!found) {
+            // Shape outside the lock so other threads are not held up by HarfBuzz.
+            ShapedSegment segment = shape_segment(buffer, hbFont, run->fFont,
+                                                  segmentStart, segmentEnd,
+                                                  direction, hbScript, language, features);
+            append(segment, clusterOffset);
+
+            SkAutoMutexExclusive lock(cache.fMutex);
+            if (cache.fSegments && !cache.fSegments->find(key)) {
+                cache.fSegments->insert(std::move(key), std::move(segment));
+            }
+        }
+        segmentStart = segmentEnd;
+    }
+
+    std::unique_ptr<ShapedGlyph[]> runGlyphs(new ShapedGlyph[glyphs.size()]);
+    std::copy(glyphs.begin(), glyphs.end(), runGlyphs.get());
+    *run = ShapedRun(run->fUtf8Range, run->fFont, run->fLevel, run->fScript, run->fLanguage,
+                     std::move(runGlyphs), glyphs.size(), advance);
+    return true;
+}
+
 ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                                   size_t const utf8Bytes,
                                   char const * const utf8Start,
@@ -1308,33 +1520,7 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                   script.currentScript(), language.currentLanguage(),
                   nullptr, 0);
 
-    hb_buffer_t* buffer = fBuffer.get();
-    SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
-    hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
-    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
-
-    // Documentation for HB_BUFFER_FLAG_BOT/EOT at 763e5466c0a03a7c27020e1e2598e488612529a7.
-    // Currently BOT forces a dotted circle when first codepoint is a mark; EOT has no effect.
-    // Avoid adding dotted circle, re-evaluate if BOT/EOT change. See https://skbug.com/40040947.
-    // hb_buffer_set_flags(buffer, HB_BUFFER_FLAG_BOT | HB_BUFFER_FLAG_EOT);
-
-    // Add precontext.
-    hb_buffer_add_utf8(buffer, utf8, utf8Start - utf8, utf8Start - utf8, 0);
-
-    // Populate the hb_buffer directly with utf8 cluster indexes.
-    const char* utf8Current = utf8Start;
-    while (utf8Current < utf8End) {
-        unsigned int cluster = utf8Current - utf8;
-        hb_codepoint_t u = utf8_next(&utf8Current, utf8End);
-        hb_buffer_add(buffer, u, cluster);
-    }
-
-    // Add postcontext.
-    hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
-
     hb_direction_t direction = is_LTR(bidi.currentLevel()) ? HB_DIRECTION_LTR:HB_DIRECTION_RTL;
-    hb_buffer_set_direction(buffer, direction);
-    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
     // Buffers with HB_LANGUAGE_INVALID race since hb_language_get_default is not thread safe.
     // The user must provide a language, but may provide data hb_language_from_string cannot use.
     // Use "und" for the undefined language in this case (RFC5646 4.1 5).
@@ -1342,8 +1528,6 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     if (hbLanguage == HB_LANGUAGE_INVALID) {
         hbLanguage = fUndefinedLanguage;
     }
-    hb_buffer_set_language(buffer, hbLanguage);
-    hb_buffer_guess_segment_properties(buffer);
 
     // TODO: better cache HBFace (data) / hbfont (typeface)
     // An HBFace is expensive (it sanitizes the bits).
@@ -1366,6 +1550,7 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
 
     STArray<32, hb_feature_t> hbFeatures;
+    bool featuresCoverRun = true;
     for (const auto& feature : SkSpan(features, featuresSize)) {
         if (feature.end < SkTo<size_t>(utf8Start - utf8) ||
                           SkTo<size_t>(utf8End   - utf8)  <= feature.start)
@@ -1380,9 +1565,47 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         } else {
             hbFeatures.push_back({ (hb_tag_t)feature.tag, feature.value,
                                    SkTo<unsigned>(feature.start), SkTo<unsigned>(feature.end)});
+            featuresCoverRun = false;
         }
     }
 
+    hb_buffer_t* buffer = fBuffer.get();
+    SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
+
+    // Features applied to part of the run would not line up with the segments' clusters.
+    if (featuresCoverRun &&
+        shape_with_segment_cache(&run, utf8, utf8Start, utf8End, buffer, hbFont.get(),
+                                 direction, hbLanguage, hbFeatures)) {
+        return run;
+    }
+
+    hb_buffer_set_content_type(buffer, HB_BUFFER_CONTENT_TYPE_UNICODE);
+    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+
+    // Documentation for HB_BUFFER_FLAG_BOT/EOT at 763e5466c0a03a7c27020e1e2598e488612529a7.
+    // Currently BOT forces a dotted circle when first codepoint is a mark; EOT has no effect.
+    // Avoid adding dotted circle, re-evaluate if BOT/EOT change. See https://skbug.com/40040947.
+    // hb_buffer_set_flags(buffer, HB_BUFFER_FLAG_BOT | HB_BUFFER_FLAG_EOT);
+
+    // Add precontext.
+    hb_buffer_add_utf8(buffer, utf8, utf8Start - utf8, utf8Start - utf8, 0);
+
+    // Populate the hb_buffer directly with utf8 cluster indexes.
+    const char* utf8Current = utf8Start;
+    while (utf8Current < utf8End) {
+        unsigned int cluster = utf8Current - utf8;
+        hb_codepoint_t u = utf8_next(&utf8Current, utf8End);
+        hb_buffer_add(buffer, u, cluster);
+    }
+
+    // Add postcontext.
+    hb_buffer_add_utf8(buffer, utf8Current, utf8 + utf8Bytes - utf8Current, 0, 0);
+
+    hb_buffer_set_direction(buffer, direction);
+    hb_buffer_set_script(buffer, hb_script_from_iso15924_tag((hb_tag_t)script.currentScript()));
+    hb_buffer_set_language(buffer, hbLanguage);
+    hb_buffer_guess_segment_properties(buffer);
+
     hb_shape(hbFont.get(), buffer, hbFeatures.data(), hbFeatures.size());
     unsigned len = hb_buffer_get_length(buffer);
     if (len == 0) {
@@ -1394,46 +1617,11 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
         // Note that the advances remain ltr.
         hb_buffer_reverse(buffer);
     }
-    hb_glyph_info_t* info = hb_buffer_get_glyph_infos(buffer, nullptr);
-    hb_glyph_position_t* pos = hb_buffer_get_glyph_positions(buffer, nullptr);
-
     run = ShapedRun(RunHandler::Range(utf8Start - utf8, utf8runLength),
                     font.currentFont(), bidi.currentLevel(),
                     script.currentScript(), language.currentLanguage(),
                     std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]), len);
-
-    // Undo skhb_position with (1.0/(1<<16)) and scale as needed.
-    AutoSTArray<32, SkGlyphID> glyphIDs(len);
-    for (unsigned i = 0; i < len; i++) {
-        glyphIDs[i] = info[i].codepoint;
-    }
-    AutoSTArray<32, SkRect> glyphBounds(len);
-    SkPaint p;
-    run.fFont.getBounds(glyphIDs, glyphBounds, &p);
-
-    double SkScalarFromHBPosX = +(1.52587890625e-5) * run.fFont.getScaleX();
-    double SkScalarFromHBPosY = -(1.52587890625e-5);  // HarfBuzz y-up, Skia y-down
-    SkVector runAdvance = { 0, 0 };
-    for (unsigned i = 0; i < len; i++) {
-        ShapedGlyph& glyph = run.fGlyphs[i];
-        glyph.fID = info[i].codepoint;
-        glyph.fCluster = info[i].cluster;
-        glyph.fOffset.fX = pos[i].x_offset * SkScalarFromHBPosX;
-        glyph.fOffset.fY = pos[i].y_offset * SkScalarFromHBPosY;
-        glyph.fAdvance.fX = pos[i].x_advance * SkScalarFromHBPosX;
-        glyph.fAdvance.fY = pos[i].y_advance * SkScalarFromHBPosY;
-
-        glyph.fHasVisual = !glyphBounds[i].isEmpty(); //!font->currentTypeface()->glyphBoundsAreZero(glyph.fID);
-#if SK_HB_VERSION_CHECK(1, 5, 0)
-        glyph.fUnsafeToBreak = info[i].mask & HB_GLYPH_FLAG_UNSAFE_TO_BREAK;
-#else
-        glyph.fUnsafeToBreak = false;
-#endif
-        glyph.fMustLineBreakBefore = false;
-
-        runAdvance += glyph.fAdvance;
-    }
-    run.fAdvance = runAdvance;
+    run.fAdvance = read_shaped_glyphs(buffer, run.fFont, run.fGlyphs.get(), 0);
 
     return run;
 }
@@ -1552,7 +1740,36 @@ std::unique_ptr<SkShaper::ScriptRunIterator> ScriptRunIterator(const char* utf8,
 }
 
 void PurgeCaches() {
-    HBLockedFaceCache cache = get_hbFace_cache();
-    cache.reset();
+    {
+        HBLockedFaceCache cache = get_hbFace_cache();
+        cache.reset();
+    }
+    ShapeCache& shapeCache = get_shape_cache();
+    SkAutoMutexExclusive lock(shapeCache.fMutex);
+    if (shapeCache.fSegments) {
+        shapeCache.fSegments->reset();
+    }
+}
+
+void SetShapeCacheLimit(int maxEntries) {
+    ShapeCache& cache = get_shape_cache();
+    SkAutoMutexExclusive lock(cache.fMutex);
+    if (maxEntries > 0) {
+        cache.fSegments = std::make_unique<
+                SkLRUCache<ShapedSegmentKey, ShapedSegment, ShapedSegmentKey::Hash>>(maxEntries);
+    } else {
+        cache.fSegments.reset();
+    }
+    cache.fEnabled.store(maxEntries > 0, std::memory_order_relaxed);
+}
+
+ShapeCacheStats GetShapeCacheStats() {
+    ShapeCache& cache = get_shape_cache();
+    SkAutoMutexExclusive lock(cache.fMutex);
+    ShapeCacheStats stats;
+    stats.hits = cache.fHits;
+    stats.misses = cache.fMisses;
+    stats.entries = cache.fSegments ? cache.fSegments->count() : 0;
+    return stats;
 }
 }  // namespace SkShapers::HB
@@ -17,12 +17,15 @@
 #include "modules/skshaper/include/SkShaper_skunicode.h"
 #include "modules/skunicode/include/SkUnicode.h"
 #include "src/base/SkZip.h"
+#include "src/core/SkPointPriv.h"
 #include "tools/Resources.h"
 #include "tools/fonts/FontToolUtils.h"
 
 #include <cinttypes>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #if defined(SK_UNICODE_ICU_IMPLEMENTATION)
 #include "modules/skunicode/include/SkUnicode_icu.h"
@@ -216,6 +219,39 @@ void shaper_test(skiatest::Reporter* reporter, const char* name, SkData* data) {
                   &rh);
 }
 
+struct CollectingRunHandler final : public SkShaper::RunHandler {
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+    size_t fRunStart = 0;
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        fRunStart = fGlyphs.size();
+        fGlyphs.resize(fRunStart + info.glyphCount);
+        fPositions.resize(fRunStart + info.glyphCount);
+        fClusters.resize(fRunStart + info.glyphCount);
+        return {&fGlyphs[fRunStart], &fPositions[fRunStart], nullptr, &fClusters[fRunStart],
+                {0, 0}};
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override {}
+};
+
+void shape_collecting(SkShaper* shaper, const SkFont& font, const char* utf8,
+                      CollectingRunHandler* handler) {
+    const size_t utf8Bytes = strlen(utf8);
+    auto fontIterator = SkShaper::TrivialFontRunIterator(font, utf8Bytes);
+    auto bidiIterator = SkShaper::TrivialBiDiRunIterator(0, utf8Bytes);
+    auto scriptIterator =
+            SkShaper::TrivialScriptRunIterator(SkSetFourByteTag('l','a','t','n'), utf8Bytes);
+    auto languageIterator = SkShaper::TrivialLanguageRunIterator("en-US", utf8Bytes);
+    shaper->shape(utf8, utf8Bytes, fontIterator, bidiIterator, scriptIterator, languageIterator,
+                  nullptr, 0, SK_ScalarInfinity, handler);
+}
+
 void cluster_test(skiatest::Reporter* reporter, const char* resource) {
     auto data = GetResourceAsData(resource);
     if (!data) {
@@ -271,4 +307,41 @@ SHAPER_TEST(taitham)
 SHAPER_TEST(tamil)
 #undef SHAPER_TEST
 
+// Runs shaped through the shape cache reuse repeated words, and match shaping without it.
+DEF_TEST(Shaper_shapeCache, r) {
+    auto unicode = get_unicode();
+    if (!unicode) {
+        ERRORF(r, "Could not create unicode.");
+        return;
+    }
+    auto shaper = SkShapers::HB::ShapeDontWrapOrReorder(unicode, SkFontMgr::RefEmpty());
+    const SkFont font = ToolUtils::DefaultFont();
+    const char* text = "OK Cancel  OK Cancel OK";
+
+    CollectingRunHandler expected;
+    shape_collecting(shaper.get(), font, text, &expected);
+
+    SkShapers::HB::SetShapeCacheLimit(64);
+    const SkShapers::HB::ShapeCacheStats before = SkShapers::HB::GetShapeCacheStats();
+    CollectingRunHandler cached;
+    shape_collecting(shaper.get(), font, text, &cached);
+    const SkShapers::HB::ShapeCacheStats after = SkShapers::HB::GetShapeCacheStats();
+    SkShapers::HB::SetShapeCacheLimit(0);
+
+    // "OK", "Cancel", " " and "  " are shaped; the other five segments are reused.
+    REPORTER_ASSERT(r, after.hits - before.hits >= 5, "hits %" PRIu64, after.hits - before.hits);
+    REPORTER_ASSERT(r, after.entries >= 4, "entries %d", after.entries);
+    REPORTER_ASSERT(r, SkShapers::HB::GetShapeCacheStats().entries == 0);
+
+    REPORTER_ASSERT(r, expected.fGlyphs == cached.fGlyphs);
+    REPORTER_ASSERT(r, expected.fClusters == cached.fClusters);
+    if (expected.fPositions.size() == cached.fPositions.size()) {
+        for (size_t i = 0; i < expected.fPositions.size(); ++i) {
+            REPORTER_ASSERT(r, SkPointPriv::EqualsWithinTolerance(expected.fPositions[i],
+                                                                  cached.fPositions[i]),
+                            "glyph %zu", i);
+        }
+    }
+}
+
 #endif  // #if defined(SK_SHAPER_HARFBUZZ_AVAILABLE) && defined(SK_SHAPER_UNICODE_AVAILABLE)
@@ -29,8 +29,10 @@
 #include "include/core/SkTileMode.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkTo.h"
+#include "src/core/SkCPUContextImpl.h"
 #include "src/core/SkCPURecorderImpl.h"
 #include "src/core/SkDraw.h"
+#include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMatrixPriv.h"
@@ -632,6 +634,17 @@ sk_sp<SkSpecialImage> SkBitmapDevice::snapSpecial(const SkIRect& bounds, bool fo
     }
 }
 
+sk_sp<skif::Backend> SkBitmapDevice::createImageFilteringBackend(
+        const SkSurfaceProps& surfaceProps, SkColorType colorType) const {
+    // Let the blur engine and tiled filter evaluation use the context's executor, if it has one.
+    if (!fRecorder) {
+        return skif::MakeRasterBackend(surfaceProps, colorType);
+    }
+    const skcpu::Context::Options& options = fRecorder->ctx()->options();
+    return skif::MakeRasterBackend(
+            surfaceProps, colorType, options.fExecutor, options.fImageFilterTileSize);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 sk_sp<SkSurface> SkBitmapDevice::makeSurface(const SkImageInfo& info, const SkSurfaceProps& props) {
@@ -1381,10 +1381,10 @@ static inline SkPMColor blend_lcd16_opaque(int srcR, int srcG, int srcB,
 
 #endif
 
-static bool blit_color(const SkPixmap& device,
-                       const SkMask& mask,
-                       const SkIRect& clip,
-                       SkColor color) {
+bool SkARGB32_BlitColorMask(const SkPixmap& device,
+                            const SkMask& mask,
+                            const SkIRect& clip,
+                            SkColor color) {
     int x = clip.fLeft,
         y = clip.fTop;
 
@@ -1558,7 +1558,7 @@ void SkARGB32_Blitter::blitMask(const SkMask& mask, const SkIRect& clip) {
         return;
     }
 
-    if (blit_color(fDevice, mask, clip, fColor)) {
+    if (SkARGB32_BlitColorMask(fDevice, mask, clip, fColor)) {
         return;
     }
 
@@ -1579,7 +1579,7 @@ void SkARGB32_Opaque_Blitter::blitMask(const SkMask& mask,
     SkASSERT(fSrcA == 0xFF);
     SkASSERT(mask.fBounds.contains(clip));
 
-    if (blit_color(fDevice, mask, clip, fColor)) {
+    if (SkARGB32_BlitColorMask(fDevice, mask, clip, fColor)) {
         return;
     }
 
@@ -36,12 +36,14 @@
 #include "src/core/SkDevice.h"
 #include "src/core/SkKnownRuntimeEffects.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <utility>
 
 
@@ -86,7 +88,7 @@ public:
             // https://drafts.fxtf.org/filter-effects/#FilterPrimitivesOverviewIntro
             int commonEnd = std::min(srcIdx, dstEnd);
             while (dstIdx < commonEnd) {
-                *dstCursor = 0;
+                *dstCursor = T{};
                 dstCursor += dstStride;
                 SK_PREFETCH(dstCursor);
                 dstIdx++;
@@ -153,16 +155,43 @@ private:
     const float fSigma;
 };
 
-// T is type of the pixel format for the color type.
-// This should only be used for 8bit color channels.
+// Rows (or columns) handed to each task when a pass is split across an SkExecutor.
+static constexpr int kLinesPerTask = 32;
+
+// Calls blurLines(pass, start, end) over [loopStart, loopEnd). Every call gets its own Pass and
+// scratch buffer, so when an executor is given the lines are split into tasks that run
+// concurrently; each line only reads and writes its own row or column of pixels.
+template <typename Fn>
+static void for_each_line_span(SkExecutor* executor, const PassMaker* maker,
+                               int loopStart, int loopEnd, Fn&& blurLines) {
+    auto blurSpan = [&](int start, int end) {
+        // 1024 is a place holder guess until more analysis can be done.
+        SkSTArenaAlloc<1024> alloc;
+        void* buffer = alloc.makeBytesAlignedTo(maker->bufferSizeBytes(),
+                                                alignof(skvx::Vec<4, uint32_t>));
+        blurLines(maker->makePass(buffer, &alloc), start, end);
+    };
+
+    const int lineCount = loopEnd - loopStart;
+    if (!executor || lineCount <= kLinesPerTask) {
+        blurSpan(loopStart, loopEnd);
+        return;
+    }
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch((lineCount + kLinesPerTask - 1) / kLinesPerTask, [&](int i) {
+        int start = loopStart + i * kLinesPerTask;
+        blurSpan(start, std::min(start + kLinesPerTask, loopEnd));
+    });
+    taskGroup.wait();
+}
+
+// T is type of the pixel format for the color type. The passes decide how its channels are
+// loaded and stored; T only determines the pixel stride.
 template <typename T>
 static sk_sp<SkSpecialImage> eval_blur_passes(PassMaker* makerX, PassMaker* makerY,
                                               SkBitmap src, const SkIRect& originalSrcBounds,
                                               const SkIRect& originalDstBounds,
-                                              SkArenaAlloc* alloc) {
-    static constexpr int N = sizeof(T) / sizeof(uint8_t);
-    static_assert(N*sizeof(uint8_t) == sizeof(T), "N must be the the size of T in bytes.");
-
+                                              SkExecutor* executor) {
     SkIRect srcBounds = originalSrcBounds;
     SkIRect dstBounds = originalDstBounds;
     if (makerX->window() > 1) {
@@ -182,10 +211,6 @@ static sk_sp<SkSpecialImage> eval_blur_passes(PassMaker* makerX, PassMaker* make
     }
     dst.eraseColor(SK_ColorTRANSPARENT);
 
-    auto buffer = alloc->makeBytesAlignedTo(std::max(makerX->bufferSizeBytes(),
-                                            makerY->bufferSizeBytes()),
-                                            alignof(skvx::Vec<N, uint32_t>));
-
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
     //     the destination. Then, do an in-place vertical blur.
@@ -203,20 +228,21 @@ static sk_sp<SkSpecialImage> eval_blur_passes(PassMaker* makerX, PassMaker* make
         loopStart = std::max(srcBounds.top(),    dstBounds.top());
         loopEnd   = std::min(srcBounds.bottom(), dstBounds.bottom());
 
-        auto srcAddr = reinterpret_cast<T*>(src.getAddr(0, loopStart - srcBounds.top()));
-        auto dstAddr = reinterpret_cast<T*>(dst.getAddr(0, loopStart - dstBounds.top()));
-
         // Iterate over each row to calculate 1D blur along X.
-        Pass* pass = makerX->makePass(buffer, alloc);
-        for (int y = loopStart; y < loopEnd; ++y) {
-            pass->blur<T>(srcBounds.left()  - dstBounds.left(),
-                          srcBounds.right() - dstBounds.left(),
-                          dstBounds.width(),
-                          srcAddr, 1,
-                          dstAddr, 1);
-            srcAddr += src.rowBytesAsPixels();
-            dstAddr += dst.rowBytesAsPixels();
-        }
+        for_each_line_span(executor, makerX, loopStart, loopEnd,
+                           [&](Pass* pass, int start, int end) {
+            auto srcAddr = reinterpret_cast<T*>(src.getAddr(0, start - srcBounds.top()));
+            auto dstAddr = reinterpret_cast<T*>(dst.getAddr(0, start - dstBounds.top()));
+            for (int y = start; y < end; ++y) {
+                pass->blur<T>(srcBounds.left()  - dstBounds.left(),
+                              srcBounds.right() - dstBounds.left(),
+                              dstBounds.width(),
+                              srcAddr, 1,
+                              dstAddr, 1);
+                srcAddr += src.rowBytesAsPixels();
+                dstAddr += dst.rowBytesAsPixels();
+            }
+        });
 
         // Set up the Y pass to blur from the full dst into the non-outset portion of dst
         src = dst;
@@ -235,19 +261,21 @@ static sk_sp<SkSpecialImage> eval_blur_passes(PassMaker* makerX, PassMaker* make
     // into dst for a 1D blur; or it's blurring from dst into dst for the second pass of a 2D
     // blur.
     if (makerY->window() > 1) {
-        auto srcAddr = reinterpret_cast<T*>(src.getAddr(loopStart - srcBounds.left(), 0));
-        auto dstAddr = reinterpret_cast<T*>(dst.getAddr(loopStart - dstBounds.left(), dstYOffset));
-
-        Pass* pass = makerY->makePass(buffer, alloc);
-        for (int x = loopStart; x < loopEnd; ++x) {
-            pass->blur<T>(srcBounds.top()    - dstBounds.top(),
-                          srcBounds.bottom() - dstBounds.top(),
-                          dstBounds.height(),
-                          srcAddr, src.rowBytesAsPixels(),
-                          dstAddr, dst.rowBytesAsPixels());
-            srcAddr += 1;
-            dstAddr += 1;
-        }
+        for_each_line_span(executor, makerY, loopStart, loopEnd,
+                           [&](Pass* pass, int start, int end) {
+            auto srcAddr = reinterpret_cast<T*>(src.getAddr(start - srcBounds.left(), 0));
+            auto dstAddr = reinterpret_cast<T*>(dst.getAddr(start - dstBounds.left(),
+                                                            dstYOffset));
+            for (int x = start; x < end; ++x) {
+                pass->blur<T>(srcBounds.top()    - dstBounds.top(),
+                              srcBounds.bottom() - dstBounds.top(),
+                              dstBounds.height(),
+                              srcAddr, src.rowBytesAsPixels(),
+                              dstAddr, dst.rowBytesAsPixels());
+                srcAddr += 1;
+                dstAddr += 1;
+            }
+        });
     }
 
 #if defined(SK_AVOID_SLOW_RASTER_PIPELINE_BLURS)
@@ -1146,8 +1174,390 @@ private:
     uint32_t fSum2;
 };
 
+// Channel access for the F16 and F32 blur passes. Both are blurred as premultiplied float4s;
+// Pixel is the stride type handed to eval_blur_passes().
+struct F16PixelFormat {
+    using Pixel = uint64_t;
+    static skvx::float4 Load(const Pixel* src) {
+        return skvx::from_half(skvx::half4::Load(src));
+    }
+    static void Store(const skvx::float4& v, Pixel* dst) { skvx::to_half(v).store(dst); }
+};
+
+struct F32PixelFormat {
+    struct Pixel { float fRGBA[4]; };
+    static skvx::float4 Load(const Pixel* src) { return skvx::float4::Load(src); }
+    static void Store(const skvx::float4& v, Pixel* dst) { v.store(dst); }
+};
+
+// The float counterpart of GaussianPass, for small sigmas on F16 and F32 images.
+template <typename Format>
+class FloatGaussianPass final : public Pass {
+public:
+    using Pixel = typename Format::Pixel;
+
+    static constexpr float kMaxSigma = 2.f;
+
+    static PassMaker* MakeMaker(float sigma, SkArenaAlloc* alloc) {
+        if (sigma >= kMaxSigma) { return nullptr; }
+
+        class Maker : public PassMaker {
+        public:
+            explicit Maker(float sigma)
+                : PassMaker{2 * SkBlurEngine::SigmaToRadius(sigma) + 1, sigma} {}
+            Pass* makePass(void* buffer, SkArenaAlloc* alloc) const override {
+                return FloatGaussianPass::Make(this->sigma(), buffer, alloc);
+            }
+            size_t bufferSizeBytes() const override {
+                // Data is skvx::float4[window] + float[window]
+                return this->window() * (sizeof(skvx::float4) + sizeof(float));
+            }
+        };
+
+        return alloc->make<Maker>(sigma);
+    }
+
+    static FloatGaussianPass* Make(float sigma, void* buffers, SkArenaAlloc* alloc) {
+        int radius = SkBlurEngine::SigmaToRadius(sigma);
+        size_t kernelWidth = 2*radius + 1;
+
+        skvx::float4* srcBuffer = static_cast<skvx::float4*>(buffers);
+
+        float* kernelValues = reinterpret_cast<float*>(srcBuffer + kernelWidth);
+        SkShaderBlurAlgorithm::Compute1DBlurKernel(sigma, radius, {kernelValues, kernelWidth});
+
+        return alloc->make<FloatGaussianPass>(radius, kernelValues, srcBuffer);
+    }
+
+    FloatGaussianPass(int radius, float* kernel, skvx::float4* srcBuffer)
+        : Pass(radius)
+        , fWindow(2 * radius + 1)
+        , fKernel(kernel)
+        , fSrcBuffer(srcBuffer)
+        , fSrcBufferBase(0) {}
+
+private:
+    void startBlur() override {
+        sk_bzero(fSrcBuffer, fWindow * sizeof(skvx::float4));
+        fSrcBufferBase = 0;
+    }
+
+    void blurSegment(int n, const void* src, int srcStride, void* dst, int dstStride) override {
+        const Pixel* srcPtr = static_cast<const Pixel*>(src);
+        Pixel* dstPtr = static_cast<Pixel*>(dst);
+
+        int base = fSrcBufferBase;
+        while (n-- > 0) {
+            fSrcBuffer[(base + fWindow - 1) % fWindow] = srcPtr ? Format::Load(srcPtr)
+                                                                : skvx::float4(0.f);
+            if (dstPtr) {
+                skvx::float4 sum = 0.f;
+                for (int i = 0; i < fWindow; ++i) {
+                    sum += fSrcBuffer[(i + base) % fWindow] * fKernel[i];
+                }
+                Format::Store(sum, dstPtr);
+                dstPtr += dstStride;
+            }
+            if (srcPtr) {
+                srcPtr += srcStride;
+            }
+            base = (base + 1) % fWindow;
+        }
+        fSrcBufferBase = base;
+    }
+
+    const int fWindow;
+    float* fKernel;
+    skvx::float4* fSrcBuffer;
+    int fSrcBufferBase;
+};
+
+// The float counterpart of ThreeBoxApproxPass, for F16 and F32 images. The sums are kept in
+// float, which cannot overflow, and scaled by 1/divisor instead of divided. Rounding error in
+// the running sums is not carried from one row or column to the next, so it stays around
+// sqrt(length) float ulps of the brightest input.
+template <typename Format>
+class FloatThreeBoxApproxPass final : public Pass {
+public:
+    using Pixel = typename Format::Pixel;
+
+    // The window limit matches ThreeBoxApproxPass so that F16 and F32 blurs pick the same
+    // filters as 8888 ones for every sigma.
+    static PassMaker* MakeMaker(float sigma, SkArenaAlloc* alloc) {
+        SkASSERT(0 <= sigma);
+        int window = SkBlurEngine::BoxBlurWindow(sigma);
+        if (255 <= window) {
+            return nullptr;
+        }
+
+        class Maker : public PassMaker {
+        public:
+            explicit Maker(int window, float sigma) : PassMaker{window, sigma} {}
+            Pass* makePass(void* buffer, SkArenaAlloc* alloc) const override {
+                return FloatThreeBoxApproxPass::Make(this->window(), buffer, alloc);
+            }
+
+            size_t bufferSizeBytes() const override {
+                int window = this->window();
+                size_t onePassSize = window - 1;
+                size_t bufferCount = (window & 1) == 1 ? 3 * onePassSize : 3 * onePassSize + 1;
+                return bufferCount * sizeof(skvx::float4);
+            }
+        };
+
+        return alloc->make<Maker>(window, sigma);
+    }
+
+    static FloatThreeBoxApproxPass* Make(int window, void* buffers, SkArenaAlloc* alloc) {
+        // The buffer layout, border and divisor are the same as ThreeBoxApproxPass::Make().
+        int passSize = window - 1;
+        skvx::float4* buffer0 = static_cast<skvx::float4*>(buffers);
+        skvx::float4* buffer1 = buffer0 + passSize;
+        skvx::float4* buffer2 = buffer1 + passSize;
+        skvx::float4* buffersEnd = buffer2 + ((window & 1) ? passSize : passSize + 1);
+
+        int border = (window & 1) == 1 ? 3 * ((window - 1) / 2) : 3 * (window / 2) - 1;
+
+        float window2 = float(window) * window;
+        float window3 = window2 * window;
+        float divisor = (window & 1) == 1 ? window3 : window3 + window2;
+        return alloc->make<FloatThreeBoxApproxPass>(buffer0, buffer1, buffer2,
+                                                    buffersEnd, border, 1.f / divisor);
+    }
+
+    FloatThreeBoxApproxPass(skvx::float4* buffer0,
+                            skvx::float4* buffer1,
+                            skvx::float4* buffer2,
+                            skvx::float4* buffersEnd,
+                            int border,
+                            float scale)
+        : Pass{border}
+        , fBuffer0{buffer0}
+        , fBuffer1{buffer1}
+        , fBuffer2{buffer2}
+        , fBuffersEnd{buffersEnd}
+        , fScale{scale} {}
+
+private:
+    void startBlur() override {
+        fSum0 = fSum1 = fSum2 = 0.f;
+        sk_bzero(fBuffer0, (fBuffersEnd - fBuffer0) * sizeof(skvx::float4));
+
+        fBuffer0Cursor = fBuffer0;
+        fBuffer1Cursor = fBuffer1;
+        fBuffer2Cursor = fBuffer2;
+    }
+
+    // See ThreeBoxApproxPass::blurSegment() for how the three box passes are combined.
+    void blurSegment(
+            int n, const void* src, int srcStride, void* dst, int dstStride) override {
+        const Pixel* srcPtr = static_cast<const Pixel*>(src);
+        Pixel* dstPtr = static_cast<Pixel*>(dst);
+        skvx::float4* buffer0Cursor = fBuffer0Cursor;
+        skvx::float4* buffer1Cursor = fBuffer1Cursor;
+        skvx::float4* buffer2Cursor = fBuffer2Cursor;
+        skvx::float4 sum0 = fSum0;
+        skvx::float4 sum1 = fSum1;
+        skvx::float4 sum2 = fSum2;
+
+        auto processValue = [&](const skvx::float4& leadingEdge) {
+            sum0 += leadingEdge;
+            sum1 += sum0;
+            sum2 += sum1;
+
+            skvx::float4 blurred = sum2 * fScale;
+
+            sum2 -= *buffer2Cursor;
+            *buffer2Cursor = sum1;
+            buffer2Cursor = (buffer2Cursor + 1) < fBuffersEnd ? buffer2Cursor + 1 : fBuffer2;
+            sum1 -= *buffer1Cursor;
+            *buffer1Cursor = sum0;
+            buffer1Cursor = (buffer1Cursor + 1) < fBuffer2 ? buffer1Cursor + 1 : fBuffer1;
+            sum0 -= *buffer0Cursor;
+            *buffer0Cursor = leadingEdge;
+            buffer0Cursor = (buffer0Cursor + 1) < fBuffer1 ? buffer0Cursor + 1 : fBuffer0;
+
+            return blurred;
+        };
+
+        if (!srcPtr && !dstPtr) {
+            while (n --> 0) {
+                (void)processValue(0.f);
+            }
+        } else if (srcPtr && !dstPtr) {
+            while (n --> 0) {
+                (void)processValue(Format::Load(srcPtr));
+                srcPtr += srcStride;
+            }
+        } else if (!srcPtr && dstPtr) {
+            while (n --> 0) {
+                Format::Store(processValue(0.f), dstPtr);
+                dstPtr += dstStride;
+            }
+        } else if (srcPtr && dstPtr) {
+            while (n --> 0) {
+                Format::Store(processValue(Format::Load(srcPtr)), dstPtr);
+                srcPtr += srcStride;
+                dstPtr += dstStride;
+            }
+        }
+
+        // Store the state
+        fBuffer0Cursor = buffer0Cursor;
+        fBuffer1Cursor = buffer1Cursor;
+        fBuffer2Cursor = buffer2Cursor;
+        fSum0 = sum0;
+        fSum1 = sum1;
+        fSum2 = sum2;
+    }
+
+    skvx::float4* const fBuffer0;
+    skvx::float4* const fBuffer1;
+    skvx::float4* const fBuffer2;
+    skvx::float4* const fBuffersEnd;
+    const float fScale;
+
+    // blur state
+    skvx::float4 fSum0;
+    skvx::float4 fSum1;
+    skvx::float4 fSum2;
+    skvx::float4* fBuffer0Cursor;
+    skvx::float4* fBuffer1Cursor;
+    skvx::float4* fBuffer2Cursor;
+};
+
+// The float counterpart of TentPass, used for the large sigmas of legacy F16 and F32 blurs.
+template <typename Format>
+class FloatTentPass final : public Pass {
+public:
+    using Pixel = typename Format::Pixel;
+
+    // The window limit matches TentPass; see FloatThreeBoxApproxPass::MakeMaker().
+    static PassMaker* MakeMaker(float sigma, SkArenaAlloc* alloc) {
+        SkASSERT(0 <= sigma);
+        int tentWindow = 3 * SkBlurEngine::BoxBlurWindow(sigma) / 2;
+        if (tentWindow >= 4104) {
+            return nullptr;
+        }
+
+        class Maker : public PassMaker {
+        public:
+            explicit Maker(int window, float sigma) : PassMaker{window, sigma} {}
+            Pass* makePass(void* buffer, SkArenaAlloc* alloc) const override {
+                return FloatTentPass::Make(this->window(), buffer, alloc);
+            }
+
+            size_t bufferSizeBytes() const override {
+                return 2 * (this->window() - 1) * sizeof(skvx::float4);
+            }
+        };
+
+        return alloc->make<Maker>(tentWindow, sigma);
+    }
+
+    static FloatTentPass* Make(int window, void* buffers, SkArenaAlloc* alloc) {
+        // The buffer layout, border and divisor are the same as TentPass::Make().
+        int passSize = window - 1;
+        skvx::float4* buffer0 = static_cast<skvx::float4*>(buffers);
+        skvx::float4* buffer1 = buffer0 + passSize;
+        skvx::float4* buffersEnd = buffer1 + passSize;
+
+        int border = window - 1;
+        return alloc->make<FloatTentPass>(buffer0, buffer1, buffersEnd, border,
+                                          1.f / (float(window) * window));
+    }
+
+    FloatTentPass(skvx::float4* buffer0,
+                  skvx::float4* buffer1,
+                  skvx::float4* buffersEnd,
+                  int border,
+                  float scale)
+        : Pass{border}
+        , fBuffer0{buffer0}
+        , fBuffer1{buffer1}
+        , fBuffersEnd{buffersEnd}
+        , fScale{scale} {}
+
+private:
+    void startBlur() override {
+        fSum0 = fSum1 = 0.f;
+        sk_bzero(fBuffer0, (fBuffersEnd - fBuffer0) * sizeof(skvx::float4));
+
+        fBuffer0Cursor = fBuffer0;
+        fBuffer1Cursor = fBuffer1;
+    }
+
+    // See TentPass::blurSegment() for how the two box passes are combined.
+    void blurSegment(
+            int n, const void* src, int srcStride, void* dst, int dstStride) override {
+        const Pixel* srcPtr = static_cast<const Pixel*>(src);
+        Pixel* dstPtr = static_cast<Pixel*>(dst);
+        skvx::float4* buffer0Cursor = fBuffer0Cursor;
+        skvx::float4* buffer1Cursor = fBuffer1Cursor;
+        skvx::float4 sum0 = fSum0;
+        skvx::float4 sum1 = fSum1;
+
+        auto processValue = [&](const skvx::float4& leadingEdge) {
+            sum0 += leadingEdge;
+            sum1 += sum0;
+
+            skvx::float4 blurred = sum1 * fScale;
+
+            sum1 -= *buffer1Cursor;
+            *buffer1Cursor = sum0;
+            buffer1Cursor = (buffer1Cursor + 1) < fBuffersEnd ? buffer1Cursor + 1 : fBuffer1;
+            sum0 -= *buffer0Cursor;
+            *buffer0Cursor = leadingEdge;
+            buffer0Cursor = (buffer0Cursor + 1) < fBuffer1 ? buffer0Cursor + 1 : fBuffer0;
+
+            return blurred;
+        };
+
+        if (!srcPtr && !dstPtr) {
+            while (n --> 0) {
+                (void)processValue(0.f);
+            }
+        } else if (srcPtr && !dstPtr) {
+            while (n --> 0) {
+                (void)processValue(Format::Load(srcPtr));
+                srcPtr += srcStride;
+            }
+        } else if (!srcPtr && dstPtr) {
+            while (n --> 0) {
+                Format::Store(processValue(0.f), dstPtr);
+                dstPtr += dstStride;
+            }
+        } else if (srcPtr && dstPtr) {
+            while (n --> 0) {
+                Format::Store(processValue(Format::Load(srcPtr)), dstPtr);
+                srcPtr += srcStride;
+                dstPtr += dstStride;
+            }
+        }
+
+        // Store the state
+        fBuffer0Cursor = buffer0Cursor;
+        fBuffer1Cursor = buffer1Cursor;
+        fSum0 = sum0;
+        fSum1 = sum1;
+    }
+
+    skvx::float4* const fBuffer0;
+    skvx::float4* const fBuffer1;
+    skvx::float4* const fBuffersEnd;
+    const float fScale;
+
+    // blur state
+    skvx::float4 fSum0;
+    skvx::float4 fSum1;
+    skvx::float4* fBuffer0Cursor;
+    skvx::float4* fBuffer1Cursor;
+};
+
 class RasterA8BlurAlgorithm : public SkBlurEngine::Algorithm {
 public:
+    explicit RasterA8BlurAlgorithm(SkExecutor* executor) : fExecutor(executor) {}
+
     // See analysis in description of GaussPass for the max supported sigma.
     float maxSigma() const override {
         static constexpr float kMaxSigma = 135.f;
@@ -1193,12 +1603,17 @@ public:
         PassMaker* makerY = makeMaker(sigma.height());
 
         return eval_blur_passes<uint8_t>(makerX, makerY, src, originalSrcBounds,
-                                         originalDstBounds, &alloc);
+                                         originalDstBounds, fExecutor);
     }
+
+private:
+    SkExecutor* const fExecutor;
 };
 
 class Raster8888BlurAlgorithm : public SkBlurEngine::Algorithm {
 public:
+    explicit Raster8888BlurAlgorithm(SkExecutor* executor) : fExecutor(executor) {}
+
     // See analysis in description of TentPass for the max supported sigma.
     float maxSigma() const override {
         // TentPass supports a sigma up to 2183, and was added so that the CPU blur algorithm's
@@ -1261,9 +1676,65 @@ public:
         PassMaker* makerY = makeMaker(sigma.height());
 
         return eval_blur_passes<uint32_t>(makerX, makerY, src, originalSrcBounds,
-                                          originalDstBounds, &alloc);
+                                          originalDstBounds, fExecutor);
     }
 
+private:
+    SkExecutor* const fExecutor;
+};
+
+// Blurs F16 or F32 images with the float versions of the 8888 passes, so wide-gamut and HDR
+// layers avoid the many-tap shader blur.
+template <typename Format>
+class RasterFloatBlurAlgorithm : public SkBlurEngine::Algorithm {
+public:
+    explicit RasterFloatBlurAlgorithm(SkExecutor* executor) : fExecutor(executor) {}
+
+    // See Raster8888BlurAlgorithm::maxSigma().
+    float maxSigma() const override { return 135.f; }
+
+    bool supportsOnlyDecalTiling() const override { return true; }
+
+    sk_sp<SkSpecialImage> blur(SkSize sigma,
+                               sk_sp<SkSpecialImage> input,
+                               const SkIRect& originalSrcBounds,
+                               SkTileMode tileMode,
+                               const SkIRect& originalDstBounds) const override {
+        SkASSERT(tileMode == SkTileMode::kDecal);
+        SkASSERT(SkIRect::MakeSize(input->dimensions()).contains(originalSrcBounds));
+
+        SkBitmap src;
+        if (!SkSpecialImages::AsBitmap(input.get(), &src)) {
+            return nullptr; // Should only have been called by CPU-backed images
+        }
+        SkASSERT(src.info().bytesPerPixel() == sizeof(typename Format::Pixel));
+
+        SkSTArenaAlloc<1024> alloc;
+        auto makeMaker = [&](float sigma) -> PassMaker* {
+            SkASSERT(0 <= sigma && sigma <= 2183); // should be guaranteed after map_sigma
+#ifndef SK_AVOID_SLOW_RASTER_PIPELINE_BLURS
+            if (PassMaker* maker = FloatGaussianPass<Format>::MakeMaker(sigma, &alloc)) {
+                return maker;
+            }
+#endif //SK_AVOID_SLOW_RASTER_PIPELINE_BLURS
+            if (PassMaker* maker = FloatThreeBoxApproxPass<Format>::MakeMaker(sigma, &alloc)) {
+                return maker;
+            }
+            if (PassMaker* maker = FloatTentPass<Format>::MakeMaker(sigma, &alloc)) {
+                return maker;
+            }
+            SK_ABORT("Sigma is out of range.");
+        };
+
+        PassMaker* makerX = makeMaker(sigma.width());
+        PassMaker* makerY = makeMaker(sigma.height());
+
+        return eval_blur_passes<typename Format::Pixel>(makerX, makerY, src, originalSrcBounds,
+                                                        originalDstBounds, fExecutor);
+    }
+
+private:
+    SkExecutor* const fExecutor;
 };
 
 class RasterShaderBlurAlgorithm : public SkShaderBlurAlgorithm {
@@ -1278,6 +1749,12 @@ public:
 
 class RasterBlurEngine : public SkBlurEngine {
 public:
+    explicit RasterBlurEngine(SkExecutor* executor)
+            : fRGBA8BlurAlgorithm(executor)
+            , fA8BlurAlgorithm(executor)
+            , fF16BlurAlgorithm(executor)
+            , fF32BlurAlgorithm(executor) {}
+
     const Algorithm* findAlgorithm(SkSize sigma,  SkColorType colorType) const override {
         // The box blur doesn't actually care about channel order as long as it's 4 8-bit channels.
         const bool rgba8Blur = colorType == kRGBA_8888_SkColorType ||
@@ -1290,13 +1767,17 @@ public:
             return &fA8BlurAlgorithm;
         } else if (rgba8Blur) {
             return &fRGBA8BlurAlgorithm;
+        } else if (colorType == kRGBA_F16_SkColorType) {
+            return &fF16BlurAlgorithm;
+        } else if (colorType == kRGBA_F32_SkColorType) {
+            return &fF32BlurAlgorithm;
         } else {
             return &fShaderBlurAlgorithm;
         }
     }
 
 private:
-    // For non-A8 or non-8888, use the shader algorithm
+    // For other color types, use the shader algorithm
     RasterShaderBlurAlgorithm fShaderBlurAlgorithm;
     // For large blurs with RGBA8 or BGRA8, use consecutive box blurs,
     // For small 8888 blurs, use gaussian blur
@@ -1304,15 +1785,22 @@ private:
     // For any large blurs with A8, use consecutive box blurs,
     // For small a8 blurs use gaussian blur
     RasterA8BlurAlgorithm fA8BlurAlgorithm;
+    // The same passes as 8888, evaluated in float
+    RasterFloatBlurAlgorithm<F16PixelFormat> fF16BlurAlgorithm;
+    RasterFloatBlurAlgorithm<F32PixelFormat> fF32BlurAlgorithm;
 };
 
 } // anonymous namespace
 
 const SkBlurEngine* SkBlurEngine::GetRasterBlurEngine() {
-    static const RasterBlurEngine kInstance;
+    static const RasterBlurEngine kInstance{nullptr};
     return &kInstance;
 }
 
+std::unique_ptr<const SkBlurEngine> SkBlurEngine::MakeRasterBlurEngine(SkExecutor* executor) {
+    return std::make_unique<RasterBlurEngine>(executor);
+}
+
 // SkShaderBlurAlgorithm
 // ----------------------------------------------------------------------------
 
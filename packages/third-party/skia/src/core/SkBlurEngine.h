@@ -17,8 +17,10 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory>
 
 class SkDevice;
+class SkExecutor;
 class SkRuntimeEffect;
 class SkRuntimeEffectBuilder;
 class SkSpecialImage;
@@ -72,10 +74,16 @@ public:
     }
 
     // Get the default CPU-backed SkBlurEngine. This has specialized algorithms for 32-bit RGBA
-    // and BGRA colors, and A8 alpha-only images when the sigma is large enough. For small blurs
-    // and other color types, it uses SkShaderBlurAlgorithm backed by the raster pipeline.
+    // and BGRA colors, RGBA F16 and F32 colors, and A8 alpha-only images when the sigma is large
+    // enough. For small blurs and other color types, it uses SkShaderBlurAlgorithm backed by the
+    // raster pipeline.
     static const SkBlurEngine* GetRasterBlurEngine();
 
+    // Make a CPU-backed SkBlurEngine like GetRasterBlurEngine() whose specialized algorithms split
+    // their row and column passes into tasks on 'executor'. The executor is not owned and must
+    // outlive the engine; if it is null, the passes run on the calling thread.
+    static std::unique_ptr<const SkBlurEngine> MakeRasterBlurEngine(SkExecutor* executor);
+
     // TODO: These are internal functions of the raster blur engine but need to be public for legacy
     // code paths to invoke them directly.
 
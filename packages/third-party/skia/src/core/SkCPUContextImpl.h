@@ -14,9 +14,14 @@
 namespace skcpu {
 class ContextImpl final : public Context {
 public:
-    ContextImpl() = default;
+    explicit ContextImpl(const Options& options) : fOptions(options) {}
+
+    const Options& options() const { return fOptions; }
 
     static const ContextImpl* TODO();
+
+private:
+    const Options fOptions;
 };
 }  // namespace skcpu
 
@@ -6,9 +6,23 @@
  */
 #include "include/core/SkCPURecorder.h"
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTArray.h"
+#include "src/core/SkBitmapDevice.h"
 #include "src/core/SkCPUContextImpl.h"
+#include "src/core/SkCPURecorderImpl.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <memory>
 
 namespace skcpu {
@@ -18,4 +32,87 @@ Recorder* Recorder::TODO() {
     return gRecorder;
 }
 
+static skia_private::TArray<SkIRect> make_tiles(const SkIRect& area,
+                                                const Context::TilePolicy& policy) {
+    const int size = std::max(policy.fTileSize, 16);
+    const int tileWidth =
+            policy.fSplit == Context::TilePolicy::Split::kBands ? area.width() : size;
+
+    skia_private::TArray<SkIRect> tiles;
+    for (int y = area.fTop; y < area.fBottom; y += size) {
+        for (int x = area.fLeft; x < area.fRight; x += tileWidth) {
+            tiles.push_back(SkIRect::MakeLTRB(x,
+                                              y,
+                                              std::min(x + tileWidth, area.fRight),
+                                              std::min(y + size, area.fBottom)));
+        }
+    }
+    return tiles;
+}
+
+void Recorder::drawPicture(SkSurface* surface, const SkPicture* picture, const SkMatrix* matrix) {
+    if (!surface || !picture) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    SkExecutor* executor = asRRI(this)->ctx()->options().fExecutor;
+
+    if (!executor || canvas->getSaveCount() != 1 || !canvas->isClipRect()) {
+        canvas->drawPicture(picture, matrix, nullptr);
+        return;
+    }
+
+    SkMatrix ctm = canvas->getTotalMatrix();
+    if (matrix) {
+        ctm.preConcat(*matrix);
+    }
+    SkIRect area = canvas->getDeviceClipBounds();
+    if (!area.intersect(ctm.mapRect(picture->cullRect()).roundOut())) {
+        return;
+    }
+
+    const skia_private::TArray<SkIRect> tiles =
+            make_tiles(area, asRRI(this)->ctx()->options().fTilePolicy);
+    if (tiles.size() == 1) {
+        canvas->drawPicture(picture, matrix, nullptr);
+        return;
+    }
+
+    // The tiles write straight into the surface's pixels, bypassing its canvas. This must come
+    // before peeking them, since it gives the surface new pixels if a snapshot shares the old ones.
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    SkPixmap pixels;
+    if (!surface->peekPixels(&pixels)) {
+        canvas->drawPicture(picture, matrix, nullptr);
+        return;
+    }
+    const SkSurfaceProps props = surface->props();
+
+    SkTaskGroup group(*executor);
+    group.batch(tiles.size(), [&](int i) {
+        const SkIRect& tile = tiles[i];
+        // Each tile's device starts on a multiple of 8 pixels, the period of the dither
+        // patterns, so dithered draws land exactly as they would without tiling.
+        const SkIPoint origin = {tile.fLeft & ~7, tile.fTop & ~7};
+        SkPixmap tilePixels;
+        if (!pixels.extractSubset(&tilePixels,
+                                  SkIRect::MakeLTRB(origin.fX, origin.fY,
+                                                    tile.fRight, tile.fBottom))) {
+            return;
+        }
+        SkBitmap tileBitmap;
+        if (!tileBitmap.installPixels(tilePixels)) {
+            return;
+        }
+        // Draw through this recorder so the tiles honor its context's options.
+        auto tileCanvas = std::make_unique<SkCanvas>(
+                sk_make_sp<SkBitmapDevice>(asRRI(this), tileBitmap, props));
+        tileCanvas->translate(-origin.fX, -origin.fY);
+        tileCanvas->clipIRect(tile);
+        tileCanvas->concat(ctm);
+        tileCanvas->drawPicture(picture);
+    });
+    group.wait();
+}
+
 }  // namespace skcpu
@@ -853,6 +853,16 @@ void SkCanvas::internalDrawDeviceWithFilter(SkDevice* src,
     FilterSpan filtersOrNull = filters.empty() ? FilterSpan{&nullFilter, 1} : filters;
 
     for (const sk_sp<SkImageFilter>& filter : filtersOrNull) {
+        if (!srcIsCoverageLayer &&
+            skif::DrawFilterInTiles(ctx, filter.get(), dst,
+                                    [&](const skif::Context& tileCtx,
+                                        const skif::FilterResult& tileResult) {
+                apply_alpha_and_colorfilter(tileCtx, tileResult, paint)
+                        .draw(tileCtx, dst, paint.getBlender());
+            })) {
+            continue;
+        }
+
         auto result = filter ? as_IFB(filter)->filterImage(ctx) : source;
 
         if (srcIsCoverageLayer) {
@@ -96,6 +96,13 @@ public:
     void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override;
 };
 
+// Blends color through an A8 or LCD16 mask into the N32 device, within clip. Returns false,
+// drawing nothing, for any other mask format or device color type.
+bool SkARGB32_BlitColorMask(const SkPixmap& device,
+                            const SkMask& mask,
+                            const SkIRect& clip,
+                            SkColor color);
+
 class SkARGB32_Shader_Blitter : public SkShaderBlitter {
 public:
     SkARGB32_Shader_Blitter(const SkPixmap& device, const SkPaint& paint,
@@ -366,14 +366,19 @@ void SkDevice::drawFilteredImage(const skif::Mapping& mapping,
                       this->imageInfo().colorSpace(),
                       &stats};
 
-    SkIPoint offset;
-    sk_sp<SkSpecialImage> result = as_IFB(filter)->filterImage(ctx).imageAndOffset(ctx, &offset);
-    stats.reportStats();
-    if (result) {
-        SkMatrix deviceMatrixWithOffset = mapping.layerToDevice().asM33();
-        deviceMatrixWithOffset.preTranslate(offset.fX, offset.fY);
-        this->drawSpecial(result.get(), deviceMatrixWithOffset, sampling, paint);
+    auto drawResult = [&](const skif::Context& drawCtx, const skif::FilterResult& filtered) {
+        SkIPoint offset;
+        sk_sp<SkSpecialImage> result = filtered.imageAndOffset(drawCtx, &offset);
+        if (result) {
+            SkMatrix deviceMatrixWithOffset = mapping.layerToDevice().asM33();
+            deviceMatrixWithOffset.preTranslate(offset.fX, offset.fY);
+            this->drawSpecial(result.get(), deviceMatrixWithOffset, sampling, paint);
+        }
+    };
+    if (!skif::DrawFilterInTiles(ctx, filter, this, drawResult)) {
+        drawResult(ctx, as_IFB(filter)->filterImage(ctx));
     }
+    stats.reportStats();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
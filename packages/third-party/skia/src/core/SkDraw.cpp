@@ -40,6 +40,7 @@
 #include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkBlitter_A8.h"
+#include "src/core/SkCPUContextImpl.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDrawProcs.h"
 #include "src/core/SkDrawTypes.h"
@@ -830,6 +831,10 @@ void Draw::drawOval(const SkRect& oval, const SkPaint& paint) const {
         return;
     }
 
+    if (this->drawRRectAnalytic(SkRRect::MakeOval(oval), paint)) {
+        return;
+    }
+
     this->drawPath(SkPath::Oval(oval), paint, nullptr);
 }
 
@@ -849,15 +854,17 @@ void Draw::drawRRect(const SkRRect& rrect, const SkPaint& paint) const {
             goto DRAW_PATH;
         }
 
-        if (paint.getPathEffect() || paint.getStyle() != SkPaint::kFill_Style) {
+        if (paint.getPathEffect()) {
             goto DRAW_PATH;
         }
     }
 
     if (paint.getMaskFilter()) {
-        if (this->drawRRectNinePatch(rrect, paint)) {
+        if (paint.getStyle() == SkPaint::kFill_Style && this->drawRRectNinePatch(rrect, paint)) {
             return;
         }
+    } else if (this->drawRRectAnalytic(rrect, paint)) {
+        return;
     }
 
 DRAW_PATH:
@@ -865,6 +872,55 @@ DRAW_PATH:
     this->drawPath(SkPath::RRect(rrect), paint, nullptr);
 }
 
+bool Draw::drawRRectAnalytic(const SkRRect& rrect, const SkPaint& paint) const {
+    if (!paint.isAntiAlias() || paint.getPathEffect() || paint.getMaskFilter()) {
+        return false;
+    }
+    SkScalar coverage;
+    if (DrawTreatAsHairline(paint, *fCTM, &coverage)) {
+        return false;
+    }
+    std::optional<SkRRect> devRRect = rrect.transform(*fCTM);
+    if (!devRRect || devRRect->isEmpty()) {
+        return false;
+    }
+
+    SkRRect outer = *devRRect,
+            inner;
+    if (paint.getStyle() != SkPaint::kFill_Style) {
+        // Offsetting the corners by half the stroke width only reproduces the stroker's output
+        // for circular corners, or square ones with a miter join.
+        if (!fCTM->isSimilarity()) {
+            return false;
+        }
+        const bool miter = paint.getStrokeJoin() == SkPaint::kMiter_Join &&
+                           paint.getStrokeMiter() >= SK_ScalarSqrt2;
+        for (SkVector r : devRRect->radii()) {
+            if (r.fX != r.fY || (r.fX == 0 && !miter)) {
+                return false;
+            }
+        }
+        const SkScalar halfWidth = SkScalarHalf(paint.getStrokeWidth()) * fCTM->getMinScale();
+        devRRect->outset(halfWidth, halfWidth, &outer);
+        if (paint.getStyle() == SkPaint::kStroke_Style) {
+            devRRect->inset(halfWidth, halfWidth, &inner);
+        }
+    }
+
+    const SkRect& devBounds = outer.getBounds();
+    if (!devBounds.isFinite() || SkScan::PathRequiresTiling(devBounds.roundOut())) {
+        return false;
+    }
+
+    SkAutoBlitterChoose blitter(*this, nullptr, paint, devBounds);
+    if (inner.isEmpty()) {
+        SkScan::AntiFillRRect(outer, *fRC, blitter.get());
+    } else {
+        SkScan::AntiFrameRRect(outer, inner, *fRC, blitter.get());
+    }
+    return true;
+}
+
 bool Draw::drawRRectNinePatch(const SkRRect& rrect, const SkPaint& paint) const {
     SkASSERT(paint.getMaskFilter());
 
@@ -916,7 +972,12 @@ void Draw::drawDevPath(const SkPathRaw& raw,
     void (*proc)(const SkPathRaw&, const SkRasterClip&, SkBlitter*);
     if (doFill) {
         if (paint.isAntiAlias()) {
-            proc = SkScan::AntiFillPath;
+            if (fCtx && fCtx->options().fPathRasterizer ==
+                                Context::PathRasterizer::kSparseStrips) {
+                proc = SkScan::SparseStripFillPath;
+            } else {
+                proc = SkScan::AntiFillPath;
+            }
         } else {
             proc = SkScan::FillPath;
         }
@@ -116,6 +116,9 @@ public:
     }
     void drawOval(const SkRect&, const SkPaint&) const;
     void drawRRect(const SkRRect&, const SkPaint&) const;
+    // Draws anti-aliased fills and strokes of axis-aligned rrects (and ovals) with analytic
+    // coverage. Returns false if the paint or matrix needs the general path rasterizer.
+    bool drawRRectAnalytic(const SkRRect&, const SkPaint&) const;
     // Specialized draw for RRect that only draws if it is nine-patchable.
     bool drawRRectNinePatch(const SkRRect&, const SkPaint&) const;
     /**
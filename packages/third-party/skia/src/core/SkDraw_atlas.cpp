@@ -13,6 +13,7 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
@@ -45,7 +46,6 @@
 class SkBlender;
 class SkBlitter;
 enum class SkBlendMode;
-struct SkRSXform;
 
 static void fill_rect(const SkMatrix& ctm, const SkRasterClip& rc,
                       const SkRect& r, SkBlitter* blitter) {
@@ -137,6 +137,11 @@ void Draw::drawAtlas(SkSpan<const SkRSXform> xform,
         return;
     }
 
+    // Sprites that are only scaled and translated (the common particle/glyph-sheet case) get
+    // their device rect and inverse matrix computed directly, skipping the general concat
+    // and invert below.
+    const bool ctmIsScaleTranslate = fCTM->isScaleTranslate();
+
     for (size_t i = 0; i < xform.size(); ++i) {
         if (!colors.empty()) {
             SkColor4f c4 = SkColor4f::FromColor(colors[i]);
@@ -144,6 +149,29 @@ void Draw::drawAtlas(SkSpan<const SkRSXform> xform,
             load_color(uniformCtx, c4.premul().vec());
         }
 
+        if (ctmIsScaleTranslate && xform[i].fSSin == 0) {
+            const SkRSXform& x = xform[i];
+            const SkRect& t = textures[i];
+            const SkScalar sx = x.fSCos * fCTM->getScaleX();
+            const SkScalar sy = x.fSCos * fCTM->getScaleY();
+            if (sx == 0 || sy == 0) {
+                return; // non-invertible
+            }
+            const SkScalar tx = fCTM->getScaleX() * (x.fTx - x.fSCos * t.fLeft) +
+                                fCTM->getTranslateX();
+            const SkScalar ty = fCTM->getScaleY() * (x.fTy - x.fSCos * t.fTop) +
+                                fCTM->getTranslateY();
+            const SkScalar invX = 1 / sx;
+            const SkScalar invY = 1 / sy;
+            if (transformShader->update(
+                        SkMatrix::ScaleTranslate(invX, invY, -tx * invX, -ty * invY))) {
+                const SkRect dst = SkRect::MakeLTRB(sx * t.fLeft + tx, sy * t.fTop + ty,
+                                                    sx * t.fRight + tx, sy * t.fBottom + ty);
+                SkScan::FillRect(dst.makeSorted(), *fRC, blitter);
+            }
+            continue;
+        }
+
         SkMatrix mx;
         mx.setRSXform(xform[i]);
         mx.preTranslate(-textures[i].fLeft, -textures[i].fTop);
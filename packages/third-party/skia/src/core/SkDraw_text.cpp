@@ -12,6 +12,7 @@
 #include "include/core/SkRegion.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkTo.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkZip.h"
 #include "src/core/SkAAClip.h"
@@ -19,6 +20,7 @@
 #include "src/core/SkDraw.h"
 #include "src/core/SkDrawTypes.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkGlyphMaskBlitter.h"
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkRasterClip.h"
@@ -50,8 +52,41 @@ static bool check_glyph_position(SkPoint position) {
              lt(position.fY, INT_MIN - (INT16_MIN + 0 /*UINT16_MIN*/)));
 }
 
+// Draws a run whose glyphs all have A8 or LCD16 masks with a solid color, gathering the visible
+// masks and blending them in one pass. Returns false, drawing nothing, if the run needs the
+// general path.
+static bool paint_masks_batched(const SkGlyphMaskBlitter& glyphBlitter,
+                                SkZip<const SkGlyph*, SkPoint> accepted,
+                                const SkIRect& clipBounds) {
+    for (auto [glyph, pos] : accepted) {
+        if (!glyphBlitter.canBlit(glyph->maskFormat())) {
+            return false;
+        }
+    }
+
+    skia_private::STArray<64, SkMask> masks;
+    for (auto [glyph, pos] : accepted) {
+        if (check_glyph_position(pos)) {
+            SkMask mask = glyph->mask(pos);
+            if (SkIRect::Intersects(mask.fBounds, clipBounds)) {
+                masks.push_back(mask);
+            }
+        }
+    }
+    glyphBlitter.blitMasks(masks, clipBounds);
+    return true;
+}
+
 namespace skcpu {
 void Draw::paintMasks(SkZip<const SkGlyph*, SkPoint> accepted, const SkPaint& paint) const {
+    // With a rectangular clip, solid color text skips building a blitter for the run.
+    if (fRC->isRect() && !fRC->clipShader()) {
+        if (auto glyphBlitter = SkGlyphMaskBlitter::Make(fDst, paint, *fCTM);
+            glyphBlitter && paint_masks_batched(*glyphBlitter, accepted, fRC->getBounds())) {
+            return;
+        }
+    }
+
     SkSTArenaAlloc<kSkBlitterContextSize> alloc;
     SkBlitter* blitter = SkBlitter::Choose(fDst,
                                            *fCTM,
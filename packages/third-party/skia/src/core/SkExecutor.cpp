@@ -11,7 +11,10 @@
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTPin.h"
 #include "src/base/SkNoDestructor.h"
+#include "src/base/SkSpinlock.h"
 
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <thread>
 #include <utility>
@@ -188,6 +191,456 @@ private:
     const bool                  fAllowBorrowing;
 };
 
+// A work-stealing thread pool. Each worker owns a Chase-Lev deque: it pushes and pops work at
+// the bottom without locks, while idle workers steal from the top. Threads that are not workers
+// (and so have no deque) submit through a lock-free bounded MPMC injection queue.
+//
+// Tasks live in small nodes that hold the std::function and are recycled through per-thread
+// free lists, so the pool itself does not allocate in steady state. The std::function handed to
+// add() may still have heap-allocated its callable, if it is too large for the library's
+// small-buffer storage; SkExecutor's interface takes a std::function, so that is up to callers.
+class SkWorkStealingThreadPool final : public SkExecutor {
+    struct Task {
+        std::function<void(void)> fn;
+        Task*                      next = nullptr;  // Free-list link.
+        int                        home = 0;        // Index of the NodeCache this came from.
+    };
+
+    // Free list of Tasks. The owner (a worker, or any non-worker under fExternalLock) pushes and
+    // pops fLocal directly; every other thread returns nodes through the lock-free fReturned
+    // stack, which the owner takes in one exchange, so there is no ABA problem.
+    struct NodeCache {
+        Task*              fLocal = nullptr;
+        std::atomic<Task*> fReturned{nullptr};
+        TArray<std::unique_ptr<Task[]>> fSlabs;
+
+        Task* get(int home) {
+            if (!fLocal) {
+                fLocal = fReturned.exchange(nullptr, std::memory_order_acquire);
+            }
+            if (!fLocal) {
+                constexpr int kSlabSize = 64;
+                auto& slab = fSlabs.push_back(std::make_unique<Task[]>(kSlabSize));
+                for (int i = 0; i < kSlabSize; i++) {
+                    slab[i].home = home;
+                    slab[i].next = fLocal;
+                    fLocal = &slab[i];
+                }
+            }
+            Task* task = fLocal;
+            fLocal = task->next;
+            return task;
+        }
+
+        void putLocal(Task* task) {
+            task->next = fLocal;
+            fLocal = task;
+        }
+
+        void putRemote(Task* task) {
+            Task* head = fReturned.load(std::memory_order_relaxed);
+            do {
+                task->next = head;
+            } while (!fReturned.compare_exchange_weak(head, task,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed));
+        }
+    };
+
+    // Chase-Lev deque, following "Correct and Efficient Work-Stealing for Weak Memory Models"
+    // (Lê, Pop, Cohen, Zappa Nardelli; PPoPP 2013). Only the owner calls push() and pop();
+    // anyone may steal(). Retired arrays are kept until the pool dies, since a thief may still
+    // be reading one.
+    class Deque {
+    public:
+        Deque() { fArray.store(this->makeArray(256), std::memory_order_relaxed); }
+
+        void push(Task* task) {
+            int64_t b = fBottom.load(std::memory_order_relaxed),
+                    t = fTop.load(std::memory_order_acquire);
+            Array* a = fArray.load(std::memory_order_relaxed);
+            if (b - t > a->mask) {
+                a = this->grow(a, t, b);
+            }
+            a->slots[b & a->mask].store(task, std::memory_order_relaxed);
+            fBottom.store(b + 1, std::memory_order_release);
+        }
+
+        Task* pop() {
+            int64_t b = fBottom.load(std::memory_order_relaxed) - 1;
+            Array* a = fArray.load(std::memory_order_relaxed);
+            fBottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = fTop.load(std::memory_order_relaxed);
+
+            Task* task = nullptr;
+            if (t <= b) {
+                task = a->slots[b & a->mask].load(std::memory_order_relaxed);
+                if (t == b) {
+                    // The last element: race any thieves for it.
+                    if (!fTop.compare_exchange_strong(t, t + 1,
+                                                      std::memory_order_seq_cst,
+                                                      std::memory_order_relaxed)) {
+                        task = nullptr;
+                    }
+                    fBottom.store(b + 1, std::memory_order_relaxed);
+                }
+            } else {
+                fBottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        Task* steal() {
+            int64_t t = fTop.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = fBottom.load(std::memory_order_acquire);
+            if (t >= b) {
+                return nullptr;
+            }
+            Array* a = fArray.load(std::memory_order_acquire);
+            Task* task = a->slots[t & a->mask].load(std::memory_order_relaxed);
+            if (!fTop.compare_exchange_strong(t, t + 1,
+                                              std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                return nullptr;  // Lost the race to the owner or another thief.
+            }
+            return task;
+        }
+
+        bool maybeEmpty() const {
+            return fTop.load(std::memory_order_acquire) >=
+                   fBottom.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct Array {
+            int64_t mask;
+            std::unique_ptr<std::atomic<Task*>[]> slots;
+        };
+
+        Array* makeArray(int64_t capacity) {
+            auto& a = fArrays.push_back(std::make_unique<Array>());
+            a->mask = capacity - 1;
+            a->slots = std::make_unique<std::atomic<Task*>[]>(capacity);
+            return a.get();
+        }
+
+        Array* grow(Array* old, int64_t t, int64_t b) {
+            Array* a = this->makeArray(2 * (old->mask + 1));
+            for (int64_t i = t; i < b; i++) {
+                a->slots[i & a->mask].store(old->slots[i & old->mask].load(
+                                                    std::memory_order_relaxed),
+                                            std::memory_order_relaxed);
+            }
+            fArray.store(a, std::memory_order_release);
+            return a;
+        }
+
+        std::atomic<int64_t> fTop{0};
+        std::atomic<int64_t> fBottom{0};
+        std::atomic<Array*>  fArray;
+        TArray<std::unique_ptr<Array>> fArrays;  // Owner-only.
+    };
+
+    // Bounded multi-producer multi-consumer queue (Dmitry Vyukov's design). Each cell's sequence
+    // number says whether it is ready to be written (== pos) or read (== pos + 1).
+    class InjectionQueue {
+    public:
+        static constexpr size_t kCapacity = 4096;  // Must be a power of two.
+
+        InjectionQueue() : fCells(std::make_unique<Cell[]>(kCapacity)) {
+            for (size_t i = 0; i < kCapacity; i++) {
+                fCells[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool push(Task* task) {
+            size_t pos = fEnqueue.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &fCells[pos & (kCapacity - 1)];
+                size_t seq = cell->seq.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                if (diff == 0) {
+                    if (fEnqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;  // Full.
+                } else {
+                    pos = fEnqueue.load(std::memory_order_relaxed);
+                }
+            }
+            cell->task = task;
+            cell->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        Task* pop() {
+            size_t pos = fDequeue.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &fCells[pos & (kCapacity - 1)];
+                size_t seq = cell->seq.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+                if (diff == 0) {
+                    if (fDequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return nullptr;  // Empty.
+                } else {
+                    pos = fDequeue.load(std::memory_order_relaxed);
+                }
+            }
+            Task* task = cell->task;
+            cell->seq.store(pos + kCapacity, std::memory_order_release);
+            return task;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> seq;
+            Task*               task;
+        };
+
+        std::unique_ptr<Cell[]> fCells;
+        alignas(64) std::atomic<size_t> fEnqueue{0};
+        alignas(64) std::atomic<size_t> fDequeue{0};
+    };
+
+    struct alignas(64) Worker {
+        SkWorkStealingThreadPool* fPool = nullptr;
+        int                       fIndex = 0;
+        uint32_t                  fRandom = 0;  // xorshift state for picking victims.
+        Deque                     fDeque;
+        NodeCache                 fNodes;
+    };
+
+    static thread_local Worker* tCurrentWorker;
+
+public:
+    explicit SkWorkStealingThreadPool(int threads, bool allowBorrowing)
+            : fNumWorkers(threads)
+            , fWorkers(std::make_unique<Worker[]>(threads))
+            , fAllowBorrowing(allowBorrowing) {
+        for (int i = 0; i < fNumWorkers; i++) {
+            fWorkers[i].fPool = this;
+            fWorkers[i].fIndex = i;
+            fWorkers[i].fRandom = 0x9E3779B9u * (i + 1);
+        }
+        for (int i = 0; i < fNumWorkers; i++) {
+            fThreads.emplace_back(&Loop, &fWorkers[i]);
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Workers drain any remaining work, then exit once they find none.
+        fShutdown.store(true, std::memory_order_seq_cst);
+        fWorkAvailable.signal(fThreads.size());
+        for (int i = 0; i < fThreads.size(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    // There is a single priority: workList is ignored.
+    void add(std::function<void(void)> work, int /* workList */) override {
+        Worker* self = this->currentWorker();
+        Task* task;
+        if (self) {
+            task = self->fNodes.get(self->fIndex);
+        } else {
+            SkAutoSpinlock lock(fExternalLock);
+            task = fExternalNodes.get(kExternalHome);
+        }
+        task->fn = std::move(work);
+
+        if (self) {
+            self->fDeque.push(task);
+        } else if (!fInjection.push(task)) {
+            SkAutoMutexExclusive lock(fOverflowLock);
+            fOverflow.push_back(task);
+            fOverflowCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Pairs with the fence in Loop(): either we see its sleeper count, or it sees our task.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (fSleepers.load(std::memory_order_relaxed) > 0) {
+            fWorkAvailable.signal(1);
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        this->add(std::move(work), /* workList= */ 0);
+    }
+
+    int discardAllPendingWork() override {
+        int numDiscarded = 0;
+        while (Task* task = this->findSharedWork(/* self= */ nullptr)) {
+            this->recycle(task);
+            numDiscarded++;
+        }
+        return numDiscarded;
+    }
+
+    // Run one task if there is any. Called from a worker (e.g. inside SkTaskGroup::wait() on a
+    // nested group), this pops the worker's own deque first, which is where that group's tasks
+    // were pushed.
+    void borrow() override {
+        if (!fAllowBorrowing) {
+            return;
+        }
+        Worker* self = this->currentWorker();
+        Task* task = self ? self->fDeque.pop() : nullptr;
+        if (!task) {
+            task = this->findSharedWork(self);
+        }
+        if (task) {
+            this->run(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr int kExternalHome = -1;
+
+    Worker* currentWorker() const {
+        Worker* w = tCurrentWorker;
+        return w && w->fPool == this ? w : nullptr;
+    }
+
+    // Work that is not in the caller's own deque: the injection queue, its overflow, and the
+    // other workers' deques, starting from a random victim.
+    Task* findSharedWork(Worker* self) {
+        if (Task* task = fInjection.pop()) {
+            return task;
+        }
+        if (fOverflowCount.load(std::memory_order_relaxed) > 0) {
+            SkAutoMutexExclusive lock(fOverflowLock);
+            if (!fOverflow.empty()) {
+                Task* task = fOverflow.front();
+                fOverflow.pop_front();
+                fOverflowCount.fetch_sub(1, std::memory_order_relaxed);
+                return task;
+            }
+        }
+
+        int start = 0;
+        if (self) {
+            uint32_t x = self->fRandom;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            self->fRandom = x;
+            start = (int)(x % (uint32_t)fNumWorkers);
+        }
+        for (int i = 0; i < fNumWorkers; i++) {
+            Worker& victim = fWorkers[(start + i) % fNumWorkers];
+            if (&victim == self) {
+                continue;
+            }
+            if (Task* task = victim.fDeque.steal()) {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    Task* findWork(Worker* self) {
+        if (Task* task = self->fDeque.pop()) {
+            return task;
+        }
+        return this->findSharedWork(self);
+    }
+
+    bool mayHaveWork() const {
+        // The injection queue is checked by findSharedWork(); this covers the deques.
+        for (int i = 0; i < fNumWorkers; i++) {
+            if (!fWorkers[i].fDeque.maybeEmpty()) {
+                return true;
+            }
+        }
+        return fOverflowCount.load(std::memory_order_relaxed) > 0;
+    }
+
+    void run(Task* task) {
+        std::function<void(void)> fn = std::move(task->fn);
+        this->recycle(task);
+        fn();
+    }
+
+    void recycle(Task* task) {
+        task->fn = nullptr;
+        Worker* self = this->currentWorker();
+        if (task->home == kExternalHome) {
+            fExternalNodes.putRemote(task);
+        } else if (self && self->fIndex == task->home) {
+            self->fNodes.putLocal(task);
+        } else {
+            fWorkers[task->home].fNodes.putRemote(task);
+        }
+    }
+
+    static void Loop(void* ctx) {
+        auto self = (Worker*)ctx;
+        SkWorkStealingThreadPool* pool = self->fPool;
+        tCurrentWorker = self;
+
+        constexpr int kSpins = 64;
+        int idle = 0;
+        for (;;) {
+            if (Task* task = pool->findWork(self)) {
+                pool->run(task);
+                idle = 0;
+                continue;
+            }
+            if (++idle < kSpins) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Announce that we're going to sleep, then look once more before doing so.
+            pool->fSleepers.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            Task* task = pool->findWork(self);
+            if (!task && !pool->mayHaveWork()) {
+                if (pool->fShutdown.load(std::memory_order_acquire)) {
+                    pool->fSleepers.fetch_sub(1, std::memory_order_relaxed);
+                    break;
+                }
+                pool->fWorkAvailable.wait();
+            }
+            pool->fSleepers.fetch_sub(1, std::memory_order_relaxed);
+            idle = 0;
+            if (task) {
+                pool->run(task);
+            }
+        }
+        tCurrentWorker = nullptr;
+    }
+
+    TArray<std::thread>         fThreads;
+    const int                   fNumWorkers;
+    std::unique_ptr<Worker[]>   fWorkers;
+    InjectionQueue              fInjection;
+
+    SkSpinlock                  fExternalLock;
+    NodeCache                   fExternalNodes;  // fLocal guarded by fExternalLock.
+
+    SkMutex                     fOverflowLock;
+    std::deque<Task*>           fOverflow SK_GUARDED_BY(fOverflowLock);
+    std::atomic<int>            fOverflowCount{0};
+
+    std::atomic<int>            fSleepers{0};
+    std::atomic<bool>           fShutdown{false};
+    SkSemaphore                 fWorkAvailable;
+    const bool                  fAllowBorrowing;
+};
+
+thread_local SkWorkStealingThreadPool::Worker* SkWorkStealingThreadPool::tCurrentWorker = nullptr;
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads, bool allowBorrowing) {
     using WorkList = std::deque<std::function<void(void)>>;
     return std::make_unique<SkThreadPool<WorkList>>(/* numWorkLists= */ 1,
@@ -217,3 +670,9 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeMultiListLIFOThreadPool(int numWorkL
                                                     threads > 0 ? threads : num_cores(),
                                                     allowBorrowing);
 }
+
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads,
+                                                                   bool allowBorrowing) {
+    return std::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores(),
+                                                      allowBorrowing);
+}
@@ -118,6 +118,9 @@ void SkFont::setEmbolden(bool predicate) {
 void SkFont::setBaselineSnap(bool predicate) {
     fFlags = set_clear_mask(fFlags, predicate, kBaselineSnap_PrivFlag);
 }
+void SkFont::setScaleBucketing(bool predicate) {
+    fFlags = set_clear_mask(fFlags, predicate, kScaleBucketing_PrivFlag);
+}
 void SkFont::setEdging(Edging e) {
     fEdging = SkToU8(e);
 }
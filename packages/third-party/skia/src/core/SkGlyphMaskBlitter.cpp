@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkGlyphMaskBlitter.h"
+
+#include "include/core/SkAlphaType.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkCoreBlitters.h"
+
+#include <cstdint>
+
+namespace {
+// This follows the raster pipeline's src-over A8 mask blit (scale_u8), so F16 text looks the same
+// drawn either way. Pixels are blended two at a time, one channel per lane.
+void blit_row_f16_a8(uint64_t* dst, const uint8_t* mask, skvx::float4 color, int width) {
+    const skvx::float8 color2 = skvx::join(color, color);
+    int i = 0;
+    for (; i + 2 <= width; i += 2) {
+        if ((mask[i] | mask[i + 1]) == 0) {
+            continue;
+        }
+        const skvx::float8 coverage = skvx::join(skvx::float4(mask[i]),
+                                                 skvx::float4(mask[i + 1])) * (1 / 255.0f);
+        const skvx::float8 c = color2 * coverage;
+        const skvx::float8 d = skvx::from_half(skvx::Vec<8, uint16_t>::Load(dst + i));
+        const skvx::float8 invA = 1.0f - skvx::shuffle<3,3,3,3, 7,7,7,7>(c);
+        skvx::to_half(c + d * invA).store(dst + i);
+    }
+    if (i < width && mask[i] != 0) {
+        const skvx::float4 c = color * (mask[i] * (1 / 255.0f));
+        const skvx::float4 d = skvx::from_half(skvx::half4::Load(dst + i));
+        skvx::to_half(c + d * (1.0f - c[3])).store(dst + i);
+    }
+}
+}  // namespace
+
+std::optional<SkGlyphMaskBlitter> SkGlyphMaskBlitter::Make(const SkPixmap& dst,
+                                                           const SkPaint& paint,
+                                                           const SkMatrix& ctm) {
+    if (paint.getShader() || paint.getColorFilter() || paint.getMaskFilter() ||
+        !paint.isSrcOver() || paint.isDither()) {
+        return std::nullopt;
+    }
+
+    switch (dst.colorType()) {
+        case kN32_SkColorType:
+            // Only where the legacy N32 blitter would be chosen, whose kernels are used below.
+            if (!SkBlitter::UseLegacyBlitter(dst, paint, ctm)) {
+                return std::nullopt;
+            }
+            return SkGlyphMaskBlitter{dst, paint.getColor(), SkPMColor4f{}};
+        case kRGBA_F16_SkColorType: {
+            if (dst.alphaType() == kUnpremul_SkAlphaType) {
+                return std::nullopt;
+            }
+            SkColor4f color = paint.getColor4f();
+            SkColorSpaceXformSteps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                                   dst.colorSpace(),    kUnpremul_SkAlphaType).apply(color.vec());
+            return SkGlyphMaskBlitter{dst, paint.getColor(), color.premul()};
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+void SkGlyphMaskBlitter::blitMasks(SkSpan<const SkMask> masks, const SkIRect& clip) const {
+    const bool isN32 = fDst.colorType() == kN32_SkColorType;
+    if (isN32 ? SkColorGetA(fColor) == 0 : fDstColor.fA == 0) {
+        return;
+    }
+
+    for (const SkMask& mask : masks) {
+        SkASSERT(this->canBlit(mask.fFormat));
+        SkIRect bounds;
+        if (!bounds.intersect(mask.fBounds, clip)) {
+            continue;
+        }
+        if (isN32) {
+            SkARGB32_BlitColorMask(fDst, mask, bounds, fColor);
+        } else {
+            this->blitF16(mask, bounds);
+        }
+    }
+}
+
+void SkGlyphMaskBlitter::blitF16(const SkMask& mask, const SkIRect& clip) const {
+    SkASSERT(mask.fFormat == SkMask::kA8_Format);
+    const skvx::float4 color = skvx::float4::Load(fDstColor.vec());
+    auto* dstRow = fDst.writable_addr64(clip.fLeft, clip.fTop);
+    const uint8_t* maskRow = mask.getAddr8(clip.fLeft, clip.fTop);
+    for (int y = clip.height(); y --> 0;) {
+        blit_row_f16_a8(dstRow, maskRow, color, clip.width());
+        dstRow  = SkTAddOffset<uint64_t>(dstRow, fDst.rowBytes());
+        maskRow += mask.fRowBytes;
+    }
+}
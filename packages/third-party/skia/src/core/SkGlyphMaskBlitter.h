@@ -0,0 +1,58 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkGlyphMaskBlitter_DEFINED
+#define SkGlyphMaskBlitter_DEFINED
+
+#include "include/core/SkColor.h"
+#include "include/core/SkColorType.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSpan.h"
+#include "src/core/SkMask.h"
+
+#include <optional>
+
+class SkMatrix;
+class SkPaint;
+struct SkIRect;
+
+// Draws the A8 and LCD16 glyph masks of a text run in a solid color straight into N32 or F16
+// pixels. Unlike going through an SkBlitter, nothing is set up per run beyond the color, and each
+// mask is blended by a kernel chosen once for the destination, without per-glyph dispatch.
+class SkGlyphMaskBlitter {
+public:
+    // Returns nothing if drawing with paint into dst needs a general SkBlitter: a shader, color
+    // filter, mask filter, blend mode other than src-over, dithering, or an unsupported
+    // destination.
+    static std::optional<SkGlyphMaskBlitter> Make(const SkPixmap& dst,
+                                                  const SkPaint& paint,
+                                                  const SkMatrix& ctm);
+
+    // A8 masks can be drawn into either destination. LCD16 masks only reach N32 destinations;
+    // the glyph painter asks for A8 masks everywhere else.
+    bool canBlit(SkMask::Format format) const {
+        return format == SkMask::kA8_Format ||
+               (format == SkMask::kLCD16_Format && fDst.colorType() == kN32_SkColorType);
+    }
+
+    // Draws each mask, in order, restricted to clip. All masks must satisfy canBlit().
+    void blitMasks(SkSpan<const SkMask> masks, const SkIRect& clip) const;
+
+private:
+    SkGlyphMaskBlitter(const SkPixmap& dst, SkColor color, const SkPMColor4f& dstColor)
+            : fDst{dst}, fColor{color}, fDstColor{dstColor} {}
+
+    void blitF16(const SkMask& mask, const SkIRect& clip) const;
+
+    const SkPixmap fDst;
+    // The paint color, used by the N32 kernels.
+    const SkColor fColor;
+    // The paint color premultiplied in the destination's color space, used by the F16 kernels.
+    const SkPMColor4f fDstColor;
+};
+
+#endif  // SkGlyphMaskBlitter_DEFINED
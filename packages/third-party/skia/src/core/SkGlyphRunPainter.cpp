@@ -35,6 +35,7 @@
 #include "src/text/GlyphRun.h"
 
 #include <algorithm>
+#include <cmath>
 #include <tuple>
 
 using namespace skia_private;
@@ -116,12 +117,16 @@ prepare_for_drawable_drawing(SkStrike* strike,
     return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
 }
 
+// Resolves glyphs for kDirectMaskCPU. Accepted positions are the rounded device positions, or
+// the unmapped source positions when keepSourcePositions is set. Glyphs already resolved are
+// found without taking the strike's lock; the lock is only taken to resolve the rest.
 std::tuple<SkZip<const SkGlyph*, SkPoint>, SkZip<SkGlyphID, SkPoint>>
-prepare_for_direct_mask_drawing(SkStrike* strike,
-                                const SkMatrix& creationMatrix,
-                                SkZip<const SkGlyphID, const SkPoint> source,
-                                SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
-                                SkZip<SkGlyphID, SkPoint> rejectedBuffer) {
+prepare_for_direct_mask_cpu(SkStrike* strike,
+                            const SkMatrix& creationMatrix,
+                            SkZip<const SkGlyphID, const SkPoint> source,
+                            SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
+                            SkZip<SkGlyphID, SkPoint> rejectedBuffer,
+                            bool keepSourcePositions) {
     const SkIPoint mask = strike->roundingSpec().ignorePositionFieldMask;
     const SkPoint halfSampleFreq = strike->roundingSpec().halfAxisSampleFreq;
 
@@ -130,37 +135,87 @@ prepare_for_direct_mask_drawing(SkStrike* strike,
     SkMatrix positionMatrixWithRounding = creationMatrix;
     positionMatrixWithRounding.postTranslate(halfSampleFreq.x(), halfSampleFreq.y());
 
+    auto acceptedPosition = [&](SkPoint mappedPos, SkPoint pos) {
+        return keepSourcePositions ? pos : SkPoint{SkScalarFloorToScalar(mappedPos.x()),
+                                                   SkScalarFloorToScalar(mappedPos.y())};
+    };
+
+    // Misses hold a null glyph in the accepted buffer until they are resolved under the lock,
+    // which keeps the accepted glyphs in source order.
+    struct Miss {
+        int acceptedIndex;
+        size_t sourceIndex;
+        SkPackedGlyphID packedGlyphID;
+    };
+    STArray<16, Miss> misses;
+
     int acceptedSize = 0;
     int rejectedSize = 0;
-    strike->lock();
-    for (auto [glyphID, pos] : source) {
+    for (size_t i = 0; i < source.size(); ++i) {
+        auto [glyphID, pos] = source[i];
         if (!SkIsFinite(pos.x(), pos.y())) {
             continue;
         }
 
         const SkPoint mappedPos = positionMatrixWithRounding.mapPoint(pos);
         const SkPackedGlyphID packedGlyphID = SkPackedGlyphID{glyphID, mappedPos, mask};
-        switch (SkGlyphDigest digest = strike->digestFor(kDirectMaskCPU, packedGlyphID);
-                digest.actionFor(kDirectMaskCPU)) {
-            case GlyphAction::kAccept: {
-                const SkPoint roundedPos{SkScalarFloorToScalar(mappedPos.x()),
-                                         SkScalarFloorToScalar(mappedPos.y())};
+        const SkGlyph* glyph;
+        if (strike->directMaskCPUGlyph(packedGlyphID, &glyph)) {
+            if (glyph != nullptr) {
                 acceptedBuffer[acceptedSize++] =
-                        std::make_tuple(strike->glyph(digest), roundedPos);
-                break;
+                        std::make_tuple(glyph, acceptedPosition(mappedPos, pos));
             }
+        } else {
+            misses.push_back({acceptedSize, i, packedGlyphID});
+            acceptedBuffer[acceptedSize++] =
+                    std::make_tuple(nullptr, acceptedPosition(mappedPos, pos));
+        }
+    }
+    if (misses.empty()) {
+        return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
+    }
+
+    bool unresolved = false;
+    strike->lock();
+    for (const Miss& miss : misses) {
+        switch (SkGlyphDigest digest = strike->digestFor(kDirectMaskCPU, miss.packedGlyphID);
+                digest.actionFor(kDirectMaskCPU)) {
+            case GlyphAction::kAccept:
+                std::get<0>(acceptedBuffer[miss.acceptedIndex]) = strike->glyph(digest);
+                break;
             case GlyphAction::kReject:
-                rejectedBuffer[rejectedSize++] = std::make_tuple(glyphID, pos);
+                rejectedBuffer[rejectedSize++] = source[miss.sourceIndex];
+                unresolved = true;
                 break;
             default:
+                unresolved = true;
                 break;
         }
     }
     strike->unlock();
 
+    if (unresolved) {
+        int kept = 0;
+        for (int i = 0; i < acceptedSize; ++i) {
+            if (std::get<0>(acceptedBuffer[i]) != nullptr) {
+                acceptedBuffer[kept++] = acceptedBuffer[i];
+            }
+        }
+        acceptedSize = kept;
+    }
     return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
 }
 
+std::tuple<SkZip<const SkGlyph*, SkPoint>, SkZip<SkGlyphID, SkPoint>>
+prepare_for_direct_mask_drawing(SkStrike* strike,
+                                const SkMatrix& creationMatrix,
+                                SkZip<const SkGlyphID, const SkPoint> source,
+                                SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
+                                SkZip<SkGlyphID, SkPoint> rejectedBuffer) {
+    return prepare_for_direct_mask_cpu(
+            strike, creationMatrix, source, acceptedBuffer, rejectedBuffer, false);
+}
+
 // Same as prepare_for_direct_mask_drawing but accepted points are unmapped source points.
 std::tuple<SkZip<const SkGlyph*, SkPoint>, SkZip<SkGlyphID, SkPoint>>
 prepare_for_direct_bitmap_drawing(SkStrike* strike,
@@ -168,41 +223,31 @@ prepare_for_direct_bitmap_drawing(SkStrike* strike,
                                   SkZip<const SkGlyphID, const SkPoint> source,
                                   SkZip<const SkGlyph*, SkPoint> acceptedBuffer,
                                   SkZip<SkGlyphID, SkPoint> rejectedBuffer) {
-    const SkIPoint mask = strike->roundingSpec().ignorePositionFieldMask;
-    const SkPoint halfSampleFreq = strike->roundingSpec().halfAxisSampleFreq;
-
-    // Build up the mapping from source space to device space. Add the rounding constant
-    // halfSampleFreq, so we just need to floor to get the device result.
-    SkMatrix positionMatrixWithRounding = creationMatrix;
-    positionMatrixWithRounding.postTranslate(halfSampleFreq.x(), halfSampleFreq.y());
-
-    int acceptedSize = 0;
-    int rejectedSize = 0;
-    strike->lock();
-    for (auto [glyphID, pos] : source) {
-        if (!SkIsFinite(pos.x(), pos.y())) {
-            continue;
-        }
+    return prepare_for_direct_mask_cpu(
+            strike, creationMatrix, source, acceptedBuffer, rejectedBuffer, true);
+}
 
-        const SkPoint mappedPos = positionMatrixWithRounding.mapPoint(pos);
-        const SkPackedGlyphID packedGlyphID = SkPackedGlyphID{glyphID, mappedPos, mask};
-        switch (SkGlyphDigest digest = strike->digestFor(kDirectMaskCPU, packedGlyphID);
-                digest.actionFor(kDirectMaskCPU)) {
-            case GlyphAction::kAccept: {
-                acceptedBuffer[acceptedSize++] =
-                        std::make_tuple(strike->glyph(digest), pos);
-                break;
-            }
-            case GlyphAction::kReject:
-                rejectedBuffer[rejectedSize++] = std::make_tuple(glyphID, pos);
-                break;
-            default:
-                break;
-        }
+// Returns the power-of-sqrt(2) scale a run's glyphs should be rasterized at when its font asks for
+// scale bucketing, or 0 if the run should be rasterized at its exact device scale. Bucketing only
+// applies to anti-aliased, solid color, SrcOver text under a uniform scale and translate, and the
+// exact scale is kept when it already lands on a bucket. Bucketed masks are drawn as bitmaps, so
+// other blend modes and color filters would touch their transparent pixels too.
+SkScalar bucketed_text_scale(const SkFont& font, const SkPaint& paint, const SkMatrix& matrix) {
+    if (!font.isScaleBucketing() ||
+        font.getEdging() == SkFont::Edging::kAlias ||
+        paint.getShader() || paint.getMaskFilter() || paint.getPathEffect() ||
+        !paint.isSrcOver() || paint.getColorFilter() ||
+        !matrix.isScaleTranslate() ||
+        matrix.getScaleX() != matrix.getScaleY() || matrix.getScaleX() <= 0) {
+        return 0;
     }
-    strike->unlock();
 
-    return {acceptedBuffer.first(acceptedSize), rejectedBuffer.first(rejectedSize)};
+    const SkScalar scale = matrix.getScaleX();
+    const SkScalar bucket = std::exp2(std::round(2 * std::log2(scale)) * 0.5f);
+    if (std::fabs(scale / bucket - 1) < 1.0f / 256 || !SkIsFinite(bucket)) {
+        return 0;
+    }
+    return bucket;
 }
 }  // namespace
 
@@ -320,18 +365,65 @@ void GlyphRunListPainter::drawForBitmapDevice(SkCanvas* canvas,
             }
         }
         if (!source.empty() && !positionMatrix.hasPerspective()) {
-            SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
-                    runFont, paint, props, fScalerContextFlags, positionMatrix);
+            if (SkScalar bucketScale = bucketed_text_scale(runFont, paint, positionMatrix)) {
+                // The masks are rasterized at the bucket scale and resampled to the device, so
+                // every scale between neighboring buckets shares a single strike. The resampled
+                // masks are drawn as alpha images, which can't carry LCD coverage. Resampling
+                // already places them at sub-pixel positions, so only one variant is needed.
+                SkFont bucketFont = runFont;
+                bucketFont.setSubpixel(false);
+                SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                        bucketFont, paint, fBitmapFallbackProps, fScalerContextFlags,
+                        SkMatrix::Scale(bucketScale, bucketScale));
+
+                auto strike = strikeSpec.findOrCreateStrike();
+
+                auto [accepted, rejected] = prepare_for_direct_bitmap_drawing(
+                        strike.get(), SkMatrix::Scale(bucketScale, bucketScale), source,
+                        acceptedBuffer, rejectedBuffer);
+                source = rejected;
 
-            auto strike = strikeSpec.findOrCreateStrike();
+                SkPaint bitmapPaint = paint;
+                bitmapPaint.setAntiAlias(true);
+                const SkScalar invBucketScale = 1.0f / bucketScale;
+                for (auto [glyph, srcPos] : accepted) {
+                    SkMask mask = glyph->mask();
+                    SkColorType maskColorType;
+                    switch (mask.fFormat) {
+                        case SkMask::kA8_Format:     maskColorType = kAlpha_8_SkColorType; break;
+                        case SkMask::kARGB32_Format: maskColorType = kN32_SkColorType;     break;
+                        default: continue;
+                    }
+                    SkBitmap bm;
+                    bm.installPixels(SkImageInfo::Make(mask.fBounds.size(),
+                                                       maskColorType,
+                                                       kPremul_SkAlphaType),
+                                     const_cast<uint8_t*>(mask.fImage),
+                                     mask.fRowBytes);
+                    bm.setImmutable();
+
+                    SkPoint pos = drawOrigin + srcPos
+                                + SkPoint::Make(mask.fBounds.left(), mask.fBounds.top())
+                                        * invBucketScale;
+                    SkMatrix translate = SkMatrix::Translate(pos);
+                    translate.preScale(invBucketScale, invBucketScale);
+                    bitmapDevice->drawBitmap(
+                            bm, translate, nullptr, SkFilterMode::kLinear, bitmapPaint);
+                }
+            } else {
+                SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                        runFont, paint, props, fScalerContextFlags, positionMatrix);
+
+                auto strike = strikeSpec.findOrCreateStrike();
 
-            auto [accepted, rejected] = prepare_for_direct_mask_drawing(strike.get(),
-                                                                        positionMatrix,
-                                                                        source,
-                                                                        acceptedBuffer,
-                                                                        rejectedBuffer);
-            source = rejected;
-            bitmapDevice->paintMasks(accepted, paint);
+                auto [accepted, rejected] = prepare_for_direct_mask_drawing(strike.get(),
+                                                                            positionMatrix,
+                                                                            source,
+                                                                            acceptedBuffer,
+                                                                            rejectedBuffer);
+                source = rejected;
+                bitmapDevice->paintMasks(accepted, paint);
+            }
         }
         if (!source.empty()) {
             // Create a strike is source space to calculate scale information.
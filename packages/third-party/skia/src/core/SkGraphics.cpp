@@ -7,10 +7,13 @@
 
 #include "include/core/SkGraphics.h"
 
+#include "include/core/SkData.h"
+#include "include/core/SkTypeface.h"
 #include "src/core/SkBitmapProcState.h"
 #include "src/core/SkBlitMask.h"
 #include "src/core/SkBlitRow.h"
 #include "src/core/SkCpu.h"
+#include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkOpts.h"
@@ -78,6 +81,15 @@ void SkGraphics::PurgePinnedFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgePinned();
 }
 
+sk_sp<SkData> SkGraphics::SerializeFontCache(SkSpan<const sk_sp<SkTypeface>> typefaces) {
+    return SkStrikeCache::GlobalStrikeCache()->serializeSnapshot(typefaces);
+}
+
+int SkGraphics::PreloadFontCache(const SkData& snapshot,
+                                 SkSpan<const sk_sp<SkTypeface>> typefaces) {
+    return SkStrikeCache::GlobalStrikeCache()->preloadSnapshot(snapshot, typefaces);
+}
+
 size_t SkGraphics::GetResourceCacheTotalBytesUsed() { return SkResourceCache::GetTotalBytesUsed(); }
 
 size_t SkGraphics::GetResourceCacheTotalByteLimit() { return SkResourceCache::GetTotalByteLimit(); }
@@ -94,6 +106,34 @@ size_t SkGraphics::SetResourceCacheSingleAllocationByteLimit(size_t newLimit) {
     return SkResourceCache::SetSingleAllocationByteLimit(newLimit);
 }
 
+void SkGraphics::SetImageFilterCacheContentAddressed(bool contentAddressed) {
+    SkImageFilterCache::Get()->setContentAddressed(contentAddressed);
+}
+
+bool SkGraphics::GetImageFilterCacheContentAddressed() {
+    return SkImageFilterCache::Get()->isContentAddressed();
+}
+
+size_t SkGraphics::GetImageFilterCacheTotalBytesUsed() {
+    return SkImageFilterCache::Get()->getTotalBytesUsed();
+}
+
+size_t SkGraphics::GetImageFilterCacheTotalByteLimit() {
+    return SkImageFilterCache::Get()->getTotalByteLimit();
+}
+
+size_t SkGraphics::SetImageFilterCacheTotalByteLimit(size_t newLimit) {
+    return SkImageFilterCache::Get()->setTotalByteLimit(newLimit);
+}
+
+uint64_t SkGraphics::GetImageFilterCacheHitCount() {
+    return SkImageFilterCache::Get()->getHitCount();
+}
+
+uint64_t SkGraphics::GetImageFilterCacheMissCount() {
+    return SkImageFilterCache::Get()->getMissCount();
+}
+
 void SkGraphics::PurgeResourceCache() {
     SkImageFilter_Base::PurgeCache();
     return SkResourceCache::PurgeAll();
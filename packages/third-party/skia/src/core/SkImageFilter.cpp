@@ -7,15 +7,21 @@
 
 #include "include/core/SkImageFilter.h"
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkData.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkM44.h"
+#include "include/core/SkPicture.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSerialProcs.h"
 #include "include/core/SkTypes.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkImageFilter_Base.h"
@@ -115,6 +121,19 @@ bool SkImageFilter_Base::affectsTransparentBlack() const {
     return false;
 }
 
+bool SkImageFilter_Base::canEvaluateInTiles(const skif::Context& context) const {
+    if (!this->onCanEvaluateInTiles(context)) {
+        return false;
+    }
+    for (int i = 0; i < this->countInputs(); i++) {
+        const SkImageFilter* input = this->getInput(i);
+        if (input && !as_IFB(input)->canEvaluateInTiles(context)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool SkImageFilter::asAColorFilter(SkColorFilter** filterPtr) const {
     SkASSERT(nullptr != filterPtr);
     if (!this->isColorFilterNode(filterPtr)) {
@@ -228,6 +247,30 @@ void SkImageFilter_Base::flatten(SkWriteBuffer& buffer) const {
     }
 }
 
+// Hashes the pixels and color info of a raster source, seeded with the filter's structure hash.
+// Layers are re-rendered into a new image every frame, so this is what lets a content-addressed
+// cache reuse a saveLayer's filtered result. Returns 0 for GPU-backed sources.
+static uint64_t source_content_hash(const SkSpecialImage& source, uint64_t seed) {
+    SkBitmap bitmap;
+    if (!SkSpecialImages::AsBitmap(&source, &bitmap)) {
+        return 0;
+    }
+    const SkImageInfo& info = bitmap.info();
+    const uint32_t format[] = {
+            static_cast<uint32_t>(info.colorType()),
+            static_cast<uint32_t>(info.alphaType()),
+            info.colorSpace() ? info.colorSpace()->toXYZD50Hash() : 0,
+            info.colorSpace() ? info.colorSpace()->transferFnHash() : 0,
+    };
+    uint64_t hash = SkChecksum::Hash64(format, sizeof(format), seed);
+    const size_t rowBytes = info.minRowBytes();
+    for (int y = 0; y < bitmap.height(); ++y) {
+        hash = SkChecksum::Hash64(bitmap.getAddr(0, y), rowBytes, hash);
+    }
+    // Zero means the source is not content-addressed.
+    return std::max<uint64_t>(hash, 1);
+}
+
 skif::FilterResult SkImageFilter_Base::filterImage(const skif::Context& context) const {
     context.markVisitedImageFilter();
 
@@ -244,24 +287,58 @@ skif::FilterResult SkImageFilter_Base::filterImage(const skif::Context& context)
     uint32_t srcGenID = srcInKey ? context.source().image()->uniqueID() : SK_InvalidUniqueID;
     const SkIRect srcSubset = srcInKey ? context.source().image()->subset() : SkIRect::MakeWH(0, 0);
 
-    SkImageFilterCacheKey key(fUniqueID,
+    // A content-addressed cache identifies the filter by its structure instead of its unique ID,
+    // so its results outlive this particular filter object and aren't purged along with it. A
+    // raster source is identified by its pixels instead of its ID as well; GPU-backed sources
+    // keep their ID, so only image sources benefit there.
+    SkImageFilterCache* cache = context.backend()->cache();
+    uint64_t structureHash = cache && cache->isContentAddressed() ? this->structureHash() : 0;
+    if (structureHash && srcInKey) {
+        if (uint64_t contentHash = source_content_hash(*context.source().image(), structureHash)) {
+            structureHash = contentHash;
+            srcGenID = SK_InvalidUniqueID;
+        }
+    }
+    SkImageFilterCacheKey key(structureHash ? 0 : fUniqueID,
                               context.mapping().layerMatrix().asM33(),
                               SkIRect(context.desiredOutput()),
-                              srcGenID, srcSubset);
-    if (context.backend()->cache() && context.backend()->cache()->get(key, &result)) {
+                              srcGenID, srcSubset, structureHash);
+    if (cache && cache->get(key, &result)) {
         context.markCacheHit();
         return result;
     }
 
     result = this->onFilterImage(context);
 
-    if (context.backend()->cache()) {
-        context.backend()->cache()->set(key, this, result);
+    if (cache) {
+        cache->set(key, structureHash ? nullptr : this, result);
     }
 
     return result;
 }
 
+uint64_t SkImageFilter_Base::structureHash() const {
+    fStructureHashOnce([this] {
+        // Images and pictures are immutable, so their IDs identify their content without the cost
+        // of encoding it.
+        SkSerialProcs procs;
+        procs.fImageProc = [](SkImage* image, void*) -> SkSerialReturnType {
+            const uint32_t id = image->uniqueID();
+            return SkData::MakeWithCopy(&id, sizeof(id));
+        };
+        procs.fPictureProc = [](SkPicture* picture, void*) -> SkSerialReturnType {
+            const uint32_t id = picture->uniqueID();
+            return SkData::MakeWithCopy(&id, sizeof(id));
+        };
+        sk_sp<SkData> data = this->serialize(&procs);
+        if (data && data->size() > 0) {
+            // Zero is reserved for filters that can't be serialized.
+            fStructureHash = std::max<uint64_t>(SkChecksum::Hash64(data->data(), data->size()), 1);
+        }
+    });
+    return fStructureHash;
+}
+
 sk_sp<SkImage> SkImageFilter_Base::makeImageWithFilter(sk_sp<skif::Backend> backend,
                                                        sk_sp<SkImage> src,
                                                        const SkIRect& subset,
@@ -16,6 +16,7 @@
 #include "src/core/SkTDynamicHash.h"
 #include "src/core/SkTHash.h"
 
+#include <atomic>
 #include <vector>
 
 using namespace skia_private;
@@ -31,7 +32,8 @@ namespace {
 class CacheImpl : public SkImageFilterCache {
 public:
     typedef SkImageFilterCacheKey Key;
-    CacheImpl(size_t maxBytes) : fMaxBytes(maxBytes), fCurrentBytes(0) { }
+    CacheImpl(size_t maxBytes)
+            : fMaxBytes(maxBytes), fCurrentBytes(0), fHitCount(0), fMissCount(0) { }
     ~CacheImpl() override {
         fLookup.foreach([&](Value* v) { delete v; });
     }
@@ -63,8 +65,10 @@ public:
             }
 
             *result = v->fImage;
+            fHitCount++;
             return true;
         }
+        fMissCount++;
         return false;
     }
 
@@ -78,20 +82,16 @@ public:
         fLookup.add(v);
         fLRU.addToHead(v);
         fCurrentBytes += result.image() ? result.image()->getSize() : 0;
-        if (auto* values = fImageFilterValues.find(filter)) {
-            values->push_back(v);
-        } else {
-            fImageFilterValues.set(filter, {v});
-        }
-
-        while (fCurrentBytes > fMaxBytes) {
-            Value* tail = fLRU.tail();
-            SkASSERT(tail);
-            if (tail == v) {
-                break;
+        // Content-addressed results aren't tied to the filter object that produced them.
+        if (filter) {
+            if (auto* values = fImageFilterValues.find(filter)) {
+                values->push_back(v);
+            } else {
+                fImageFilterValues.set(filter, {v});
             }
-            this->removeInternal(tail);
         }
+
+        this->purgeToLimit(v);
     }
 
     void purge() override {
@@ -118,8 +118,59 @@ public:
         fImageFilterValues.remove(filter);
     }
 
+    bool isContentAddressed() const override {
+        return fContentAddressed.load(std::memory_order_relaxed);
+    }
+
+    void setContentAddressed(bool contentAddressed) override {
+        if (fContentAddressed.exchange(contentAddressed) != contentAddressed) {
+            this->purge();
+        }
+    }
+
+    size_t getTotalBytesUsed() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        return fCurrentBytes;
+    }
+
+    size_t getTotalByteLimit() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        return fMaxBytes;
+    }
+
+    size_t setTotalByteLimit(size_t newLimit) override {
+        SkAutoMutexExclusive mutex(fMutex);
+        size_t prevLimit = fMaxBytes;
+        fMaxBytes = newLimit;
+        this->purgeToLimit(nullptr);
+        return prevLimit;
+    }
+
+    uint64_t getHitCount() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        return fHitCount;
+    }
+
+    uint64_t getMissCount() const override {
+        SkAutoMutexExclusive mutex(fMutex);
+        return fMissCount;
+    }
+
     SkDEBUGCODE(int count() const override { return fLookup.count(); })
 private:
+    // Evicts least recently used entries until the cache fits its budget, keeping 'keep' even if
+    // it alone exceeds the budget.
+    void purgeToLimit(Value* keep) {
+        while (fCurrentBytes > fMaxBytes) {
+            Value* tail = fLRU.tail();
+            SkASSERT(tail);
+            if (tail == keep) {
+                break;
+            }
+            this->removeInternal(tail);
+        }
+    }
+
     void removeInternal(Value* v) {
         if (v->fFilter) {
             if (auto* values = fImageFilterValues.find(v->fFilter)) {
@@ -147,6 +198,9 @@ private:
     THashMap<const SkImageFilter*, std::vector<Value*>> fImageFilterValues;
     size_t                                              fMaxBytes;
     size_t                                              fCurrentBytes;
+    mutable uint64_t                                    fHitCount;
+    mutable uint64_t                                    fMissCount;
+    std::atomic<bool>                                   fContentAddressed{false};
     mutable SkMutex                                     fMutex;
 };
 
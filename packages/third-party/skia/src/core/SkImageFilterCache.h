@@ -22,15 +22,18 @@ namespace skif { class FilterResult; }
 
 struct SkImageFilterCacheKey {
     SkImageFilterCacheKey(const uint32_t uniqueID, const SkMatrix& matrix,
-        const SkIRect& clipBounds, uint32_t srcGenID, const SkIRect& srcSubset)
+        const SkIRect& clipBounds, uint32_t srcGenID, const SkIRect& srcSubset,
+        uint64_t structureHash = 0)
         : fUniqueID(uniqueID)
         , fMatrix(matrix)
         , fClipBounds(clipBounds)
         , fSrcGenID(srcGenID)
-        , fSrcSubset(srcSubset) {
+        , fSrcSubset(srcSubset)
+        , fStructureHash(structureHash) {
         // Assert that Key is tightly-packed, since it is hashed.
         static_assert(sizeof(SkImageFilterCacheKey) == sizeof(uint32_t) + sizeof(SkMatrix) +
-                                     sizeof(SkIRect) + sizeof(uint32_t) + 4 * sizeof(int32_t),
+                                     sizeof(SkIRect) + sizeof(uint32_t) + 4 * sizeof(int32_t) +
+                                     sizeof(uint64_t),
                                      "image_filter_key_tight_packing");
         fMatrix.getType();  // force initialization of type, so hashes match
         SkASSERT(fMatrix.isFinite());   // otherwise we can't rely on == self when comparing keys
@@ -41,19 +44,26 @@ struct SkImageFilterCacheKey {
     SkIRect fClipBounds;
     uint32_t fSrcGenID;
     SkIRect fSrcSubset;
+    // SkImageFilter_Base::structureHash() when the cache is content-addressed (fUniqueID is then
+    // 0), otherwise 0. For a raster source it also covers the source's pixels, and fSrcGenID is
+    // then SK_InvalidUniqueID.
+    uint64_t fStructureHash;
 
     bool operator==(const SkImageFilterCacheKey& other) const {
         return fUniqueID == other.fUniqueID &&
                fMatrix == other.fMatrix &&
                fClipBounds == other.fClipBounds &&
                fSrcGenID == other.fSrcGenID &&
-               fSrcSubset == other.fSrcSubset;
+               fSrcSubset == other.fSrcSubset &&
+               fStructureHash == other.fStructureHash;
     }
 };
 
 // This cache maps from (filter's unique ID + CTM + clipBounds + src bitmap generation ID) to result
 // NOTE: this is the _specific_ unique ID of the image filter, so refiltering the same image with a
-// copy of the image filter (with exactly the same parameters) will not yield a cache hit.
+// copy of the image filter (with exactly the same parameters) will not yield a cache hit, unless
+// the cache is content-addressed. In that mode the filter is identified by the structure of its DAG
+// instead, so equivalent filters re-created every frame reuse each other's results.
 class SkImageFilterCache : public SkRefCnt {
 public:
     static constexpr size_t kDefaultTransientSize = 32 * 1024 * 1024;
@@ -75,6 +85,20 @@ public:
                      const skif::FilterResult& result) = 0;
     virtual void purge() = 0;
     virtual void purgeByImageFilter(const SkImageFilter*) = 0;
+
+    // Switching modes purges the cache, since existing entries are keyed for the other mode.
+    virtual bool isContentAddressed() const = 0;
+    virtual void setContentAddressed(bool contentAddressed) = 0;
+
+    virtual size_t getTotalBytesUsed() const = 0;
+    virtual size_t getTotalByteLimit() const = 0;
+    // Returns the previous limit, evicting least recently used results to fit the new one.
+    virtual size_t setTotalByteLimit(size_t newLimit) = 0;
+
+    // The number of get() calls that found, or did not find, a cached result.
+    virtual uint64_t getHitCount() const = 0;
+    virtual uint64_t getMissCount() const = 0;
+
     SkDEBUGCODE(virtual int count() const = 0;)
 };
 
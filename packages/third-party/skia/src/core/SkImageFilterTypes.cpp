@@ -8,6 +8,7 @@
 #include "src/core/SkImageFilterTypes.h"
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
@@ -22,6 +23,9 @@
 #include "include/effects/SkRuntimeEffect.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkMalloc.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTArray.h"
 #include "src/base/SkMathPriv.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkBitmapDevice.h"
@@ -35,12 +39,14 @@
 #include "src/core/SkKnownRuntimeEffects.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkRectPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/effects/colorfilters/SkColorFilterBase.h"
 
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <memory>
 
 namespace skif {
 
@@ -183,8 +189,14 @@ std::optional<LayerSpace<SkMatrix>> periodic_axis_transform(
 class RasterBackend : public Backend {
 public:
 
-    RasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType)
-            : Backend(SkImageFilterCache::Get(), surfaceProps, colorType) {}
+    RasterBackend(const SkSurfaceProps& surfaceProps,
+                  SkColorType colorType,
+                  SkExecutor* executor,
+                  int tileSize)
+            : Backend(SkImageFilterCache::Get(), surfaceProps, colorType)
+            , fBlurEngine(executor ? SkBlurEngine::MakeRasterBlurEngine(executor) : nullptr)
+            , fExecutor(executor)
+            , fTileSize(tileSize) {}
 
     sk_sp<SkDevice> makeDevice(SkISize size,
                                sk_sp<SkColorSpace> colorSpace,
@@ -205,10 +217,146 @@ public:
     }
 
     const SkBlurEngine* getBlurEngine() const override {
-        return SkBlurEngine::GetRasterBlurEngine();
+        return fBlurEngine ? fBlurEngine.get() : SkBlurEngine::GetRasterBlurEngine();
     }
+
+    int filterTileSize() const override { return fTileSize; }
+    SkExecutor* filterExecutor() const override { return fExecutor; }
+
+private:
+    std::unique_ptr<const SkBlurEngine> fBlurEngine;
+    SkExecutor* fExecutor;
+    int fTileSize;
+};
+
+// Recycles the pixel memory of the intermediate devices created while filtering tiles. Tiles all
+// have about the same dimensions, so a buffer released by one tile usually fits the next request.
+// Buffers are returned to the pool when the last image or device referencing them is destroyed.
+class TileBufferPool : public SkNVRefCnt<TileBufferPool> {
+public:
+    explicit TileBufferPool(int maxFreeBuffers) : fMaxFreeBuffers(maxFreeBuffers) {}
+
+    ~TileBufferPool() {
+        for (Buffer* buffer : fFreeBuffers) {
+            sk_free(buffer);
+        }
+    }
+
+    sk_sp<SkDevice> makeDevice(const SkImageInfo& info, const SkSurfaceProps& props) {
+        const size_t rowBytes = info.minRowBytes();
+        const size_t byteSize = info.computeByteSize(rowBytes);
+        if (info.isEmpty() || SkImageInfo::ByteSizeOverflowed(byteSize)) {
+            return SkBitmapDevice::Create(info, props);
+        }
+
+        Buffer* buffer = this->acquire(byteSize);
+        // Match SkBitmapDevice::Create(), which starts out transparent.
+        sk_bzero(buffer->pixels(), byteSize);
+
+        // Each outstanding buffer keeps the pool alive; installPixels() releases it on failure.
+        this->ref();
+        SkBitmap bitmap;
+        if (!bitmap.installPixels(info, buffer->pixels(), rowBytes, &ReleaseBuffer, buffer)) {
+            return nullptr;
+        }
+        return sk_make_sp<SkBitmapDevice>(bitmap, props);
+    }
+
+private:
+    struct alignas(16) Buffer {
+        TileBufferPool* fPool;
+        size_t fCapacity;
+
+        void* pixels() { return this + 1; }
+    };
+
+    static void ReleaseBuffer(void* /*pixels*/, void* context) {
+        Buffer* buffer = static_cast<Buffer*>(context);
+        TileBufferPool* pool = buffer->fPool;
+        pool->recycle(buffer);
+        pool->unref();
+    }
+
+    Buffer* acquire(size_t byteSize) {
+        {
+            SkAutoMutexExclusive lock{fMutex};
+            // Take the smallest free buffer that fits.
+            int best = -1;
+            for (int i = 0; i < fFreeBuffers.size(); ++i) {
+                if (fFreeBuffers[i]->fCapacity >= byteSize &&
+                    (best < 0 || fFreeBuffers[i]->fCapacity < fFreeBuffers[best]->fCapacity)) {
+                    best = i;
+                }
+            }
+            if (best >= 0) {
+                Buffer* buffer = fFreeBuffers[best];
+                fFreeBuffers.removeShuffle(best);
+                return buffer;
+            }
+        }
+
+        Buffer* buffer = static_cast<Buffer*>(sk_malloc_throw(sizeof(Buffer) + byteSize));
+        buffer->fPool = this;
+        buffer->fCapacity = byteSize;
+        return buffer;
+    }
+
+    void recycle(Buffer* buffer) {
+        {
+            SkAutoMutexExclusive lock{fMutex};
+            if (fFreeBuffers.size() < fMaxFreeBuffers) {
+                fFreeBuffers.push_back(buffer);
+                return;
+            }
+        }
+        sk_free(buffer);
+    }
+
+    const int fMaxFreeBuffers;
+    SkMutex fMutex;
+    skia_private::TArray<Buffer*> fFreeBuffers;
 };
 
+// Filters a single tile for DrawFilterInTiles(). Intermediate devices come from a shared buffer
+// pool, and nothing is written to the image filter cache since per-tile results are keyed by their
+// tile bounds and would never be reused. Everything else defers to the original backend.
+class TileBackend : public Backend {
+public:
+    TileBackend(sk_sp<Backend> backend, sk_sp<TileBufferPool> pool)
+            : Backend(/*cache=*/nullptr, backend->surfaceProps(), backend->colorType())
+            , fBackend(std::move(backend))
+            , fPool(std::move(pool)) {}
+
+    sk_sp<SkDevice> makeDevice(SkISize size,
+                               sk_sp<SkColorSpace> colorSpace,
+                               const SkSurfaceProps* props) const override {
+        SkImageInfo imageInfo = SkImageInfo::Make(size,
+                                                  this->colorType(),
+                                                  kPremul_SkAlphaType,
+                                                  std::move(colorSpace));
+        return fPool->makeDevice(imageInfo, props ? *props : this->surfaceProps());
+    }
+
+    sk_sp<SkSpecialImage> makeImage(const SkIRect& subset, sk_sp<SkImage> image) const override {
+        return fBackend->makeImage(subset, std::move(image));
+    }
+
+    sk_sp<SkImage> getCachedBitmap(const SkBitmap& data) const override {
+        return fBackend->getCachedBitmap(data);
+    }
+
+    const SkBlurEngine* getBlurEngine() const override { return fBackend->getBlurEngine(); }
+
+private:
+    sk_sp<Backend> fBackend;
+    sk_sp<TileBufferPool> fPool;
+};
+
+// The number of tiles filtered concurrently before they are drawn, which bounds peak memory.
+static constexpr int kTilesPerWave = 8;
+// Each tile typically needs a couple of intermediates alive at once.
+static constexpr int kMaxPooledTileBuffers = 2 * kTilesPerWave;
+
 } // anonymous namespace
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -222,8 +370,95 @@ Backend::Backend(sk_sp<SkImageFilterCache> cache,
 
 Backend::~Backend() = default;
 
-sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType) {
-    return sk_make_sp<RasterBackend>(surfaceProps, colorType);
+sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps,
+                                 SkColorType colorType,
+                                 SkExecutor* executor,
+                                 int tileSize) {
+    return sk_make_sp<RasterBackend>(surfaceProps, colorType, executor, tileSize);
+}
+
+bool DrawFilterInTiles(const Context& ctx,
+                       const SkImageFilter* filter,
+                       SkDevice* device,
+                       const std::function<void(const Context&, const FilterResult&)>& drawTile) {
+    const int tileSize = ctx.backend()->filterTileSize();
+    const LayerSpace<SkIRect>& output = ctx.desiredOutput();
+    if (!filter || tileSize <= 0 || output.isEmpty() ||
+        (output.width() <= tileSize && output.height() <= tileSize)) {
+        return false;
+    }
+    // Tiles are clipped to in device space, so their edges must land exactly on device pixels.
+    if (!is_nearly_integer_translation(LayerSpace<SkMatrix>(
+                ctx.mapping().layerToDevice().asM33())) ||
+        !as_IFB(filter)->canEvaluateInTiles(ctx)) {
+        return false;
+    }
+
+    const int cols = (output.width() + tileSize - 1) / tileSize;
+    const int rows = (output.height() + tileSize - 1) / tileSize;
+    const int tileCount = cols * rows;
+    auto tileBounds = [&](int index) {
+        const int x = output.left() + (index % cols) * tileSize;
+        const int y = output.top() + (index / cols) * tileSize;
+        return LayerSpace<SkIRect>(SkIRect::MakeLTRB(x, y,
+                                                     std::min(x + tileSize, output.right()),
+                                                     std::min(y + tileSize, output.bottom())));
+    };
+
+    sk_sp<Backend> tileBackend = sk_make_sp<TileBackend>(
+            sk_ref_sp(ctx.backend()), sk_make_sp<TileBufferPool>(kMaxPooledTileBuffers));
+    SkExecutor* executor = ctx.backend()->filterExecutor();
+    const int tilesPerWave = executor ? kTilesPerWave : 1;
+
+    FilterResult results[kTilesPerWave];
+    Stats stats[kTilesPerWave];
+    for (int first = 0; first < tileCount; first += tilesPerWave) {
+        const int count = std::min(tilesPerWave, tileCount - first);
+        auto filterTile = [&](int i) {
+            stats[i] = {};
+            Context tileCtx{tileBackend,
+                            ctx.mapping(),
+                            tileBounds(first + i),
+                            ctx.source(),
+                            ctx.colorSpace(),
+                            &stats[i]};
+            results[i] = as_IFB(filter)->filterImage(tileCtx);
+        };
+        if (count > 1) {
+            SkTaskGroup tasks{*executor};
+            tasks.batch(count, filterTile);
+            tasks.wait();
+        } else {
+            filterTile(0);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            ctx.mergeStats(stats[i]);
+
+            const LayerSpace<SkIRect> tile = tileBounds(first + i);
+            device->pushClipStack();
+            {
+                SkAutoDeviceTransformRestore adtr{device, SkM44()};
+                device->clipRect(SkRect::Make(SkIRect(ctx.mapping().layerToDevice(tile))),
+                                 SkClipOp::kIntersect,
+                                 /*aa=*/false);
+            }
+            drawTile(ctx.withNewDesiredOutput(tile), results[i]);
+            device->popClipStack();
+
+            // Release the tile's buffers back to the pool before filtering the next wave.
+            results[i] = {};
+        }
+    }
+    return true;
+}
+
+void Stats::merge(const Stats& other) {
+    fNumVisitedImageFilters += other.fNumVisitedImageFilters;
+    fNumCacheHits += other.fNumCacheHits;
+    fNumOffscreenSurfaces += other.fNumOffscreenSurfaces;
+    fNumShaderClampedDraws += other.fNumShaderClampedDraws;
+    fNumShaderBasedTilingDraws += other.fNumShaderBasedTilingDraws;
 }
 
 void Stats::dumpStats() const {
@@ -30,6 +30,7 @@
 #include "src/core/SkSpecialImage.h"
 
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <utility>
 
@@ -38,6 +39,7 @@ class SkBitmap;
 class SkBlender;
 class SkBlurEngine;
 class SkDevice;
+class SkExecutor;
 class SkImage;
 class SkImageFilter;
 class SkImageFilterCache;
@@ -1123,6 +1125,12 @@ public:
 
     SkImageFilterCache* cache() const { return fCache.get(); }
 
+    // Square tile size, in layer pixels, that DrawFilterInTiles() splits a filter's desired output
+    // into, or 0 if the DAG should be evaluated over the whole layer at once.
+    virtual int filterTileSize() const { return 0; }
+    // When non-null, DrawFilterInTiles() evaluates independent tiles in parallel on this executor.
+    virtual SkExecutor* filterExecutor() const { return nullptr; }
+
 protected:
     Backend(sk_sp<SkImageFilterCache> cache,
             const SkSurfaceProps& surfaceProps,
@@ -1134,7 +1142,13 @@ private:
     SkColorType fColorType;
 };
 
-sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType);
+// When 'executor' is non-null, the backend's blur engine splits its passes into tasks on it. The
+// executor is not owned and must outlive the backend. A positive 'tileSize' enables tiled
+// evaluation of filter DAGs in DrawFilterInTiles() (in parallel on 'executor' if it's provided).
+sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps,
+                                 SkColorType colorType,
+                                 SkExecutor* executor = nullptr,
+                                 int tileSize = 0);
 
 // Stats for a single image filter evaluation
 struct Stats {
@@ -1144,6 +1158,8 @@ struct Stats {
     int fNumShaderClampedDraws = 0; // shader-emulated clamp is fairly cheap but HW tiling is best
     int fNumShaderBasedTilingDraws = 0; // shader-emulated decal, mirror, repeat are expensive
 
+    void merge(const Stats& other);
+
     void dumpStats() const;   // log to std out
     void reportStats() const; // trace event counters
 };
@@ -1251,6 +1267,11 @@ public:
             }
         }
     }
+    void mergeStats(const Stats& stats) const {
+        if (fStats) {
+            fStats->merge(stats);
+        }
+    }
 
 private:
     friend class ::FilterResultTestAccess; // For controlling Stats
@@ -1268,6 +1289,21 @@ private:
     Stats* fStats;
 };
 
+// Evaluates 'filter' over ctx.desiredOutput() as a grid of ctx.backend()->filterTileSize() tiles.
+// Each tile is filtered independently, requesting only the input (and halo) it needs through the
+// DAG's input bounds, so intermediate images are bounded by the tile size instead of the layer
+// size. Tiles are evaluated in parallel when the backend has a filter executor, but 'drawTile' is
+// always invoked on the calling thread, once per tile, with 'device' clipped to that tile and a
+// Context whose desired output is the tile.
+//
+// Returns false without drawing anything when the backend doesn't tile, when the layer-to-device
+// transform isn't an integer translation, or when the DAG can't produce identical results in tiles
+// (see SkImageFilter_Base::canEvaluateInTiles()). The caller should then filter the whole layer.
+bool DrawFilterInTiles(const Context& ctx,
+                       const SkImageFilter* filter,
+                       SkDevice* device,
+                       const std::function<void(const Context&, const FilterResult&)>& drawTile);
+
 } // end namespace skif
 
 #endif // SkImageFilterTypes_DEFINED
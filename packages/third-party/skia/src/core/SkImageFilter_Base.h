@@ -11,6 +11,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
+#include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTemplates.h"
 
@@ -121,6 +122,10 @@ public:
     // Returns true if this image filter graph references the Context's source image.
     bool usesSource() const { return fUsesSrcInput; }
 
+    // Returns true if evaluating this image filter graph separately for each tile of a partition of
+    // the desired output produces the same pixels as evaluating it over the whole output at once.
+    bool canEvaluateInTiles(const skif::Context& context) const;
+
     /**
      *  This call returns the maximum "kind" of CTM for a filter and all of its (non-null) inputs.
      */
@@ -129,6 +134,11 @@ public:
 
     uint32_t uniqueID() const { return fUniqueID; }
 
+    // Returns a hash of this filter DAG's serialized form, so that separately created filters with
+    // identical structure and parameters hash equally. Embedded images and pictures contribute
+    // their unique IDs rather than their contents. Returns 0 if the DAG can't be serialized.
+    uint64_t structureHash() const;
+
     static SkFlattenable::Type GetFlattenableType() {
         return kSkImageFilter_Type;
     }
@@ -239,6 +249,13 @@ private:
      */
     virtual bool ignoreInputsAffectsTransparentBlack() const { return false; }
 
+    /**
+     *  Return false if this node's output pixels depend on the extent of the desired output it is
+     *  asked to produce (e.g. a resampling grid anchored to that output), beyond the input bounds it
+     *  reports from onGetInputLayerBounds(). Such nodes prevent tiled evaluation of the DAG.
+     */
+    virtual bool onCanEvaluateInTiles(const skif::Context&) const { return true; }
+
     /**
      *  This is the virtual which should be overridden by the derived class to perform image
      *  filtering. Subclasses are responsible for recursing to their input filters, although the
@@ -304,6 +321,10 @@ private:
     bool fUsesSrcInput;
     uint32_t fUniqueID; // Globally unique
 
+    // Computed on first use by structureHash(); filters are immutable once created.
+    mutable SkOnce fStructureHashOnce;
+    mutable uint64_t fStructureHash = 0;
+
     using INHERITED = SkImageFilter;
 };
 
@@ -14,7 +14,9 @@
 #include "src/base/SkMathPriv.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMipmapBuilder.h"
+#include "src/core/SkTaskGroup.h"
 
+#include <algorithm>
 #include <new>
 
 //
@@ -42,8 +44,32 @@ size_t SkMipmap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return SkTo<int32_t>(size);
 }
 
+// Levels with at least this many pixels are split into bands of kRowsPerBand rows when an executor
+// is provided; smaller levels aren't worth the task overhead.
+static constexpr int64_t kMinPixelsPerBandedLevel = 256 * 256;
+static constexpr int kRowsPerBand = 32;
+
+static void build_level(const SkMipmapDownSampler& downsampler,
+                        const SkPixmap& dst,
+                        const SkPixmap& src,
+                        SkExecutor* executor) {
+    const int bandCount = (dst.height() + kRowsPerBand - 1) / kRowsPerBand;
+    if (!executor || bandCount < 2 ||
+        int64_t(dst.width()) * dst.height() < kMinPixelsPerBandedLevel) {
+        downsampler.buildLevel(dst, src);
+        return;
+    }
+
+    SkTaskGroup tasks(*executor);
+    tasks.batch(bandCount, [&](int band) {
+        const int top = band * kRowsPerBand;
+        downsampler.buildRows(dst, src, top, std::min(top + kRowsPerBand, dst.height()));
+    });
+    tasks.wait();
+}
+
 SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
-                          bool computeContents) {
+                          bool computeContents, SkExecutor* executor) {
     if (src.width() <= 1 && src.height() <= 1) {
         return nullptr;
     }
@@ -121,7 +147,8 @@ SkMipmap* SkMipmap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact,
 
         const SkPixmap& dstPM = levels[i].fPixmap;
         if (downsampler) {
-            downsampler->buildLevel(dstPM, srcPM);
+            // Each level reads the previous one, so only the rows within a level run in parallel.
+            build_level(*downsampler, dstPM, srcPM, executor);
         }
         srcPM = dstPM;
         addr += height * rowBytes;
@@ -18,6 +18,7 @@
 
 class SkBitmap;
 class SkData;
+class SkExecutor;
 class SkDiscardableMemory;
 class SkMipmapBuilder;
 
@@ -26,7 +27,13 @@ typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
 struct SkMipmapDownSampler {
     virtual ~SkMipmapDownSampler() {}
 
-    virtual void buildLevel(const SkPixmap& dst, const SkPixmap& src) = 0;
+    void buildLevel(const SkPixmap& dst, const SkPixmap& src) const {
+        this->buildRows(dst, src, 0, dst.height());
+    }
+
+    // Fills rows [top, bottom) of 'dst' from the whole 'src' level. Disjoint row ranges of the same
+    // level may be built concurrently.
+    virtual void buildRows(const SkPixmap& dst, const SkPixmap& src, int top, int bottom) const = 0;
 };
 
 /*
@@ -40,9 +47,10 @@ class SkMipmap : public SkCachedData {
 public:
     ~SkMipmap() override;
     // Allocate and fill-in a mipmap. If computeContents is false, we just allocated
-    // and compute the sizes/rowbytes, but leave the pixel-data uninitialized.
+    // and compute the sizes/rowbytes, but leave the pixel-data uninitialized. If executor is
+    // non-null, large levels are split into row bands that are built in parallel on it.
     static SkMipmap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
-                           bool computeContents = true);
+                           bool computeContents = true, SkExecutor* executor = nullptr);
 
     static SkMipmap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
 
@@ -23,6 +23,10 @@ class SkImage;
 // Try to load from the base image, or from the cache
 static sk_sp<const SkMipmap> try_load_mips(const SkImage_Base* image) {
     sk_sp<const SkMipmap> mips = image->refMips();
+    if (!mips && image->hasPendingMipmaps()) {
+        // Don't stall on building a second copy; the caller falls back to the base level.
+        return nullptr;
+    }
     if (!mips) {
         mips.reset(SkMipmapCache::FindAndRef(SkBitmapCacheDesc::Make(image)));
     }
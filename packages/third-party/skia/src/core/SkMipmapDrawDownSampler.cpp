@@ -32,7 +32,7 @@ struct DrawDownSampler : SkMipmapDownSampler {
         fPaint.setBlendMode(SkBlendMode::kSrc);
     }
 
-    void buildLevel(const SkPixmap& dst, const SkPixmap& src) override;
+    void buildRows(const SkPixmap& dst, const SkPixmap& src, int top, int bottom) const override;
 };
 
 static SkSamplingOptions choose_options(const SkPixmap& dst, const SkPixmap& src) {
@@ -45,8 +45,11 @@ static SkSamplingOptions choose_options(const SkPixmap& dst, const SkPixmap& src
     return SkSamplingOptions(cubic);
 }
 
-void DrawDownSampler::buildLevel(const SkPixmap& dst, const SkPixmap& src) {
-    const SkRasterClip rclip(dst.bounds());
+void DrawDownSampler::buildRows(const SkPixmap& dst,
+                                const SkPixmap& src,
+                                int top,
+                                int bottom) const {
+    const SkRasterClip rclip(SkIRect::MakeLTRB(0, top, dst.width(), bottom));
     const SkMatrix mx = SkMatrix::Scale(SkIntToScalar(dst.width())  / src.width(),
                                         SkIntToScalar(dst.height()) / src.height());
     const auto sampling = choose_options(dst, src);
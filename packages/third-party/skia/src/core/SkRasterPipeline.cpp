@@ -303,6 +303,15 @@ void SkRasterPipeline::appendConstantColor(SkArenaAlloc* alloc, const float rgba
     }
 }
 
+void SkRasterPipeline::appendUniformColor(const SkRasterPipelineContexts::UniformColorCtx* ctx) {
+    SkASSERT(0 <= ctx->a && ctx->a <= 1);
+    SkASSERT(0 <= ctx->r && ctx->r <= ctx->a);
+    SkASSERT(0 <= ctx->g && ctx->g <= ctx->a);
+    SkASSERT(0 <= ctx->b && ctx->b <= ctx->a);
+    this->uncheckedAppend(Op::uniform_color,
+                          const_cast<SkRasterPipelineContexts::UniformColorCtx*>(ctx));
+}
+
 void SkRasterPipeline::appendMatrix(SkArenaAlloc* alloc, const SkMatrix& matrix) {
     SkMatrix::TypeMask mt = matrix.getType();
 
@@ -119,6 +119,10 @@ public:
         this->appendConstantColor(alloc, color.vec());
     }
 
+    // Appends a uniform_color stage that reads ctx, which the caller owns and may rewrite between
+    // runs. Its color must be premultiplied and in range, as uniform_color runs in lowp.
+    void appendUniformColor(const SkRasterPipelineContexts::UniformColorCtx* ctx);
+
     // Like appendConstantColor() but only affecting r,g,b, ignoring the alpha channel.
     void appendSetRGB(SkArenaAlloc*, const float rgb[3]);
 
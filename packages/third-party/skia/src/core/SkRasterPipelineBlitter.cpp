@@ -10,6 +10,7 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -23,17 +24,22 @@
 #include "include/private/base/SkOnce.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/base/SkVx.h"
 #include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlenderBase.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkCoreBlitters.h"
 #include "src/core/SkEffectPriv.h"
+#include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMemset.h"
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineBlitterCache.h"
 #include "src/core/SkRasterPipelineOpContexts.h"
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkRasterPipelineVizualizer.h"
@@ -41,6 +47,7 @@
 #include "src/shaders/SkShaderBase.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <functional>
@@ -48,7 +55,6 @@
 #include <utility>
 #include <vector>
 
-class SkColorSpace;
 class SkShader;
 
 static bool can_direct_blit(const SkPaint& paint) {
@@ -79,7 +85,8 @@ public:
                              const SkRasterPipeline& shaderPipeline,
                              bool is_opaque,
                              bool is_constant,
-                             const SkShader* clipShader);
+                             const SkShader* clipShader,
+                             SkRasterPipelineContexts::UniformColorCtx* uniformColor = nullptr);
 
     SkRasterPipelineBlitter(SkPixmap dst,
                             const SkPaint& paint,
@@ -101,6 +108,14 @@ public:
     void blitV     (int x, int y, int height, SkAlpha alpha)        override;
     std::optional<DirectBlit> canDirectBlit()                       override;
 
+    // Points a blitter made with a uniformColor slot at a new dst and constant color, so it can
+    // be reused by a later draw with the same signature. The dst must match the original's
+    // color type, alpha type and color space.
+    void retarget(const SkPixmap& dst,
+                  const SkPMColor4f& color,
+                  bool canDirectBlit,
+                  const SkColor4f& directBlitPaintColor);
+
 private:
     void appendLoadDst      (SkRasterPipeline*) const;
     void appendStore        (SkRasterPipeline*) const;
@@ -119,7 +134,7 @@ private:
     void*                  fClipShaderBuffer = nullptr; // "native" : float or U16
 
     bool fCanDirectBlit;
-    const SkColor4f fDirectBlitPaintColor;
+    SkColor4f fDirectBlitPaintColor;
     std::optional<uint64_t> fDirectBlitValue;
 
     SkRasterPipelineContexts::MemoryCtx
@@ -131,6 +146,11 @@ private:
     void   (*fMemset2D)(SkPixmap*, int x,int y, int w,int h, uint64_t color) = nullptr;
     uint64_t fMemsetColor = 0;   // Big enough for largest memsettable dst format, F16.
 
+    // Set when the constant color lives in a caller-owned slot (see retarget()).
+    SkRasterPipelineContexts::UniformColorCtx* fUniformColor = nullptr;
+    SkRasterPipelineContexts::MemoryCtx fMemsetPtr = {&fMemsetColor, 0};
+    std::function<void(size_t, size_t, size_t, size_t)> fEncodeMemsetColor;
+
     // Built lazily on first use.
     std::function<void(size_t, size_t, size_t, size_t)> fBlitRect,
                                                         fBlitAntiH,
@@ -192,6 +212,252 @@ static bool create_pipeline_for_blitter(const SkPixmap& dst,
     return false;
 }
 
+// Draws with a constant color and a blend mode differ only in their uniforms (the dst pixels
+// and the color), so each thread keeps a small LRU of blitters keyed by everything else. A hit
+// retargets the cached blitter instead of rebuilding and recompiling its pipelines.
+namespace {
+
+constexpr int kMaxCachedBlittersPerThread = 32;
+
+std::atomic<bool>     gBlitterCacheEnabled{true};
+// Set by ScopedEnabledOverride: -1 defers to gBlitterCacheEnabled, otherwise 0 or 1.
+thread_local int      gThreadBlitterCacheOverride = -1;
+std::atomic<uint64_t> gBlitterCacheHits{0};
+std::atomic<uint64_t> gBlitterCacheMisses{0};
+std::atomic<uint64_t> gBlitterCacheEvictions{0};
+
+struct BlitterKey {
+    SkColorType         fColorType;
+    SkAlphaType         fAlphaType;
+    SkBlendMode         fBlendMode;
+    bool                fOpaque;
+    uint64_t            fColorSpaceHash;  // 0 when fColorSpace is null
+    sk_sp<SkColorSpace> fColorSpace;
+
+    bool operator==(const BlitterKey& that) const {
+        return fColorType      == that.fColorType      &&
+               fAlphaType      == that.fAlphaType      &&
+               fBlendMode      == that.fBlendMode      &&
+               fOpaque         == that.fOpaque         &&
+               fColorSpaceHash == that.fColorSpaceHash &&
+               SkColorSpace::Equals(fColorSpace.get(), that.fColorSpace.get());
+    }
+
+    struct Hash {
+        uint32_t operator()(const BlitterKey& k) const {
+            const uint32_t bits[] = {(uint32_t)k.fColorType,
+                                     (uint32_t)k.fAlphaType,
+                                     (uint32_t)k.fBlendMode,
+                                     (uint32_t)k.fOpaque,
+                                     (uint32_t)k.fColorSpaceHash,
+                                     (uint32_t)(k.fColorSpaceHash >> 32)};
+            return SkChecksum::Hash32(bits, sizeof(bits));
+        }
+    };
+};
+
+// A blitter built around a uniform color slot, plus the per-thread state needed to share it.
+struct CachedBlitter : public SkNVRefCnt<CachedBlitter> {
+    explicit CachedBlitter(const SkColorSpace* dstCS)
+        : fPaintToDst(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                      dstCS,               kUnpremul_SkAlphaType) {}
+
+    SkSTArenaAlloc<2048>                      fAlloc;
+    SkColorSpaceXformSteps                    fPaintToDst;
+    SkRasterPipelineContexts::UniformColorCtx fColor;
+    SkRasterPipelineBlitter*                  fBlitter = nullptr;
+
+    // Several blitters may share this one at once (e.g. while drawing a layer); whichever
+    // last patched in its uniforms owns it until another one draws.
+    uint32_t fOwner = 0;
+    uint32_t fNextOwner = 1;
+};
+
+struct CountEviction {
+    void operator()(void*, const BlitterKey&, const sk_sp<CachedBlitter>*) const {
+        gBlitterCacheEvictions.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+using BlitterCache =
+        SkLRUCache<BlitterKey, sk_sp<CachedBlitter>, BlitterKey::Hash, CountEviction>;
+
+BlitterCache* thread_blitter_cache() {
+    static thread_local BlitterCache cache(kMaxCachedBlittersPerThread);
+    return &cache;
+}
+
+void set_uniform_color(SkRasterPipelineContexts::UniformColorCtx* ctx, const SkPMColor4f& color) {
+    // Matches SkRasterPipeline::appendConstantColor() for in-range colors.
+    skvx::float4 c = skvx::float4::Load(color.vec());
+    c.store(&ctx->r);
+    c = c * 255.0f + 0.5f;
+    ctx->rgba[0] = (uint16_t)c[0];
+    ctx->rgba[1] = (uint16_t)c[1];
+    ctx->rgba[2] = (uint16_t)c[2];
+    ctx->rgba[3] = (uint16_t)c[3];
+}
+
+class SkRasterPipelineCachedBlitter final : public SkBlitter {
+public:
+    SkRasterPipelineCachedBlitter(sk_sp<CachedBlitter> cached,
+                                  const SkPixmap& dst,
+                                  const SkPMColor4f& color,
+                                  const SkPaint& paint)
+        : fCached(std::move(cached))
+        , fDst(dst)
+        , fColor(color)
+        , fCanDirectBlit(can_direct_blit(paint))
+        , fDirectBlitPaintColor(paint.getColor4f())
+        , fID(fCached->fNextOwner++) {}
+
+    void blitH(int x, int y, int w) override { this->bind()->blitH(x, y, w); }
+    void blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) override {
+        this->bind()->blitAntiH(x, y, aa, runs);
+    }
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override {
+        this->bind()->blitAntiH2(x, y, a0, a1);
+    }
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override {
+        this->bind()->blitAntiV2(x, y, a0, a1);
+    }
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        this->bind()->blitMask(mask, clip);
+    }
+    void blitRect(int x, int y, int w, int h) override { this->bind()->blitRect(x, y, w, h); }
+    void blitV(int x, int y, int h, SkAlpha alpha) override { this->bind()->blitV(x, y, h, alpha); }
+    std::optional<DirectBlit> canDirectBlit() override { return this->bind()->canDirectBlit(); }
+
+private:
+    SkRasterPipelineBlitter* bind() {
+        if (fCached->fOwner != fID) {
+            fCached->fBlitter->retarget(fDst, fColor, fCanDirectBlit, fDirectBlitPaintColor);
+            fCached->fOwner = fID;
+        }
+        return fCached->fBlitter;
+    }
+
+    sk_sp<CachedBlitter> fCached;
+    SkPixmap             fDst;
+    SkPMColor4f          fColor;
+    bool                 fCanDirectBlit;
+    SkColor4f            fDirectBlitPaintColor;
+    uint32_t             fID;
+};
+
+}  // namespace
+
+// Returns nullptr when the paint can't use the cache; the caller then builds a blitter as usual.
+static SkBlitter* find_or_create_cached_blitter(const SkPixmap& dst,
+                                                const SkPaint& paint,
+                                                SkArenaAlloc* alloc,
+                                                const SkShader* clipShader) {
+    const bool enabled = gThreadBlitterCacheOverride >= 0
+                                 ? gThreadBlitterCacheOverride != 0
+                                 : gBlitterCacheEnabled.load(std::memory_order_relaxed);
+    if (!enabled ||
+        clipShader || paint.getShader() || paint.getColorFilter()) {
+        return nullptr;
+    }
+    std::optional<SkBlendMode> mode = paint.asBlendMode();
+    if (!mode) {
+        return nullptr;
+    }
+
+    // Converting to the dst color space leaves alpha alone, so the paint tells us if we're opaque.
+    BlitterKey key{dst.colorType(),
+                   dst.alphaType(),
+                   *mode,
+                   paint.getAlphaf() == 1.0f,
+                   dst.colorSpace() ? dst.colorSpace()->hash() : 0,
+                   dst.refColorSpace()};
+
+    BlitterCache* cache = thread_blitter_cache();
+    sk_sp<CachedBlitter>* found = cache->find(key);
+    const SkColorSpaceXformSteps* paintToDst = found ? &(*found)->fPaintToDst : nullptr;
+    std::optional<SkColorSpaceXformSteps> missSteps;
+    if (!paintToDst) {
+        missSteps.emplace(sk_srgb_singleton(), kUnpremul_SkAlphaType,
+                          dst.colorSpace(),    kUnpremul_SkAlphaType);
+        paintToDst = &*missSteps;
+    }
+
+    SkColor4f dstPaintColor = paint.getColor4f();
+    paintToDst->apply(dstPaintColor.vec());
+    SkPMColor4f color = dstPaintColor.premul();
+    if (SkColorTypeIsNormalized(dst.colorType())) {
+        // This is the clamp that appendClampIfNormalized() applies to the uncached constant.
+        skvx::pin(skvx::float4::Load(color.vec()), skvx::float4(0.0f), skvx::float4(1.0f))
+                .store(color.vec());
+    }
+    // The slot is a uniform_color, which (unlike unbounded_uniform_color) needs in-range colors.
+    if (!(0 <= color.fR && color.fR <= color.fA &&
+          0 <= color.fG && color.fG <= color.fA &&
+          0 <= color.fB && color.fB <= color.fA)) {
+        return nullptr;
+    }
+
+    if (found) {
+        gBlitterCacheHits.fetch_add(1, std::memory_order_relaxed);
+        return alloc->make<SkRasterPipelineCachedBlitter>(*found, dst, color, paint);
+    }
+
+    auto cached = sk_make_sp<CachedBlitter>(dst.colorSpace());
+    set_uniform_color(&cached->fColor, color);
+    SkPaint templatePaint;
+    templatePaint.setBlendMode(*mode);
+    SkRasterPipeline noShader(&cached->fAlloc);
+    cached->fBlitter = static_cast<SkRasterPipelineBlitter*>(
+            SkRasterPipelineBlitter::Create(dst,
+                                            templatePaint,
+                                            dstPaintColor,
+                                            &cached->fAlloc,
+                                            noShader,
+                                            key.fOpaque,
+                                            /*is_constant=*/true,
+                                            /*clipShader=*/nullptr,
+                                            &cached->fColor));
+    if (!cached->fBlitter) {
+        return nullptr;
+    }
+    gBlitterCacheMisses.fetch_add(1, std::memory_order_relaxed);
+    sk_sp<CachedBlitter>* inserted = cache->insert(std::move(key), std::move(cached));
+    return alloc->make<SkRasterPipelineCachedBlitter>(*inserted, dst, color, paint);
+}
+
+namespace SkRasterPipelineBlitterCache {
+
+Stats GetStats() {
+    return {gBlitterCacheHits.load(std::memory_order_relaxed),
+            gBlitterCacheMisses.load(std::memory_order_relaxed),
+            gBlitterCacheEvictions.load(std::memory_order_relaxed)};
+}
+
+void ResetStats() {
+    gBlitterCacheHits.store(0, std::memory_order_relaxed);
+    gBlitterCacheMisses.store(0, std::memory_order_relaxed);
+    gBlitterCacheEvictions.store(0, std::memory_order_relaxed);
+}
+
+void SetEnabled(bool enabled) {
+    gBlitterCacheEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+ScopedEnabledOverride::ScopedEnabledOverride(bool enabled)
+        : fPrevious(gThreadBlitterCacheOverride) {
+    gThreadBlitterCacheOverride = enabled ? 1 : 0;
+}
+
+ScopedEnabledOverride::~ScopedEnabledOverride() {
+    gThreadBlitterCacheOverride = fPrevious;
+}
+
+void PurgeThreadCache() {
+    thread_blitter_cache()->reset();
+}
+
+}  // namespace SkRasterPipelineBlitterCache
+
 SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap& dst,
                                          const SkPaint& paint,
                                          const SkMatrix& ctm,
@@ -199,6 +465,10 @@ SkBlitter* SkCreateRasterPipelineBlitter(const SkPixmap& dst,
                                          sk_sp<SkShader> clipShader,
                                          const SkSurfaceProps& props,
                                          const SkRect& devBounds) {
+    if (SkBlitter* blitter = find_or_create_cached_blitter(dst, paint, alloc, clipShader.get())) {
+        return blitter;
+    }
+
     SkRasterPipeline_<256> shaderPipeline;
     SkColor4f dstPaintColor;
     bool is_opaque, is_constant;
@@ -305,8 +575,10 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
                                            const SkRasterPipeline& shaderPipeline,
                                            bool is_opaque,
                                            bool is_constant,
-                                           const SkShader* clipShader) {
+                                           const SkShader* clipShader,
+                                           SkRasterPipelineContexts::UniformColorCtx* uniformColor) {
     auto blitter = alloc->make<SkRasterPipelineBlitter>(dst, paint, alloc);
+    blitter->fUniformColor = uniformColor;
 
     // Our job in this factory is to fill out the blitter's color and blend pipelines.
     // The color pipeline is the common front of the full blit pipeline. The blend pipeline is just
@@ -408,8 +680,14 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
         }
     }
 
-    // Optimization: A pipeline that's still constant here can collapse back into a constant color.
-    if (is_constant) {
+    // A pre-resolved constant color stays in its slot, so that retarget() can swap it out.
+    if (uniformColor) {
+        SkASSERT(is_constant && shaderPipeline.empty() && !clipShader);
+        colorPipeline->appendUniformColor(uniformColor);
+        is_opaque = uniformColor->a == 1.0f;
+    } else if (is_constant) {
+        // Optimization: A pipeline that's still constant here can collapse back into a
+        // constant color.
         SkColor4f constantColor;
         SkRasterPipelineContexts::MemoryCtx constantColorPtr = {&constantColor, 0};
         // We could remove this clamp entirely, but if the destination is 8888, doing the clamp
@@ -443,11 +721,23 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
         dst.info().bytesPerPixel() <= static_cast<int>(sizeof(blitter->fMemsetColor))) {
         // Run our color pipeline all the way through to produce what we'd memset when we can.
         // Not all blits can memset, so we need to keep colorPipeline too.
-        SkRasterPipeline_<256> p;
-        p.extend(*colorPipeline);
-        blitter->fDstPtr = SkRasterPipelineContexts::MemoryCtx{&blitter->fMemsetColor, 0};
-        blitter->appendStore(&p);
-        p.run(0,0,1,1);
+        if (uniformColor) {
+            // Keep the program around to re-encode the color each time it is retargeted.
+            SkRasterPipeline p(alloc);
+            p.extend(*colorPipeline);
+            if (dst.info().alphaType() == kUnpremul_SkAlphaType) {
+                p.append(SkRasterPipelineOp::unpremul);
+            }
+            p.appendStore(dst.info().colorType(), &blitter->fMemsetPtr);
+            blitter->fEncodeMemsetColor = p.compile();
+            blitter->fEncodeMemsetColor(0,0,1,1);
+        } else {
+            SkRasterPipeline_<256> p;
+            p.extend(*colorPipeline);
+            blitter->fDstPtr = SkRasterPipelineContexts::MemoryCtx{&blitter->fMemsetColor, 0};
+            blitter->appendStore(&p);
+            p.run(0,0,1,1);
+        }
 
         switch (blitter->fDst.shiftPerPixel()) {
             case 0: blitter->fMemset2D = [](SkPixmap* dst, int x,int y, int w,int h, uint64_t c) {
@@ -764,3 +1054,22 @@ FAIL:
     fCanDirectBlit = false;
     return {};
 }
+
+void SkRasterPipelineBlitter::retarget(const SkPixmap& dst,
+                                       const SkPMColor4f& color,
+                                       bool canDirectBlit,
+                                       const SkColor4f& directBlitPaintColor) {
+    SkASSERT(fUniformColor);
+    SkASSERT(dst.colorType() == fDst.colorType() && dst.alphaType() == fDst.alphaType());
+
+    fDst = dst;
+    fDstPtr = SkRasterPipelineContexts::MemoryCtx{fDst.writable_addr(), fDst.rowBytesAsPixels()};
+    set_uniform_color(fUniformColor, color);
+    if (fEncodeMemsetColor) {
+        fEncodeMemsetColor(0,0,1,1);
+    }
+
+    fCanDirectBlit = canDirectBlit;
+    fDirectBlitPaintColor = directBlitPaintColor;
+    fDirectBlitValue.reset();
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkRasterPipelineBlitterCache_DEFINED
+#define SkRasterPipelineBlitterCache_DEFINED
+
+#include <cstdint>
+
+// SkCreateRasterPipelineBlitter() keeps a small per-thread cache of blitters for paints that
+// draw a constant color with a blend mode. Draws whose paints differ only in color reuse the
+// cached blitter's compiled pipelines, patching in their dst and color instead of rebuilding.
+namespace SkRasterPipelineBlitterCache {
+
+struct Stats {
+    uint64_t fHits;
+    uint64_t fMisses;
+    uint64_t fEvictions;
+
+    double hitRate() const {
+        uint64_t lookups = fHits + fMisses;
+        return lookups ? (double)fHits / lookups : 0.0;
+    }
+};
+
+// Counters are shared by all threads' caches.
+Stats GetStats();
+void ResetStats();
+
+// The cache is enabled by default. Disabling it affects blitters created afterwards on any thread.
+void SetEnabled(bool);
+
+// Enables or disables the cache for blitters created on the calling thread while this is alive,
+// whatever SetEnabled() says, and restores the thread's previous setting when destroyed. Tests
+// and benches use this so they don't change the cache for other threads.
+class ScopedEnabledOverride {
+public:
+    explicit ScopedEnabledOverride(bool enabled);
+    ~ScopedEnabledOverride();
+
+    ScopedEnabledOverride(const ScopedEnabledOverride&) = delete;
+    ScopedEnabledOverride& operator=(const ScopedEnabledOverride&) = delete;
+
+private:
+    int fPrevious;
+};
+
+// Drops every blitter cached by the calling thread.
+void PurgeThreadCache();
+
+}  // namespace SkRasterPipelineBlitterCache
+
+#endif  // SkRasterPipelineBlitterCache_DEFINED
@@ -16,6 +16,7 @@
 class SkBlitter;
 class SkPath;
 struct SkPathRaw;
+class SkRRect;
 class SkRasterClip;
 class SkRegion;
 
@@ -53,11 +54,19 @@ public:
     static void FillPath(const SkPathRaw&, const SkRasterClip&, SkBlitter*);
     static void FillPath(const SkPathRaw&, const SkRegion& clip, SkBlitter*);
     static void AntiFillPath(const SkPathRaw&, const SkRasterClip&, SkBlitter*);
+    // An alternative to AntiFillPath that bins edges into 4-row strips and blits their coverage
+    // as A8 masks and solid rects. See SkScan_SparseStrips.cpp.
+    static void SparseStripFillPath(const SkPathRaw&, const SkRasterClip&, SkBlitter*);
 
     static void FrameRect(const SkRect&, const SkPoint& strokeSize,
                           const SkRasterClip&, SkBlitter*);
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
                               const SkRasterClip&, SkBlitter*);
+    // Analytic coverage for device-space rrects, ovals included. AntiFrameRRect fills the region
+    // between outer and inner, which must be contained in outer. See SkScan_AntiRRect.cpp.
+    static void AntiFillRRect(const SkRRect&, const SkRasterClip&, SkBlitter*);
+    static void AntiFrameRRect(const SkRRect& outer, const SkRRect& inner,
+                               const SkRasterClip&, SkBlitter*);
     static void FillTriangle(const SkPoint pts[], const SkRasterClip&, SkBlitter*);
     static void HairLine(SkSpan<const SkPoint>, const SkRasterClip&, SkBlitter*);
     static void AntiHairLine(SkSpan<const SkPoint>, const SkRasterClip&, SkBlitter*);
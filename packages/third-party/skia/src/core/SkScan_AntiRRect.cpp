@@ -0,0 +1,394 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPoint.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkTypes.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkAAClip.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkScanPriv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/*
+    Analytic coverage for axis-aligned rounded rects (which includes circles and ellipses).
+
+    Each row is split into the few columns where the left or right boundary actually crosses the
+    row, and the spans between them, where coverage is constant. Boundary columns get the exact
+    area of the pixel inside the shape, using the closed form integral of the corner ellipses.
+    Everything else is emitted as runs, so interiors reach the blitter as solid spans.
+
+    Strokes are the region between an outer and an inner rrect; their coverage is the difference of
+    the two. The rows between the corners of a fill are a rect and go out as one blitAntiRect().
+*/
+
+namespace {
+
+// Area of [u0,u1] x [v0,v1] inside the unit circle, for 0 <= u0 <= u1 <= 1 and 0 <= v0 <= v1.
+float unit_circle_area(float u0, float u1, float v0, float v1) {
+    if (v0 >= 1) {
+        return 0;
+    }
+    // Antiderivative of sqrt(1 - u^2).
+    auto integral = [](float u) { return 0.5f * (u * std::sqrt(1 - u * u) + std::asin(u)); };
+
+    // The circle leaves the top of the box at ua and the bottom at ub.
+    const float ua = v1 < 1 ? std::sqrt(1 - v1 * v1) : 0,
+                ub = std::sqrt(1 - v0 * v0);
+    float area = 0;
+    if (const float full = std::min(u1, ua) - u0; full > 0) {
+        area += full * (v1 - v0);
+    }
+    const float lo = std::max(u0, ua),
+                hi = std::min(u1, ub);
+    if (hi > lo) {
+        area += integral(hi) - integral(lo) - v0 * (hi - lo);
+    }
+    return area;
+}
+
+// Area of the box [x0,x1] x [y0,y1], which lies within one corner of an rrect, that is outside
+// the corner's ellipse centered at c.
+float corner_cutoff_area(float x0, float x1, float y0, float y1, SkPoint c, SkVector r) {
+    auto range = [](float a, float b, float center, float radius, float* lo, float* hi) {
+        a = std::min(std::abs(a - center) / radius, 1.f);
+        b = std::min(std::abs(b - center) / radius, 1.f);
+        *lo = std::min(a, b);
+        *hi = std::max(a, b);
+    };
+    float u0, u1, v0, v1;
+    range(x0, x1, c.fX, r.fX, &u0, &u1);
+    range(y0, y1, c.fY, r.fY, &v0, &v1);
+    const float inside = r.fX * r.fY * unit_circle_area(u0, u1, v0, v1);
+    return std::max(0.f, (x1 - x0) * (y1 - y0) - inside);
+}
+
+SkAlpha to_alpha(float coverage) {
+    return SkToU8(std::clamp((int)std::lround(coverage * 255), 0, 255));
+}
+
+class RRectEdges {
+public:
+    explicit RRectEdges(const SkRRect& rrect) : fRect(rrect.rect()) {
+        for (int i = 0; i < 4; ++i) {
+            fRadii[i] = rrect.radii(static_cast<SkRRect::Corner>(i));
+        }
+    }
+
+    const SkRect& rect() const { return fRect; }
+
+    // Fraction of row y that lies between the top and bottom edges.
+    float rowCoverage(int y) const {
+        return std::clamp(std::min(y + 1.f, fRect.fBottom) - std::max((float)y, fRect.fTop), 0.f,
+                          1.f);
+    }
+
+    // First and last rows (exclusive) that are fully covered and untouched by the corners.
+    int straightTop() const {
+        return (int)std::ceil(fRect.fTop + std::max(fRadii[SkRRect::kUpperLeft_Corner].fY,
+                                                    fRadii[SkRRect::kUpperRight_Corner].fY));
+    }
+    int straightBottom() const {
+        return (int)std::floor(fRect.fBottom - std::max(fRadii[SkRRect::kLowerLeft_Corner].fY,
+                                                        fRadii[SkRRect::kLowerRight_Corner].fY));
+    }
+
+    // Columns [*x0, *x1) whose coverage varies along row y on the left and the right.
+    void leftSpan(int y, int* x0, int* x1) const {
+        float minInset, maxInset;
+        this->insetRange(y, fRadii[SkRRect::kUpperLeft_Corner],
+                         fRadii[SkRRect::kLowerLeft_Corner], &minInset, &maxInset);
+        *x0 = (int)std::floor(fRect.fLeft + minInset);
+        *x1 = (int)std::ceil(fRect.fLeft + maxInset);
+    }
+    void rightSpan(int y, int* x0, int* x1) const {
+        float minInset, maxInset;
+        this->insetRange(y, fRadii[SkRRect::kUpperRight_Corner],
+                         fRadii[SkRRect::kLowerRight_Corner], &minInset, &maxInset);
+        *x0 = (int)std::floor(fRect.fRight - maxInset);
+        *x1 = (int)std::ceil(fRect.fRight - minInset);
+    }
+
+    // Exact area of pixel (x, y) inside the rrect: its overlap with the rect, less whatever falls
+    // outside a corner's ellipse.
+    float coverage(int x, int y) const {
+        const float covX = std::min(x + 1.f, fRect.fRight) - std::max((float)x, fRect.fLeft);
+        float cov = std::clamp(covX, 0.f, 1.f) * this->rowCoverage(y);
+
+        const SkRect pixel = SkRect::MakeXYWH(x, y, 1, 1);
+        for (int i = 0; i < 4; ++i) {
+            const SkVector r = fRadii[i];
+            if (r.fX <= 0 || r.fY <= 0) {
+                continue;
+            }
+            const bool left = i == SkRRect::kUpperLeft_Corner || i == SkRRect::kLowerLeft_Corner,
+                       top = i == SkRRect::kUpperLeft_Corner || i == SkRRect::kUpperRight_Corner;
+            const SkRect corner = SkRect::MakeXYWH(left ? fRect.fLeft : fRect.fRight - r.fX,
+                                                   top ? fRect.fTop : fRect.fBottom - r.fY,
+                                                   r.fX, r.fY);
+            SkRect overlap;
+            if (overlap.intersect(pixel, corner)) {
+                const SkPoint center = {left ? corner.fRight : corner.fLeft,
+                                        top ? corner.fBottom : corner.fTop};
+                cov -= corner_cutoff_area(overlap.fLeft, overlap.fRight,
+                                          overlap.fTop, overlap.fBottom, center, r);
+            }
+        }
+        return std::max(cov, 0.f);
+    }
+
+private:
+    // How far the corner at the top or bottom pulls the boundary in from the straight edge at y.
+    float inset(float y, SkVector top, SkVector bottom) const {
+        y = std::clamp(y, fRect.fTop, fRect.fBottom);
+        float dy;
+        SkVector r;
+        if (y < fRect.fTop + top.fY) {
+            dy = fRect.fTop + top.fY - y;
+            r = top;
+        } else if (y > fRect.fBottom - bottom.fY) {
+            dy = y - (fRect.fBottom - bottom.fY);
+            r = bottom;
+        } else {
+            return 0;
+        }
+        const float t = dy / r.fY;
+        return r.fX * (1 - std::sqrt(std::max(0.f, 1 - t * t)));
+    }
+
+    // The boundary bulges out toward the straight edge, so over a row the inset is smallest
+    // where the row meets the straight section, and otherwise at one of the row's ends.
+    void insetRange(int y, SkVector top, SkVector bottom, float* minInset, float* maxInset) const {
+        const float a = this->inset(y, top, bottom),
+                    b = this->inset(y + 1, top, bottom);
+        const float straightTop = fRect.fTop + top.fY,
+                    straightBottom = fRect.fBottom - bottom.fY;
+        if (std::max((float)y, straightTop) <= std::min(y + 1.f, straightBottom)) {
+            *minInset = 0;
+        } else {
+            *minInset = std::min(a, b);
+        }
+        *maxInset = std::max(a, b);
+    }
+
+    SkRect   fRect;
+    SkVector fRadii[4];
+};
+
+// Rows up to this wide are built without a heap allocation.
+constexpr int kStackRowWidth = 256;
+
+struct Span {
+    int fStart, fEnd;
+};
+
+class RRectRasterizer {
+public:
+    RRectRasterizer(const SkRRect& outer, const SkRRect* inner)
+            : fOuter(outer)
+            , fInner(inner ? *inner : SkRRect())
+            , fHasInner(inner != nullptr) {
+        const SkIRect bounds = outer.rect().roundOut();
+        fLeft = bounds.fLeft;
+        fAlpha.reset(bounds.width() + 1);
+        fRuns.reset(bounds.width() + 1);
+    }
+
+    void fill(int top, int bottom, SkBlitter* blitter) {
+        int solidTop = bottom,
+            solidBottom = bottom;
+        if (!fHasInner) {
+            // Between the corners a fill is a rect with (possibly) partial left and right columns.
+            const SkRect& r = fOuter.rect();
+            const int left = (int)std::floor(r.fLeft),
+                      right = (int)std::ceil(r.fRight);
+            if (right - left >= 2) {
+                solidTop = std::clamp(fOuter.straightTop(), top, bottom);
+                solidBottom = std::clamp(fOuter.straightBottom(), solidTop, bottom);
+            }
+        }
+
+        for (int y = top; y < solidTop; ++y) {
+            this->blitRow(y, blitter);
+        }
+        if (solidTop < solidBottom) {
+            const SkRect& r = fOuter.rect();
+            const int left = (int)std::floor(r.fLeft),
+                      right = (int)std::ceil(r.fRight);
+            blitter->blitAntiRect(left, solidTop, right - left - 2, solidBottom - solidTop,
+                                  to_alpha(left + 1 - r.fLeft), to_alpha(r.fRight - (right - 1)));
+        }
+        for (int y = solidBottom; y < bottom; ++y) {
+            this->blitRow(y, blitter);
+        }
+    }
+
+private:
+    // Appends the rrect's varying columns on row y; they stay in left to right order.
+    static int AddSpans(const RRectEdges& edges, int y, Span spans[2]) {
+        Span l, r;
+        edges.leftSpan(y, &l.fStart, &l.fEnd);
+        edges.rightSpan(y, &r.fStart, &r.fEnd);
+        if (l.fEnd >= r.fStart) {
+            spans[0] = {l.fStart, std::max(l.fEnd, r.fEnd)};
+            return 1;
+        }
+        spans[0] = l;
+        spans[1] = r;
+        return 2;
+    }
+
+    void blitRow(int y, SkBlitter* blitter) {
+        const float outerRow = fOuter.rowCoverage(y);
+        if (outerRow <= 0) {
+            return;
+        }
+        const float innerRow = fHasInner ? fInner.rowCoverage(y) : 0;
+
+        Span spans[4];
+        int count = AddSpans(fOuter, y, spans);
+        const int start = spans[0].fStart,
+                  end = spans[count - 1].fEnd;
+        // Columns strictly inside both of the outer rrect's boundary spans.
+        const int outerSolidL = spans[0].fEnd,
+                  outerSolidR = spans[count - 1].fStart;
+        int innerSolidL = 0,
+            innerSolidR = 0;
+        if (innerRow > 0) {
+            Span inner[2];
+            const int innerCount = AddSpans(fInner, y, inner);
+            innerSolidL = inner[0].fEnd;
+            innerSolidR = inner[innerCount - 1].fStart;
+            // Slot the inner spans between the outer ones, merging any that overlap.
+            Span merged[4];
+            int mergedCount = 0;
+            Span* all[4];
+            int allCount = 0;
+            all[allCount++] = &spans[0];
+            for (int i = 0; i < innerCount; ++i) {
+                all[allCount++] = &inner[i];
+            }
+            if (count == 2) {
+                all[allCount++] = &spans[1];
+            }
+            for (int i = 0; i < allCount; ++i) {
+                const Span s = {std::max(all[i]->fStart, start), std::min(all[i]->fEnd, end)};
+                if (s.fStart >= s.fEnd) {
+                    continue;
+                }
+                if (mergedCount > 0 && s.fStart <= merged[mergedCount - 1].fEnd) {
+                    merged[mergedCount - 1].fEnd = std::max(merged[mergedCount - 1].fEnd, s.fEnd);
+                } else {
+                    merged[mergedCount++] = s;
+                }
+            }
+            std::copy(merged, merged + mergedCount, spans);
+            count = mergedCount;
+        }
+
+        SkAlpha* alpha = fAlpha.get() - fLeft;
+        int16_t* runs = fRuns.get() - fLeft;
+        int x = start;
+        auto emitRun = [&](int runEnd, SkAlpha a) {
+            while (x < runEnd) {
+                const int n = std::min(runEnd - x, (int)SK_MaxS16);
+                alpha[x] = a;
+                runs[x] = SkToS16(n);
+                x += n;
+            }
+        };
+        // The last pass only emits the run after the final span.
+        for (int i = 0; i <= count; ++i) {
+            const Span span = i < count ? spans[i] : Span{end, end};
+            if (x < span.fStart) {
+                // Between boundary columns coverage only depends on the row.
+                float cov = (x >= outerSolidL && x < outerSolidR) ? outerRow : 0;
+                if (innerRow > 0 && x >= innerSolidL && x < innerSolidR) {
+                    cov -= innerRow;
+                }
+                emitRun(span.fStart, to_alpha(cov));
+            }
+            for (; x < span.fEnd; ++x) {
+                float cov = fOuter.coverage(x, y);
+                if (innerRow > 0) {
+                    cov -= fInner.coverage(x, y);
+                }
+                alpha[x] = to_alpha(cov);
+                runs[x] = 1;
+            }
+        }
+        SkASSERT(x == end);
+        if (end > start) {
+            runs[end] = 0;
+            blitter->blitAntiH(start, y, alpha + start, runs + start);
+        }
+    }
+
+    RRectEdges fOuter;
+    RRectEdges fInner;
+    bool fHasInner;
+    int fLeft;
+    skia_private::AutoSTMalloc<kStackRowWidth, SkAlpha> fAlpha;
+    skia_private::AutoSTMalloc<kStackRowWidth, int16_t> fRuns;
+};
+
+void anti_fill_rrect(const SkRRect& outer, const SkRRect* inner, const SkRegion& clip,
+                     SkBlitter* blitter) {
+    const SkIRect bounds = outer.rect().roundOut();
+    SkIRect rows;
+    if (!rows.intersect(bounds, clip.getBounds())) {
+        return;
+    }
+    SkScanClipper clipper(blitter, &clip, bounds);
+    if (!clipper.getBlitter()) {
+        return;
+    }
+    RRectRasterizer(outer, inner).fill(rows.fTop, rows.fBottom, clipper.getBlitter());
+}
+
+void anti_fill_rrect(const SkRRect& outer, const SkRRect* inner, const SkRasterClip& clip,
+                     SkBlitter* blitter) {
+    if (clip.isEmpty() || outer.isEmpty()) {
+        return;
+    }
+    SkASSERT(outer.rect().isFinite() && !SkScan::PathRequiresTiling(outer.rect().roundOut()));
+    if (inner && inner->isEmpty()) {
+        inner = nullptr;
+    }
+
+    if (clip.isBW()) {
+        anti_fill_rrect(outer, inner, clip.bwRgn(), blitter);
+    } else {
+        SkRegion        tmp;
+        SkAAClipBlitter aaBlitter;
+
+        tmp.setRect(clip.getBounds());
+        aaBlitter.init(blitter, &clip.aaRgn());
+        anti_fill_rrect(outer, inner, tmp, &aaBlitter);
+    }
+}
+
+}  // namespace
+
+void SkScan::AntiFillRRect(const SkRRect& rrect, const SkRasterClip& clip, SkBlitter* blitter) {
+    anti_fill_rrect(rrect, nullptr, clip, blitter);
+}
+
+void SkScan::AntiFrameRRect(const SkRRect& outer, const SkRRect& inner,
+                            const SkRasterClip& clip, SkBlitter* blitter) {
+    SkASSERT(outer.rect().contains(inner.rect()));
+    anti_fill_rrect(outer, &inner, clip, blitter);
+}
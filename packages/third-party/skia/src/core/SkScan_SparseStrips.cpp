@@ -0,0 +1,492 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPathTypes.h"
+#include "include/core/SkPoint.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/private/base/SkAssert.h"
+#include "include/private/base/SkTDArray.h"
+#include "include/private/base/SkTemplates.h"
+#include "src/base/SkTSort.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkAAClip.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkLineClipper.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkPathRaw.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkScanPriv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/*
+    Sparse strip rasterization.
+
+    Instead of walking edges one scanline at a time (SkScan_AAAPath), the path is flattened to
+    lines and each line is binned into the kStripHeight-row strips it crosses. Within a strip every
+    line deposits its exact signed area and cover into an accumulation buffer laid out as one
+    float4 per column (one lane per row), so the prefix sum that turns those deposits into coverage
+    runs all rows of the strip at once.
+
+    Only the columns some line touched need that treatment. Between them coverage is constant
+    along each row, so the strip is emitted as alternating A8 masks (the sparse part) and solid
+    blitRect() spans or skipped gaps, kStripHeight rows at a time.
+*/
+
+namespace {
+
+constexpr int kStripHeight = 4;
+using Strip = skvx::Vec<kStripHeight, float>;
+
+// Max distance between a curve and its flattened lines, in pixels.
+constexpr float kFlattenTolerance = 0.1f;
+constexpr int kMaxCurveLines = 256;
+
+// Columns closer than this to a pending mask are folded into it rather than blitted separately.
+constexpr int kMinSpanWidth = 8;
+
+struct Line {
+    float fX0, fY0, fX1, fY1;  // fY0 < fY1
+    float fDir;                // +1 if the original line went down, -1 if up
+};
+
+class SparseStripRasterizer {
+public:
+    SparseStripRasterizer(const SkIRect& bounds, SkPathFillType fillType)
+            : fBounds(bounds)
+            , fClip(SkRect::Make(bounds))
+            , fEvenOdd(SkPathFillType_IsEvenOdd(fillType))
+            , fWidth(bounds.width())
+            // Lines touch up to two columns past their right end.
+            , fAccumulation(size_t(fWidth + 2) * kStripHeight)
+            , fMask(size_t(fWidth) * kStripHeight) {
+        sk_bzero(fAccumulation.get(), size_t(fWidth + 2) * kStripHeight * sizeof(float));
+    }
+
+    void addPath(const SkPathRaw& raw);
+    void fill(SkBlitter*);
+
+private:
+    void addLine(SkPoint p0, SkPoint p1);
+    void addQuad(const SkPoint pts[3]);
+    void addCubic(const SkPoint pts[4]);
+    bool addChordIfOutside(SkSpan<const SkPoint> pts);
+
+    // Deposits the part of `line` within the strip starting at `top`, returning the (strip
+    // relative) columns it touched.
+    void accumulate(const Line& line, int top, int rows, int* minCol, int* maxCol);
+
+    void emitStrip(int top, int rows, SkBlitter*);
+    void extendMask(int col, Strip winding, int rows);
+    void flushMask(int top, int rows, SkBlitter*);
+
+    Strip coverage(Strip winding) const {
+        Strip a = abs(winding);
+        if (fEvenOdd) {
+            a = a - 2.0f * floor(a * 0.5f);
+            a = min(a, 2.0f - a);
+        }
+        return min(a, 1.0f);
+    }
+
+    const SkIRect fBounds;
+    const SkRect  fClip;
+    const bool    fEvenOdd;
+    const int     fWidth;
+
+    SkTDArray<Line> fLines;
+
+    // Column-major: fAccumulation[col * kStripHeight + row].
+    skia_private::AutoTMalloc<float>   fAccumulation;
+    // Row-major with fWidth bytes per row, so any run of columns is a valid A8 mask.
+    skia_private::AutoTMalloc<uint8_t> fMask;
+
+    struct Span { int fStart, fEnd; };  // inclusive
+    SkTDArray<Span> fSpans;
+
+    int fMaskStart = -1;  // first column of the pending mask, or -1
+    int fMaskEnd = 0;
+};
+
+void SparseStripRasterizer::addLine(SkPoint p0, SkPoint p1) {
+    SkPoint pts[2] = {p0, p1};
+    SkPoint clipped[SkLineClipper::kMaxPoints];
+    // Anything right of the clip only affects columns we never emit.
+    int count = SkLineClipper::ClipLine(pts, fClip, clipped, /*canCullToTheRight=*/true);
+    for (int i = 0; i < count; i++) {
+        SkPoint a = clipped[i], b = clipped[i + 1];
+        if (a.fY == b.fY) {
+            continue;
+        }
+        float dir = 1;
+        if (a.fY > b.fY) {
+            std::swap(a, b);
+            dir = -1;
+        }
+        *fLines.append() = {a.fX - fBounds.fLeft, a.fY, b.fX - fBounds.fLeft, b.fY, dir};
+    }
+}
+
+// A curve entirely above, below, left or right of the clip contributes exactly what its chord
+// does: nothing, or a vertical line along the left edge covering the same span of y.
+bool SparseStripRasterizer::addChordIfOutside(SkSpan<const SkPoint> pts) {
+    SkRect bounds = SkRect::BoundsOrEmpty(pts);
+    if (bounds.fBottom <= fClip.fTop || bounds.fTop >= fClip.fBottom ||
+        bounds.fRight <= fClip.fLeft || bounds.fLeft >= fClip.fRight) {
+        this->addLine(pts.front(), pts.back());
+        return true;
+    }
+    return false;
+}
+
+static int curve_lines(float secondDifference, float scale) {
+    float n = std::ceil(std::sqrt(scale * secondDifference / kFlattenTolerance));
+    return std::clamp(n, 1.0f, (float)kMaxCurveLines);  // also catches NaN
+}
+
+void SparseStripRasterizer::addQuad(const SkPoint pts[3]) {
+    if (this->addChordIfOutside({pts, 3})) {
+        return;
+    }
+    // Wang's formula: a quad is within tolerance of n lines when n^2 >= |p0 - 2p1 + p2| / 4tol.
+    int n = curve_lines((pts[0] - pts[1] * 2 + pts[2]).length(), 0.25f);
+
+    skvx::float2 p0 = skvx::float2::Load(&pts[0]),
+                 p1 = skvx::float2::Load(&pts[1]),
+                 p2 = skvx::float2::Load(&pts[2]);
+    skvx::float2 b = 2.0f * (p1 - p0),
+                 a = p2 - 2.0f * p1 + p0;
+    SkPoint prev = pts[0];
+    for (int i = 1; i < n; i++) {
+        float t = (float)i / n;
+        SkPoint next;
+        ((a * t + b) * t + p0).store(&next);
+        this->addLine(prev, next);
+        prev = next;
+    }
+    this->addLine(prev, pts[2]);
+}
+
+void SparseStripRasterizer::addCubic(const SkPoint pts[4]) {
+    if (this->addChordIfOutside({pts, 4})) {
+        return;
+    }
+    // Wang's formula for cubics: n^2 >= 3/4 max|second differences| / tol.
+    float dd = std::max((pts[0] - pts[1] * 2 + pts[2]).length(),
+                        (pts[1] - pts[2] * 2 + pts[3]).length());
+    int n = curve_lines(dd, 0.75f);
+
+    skvx::float2 p0 = skvx::float2::Load(&pts[0]),
+                 p1 = skvx::float2::Load(&pts[1]),
+                 p2 = skvx::float2::Load(&pts[2]),
+                 p3 = skvx::float2::Load(&pts[3]);
+    skvx::float2 c = 3.0f * (p1 - p0),
+                 b = 3.0f * (p2 - 2.0f * p1 + p0),
+                 a = p3 + 3.0f * (p1 - p2) - p0;
+    SkPoint prev = pts[0];
+    for (int i = 1; i < n; i++) {
+        float t = (float)i / n;
+        SkPoint next;
+        (((a * t + b) * t + c) * t + p0).store(&next);
+        this->addLine(prev, next);
+        prev = next;
+    }
+    this->addLine(prev, pts[3]);
+}
+
+void SparseStripRasterizer::addPath(const SkPathRaw& raw) {
+    // Fills implicitly close every contour.
+    SkPoint start = {0, 0}, last = {0, 0};
+    SkPathIter iter = raw.iter();
+    while (auto rec = iter.next()) {
+        SkSpan<const SkPoint> pts = rec->fPoints;
+        switch (rec->fVerb) {
+            case SkPathVerb::kMove:
+                this->addLine(last, start);
+                start = last = pts[0];
+                break;
+            case SkPathVerb::kLine:
+                this->addLine(pts[0], pts[1]);
+                last = pts[1];
+                break;
+            case SkPathVerb::kQuad:
+                this->addQuad(pts.data());
+                last = pts[2];
+                break;
+            case SkPathVerb::kConic: {
+                if (this->addChordIfOutside(pts)) {
+                    last = pts[2];
+                    break;
+                }
+                SkAutoConicToQuads quadder;
+                const SkPoint* quads = quadder.computeQuads(pts, rec->conicWeight(), 0.25f);
+                for (int i = 0; i < quadder.countQuads(); i++) {
+                    this->addQuad(quads + 2 * i);
+                }
+                last = pts[2];
+                break;
+            }
+            case SkPathVerb::kCubic:
+                this->addCubic(pts.data());
+                last = pts[3];
+                break;
+            case SkPathVerb::kClose:
+                this->addLine(last, start);
+                last = start;
+                break;
+        }
+    }
+    this->addLine(last, start);
+}
+
+// Exact area coverage of a line over the cells of each row, accumulated as the per-cell
+// difference so that a running sum along the row yields the winding-weighted coverage.
+void SparseStripRasterizer::accumulate(const Line& line, int top, int rows,
+                                       int* minCol, int* maxCol) {
+    float y0 = line.fY0 - top,
+          y1 = line.fY1 - top;
+    float dxdy = (line.fX1 - line.fX0) / (line.fY1 - line.fY0);
+    float x = line.fX0;
+    if (y0 < 0) {
+        x -= y0 * dxdy;
+        y0 = 0;
+    }
+    y1 = std::min(y1, (float)rows);
+
+    int lo = fWidth, hi = 0;
+    float* acc = fAccumulation.get();
+    for (int row = (int)y0; row < y1; row++) {
+        float dy = std::min((float)row + 1, y1) - std::max((float)row, y0);
+        float xNext = x + dxdy * dy;
+        float d = dy * line.fDir;
+
+        float x0 = std::min(x, xNext),
+              x1 = std::max(x, xNext);
+        // Clipping keeps x within [0, fWidth], but float error may nudge it out.
+        x0 = std::clamp(x0, 0.0f, (float)fWidth);
+        x1 = std::clamp(x1, 0.0f, (float)fWidth);
+        float x0Floor = std::floor(x0);
+        int x0i = (int)x0Floor;
+        float x1Ceil = std::ceil(x1);
+        int x1i = (int)x1Ceil;
+
+        auto cell = [&](int col) -> float& { return acc[col * kStripHeight + row]; };
+        if (x1i <= x0i + 1) {
+            // The line stays within one column; split its cover at its mean x.
+            float xMid = 0.5f * (x0 + x1) - x0Floor;
+            cell(x0i)     += d - d * xMid;
+            cell(x0i + 1) += d * xMid;
+            x1i = x0i + 1;
+        } else {
+            float s = 1 / (x1 - x0);
+            float x0f = x0 - x0Floor;
+            float a0 = 0.5f * s * (1 - x0f) * (1 - x0f);
+            float x1f = x1 - x1Ceil + 1;
+            float am = 0.5f * s * x1f * x1f;
+            cell(x0i) += d * a0;
+            if (x1i == x0i + 2) {
+                cell(x0i + 1) += d * (1 - a0 - am);
+            } else {
+                float a1 = s * (1.5f - x0f);
+                cell(x0i + 1) += d * (a1 - a0);
+                for (int col = x0i + 2; col < x1i - 1; col++) {
+                    cell(col) += d * s;
+                }
+                float a2 = a1 + (x1i - x0i - 3) * s;
+                cell(x1i - 1) += d * (1 - a2 - am);
+            }
+            cell(x1i) += d * am;
+        }
+        lo = std::min(lo, x0i);
+        hi = std::max(hi, x1i);
+        x = xNext;
+    }
+    *minCol = lo;
+    *maxCol = hi;
+}
+
+void SparseStripRasterizer::extendMask(int col, Strip winding, int rows) {
+    if (fMaskStart < 0) {
+        fMaskStart = col;
+    }
+    fMaskEnd = col + 1;
+
+    auto bytes = skvx::cast<uint8_t>(this->coverage(winding) * 255.0f + 0.5f);
+    uint8_t* dst = fMask.get() + col;
+    for (int row = 0; row < rows; row++) {
+        dst[row * fWidth] = bytes[row];
+    }
+}
+
+void SparseStripRasterizer::flushMask(int top, int rows, SkBlitter* blitter) {
+    if (fMaskStart < 0) {
+        return;
+    }
+    SkIRect bounds = SkIRect::MakeLTRB(fBounds.fLeft + fMaskStart, top,
+                                       fBounds.fLeft + fMaskEnd, top + rows);
+    SkMask mask(fMask.get() + fMaskStart, bounds, fWidth, SkMask::kA8_Format);
+    blitter->blitMask(mask, bounds);
+    fMaskStart = -1;
+}
+
+void SparseStripRasterizer::emitStrip(int top, int rows, SkBlitter* blitter) {
+    // Merge the touched column ranges so each column is summed once, left to right.
+    SkTQSort(fSpans.begin(), fSpans.end(),
+             [](const Span& a, const Span& b) { return a.fStart < b.fStart; });
+
+    float* acc = fAccumulation.get();
+    Strip winding = 0.0f;
+    int col = 0;
+
+    // Between touched columns each row's coverage is constant: skip it, fill it, or fold it
+    // into the pending mask when the rows disagree (a path vertex lies within the strip).
+    auto gap = [&](int end) {
+        if (col >= end) {
+            return;
+        }
+        auto bytes = skvx::cast<uint8_t>(this->coverage(winding) * 255.0f + 0.5f);
+        bool empty = true, solid = true;
+        for (int row = 0; row < rows; row++) {
+            empty = empty && bytes[row] == 0;
+            solid = solid && bytes[row] == 0xFF;
+        }
+        if ((empty || solid) && end - col >= kMinSpanWidth) {
+            this->flushMask(top, rows, blitter);
+            if (solid) {
+                blitter->blitRect(fBounds.fLeft + col, top, end - col, rows);
+            }
+        } else if (!empty || fMaskStart >= 0) {
+            for (int c = col; c < end; c++) {
+                this->extendMask(c, winding, rows);
+            }
+        }
+        col = end;
+    };
+
+    for (int i = 0; i < fSpans.size();) {
+        int start = fSpans[i].fStart,
+            end = fSpans[i].fEnd;
+        for (i++; i < fSpans.size() && fSpans[i].fStart <= end + 1; i++) {
+            end = std::max(end, fSpans[i].fEnd);
+        }
+
+        gap(start);
+        for (int c = start; c <= end; c++) {
+            float* cell = acc + c * kStripHeight;
+            winding += Strip::Load(cell);
+            Strip(0.0f).store(cell);
+            if (c < fWidth) {
+                this->extendMask(c, winding, rows);
+            }
+        }
+        col = std::max(col, end + 1);
+    }
+    gap(fWidth);
+    this->flushMask(top, rows, blitter);
+    fSpans.clear();
+}
+
+void SparseStripRasterizer::fill(SkBlitter* blitter) {
+    if (fLines.empty()) {
+        return;
+    }
+    SkTQSort(fLines.begin(), fLines.end(),
+             [](const Line& a, const Line& b) { return a.fY0 < b.fY0; });
+
+    SkTDArray<Line*> active;
+    int next = 0;
+    int top = fBounds.fTop + (std::max((int)fLines[0].fY0, fBounds.fTop) - fBounds.fTop) /
+                             kStripHeight * kStripHeight;
+    while (top < fBounds.fBottom) {
+        int rows = std::min(kStripHeight, fBounds.fBottom - top);
+        int bottom = top + rows;
+
+        // Retire lines above this strip, then admit those starting in it.
+        int kept = 0;
+        for (Line* line : active) {
+            if (line->fY1 > top) {
+                active[kept++] = line;
+            }
+        }
+        active.resize(kept);
+        while (next < fLines.size() && fLines[next].fY0 < bottom) {
+            if (fLines[next].fY1 > top) {
+                *active.append() = &fLines[next];
+            }
+            next++;
+        }
+
+        if (active.empty()) {
+            if (next == fLines.size()) {
+                break;
+            }
+            // Jump to the strip holding the next line.
+            int skipTo = (int)fLines[next].fY0;
+            top = std::max(bottom, fBounds.fTop + (skipTo - fBounds.fTop) / kStripHeight *
+                                                  kStripHeight);
+            continue;
+        }
+
+        for (const Line* line : active) {
+            Span span;
+            this->accumulate(*line, top, rows, &span.fStart, &span.fEnd);
+            if (span.fStart <= span.fEnd) {
+                *fSpans.append() = span;
+            }
+        }
+        this->emitStrip(top, rows, blitter);
+        top = bottom;
+    }
+}
+
+void sparse_strip_fill_path(const SkPathRaw& raw, const SkRegion& clip, SkBlitter* blitter) {
+    SkIRect bounds;
+    if (!bounds.intersect(raw.bounds().roundOut(), clip.getBounds())) {
+        return;
+    }
+    SkScanClipper clipper(blitter, &clip, bounds);
+    if (!clipper.getBlitter()) {
+        return;
+    }
+
+    SparseStripRasterizer rasterizer(bounds, raw.fillType());
+    rasterizer.addPath(raw);
+    rasterizer.fill(clipper.getBlitter());
+}
+
+}  // namespace
+
+void SkScan::SparseStripFillPath(const SkPathRaw& raw,
+                                 const SkRasterClip& clip,
+                                 SkBlitter* blitter) {
+    SkASSERT(raw.bounds().isFinite());
+    if (clip.isEmpty()) {
+        return;
+    }
+    // Inverse fills cover everything outside the path too; leave those to the edge walker.
+    if (raw.isInverseFillType() || PathRequiresTiling(raw.bounds().roundOut())) {
+        AntiFillPath(raw, clip, blitter);
+        return;
+    }
+
+    if (clip.isBW()) {
+        sparse_strip_fill_path(raw, clip.bwRgn(), blitter);
+    } else {
+        SkRegion        tmp;
+        SkAAClipBlitter aaBlitter;
+
+        tmp.setRect(clip.getBounds());
+        aaBlitter.init(blitter, &clip.aaRgn());
+        sparse_strip_fill_path(raw, tmp, &aaBlitter);
+    }
+}
@@ -114,6 +114,19 @@ SkStrike::FlattenGlyphsByType(SkWriteBuffer& buffer,
     }
 }
 
+void SkStrike::flattenGlyphImages(SkWriteBuffer& buffer) const {
+    std::vector<SkGlyph> images;
+    {
+        SkAutoMutexExclusive lock{fStrikeLock};
+        for (const SkGlyph* glyph : fGlyphForIndex) {
+            if (glyph->setImageHasBeenCalled()) {
+                images.push_back(*glyph);
+            }
+        }
+    }
+    FlattenGlyphsByType(buffer, images, {}, {});
+}
+
 bool SkStrike::mergeFromBuffer(SkReadBuffer& buffer) {
     // Read glyphs with images for the current strike.
     const int imagesCount = buffer.readInt();
@@ -328,6 +341,11 @@ SkGlyph* SkStrike::glyph(SkPackedGlyphID packedGlyphID) {
 SkGlyphDigest SkStrike::digestFor(ActionType actionType, SkPackedGlyphID packedGlyphID) {
     SkGlyphDigest* digestPtr = fDigestForPackedGlyphID.find(packedGlyphID);
     if (digestPtr != nullptr && digestPtr->actionFor(actionType) != GlyphAction::kUnset) {
+        if (actionType == kDirectMaskCPU) {
+            // Republish in case a colliding glyph took its slot.
+            this->publishDirectMaskCPU(fGlyphForIndex[digestPtr->index()],
+                                       digestPtr->actionFor(kDirectMaskCPU));
+        }
         return *digestPtr;
     }
 
@@ -342,9 +360,40 @@ SkGlyphDigest SkStrike::digestFor(ActionType actionType, SkPackedGlyphID packedG
 
     digestPtr->setActionFor(actionType, glyph, this);
 
+    if (actionType == kDirectMaskCPU) {
+        this->publishDirectMaskCPU(glyph, digestPtr->actionFor(kDirectMaskCPU));
+    }
+
     return *digestPtr;
 }
 
+void SkStrike::publishDirectMaskCPU(const SkGlyph* glyph, GlyphAction action) {
+    static_assert(alignof(SkGlyph) > kDirectMaskCPUDrop);
+    if (action != GlyphAction::kAccept && action != GlyphAction::kDrop) {
+        return;
+    }
+    const uintptr_t entry = reinterpret_cast<uintptr_t>(glyph) |
+                            (action == GlyphAction::kDrop ? kDirectMaskCPUDrop : 0);
+    const uint32_t hash = glyph->getPackedID().hash();
+    const uint32_t slots[] = {hash & kDirectMaskCPUSlotMask,
+                              (hash >> 16) & kDirectMaskCPUSlotMask};
+
+    // Take the first slot that is free or already holds this glyph, else evict the first.
+    uint32_t target = slots[0];
+    for (uint32_t slot : slots) {
+        const uintptr_t current = fDirectMaskCPUGlyphs[slot].load(std::memory_order_relaxed);
+        if (current == entry) {
+            return;
+        }
+        const auto* held = reinterpret_cast<const SkGlyph*>(current & ~kDirectMaskCPUDrop);
+        if (held == nullptr || held->getPackedID() == glyph->getPackedID()) {
+            target = slot;
+            break;
+        }
+    }
+    fDirectMaskCPUGlyphs[target].store(entry, std::memory_order_release);
+}
+
 SkGlyphDigest* SkStrike::addGlyphAndDigest(SkGlyph* glyph) {
     size_t index = fGlyphForIndex.size();
     SkGlyphDigest digest = SkGlyphDigest{index, *glyph};
@@ -442,12 +491,6 @@ SkSpan<const SkGlyph*> SkStrike::internalPrepare(
 
 void SkStrike::updateMemoryUsage(size_t increase) {
     if (increase > 0) {
-        // fRemoved and the cache's total memory are managed under the cache's lock. This allows
-        // them to be accessed under LRU operation.
-        SkAutoMutexExclusive lock{fStrikeCache->fLock};
-        fMemoryUsed += increase;
-        if (!fRemoved) {
-            fStrikeCache->fTotalMemoryUsed += increase;
-        }
+        fStrikeCache->updateMemoryUsage(this, increase);
     }
 }
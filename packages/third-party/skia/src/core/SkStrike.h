@@ -21,6 +21,7 @@
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <vector>
@@ -57,6 +58,10 @@ public:
     bool prepareForDrawable(SkGlyph*) override SK_REQUIRES(fStrikeLock);
 
     bool mergeFromBuffer(SkReadBuffer& buffer) SK_EXCLUDES(fStrikeLock);
+
+    // Write the metrics and images of all the glyphs whose images have been generated, in the
+    // format read by mergeFromBuffer().
+    void flattenGlyphImages(SkWriteBuffer& buffer) const SK_EXCLUDES(fStrikeLock);
     static void FlattenGlyphsByType(SkWriteBuffer& buffer,
                                     SkSpan<SkGlyph> images,
                                     SkSpan<SkGlyph> paths,
@@ -133,6 +138,24 @@ public:
 
     SkGlyph* glyph(SkGlyphDigest) SK_REQUIRES(fStrikeLock);
 
+    // Looks up packedID among the glyphs already resolved for kDirectMaskCPU, without taking the
+    // strike's lock. Returns false if it is not in the table; then fall back to digestFor() under
+    // the lock. Otherwise, *glyph is the accepted glyph with its image, or nullptr if the glyph
+    // was dropped because it is empty.
+    bool directMaskCPUGlyph(SkPackedGlyphID packedID, const SkGlyph** glyph) const {
+        const uint32_t hash = packedID.hash();
+        for (uint32_t slot : {hash & kDirectMaskCPUSlotMask,
+                              (hash >> 16) & kDirectMaskCPUSlotMask}) {
+            const uintptr_t entry = fDirectMaskCPUGlyphs[slot].load(std::memory_order_acquire);
+            const SkGlyph* found = reinterpret_cast<const SkGlyph*>(entry & ~kDirectMaskCPUDrop);
+            if (found != nullptr && found->getPackedID() == packedID) {
+                *glyph = (entry & kDirectMaskCPUDrop) ? nullptr : found;
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
     friend class SkStrikeCache;
     friend class SkStrikeTestingPeer;
@@ -197,7 +220,21 @@ private:
 
     SkArenaAlloc            fAlloc SK_GUARDED_BY(fStrikeLock) {kMinAllocAmount};
 
-    // The following are protected by the SkStrikeCache's mutex.
+    // Records the kDirectMaskCPU action of glyph in fDirectMaskCPUGlyphs if it can be replayed
+    // without the lock, that is, if the glyph was accepted or dropped.
+    void publishDirectMaskCPU(const SkGlyph* glyph, skglyph::GlyphAction action)
+            SK_REQUIRES(fStrikeLock);
+
+    // A two-way table of glyphs resolved for kDirectMaskCPU. Each entry is a glyph pointer, with
+    // kDirectMaskCPUDrop set for glyphs that are dropped. Each glyph can go in one of two slots,
+    // so subpixel variants of a glyph rarely evict each other. It is written under fStrikeLock
+    // and read without it by directMaskCPUGlyph(). Glyphs live in fAlloc, so published pointers
+    // stay valid as long as the strike does.
+    inline static constexpr uint32_t kDirectMaskCPUSlotMask = 255;
+    inline static constexpr uintptr_t kDirectMaskCPUDrop = 1;
+    std::atomic<uintptr_t> fDirectMaskCPUGlyphs[kDirectMaskCPUSlotMask + 1] = {};
+
+    // The following are protected by the mutex of the SkStrikeCache shard holding this strike.
     SkStrike*                       fNext{nullptr};
     SkStrike*                       fPrev{nullptr};
     std::unique_ptr<SkStrikePinner> fPinner;
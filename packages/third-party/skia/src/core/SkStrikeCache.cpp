@@ -7,26 +7,144 @@
 
 #include "src/core/SkStrikeCache.h"
 
+#include "include/core/SkData.h"
+#include "include/core/SkFontArguments.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkMilestone.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkStream.h"
 #include "include/core/SkTraceMemoryDump.h"
+#include "include/core/SkTypeface.h"
 #include "include/private/base/SkAssert.h"
 #include "include/private/base/SkDebug.h"
 #include "include/private/base/SkMutex.h"
+#include "include/private/base/SkTo.h"
+#include "src/core/SkChecksum.h"
 #include "src/core/SkDescriptor.h"
+#include "src/core/SkFontMetricsPriv.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkScalerContext.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkWriteBuffer.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <thread>
 #include <utility>
+#include <vector>
 
 class SkScalerContext;
 struct SkFontMetrics;
 
+using namespace skia_private;
 using namespace sktext;
 
 bool gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental = false;
 
+namespace {
+uint32_t next_strike_cache_id() {
+    static std::atomic<uint32_t> nextID{1};
+    return nextID.fetch_add(1, std::memory_order_relaxed);
+}
+
+// A few strikes the current thread used recently, tagged with the unique ID of the cache they
+// came from and the removal epoch of their shard when they were found. Entries do not own their
+// strikes; an entry is only dereferenced while its cache is the one being searched and its shard
+// has removed no strike since, so it never keeps a purged strike, or a destroyed cache, alive.
+struct ThreadStrikeCache {
+    static constexpr int kEntryCount = 8;
+
+    // Every kRefreshInterval-th hit goes through the cache anyway, which keeps the strike's LRU
+    // position fresh and gives the budgets a chance to be enforced.
+    static constexpr uint32_t kRefreshInterval = 64;
+
+    struct Entry {
+        uint32_t fCacheID{0};
+        int fShardIndex{0};
+        uint32_t fRemovalEpoch{0};
+        SkStrike* fStrike{nullptr};
+    };
+
+    Entry fEntries[kEntryCount];
+    int fNextEntry{0};
+    uint32_t fHitCount{0};
+};
+
+ThreadStrikeCache& thread_strike_cache() {
+    static thread_local ThreadStrikeCache cache;
+    return cache;
+}
+
+// Bump kSnapshotVersion whenever the layout of a snapshot, or of the structures it flattens,
+// changes. Snapshots also record SK_MILESTONE, since glyph rasterization can change between
+// releases; the version of the platform font backend is not recorded.
+constexpr uint32_t kSnapshotMagic = SkSetFourByteTag('s', 'k', 's', 'c');
+constexpr uint32_t kSnapshotVersion = 2;
+
+// Identifies a typeface by its font data and variation position, which, unlike its unique ID,
+// are the same from one process to the next. Returns 0 if the typeface has no data.
+uint64_t typeface_content_hash(const SkTypeface& typeface) {
+    int ttcIndex = 0;
+    std::unique_ptr<SkStreamAsset> stream = typeface.openStream(&ttcIndex);
+    if (stream == nullptr) {
+        return 0;
+    }
+    const size_t length = stream->getLength();
+    sk_sp<SkData> copy;
+    const void* bytes = stream->getMemoryBase();
+    if (bytes == nullptr) {
+        copy = SkData::MakeFromStream(stream.get(), length);
+        bytes = copy != nullptr ? copy->data() : nullptr;
+    }
+    if (bytes == nullptr || length == 0) {
+        return 0;
+    }
+    uint64_t hash = SkChecksum::Hash64(bytes, length, ttcIndex);
+
+    const int axisCount = typeface.getVariationDesignPosition({});
+    if (axisCount > 0) {
+        std::vector<SkFontArguments::VariationPosition::Coordinate> position(axisCount);
+        if (typeface.getVariationDesignPosition(position) == axisCount) {
+            hash = SkChecksum::Hash64(position.data(),
+                                      position.size() * sizeof(position[0]),
+                                      hash);
+        }
+    }
+    return hash != 0 ? hash : 1;
+}
+
+std::optional<SkTypefaceID> rec_typeface_id(const SkDescriptor& descriptor) {
+    uint32_t size;
+    const void* ptr = descriptor.findEntry(kRec_SkDescriptorTag, &size);
+    SkScalerContextRec rec;
+    if (!ptr || size != sizeof(rec)) { return std::nullopt; }
+    std::memcpy((void*)&rec, ptr, size);
+    return rec.fTypefaceID;
+}
+
+// Snapshots refer to typefaces by their index in the snapshot instead of their unique ID, so the
+// rec in a descriptor is rewritten when saving and loading.
+bool set_rec_typeface_id(SkDescriptor* descriptor, SkTypefaceID typefaceID) {
+    uint32_t size;
+    // findEntry returns a const void*, remove the const in order to update in place.
+    void* ptr = const_cast<void*>(descriptor->findEntry(kRec_SkDescriptorTag, &size));
+    SkScalerContextRec rec;
+    if (!ptr || size != sizeof(rec)) { return false; }
+    std::memcpy((void*)&rec, ptr, size);
+    rec.fTypefaceID = typefaceID;
+    std::memcpy(ptr, &rec, size);
+    descriptor->computeChecksum();
+    return true;
+}
+
+}  // namespace
+
+SkStrikeCache::SkStrikeCache() : fUniqueID{next_strike_cache_id()} {}
+
 SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     if (gSkUseThreadLocalStrikeCaches_IAcknowledgeThisIsIncrediblyExperimental) {
         static thread_local auto* cache = new SkStrikeCache;
@@ -36,13 +154,30 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     return cache;
 }
 
+int SkStrikeCache::shardIndexFor(const SkDescriptor& desc) const {
+    return SkChecksum::CheapMix(desc.getChecksum()) % kShardCount;
+}
+
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
-    if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+    const SkDescriptor& desc = strikeSpec.descriptor();
+    if (sk_sp<SkStrike> strike = this->findInThreadCache(desc)) {
+        return strike;
     }
-    this->internalPurge();
+
+    const int shardIndex = this->shardIndexFor(desc);
+    sk_sp<SkStrike> strike;
+    uint32_t removalEpoch;
+    {
+        Shard& shard = fShards[shardIndex];
+        SkAutoMutexExclusive ac(shard.fLock);
+        strike = this->internalFindStrikeOrNull(shard, desc);
+        if (strike == nullptr) {
+            strike = this->internalCreateStrike(shard, strikeSpec);
+        }
+        removalEpoch = shard.fRemovalEpoch.load(std::memory_order_relaxed);
+    }
+    this->purge(0, false, shardIndex);
+    this->addToThreadCache(strike.get(), removalEpoch);
     return strike;
 }
 
@@ -90,94 +225,147 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
-    this->internalPurge();
+    const int shardIndex = this->shardIndexFor(desc);
+    sk_sp<SkStrike> result;
+    {
+        Shard& shard = fShards[shardIndex];
+        SkAutoMutexExclusive ac(shard.fLock);
+        result = this->internalFindStrikeOrNull(shard, desc);
+    }
+    this->purge(0, false, shardIndex);
     return result;
 }
 
-auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
+auto SkStrikeCache::internalFindStrikeOrNull(Shard& shard, const SkDescriptor& desc)
+        -> sk_sp<SkStrike> {
 
     // Check head because it is likely the strike we are looking for.
-    if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
+    if (shard.fHead != nullptr && shard.fHead->getDescriptor() == desc) {
+        return sk_ref_sp(shard.fHead);
+    }
 
     // Do the heavy search looking for the strike.
-    sk_sp<SkStrike>* strikeHandle = fStrikeLookup.find(desc);
+    sk_sp<SkStrike>* strikeHandle = shard.fStrikeLookup.find(desc);
     if (strikeHandle == nullptr) { return nullptr; }
     SkStrike* strikePtr = strikeHandle->get();
     SkASSERT(strikePtr != nullptr);
-    if (fHead != strikePtr) {
+    if (shard.fHead != strikePtr) {
         // Make most recently used
         strikePtr->fPrev->fNext = strikePtr->fNext;
         if (strikePtr->fNext != nullptr) {
             strikePtr->fNext->fPrev = strikePtr->fPrev;
         } else {
-            fTail = strikePtr->fPrev;
+            shard.fTail = strikePtr->fPrev;
         }
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+        shard.fHead->fPrev = strikePtr;
+        strikePtr->fNext = shard.fHead;
         strikePtr->fPrev = nullptr;
-        fHead = strikePtr;
+        shard.fHead = strikePtr;
     }
     return sk_ref_sp(strikePtr);
 }
 
+sk_sp<SkStrike> SkStrikeCache::findInThreadCache(const SkDescriptor& desc) const {
+    ThreadStrikeCache& threadCache = thread_strike_cache();
+    const int shardIndex = this->shardIndexFor(desc);
+    const Shard& shard = fShards[shardIndex];
+
+    // While this thread is counted as a reader, internalRemoveStrike() will not release a strike,
+    // so an entry whose epoch is current can be dereferenced and reffed.
+    shard.fThreadCacheReaders.fetch_add(1, std::memory_order_seq_cst);
+    const uint32_t removalEpoch = shard.fRemovalEpoch.load(std::memory_order_seq_cst);
+    sk_sp<SkStrike> result;
+    for (ThreadStrikeCache::Entry& entry : threadCache.fEntries) {
+        if (entry.fCacheID != fUniqueID || entry.fShardIndex != shardIndex ||
+            entry.fStrike == nullptr) {
+            continue;
+        }
+        if (entry.fRemovalEpoch != removalEpoch) {
+            // The shard has removed a strike since this entry was made, maybe this one.
+            entry = ThreadStrikeCache::Entry{};
+            continue;
+        }
+        const SkDescriptor& entryDesc = entry.fStrike->getDescriptor();
+        if (entryDesc.getChecksum() != desc.getChecksum() || entryDesc != desc) {
+            continue;
+        }
+        if (++threadCache.fHitCount % ThreadStrikeCache::kRefreshInterval != 0) {
+            result = sk_ref_sp(entry.fStrike);
+        }
+        break;
+    }
+    shard.fThreadCacheReaders.fetch_sub(1, std::memory_order_release);
+    return result;
+}
+
+void SkStrikeCache::addToThreadCache(SkStrike* strike, uint32_t removalEpoch) const {
+    ThreadStrikeCache& threadCache = thread_strike_cache();
+    ThreadStrikeCache::Entry* entry = nullptr;
+    for (ThreadStrikeCache::Entry& candidate : threadCache.fEntries) {
+        if (candidate.fCacheID == fUniqueID && candidate.fStrike == strike) {
+            entry = &candidate;
+            break;
+        }
+    }
+    if (entry == nullptr) {
+        entry = &threadCache.fEntries[threadCache.fNextEntry];
+        threadCache.fNextEntry = (threadCache.fNextEntry + 1) % ThreadStrikeCache::kEntryCount;
+    }
+    entry->fCacheID = fUniqueID;
+    entry->fShardIndex = this->shardIndexFor(strike->getDescriptor());
+    entry->fRemovalEpoch = removalEpoch;
+    entry->fStrike = strike;
+}
+
 sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
-    SkAutoMutexExclusive ac(fLock);
-    return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+    Shard& shard = fShards[this->shardIndexFor(strikeSpec.descriptor())];
+    SkAutoMutexExclusive ac(shard.fLock);
+    return this->internalCreateStrike(shard, strikeSpec, maybeMetrics, std::move(pinner));
 }
 
 auto SkStrikeCache::internalCreateStrike(
+        Shard& shard,
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<SkStrike> {
     std::unique_ptr<SkScalerContext> scaler = strikeSpec.createScalerContext();
     auto strike =
         sk_make_sp<SkStrike>(this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
+    this->internalAttachToHead(shard, strike);
     return strike;
 }
 
 void SkStrikeCache::purgePinned(size_t minBytesNeeded) {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(minBytesNeeded, /* checkPinners= */ true);
+    this->purge(minBytesNeeded, /* checkPinners= */ true);
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoMutexExclusive ac(fLock);
-    this->internalPurge(fTotalMemoryUsed, /* checkPinners= */ true);
+    this->purge(fTotalMemoryUsed.load(std::memory_order_relaxed), /* checkPinners= */ true);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fTotalMemoryUsed;
+    return fTotalMemoryUsed.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCount;
+    return fCacheCount.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheCountLimit;
+    return fCacheCountLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
-    SkAutoMutexExclusive ac(fLock);
-
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
-    this->internalPurge();
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit, std::memory_order_relaxed);
+    this->purge();
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoMutexExclusive ac(fLock);
-    return fCacheSizeLimit;
+    return fCacheSizeLimit.load(std::memory_order_relaxed);
 }
 
 int SkStrikeCache::setCacheCountLimit(int newCount) {
@@ -185,48 +373,216 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoMutexExclusive ac(fLock);
-
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
-    this->internalPurge();
+    int prevCount = fCacheCountLimit.exchange(newCount, std::memory_order_relaxed);
+    this->purge();
     return prevCount;
 }
 
+sk_sp<SkData> SkStrikeCache::serializeSnapshot(SkSpan<const sk_sp<SkTypeface>> typefaces) const {
+    THashMap<SkTypefaceID, uint32_t> snapshotIndexForID;
+    std::vector<uint64_t> typefaceHashes;
+    for (const sk_sp<SkTypeface>& typeface : typefaces) {
+        if (typeface == nullptr || snapshotIndexForID.find(typeface->uniqueID()) != nullptr) {
+            continue;
+        }
+        const uint64_t hash = typeface_content_hash(*typeface);
+        if (hash == 0) {
+            continue;
+        }
+        snapshotIndexForID.set(typeface->uniqueID(), SkTo<uint32_t>(typefaceHashes.size()));
+        typefaceHashes.push_back(hash);
+    }
+
+    std::vector<sk_sp<SkData>> strikes;
+    this->forEachStrike([&](const SkStrike& strike) {
+        std::optional<SkTypefaceID> typefaceID = rec_typeface_id(strike.getDescriptor());
+        const uint32_t* snapshotIndex =
+                typefaceID ? snapshotIndexForID.find(*typefaceID) : nullptr;
+        if (snapshotIndex == nullptr) {
+            return;
+        }
+        SkAutoDescriptor descriptor{strike.getDescriptor()};
+        set_rec_typeface_id(descriptor.getDesc(), *snapshotIndex);
+
+        SkBinaryWriteBuffer buffer{nullptr, 0, {}};
+        buffer.writeUInt(*snapshotIndex);
+        descriptor.getDesc()->flatten(buffer);
+        SkFontMetricsPriv::Flatten(buffer, strike.getFontMetrics());
+        strike.flattenGlyphImages(buffer);
+        strikes.push_back(buffer.snapshotAsData());
+    });
+    if (strikes.empty()) {
+        return nullptr;
+    }
+
+    SkBinaryWriteBuffer payload{nullptr, 0, {}};
+    payload.writeUInt(SkTo<uint32_t>(typefaceHashes.size()));
+    for (uint64_t hash : typefaceHashes) {
+        payload.writeUInt(static_cast<uint32_t>(hash >> 32));
+        payload.writeUInt(static_cast<uint32_t>(hash));
+    }
+    payload.writeUInt(SkTo<uint32_t>(strikes.size()));
+    for (const sk_sp<SkData>& strike : strikes) {
+        payload.writeDataAsByteArray(strike.get());
+    }
+    sk_sp<SkData> payloadData = payload.snapshotAsData();
+
+    SkBinaryWriteBuffer snapshot{nullptr, 0, {}};
+    snapshot.writeUInt(kSnapshotMagic);
+    snapshot.writeUInt(kSnapshotVersion);
+    snapshot.writeUInt(SK_MILESTONE);
+    snapshot.writeUInt(SkChecksum::Hash32(payloadData->data(), payloadData->size()));
+    snapshot.writeDataAsByteArray(payloadData.get());
+    return snapshot.snapshotAsData();
+}
+
+bool SkStrikeCache::preloadStrike(const SkData& strikeData,
+                                  SkSpan<const sk_sp<SkTypeface>> typefaceForIndex) {
+    SkReadBuffer buffer{strikeData.data(), strikeData.size()};
+
+    const uint32_t typefaceIndex = buffer.readUInt();
+    if (!buffer.isValid() ||
+        typefaceIndex >= typefaceForIndex.size() ||
+        typefaceForIndex[typefaceIndex] == nullptr) {
+        return false;
+    }
+    const sk_sp<SkTypeface>& typeface = typefaceForIndex[typefaceIndex];
+
+    std::optional<SkAutoDescriptor> descriptor = SkAutoDescriptor::MakeFromBuffer(buffer);
+    if (!buffer.validate(descriptor.has_value())) {
+        return false;
+    }
+    std::optional<SkTypefaceID> snapshotTypefaceID = rec_typeface_id(*descriptor->getDesc());
+    if (!snapshotTypefaceID || *snapshotTypefaceID != typefaceIndex ||
+        !set_rec_typeface_id(descriptor->getDesc(), typeface->uniqueID())) {
+        return false;
+    }
+
+    std::optional<SkFontMetrics> fontMetrics = SkFontMetricsPriv::MakeFromBuffer(buffer);
+    if (!buffer.validate(fontMetrics.has_value())) {
+        return false;
+    }
+
+    // A live strike already has everything the snapshot could add. Finding and creating under
+    // one lock keeps a concurrent findOrCreateStrike() from adding the same strike in between.
+    const SkStrikeSpec strikeSpec{*descriptor->getDesc(), typeface};
+    sk_sp<SkStrike> strike;
+    {
+        Shard& shard = fShards[this->shardIndexFor(strikeSpec.descriptor())];
+        SkAutoMutexExclusive ac(shard.fLock);
+        if (this->internalFindStrikeOrNull(shard, strikeSpec.descriptor()) != nullptr) {
+            return false;
+        }
+        strike = this->internalCreateStrike(shard, strikeSpec, &fontMetrics.value());
+    }
+
+    // Glyphs merged before a failure are complete, and any glyph without an image falls back to
+    // the scaler, so a partially read strike is still correct.
+    (void)strike->mergeFromBuffer(buffer);
+    return true;
+}
+
+int SkStrikeCache::preloadSnapshot(const SkData& snapshot,
+                                   SkSpan<const sk_sp<SkTypeface>> typefaces) {
+    SkReadBuffer buffer{snapshot.data(), snapshot.size()};
+    const uint32_t magic = buffer.readUInt();
+    const uint32_t version = buffer.readUInt();
+    const uint32_t milestone = buffer.readUInt();
+    const uint32_t checksum = buffer.readUInt();
+    if (!buffer.isValid() || magic != kSnapshotMagic || version != kSnapshotVersion ||
+        milestone != SK_MILESTONE) {
+        return 0;
+    }
+    sk_sp<SkData> payloadData = buffer.readByteArrayAsData();
+    if (payloadData == nullptr ||
+        SkChecksum::Hash32(payloadData->data(), payloadData->size()) != checksum) {
+        return 0;
+    }
+
+    THashMap<uint64_t, sk_sp<SkTypeface>> typefaceForHash;
+    for (const sk_sp<SkTypeface>& typeface : typefaces) {
+        if (typeface != nullptr) {
+            if (const uint64_t hash = typeface_content_hash(*typeface); hash != 0) {
+                typefaceForHash.set(hash, typeface);
+            }
+        }
+    }
+
+    SkReadBuffer payload{payloadData->data(), payloadData->size()};
+    const uint32_t typefaceCount = payload.readUInt();
+    if (!payload.validateCanReadN<uint64_t>(typefaceCount)) {
+        return 0;
+    }
+    // Typefaces whose data changed since the snapshot was taken are left null, and their
+    // strikes are skipped.
+    std::vector<sk_sp<SkTypeface>> typefaceForIndex;
+    typefaceForIndex.reserve(typefaceCount);
+    for (uint32_t i = 0; i < typefaceCount; ++i) {
+        const uint64_t hi = payload.readUInt();
+        const uint64_t lo = payload.readUInt();
+        sk_sp<SkTypeface>* typeface = typefaceForHash.find((hi << 32) | lo);
+        typefaceForIndex.push_back(typeface != nullptr ? *typeface : nullptr);
+    }
+
+    int strikesAdded = 0;
+    const uint32_t strikeCount = payload.readUInt();
+    for (uint32_t i = 0; i < strikeCount && payload.isValid(); ++i) {
+        sk_sp<SkData> strikeData = payload.readByteArrayAsData();
+        if (strikeData == nullptr) {
+            break;
+        }
+        if (this->preloadStrike(*strikeData, typefaceForIndex)) {
+            strikesAdded += 1;
+        }
+    }
+
+    this->purge();
+    return strikesAdded;
+}
+
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoMutexExclusive ac(fLock);
+    for (const Shard& shard : fShards) {
+        SkAutoMutexExclusive ac(shard.fLock);
 
-    this->validate();
+        this->validate(shard);
 
-    for (SkStrike* strike = fHead; strike != nullptr; strike = strike->fNext) {
-        visitor(*strike);
+        for (SkStrike* strike = shard.fHead; strike != nullptr; strike = strike->fNext) {
+            visitor(*strike);
+        }
     }
 }
 
-size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
+size_t SkStrikeCache::purge(size_t minBytesNeeded, bool checkPinners, int firstShard) {
 #ifndef SK_STRIKE_CACHE_DOESNT_AUTO_CHECK_PINNERS
     // Temporarily default to checking pinners, for staging.
     checkPinners = true;
 #endif
 
-    if (fPinnerCount == fCacheCount && !checkPinners)
+    // The totals are read without holding any shard lock, so other threads may change them while
+    // this runs. The budget is only approximate under contention.
+    const size_t totalMemoryUsed = fTotalMemoryUsed.load(std::memory_order_relaxed);
+    const int32_t cacheCount = fCacheCount.load(std::memory_order_relaxed);
+    const size_t cacheSizeLimit = fCacheSizeLimit.load(std::memory_order_relaxed);
+    const int32_t cacheCountLimit = fCacheCountLimit.load(std::memory_order_relaxed);
+
+    if (fPinnerCount.load(std::memory_order_relaxed) == cacheCount && !checkPinners)
         return 0;
 
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (totalMemoryUsed > cacheSizeLimit) {
+        bytesNeeded = totalMemoryUsed - cacheSizeLimit;
     }
     bytesNeeded = std::max(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = std::max(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = std::max(bytesNeeded, totalMemoryUsed >> 2);
     }
 
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (cacheCount > cacheCountLimit) {
+        countNeeded = cacheCount - cacheCountLimit;
         // no small purges!
-        countNeeded = std::max(countNeeded, fCacheCount >> 2);
+        countNeeded = std::max(countNeeded, cacheCount >> 2);
     }
 
     // early exit
@@ -237,23 +593,36 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
-    // Start at the tail and proceed backwards deleting; the list is in LRU
-    // order, with unimportant entries at the tail.
-    SkStrike* strike = fTail;
-    while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
-        SkStrike* prev = strike->fPrev;
-
-        // Only delete if the strike is not pinned.
-        if (strike->fPinner == nullptr || (checkPinners && strike->fPinner->canDelete())) {
-            bytesFreed += strike->fMemoryUsed;
-            countFreed += 1;
-            this->internalRemoveStrike(strike);
+    // The first pass takes from each shard in proportion to its share of the totals, so the
+    // least recently used strikes of every shard go first. The second pass makes up whatever is
+    // still missing, either from rounding or because a shard's strikes were pinned.
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < kShardCount; ++i) {
+            if (bytesFreed >= bytesNeeded && countFreed >= countNeeded) {
+                break;
+            }
+            Shard& shard = fShards[(firstShard + i) % kShardCount];
+            SkAutoMutexExclusive ac(shard.fLock);
+
+            size_t shardBytesNeeded = bytesNeeded > bytesFreed ? bytesNeeded - bytesFreed : 0;
+            int shardCountNeeded = std::max(countNeeded - countFreed, 0);
+            if (pass == 0) {
+                if (totalMemoryUsed > 0) {
+                    shardBytesNeeded = std::min(shardBytesNeeded, static_cast<size_t>(std::ceil(
+                            static_cast<double>(bytesNeeded) * shard.fMemoryUsed /
+                            totalMemoryUsed)));
+                }
+                if (cacheCount > 0) {
+                    shardCountNeeded = std::min(shardCountNeeded, static_cast<int>(
+                            (static_cast<int64_t>(countNeeded) * shard.fCount + cacheCount - 1) /
+                            cacheCount));
+                }
+            }
+            this->internalPurgeShard(shard, shardBytesNeeded, shardCountNeeded, checkPinners,
+                                     &bytesFreed, &countFreed);
         }
-        strike = prev;
     }
 
-    this->validate();
-
 #ifdef SPEW_PURGE_STATUS
     if (countFreed) {
         SkDebugf("purging %dK from font cache [%d entries]\n",
@@ -264,70 +633,128 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
     return bytesFreed;
 }
 
-void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
-    SkASSERT(fStrikeLookup.find(strike->getDescriptor()) == nullptr);
+void SkStrikeCache::internalPurgeShard(Shard& shard,
+                                       size_t bytesNeeded,
+                                       int countNeeded,
+                                       bool checkPinners,
+                                       size_t* bytesFreed,
+                                       int* countFreed) {
+    size_t  shardBytesFreed = 0;
+    int     shardCountFreed = 0;
+
+    // Start at the tail and proceed backwards deleting; the list is in LRU
+    // order, with unimportant entries at the tail.
+    SkStrike* strike = shard.fTail;
+    while (strike != nullptr &&
+           (shardBytesFreed < bytesNeeded || shardCountFreed < countNeeded)) {
+        SkStrike* prev = strike->fPrev;
+
+        // Only delete if the strike is not pinned.
+        if (strike->fPinner == nullptr || (checkPinners && strike->fPinner->canDelete())) {
+            shardBytesFreed += strike->fMemoryUsed;
+            shardCountFreed += 1;
+            this->internalRemoveStrike(shard, strike);
+        }
+        strike = prev;
+    }
+
+    this->validate(shard);
+
+    *bytesFreed += shardBytesFreed;
+    *countFreed += shardCountFreed;
+}
+
+void SkStrikeCache::internalAttachToHead(Shard& shard, sk_sp<SkStrike> strike) {
+    SkASSERT(shard.fStrikeLookup.find(strike->getDescriptor()) == nullptr);
     SkStrike* strikePtr = strike.get();
-    fStrikeLookup.set(std::move(strike));
+    shard.fStrikeLookup.set(std::move(strike));
     SkASSERT(nullptr == strikePtr->fPrev && nullptr == strikePtr->fNext);
 
-    fCacheCount += 1;
-    fPinnerCount += strikePtr->fPinner != nullptr ? 1 : 0;
-    fTotalMemoryUsed += strikePtr->fMemoryUsed;
-
-    if (fHead != nullptr) {
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
+    const int pinned = strikePtr->fPinner != nullptr ? 1 : 0;
+    shard.fCount += 1;
+    shard.fPinnerCount += pinned;
+    shard.fMemoryUsed += strikePtr->fMemoryUsed;
+    fCacheCount.fetch_add(1, std::memory_order_relaxed);
+    fPinnerCount.fetch_add(pinned, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_add(strikePtr->fMemoryUsed, std::memory_order_relaxed);
+
+    if (shard.fHead != nullptr) {
+        shard.fHead->fPrev = strikePtr;
+        strikePtr->fNext = shard.fHead;
     }
 
-    if (fTail == nullptr) {
-        fTail = strikePtr;
+    if (shard.fTail == nullptr) {
+        shard.fTail = strikePtr;
     }
 
-    fHead = strikePtr; // Transfer ownership of strike to the cache list.
+    shard.fHead = strikePtr; // Transfer ownership of strike to the cache list.
 }
 
-void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
-    SkASSERT(fCacheCount > 0);
-    fCacheCount -= 1;
-    fPinnerCount -= strike->fPinner != nullptr ? 1 : 0;
-    fTotalMemoryUsed -= strike->fMemoryUsed;
+void SkStrikeCache::internalRemoveStrike(Shard& shard, SkStrike* strike) {
+    SkASSERT(shard.fCount > 0);
+    const int pinned = strike->fPinner != nullptr ? 1 : 0;
+    shard.fCount -= 1;
+    shard.fPinnerCount -= pinned;
+    shard.fMemoryUsed -= strike->fMemoryUsed;
+    fCacheCount.fetch_sub(1, std::memory_order_relaxed);
+    fPinnerCount.fetch_sub(pinned, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_sub(strike->fMemoryUsed, std::memory_order_relaxed);
 
     if (strike->fPrev) {
         strike->fPrev->fNext = strike->fNext;
     } else {
-        fHead = strike->fNext;
+        shard.fHead = strike->fNext;
     }
     if (strike->fNext) {
         strike->fNext->fPrev = strike->fPrev;
     } else {
-        fTail = strike->fPrev;
+        shard.fTail = strike->fPrev;
     }
 
     strike->fPrev = strike->fNext = nullptr;
     strike->fRemoved = true;
-    fStrikeLookup.remove(strike->getDescriptor());
+
+    // Invalidate every thread cache entry for this shard, then wait out lookups that may have
+    // read the old epoch before the cache's reference, possibly the last one, is dropped.
+    shard.fRemovalEpoch.fetch_add(1, std::memory_order_seq_cst);
+    while (shard.fThreadCacheReaders.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    shard.fStrikeLookup.remove(strike->getDescriptor());
+}
+
+void SkStrikeCache::updateMemoryUsage(SkStrike* strike, size_t increase) {
+    // fMemoryUsed and fRemoved are managed under the shard's lock. This allows them to be
+    // accessed under LRU operation.
+    Shard& shard = fShards[this->shardIndexFor(strike->getDescriptor())];
+    SkAutoMutexExclusive lock{shard.fLock};
+    strike->fMemoryUsed += increase;
+    if (!strike->fRemoved) {
+        shard.fMemoryUsed += increase;
+        fTotalMemoryUsed.fetch_add(increase, std::memory_order_relaxed);
+    }
 }
 
-void SkStrikeCache::validate() const {
+void SkStrikeCache::validate(const Shard& shard) const {
 #ifdef SK_DEBUG
     size_t computedBytes = 0;
     int computedCount = 0;
 
-    const SkStrike* strike = fHead;
+    const SkStrike* strike = shard.fHead;
     while (strike != nullptr) {
         computedBytes += strike->fMemoryUsed;
         computedCount += 1;
-        SkASSERT(fStrikeLookup.findOrNull(strike->getDescriptor()) != nullptr);
+        SkASSERT(shard.fStrikeLookup.findOrNull(strike->getDescriptor()) != nullptr);
         strike = strike->fNext;
     }
 
-    if (fCacheCount != computedCount) {
-        SkDebugf("fCacheCount: %d, computedCount: %d", fCacheCount, computedCount);
-        SK_ABORT("fCacheCount != computedCount");
+    if (shard.fCount != computedCount) {
+        SkDebugf("fCount: %d, computedCount: %d", shard.fCount, computedCount);
+        SK_ABORT("fCount != computedCount");
     }
-    if (fTotalMemoryUsed != computedBytes) {
-        SkDebugf("fTotalMemoryUsed: %zu, computedBytes: %zu", fTotalMemoryUsed, computedBytes);
-        SK_ABORT("fTotalMemoryUsed == computedBytes");
+    if (shard.fMemoryUsed != computedBytes) {
+        SkDebugf("fMemoryUsed: %zu, computedBytes: %zu", shard.fMemoryUsed, computedBytes);
+        SK_ABORT("fMemoryUsed == computedBytes");
     }
 #endif
 }
@@ -9,6 +9,7 @@
 #define SkStrikeCache_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/private/base/SkLoadUserConfig.h" // IWYU pragma: keep
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkThreadAnnotations.h"
@@ -16,14 +17,17 @@
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 
+class SkData;
 class SkDescriptor;
 class SkStrikeSpec;
 class SkTraceMemoryDump;
+class SkTypeface;
 struct SkFontMetrics;
 
 //  SK_DEFAULT_FONT_CACHE_COUNT_LIMIT and SK_DEFAULT_FONT_CACHE_LIMIT can be set using -D on your
@@ -38,23 +42,28 @@ struct SkFontMetrics;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Strikes are spread over kShardCount shards by descriptor checksum, each with its own lock, LRU
+// list and lookup table, so threads drawing with different strikes rarely contend. Each thread
+// also keeps a few recently used strikes that findOrCreateStrike() checks without any lock. The
+// byte and count budgets are global; they are tracked with atomics and enforced approximately, by
+// purging every shard's least recently used strikes in proportion to its size.
 class SkStrikeCache final : public sktext::StrikeForGPUCacheInterface {
 public:
-    SkStrikeCache() = default;
+    SkStrikeCache();
 
     static SkStrikeCache* GlobalStrikeCache();
 
-    sk_sp<SkStrike> findStrike(const SkDescriptor& desc) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findStrike(const SkDescriptor& desc);
 
     sk_sp<SkStrike> createStrike(
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_EXCLUDES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr);
 
-    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec) SK_EXCLUDES(fLock);
+    sk_sp<SkStrike> findOrCreateStrike(const SkStrikeSpec& strikeSpec);
 
     sk_sp<sktext::StrikeForGPU> findOrCreateScopedStrike(
-            const SkStrikeSpec& strikeSpec) override SK_EXCLUDES(fLock);
+            const SkStrikeSpec& strikeSpec) override;
 
     static void PurgeAll();
     static void Dump();
@@ -63,55 +72,107 @@ public:
     // SkTraceMemoryDump interface.
     static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
-    void purgeAll() SK_EXCLUDES(fLock); // does not change budget
-    void purgePinned(size_t minBytesNeeded = 0) SK_EXCLUDES(fLock);
+    void purgeAll(); // does not change budget
+    void purgePinned(size_t minBytesNeeded = 0);
 
-    int getCacheCountLimit() const SK_EXCLUDES(fLock);
-    int setCacheCountLimit(int limit) SK_EXCLUDES(fLock);
-    int getCacheCountUsed() const SK_EXCLUDES(fLock);
+    int getCacheCountLimit() const;
+    int setCacheCountLimit(int limit);
+    int getCacheCountUsed() const;
 
-    size_t getCacheSizeLimit() const SK_EXCLUDES(fLock);
-    size_t setCacheSizeLimit(size_t limit) SK_EXCLUDES(fLock);
-    size_t getTotalMemoryUsed() const SK_EXCLUDES(fLock);
+    size_t getCacheSizeLimit() const;
+    size_t setCacheSizeLimit(size_t limit);
+    size_t getTotalMemoryUsed() const;
+
+    // Returns a versioned snapshot of the generated glyph images of the strikes using one of
+    // typefaces, or nullptr if there are none. Typefaces are recorded by a hash of their font
+    // data, so a snapshot can be preloaded in another process.
+    sk_sp<SkData> serializeSnapshot(SkSpan<const sk_sp<SkTypeface>> typefaces) const;
+
+    // Creates the strikes recorded in snapshot that are not already in the cache, with their
+    // glyph images, so those glyphs are drawn without running the scaler. Strikes whose typeface
+    // does not match the data of one of typefaces are skipped, and a snapshot from another
+    // snapshot format or Skia milestone, or that fails its checksum, is ignored entirely. Returns
+    // the number of strikes added.
+    int preloadSnapshot(const SkData& snapshot, SkSpan<const sk_sp<SkTypeface>> typefaces);
+
+    static constexpr int kShardCount = 8;
 
 private:
-    friend class SkStrike;  // for SkStrike::updateDelta
+    friend class SkStrike;  // for SkStrike::updateMemoryUsage
     static constexpr char kGlyphCacheDumpName[] = "skia/sk_glyph_cache";
-    sk_sp<SkStrike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
+
+    struct StrikeTraits {
+        static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike);
+        static uint32_t Hash(const SkDescriptor& descriptor);
+    };
+
+    struct Shard {
+        mutable SkMutex fLock;
+        SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
+        SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
+        skia_private::THashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
+                SK_GUARDED_BY(fLock);
+        size_t  fMemoryUsed SK_GUARDED_BY(fLock) {0};
+        int32_t fCount SK_GUARDED_BY(fLock) {0};
+        int32_t fPinnerCount SK_GUARDED_BY(fLock) {0};
+
+        // Bumped, under fLock, whenever a strike is removed; thread cache entries made under an
+        // older epoch are stale. fThreadCacheReaders counts lookups that may be dereferencing one.
+        std::atomic<uint32_t> fRemovalEpoch{0};
+        mutable std::atomic<int32_t> fThreadCacheReaders{0};
+    };
+
+    int shardIndexFor(const SkDescriptor& desc) const;
+
+    sk_sp<SkStrike> internalFindStrikeOrNull(Shard& shard, const SkDescriptor& desc)
+            SK_REQUIRES(shard.fLock);
     sk_sp<SkStrike> internalCreateStrike(
+            Shard& shard,
             const SkStrikeSpec& strikeSpec,
             SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(fLock);
+            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(shard.fLock);
 
-    // The following methods can only be called when mutex is already held.
-    void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
-    void internalAttachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
+    // The following methods can only be called when the shard's mutex is already held.
+    void internalRemoveStrike(Shard& shard, SkStrike* strike) SK_REQUIRES(shard.fLock);
+    void internalAttachToHead(Shard& shard, sk_sp<SkStrike> strike) SK_REQUIRES(shard.fLock);
 
-    // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
+    // Checkout budgets, modulated by the specified min-bytes-needed-to-purge, and attempt to purge
+    // caches to match, starting with firstShard. Must be called with no shard locked.
     // Returns number of bytes freed.
-    size_t internalPurge(size_t minBytesNeeded = 0, bool checkPinners = false) SK_REQUIRES(fLock);
+    size_t purge(size_t minBytesNeeded = 0, bool checkPinners = false, int firstShard = 0);
 
-    // A simple accounting of what each glyph cache reports and the strike cache total.
-    void validate() const SK_REQUIRES(fLock);
+    // Removes strikes from the tail of shard until both targets are met or nothing is left.
+    void internalPurgeShard(Shard& shard, size_t bytesNeeded, int countNeeded, bool checkPinners,
+                            size_t* bytesFreed, int* countFreed) SK_REQUIRES(shard.fLock);
 
-    void forEachStrike(std::function<void(const SkStrike&)> visitor) const SK_EXCLUDES(fLock);
+    // Creates the strike serialized in strikeData and merges its glyph images, unless the cache
+    // already has that strike. Returns true if a strike was added.
+    bool preloadStrike(const SkData& strikeData,
+                       SkSpan<const sk_sp<SkTypeface>> typefaceForIndex);
 
-    mutable SkMutex fLock;
-    SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
-    SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
-    struct StrikeTraits {
-        static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike);
-        static uint32_t Hash(const SkDescriptor& descriptor);
-    };
-    skia_private::THashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
-            SK_GUARDED_BY(fLock);
-
-    size_t  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
-    size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
-    int32_t fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
-    int32_t fCacheCount SK_GUARDED_BY(fLock) {0};
-    int32_t fPinnerCount SK_GUARDED_BY(fLock) {0};
+    // Called by SkStrike when it has allocated more glyph data.
+    void updateMemoryUsage(SkStrike* strike, size_t increase);
+
+    // The calling thread's recently used strikes, which are only trusted while their shard has
+    // removed nothing since they were found. The thread caches never own a strike.
+    sk_sp<SkStrike> findInThreadCache(const SkDescriptor& desc) const;
+    void addToThreadCache(SkStrike* strike, uint32_t removalEpoch) const;
+
+    // A simple accounting of what each glyph cache reports and the shard total.
+    void validate(const Shard& shard) const SK_REQUIRES(shard.fLock);
+
+    void forEachStrike(std::function<void(const SkStrike&)> visitor) const;
+
+    // Distinguishes this cache from one later allocated at the same address, for the thread caches.
+    const uint32_t fUniqueID;
+
+    Shard fShards[kShardCount];
+
+    std::atomic<size_t>  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
+    std::atomic<size_t>  fTotalMemoryUsed{0};
+    std::atomic<int32_t> fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
+    std::atomic<int32_t> fCacheCount{0};
+    std::atomic<int32_t> fPinnerCount{0};
 };
 
 #endif  // SkStrikeCache_DEFINED
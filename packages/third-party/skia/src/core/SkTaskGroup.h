@@ -36,7 +36,7 @@ public:
     // It is safe to reuse this SkTaskGroup once done().
     bool done() const;
 
-    // Block until done().
+    // Block until done(), helping the executor run work (see SkExecutor::borrow()) meanwhile.
     void wait();
 
     // A convenience for testing tools.
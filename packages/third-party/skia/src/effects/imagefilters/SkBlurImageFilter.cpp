@@ -50,6 +50,8 @@ private:
 
     skif::FilterResult onFilterImage(const skif::Context& context) const override;
 
+    bool onCanEvaluateInTiles(const skif::Context& context) const override;
+
     skif::LayerSpace<SkIRect> onGetInputLayerBounds(
             const skif::Mapping& mapping,
             const skif::LayerSpace<SkIRect>& desiredOutput,
@@ -195,6 +197,26 @@ skif::FilterResult SkBlurImageFilter::onFilterImage(const skif::Context& ctx) co
     return builder.blur(sigma);
 }
 
+bool SkBlurImageFilter::onCanEvaluateInTiles(const skif::Context& ctx) const {
+    if (fLegacyTileMode != SkTileMode::kDecal) {
+        // The legacy tile mode is applied at the child's output bounds, which are clipped to the
+        // requested output, so each tile would tile its own edges.
+        return false;
+    }
+    // Sigmas above the algorithm's limit are applied to a downscaled image whose sampling grid is
+    // anchored to the desired output, which would differ from tile to tile.
+    skif::LayerSpace<SkSize> sigma = this->mapSigma(ctx.mapping());
+    if (sigma.width() == 0.f && sigma.height() == 0.f) {
+        return true;
+    }
+    const SkBlurEngine* blurEngine = ctx.backend()->getBlurEngine();
+    const SkBlurEngine::Algorithm* algorithm =
+            blurEngine ? blurEngine->findAlgorithm(SkSize(sigma), ctx.backend()->colorType())
+                       : nullptr;
+    return algorithm && sigma.width() <= algorithm->maxSigma() &&
+           sigma.height() <= algorithm->maxSigma();
+}
+
 skif::LayerSpace<SkSize> SkBlurImageFilter::mapSigma(const skif::Mapping& mapping) const {
     skif::LayerSpace<SkSize> sigma = mapping.paramToLayer(fSigma);
     // Clamp to the maximum sigma
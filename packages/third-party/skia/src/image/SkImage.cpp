@@ -344,3 +344,12 @@ sk_sp<SkImage> SkImage::withMipmaps(sk_sp<SkMipmap> mips) const {
 sk_sp<SkImage> SkImage::withDefaultMipmaps() const {
     return this->withMipmaps(nullptr);
 }
+
+sk_sp<SkImage> SkImage::withDefaultMipmapsAsync(SkExecutor* executor) const {
+    if (executor) {
+        if (auto result = as_IB(this)->onMakeWithMipmapsAsync(executor)) {
+            return result;
+        }
+    }
+    return this->withDefaultMipmaps();
+}
@@ -68,6 +68,10 @@ public:
 
     virtual SkMipmap* onPeekMips() const { return nullptr; }
 
+    // True while mipmaps requested with withDefaultMipmapsAsync() are still being built. Samplers
+    // should use the base level rather than build their own mipmaps in the meantime.
+    virtual bool hasPendingMipmaps() const { return false; }
+
     sk_sp<SkMipmap> refMips() const {
         return sk_ref_sp(this->onPeekMips());
     }
@@ -174,6 +178,11 @@ public:
         return nullptr;
     }
 
+    // on failure, or if the image can't build mipmaps asynchronously, returns nullptr
+    virtual sk_sp<SkImage> onMakeWithMipmapsAsync(SkExecutor*) const {
+        return nullptr;
+    }
+
 protected:
     SkImage_Base(const SkImageInfo& info, uint32_t uniqueID);
 
@@ -10,6 +10,7 @@
 #include "include/core/SkCPURecorder.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixelRef.h"
@@ -137,6 +138,27 @@ static sk_sp<SkMipmap> copy_mipmaps(const SkBitmap& src, SkMipmap* srcMips) {
     return dst;
 }
 
+sk_sp<SkImage> SkImage_Raster::onMakeWithMipmapsAsync(SkExecutor* executor) const {
+    // Copy for the same reasons as onMakeWithMipmaps().
+    sk_sp<SkImage> img = SkMakeImageFromRasterBitmap(fBitmap, kAlways_SkCopyPixelsMode);
+    if (!img) {
+        return nullptr;
+    }
+    auto imgRaster = static_cast<SkImage_Raster*>(img.get());
+    auto pending = sk_make_sp<PendingMipmaps>();
+    imgRaster->fPendingMips = pending;
+
+    // The task's copy of the bitmap keeps the base level's pixels alive even if the image is
+    // destroyed before the build finishes.
+    executor->add([pending, base = imgRaster->fBitmap, executor] {
+        pending->finish(sk_sp<SkMipmap>(SkMipmap::Build(base.pixmap(),
+                                                        /*factoryProc=*/nullptr,
+                                                        /*computeContents=*/true,
+                                                        executor)));
+    });
+    return img;
+}
+
 sk_sp<SkImage> SkImage_Raster::onMakeSubset(SkRecorder*,
                                             const SkIRect& subset,
                                             RequiredProperties requiredProperties) const {
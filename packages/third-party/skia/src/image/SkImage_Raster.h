@@ -19,6 +19,7 @@
 #include "src/core/SkMipmap.h"
 #include "src/image/SkImage_Base.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <utility>
@@ -80,10 +81,19 @@ public:
         fBitmap.pixelRef()->notifyAddedToCache();
     }
 
-    bool onHasMipmaps() const override { return SkToBool(fBitmap.fMips); }
+    bool onHasMipmaps() const override { return SkToBool(this->onPeekMips()); }
     bool onIsProtected() const override { return false; }
 
-    SkMipmap* onPeekMips() const override { return fBitmap.fMips.get(); }
+    SkMipmap* onPeekMips() const override {
+        if (fBitmap.fMips || !fPendingMips) {
+            return fBitmap.fMips.get();
+        }
+        return fPendingMips->peek();
+    }
+
+    bool hasPendingMipmaps() const override {
+        return !fBitmap.fMips && fPendingMips && !fPendingMips->isDone();
+    }
 
     sk_sp<SkImage> onMakeWithMipmaps(sk_sp<SkMipmap> mips) const override {
         // It's dangerous to have two SkBitmaps that share a SkPixelRef but have different SkMipmaps
@@ -102,11 +112,32 @@ public:
         return img;
     }
 
+    sk_sp<SkImage> onMakeWithMipmapsAsync(SkExecutor*) const override;
+
     SkImage_Base::Type type() const override { return SkImage_Base::Type::kRaster; }
 
     SkBitmap bitmap() const { return fBitmap; }
 private:
+    // Mipmaps being built in the background by onMakeWithMipmapsAsync(). The builder sets fMips
+    // and then fDone, after which fMips is never modified again.
+    class PendingMipmaps : public SkNVRefCnt<PendingMipmaps> {
+    public:
+        bool isDone() const { return fDone.load(std::memory_order_acquire); }
+        // Null until done, or if the mipmaps couldn't be built.
+        SkMipmap* peek() const { return this->isDone() ? fMips.get() : nullptr; }
+
+        void finish(sk_sp<SkMipmap> mips) {
+            fMips = std::move(mips);
+            fDone.store(true, std::memory_order_release);
+        }
+
+    private:
+        sk_sp<SkMipmap> fMips;
+        std::atomic<bool> fDone{false};
+    };
+
     SkBitmap fBitmap;
+    sk_sp<PendingMipmaps> fPendingMips;
 };
 
 sk_sp<SkImage> MakeRasterCopyPriv(const SkPixmap& pmap, uint32_t id);
@@ -37,6 +37,8 @@
         #define SK_OPTS_NS sse2
     #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE1
         #define SK_OPTS_NS sse
+    #elif defined(__wasm_simd128__)
+        #define SK_OPTS_NS wasm
     #elif SK_CPU_LSX_LEVEL >= SK_CPU_LSX_LEVEL_LASX
         #define SK_OPTS_NS lasx
     #elif SK_CPU_LSX_LEVEL >= SK_CPU_LSX_LEVEL_LSX
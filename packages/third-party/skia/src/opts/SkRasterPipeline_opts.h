@@ -75,12 +75,14 @@ using NoCtx = const void*;
 
 #if defined(SKRP_CPU_SCALAR) || defined(SKRP_CPU_NEON) || defined(SKRP_CPU_HSW) || \
         defined(SKRP_CPU_SKX) || defined(SKRP_CPU_AVX) || defined(SKRP_CPU_SSE41) || \
-        defined(SKRP_CPU_SSE2)
+        defined(SKRP_CPU_SSE2) || defined(SKRP_CPU_WASM)
     // Honor the existing setting
 #elif !defined(__clang__) && !defined(__GNUC__)
     #define SKRP_CPU_SCALAR
 #elif defined(SK_ARM_HAS_NEON)
     #define SKRP_CPU_NEON
+#elif defined(__wasm_simd128__)
+    #define SKRP_CPU_WASM
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SKX
     #define SKRP_CPU_SKX
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
@@ -103,6 +105,8 @@ using NoCtx = const void*;
     #include <math.h>
 #elif defined(SKRP_CPU_NEON)
     #include <arm_neon.h>
+#elif defined(SKRP_CPU_WASM)
+    #include <wasm_simd128.h>
 #elif defined(SKRP_CPU_LASX)
     #include <lasxintrin.h>
     #include <lsxintrin.h>
@@ -924,6 +928,145 @@ namespace SK_OPTS_NS {
         _mm_storeu_ps(ptr +12, a);
     }
 
+#elif defined(SKRP_CPU_WASM)
+    // These are v128_t, but friendlier and strongly-typed.
+    template <typename T> using V = Vec<4, T>;
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return (F)wasm_v128_bitselect((v128_t)t, (v128_t)e, (v128_t)c);
+    }
+    SI I32 if_then_else(I32 c, I32 t, I32 e) {
+        return (I32)wasm_v128_bitselect((v128_t)t, (v128_t)e, (v128_t)c);
+    }
+
+    // pmin/pmax are the "pseudo" min and max, which lower to a single minps/maxps on x86.
+    // With the arguments swapped they select exactly like _mm_min_ps(a,b) and _mm_max_ps(a,b).
+    SI F   min(F a, F b)     { return (F)wasm_f32x4_pmin((v128_t)b, (v128_t)a); }
+    SI F   max(F a, F b)     { return (F)wasm_f32x4_pmax((v128_t)b, (v128_t)a); }
+    SI I32 min(I32 a, I32 b) { return (I32)wasm_i32x4_min((v128_t)a, (v128_t)b); }
+    SI U32 min(U32 a, U32 b) { return (U32)wasm_u32x4_min((v128_t)a, (v128_t)b); }
+    SI I32 max(I32 a, I32 b) { return (I32)wasm_i32x4_max((v128_t)a, (v128_t)b); }
+    SI U32 max(U32 a, U32 b) { return (U32)wasm_u32x4_max((v128_t)a, (v128_t)b); }
+
+    SI F   mad(F f, F m, F a)  { return a+f*m; }
+    SI F  nmad(F f, F m, F a)  { return a-f*m; }
+    SI F   abs_(F v)           { return (F)wasm_f32x4_abs((v128_t)v); }
+    SI I32 abs_(I32 v)         { return (I32)wasm_i32x4_abs((v128_t)v); }
+    // Wasm SIMD has no reciprocal or rsqrt estimates, so these are always precise.
+    SI F   rcp_approx(F v)     { return 1.0f / v; }  // use rcp_fast instead
+    SI F   rcp_precise (F v)   { return 1.0f / v; }
+    SI F    sqrt_(F v)         { return (F)wasm_f32x4_sqrt((v128_t)v); }
+    SI F   rsqrt_approx(F v)   { return 1.0f / sqrt_(v); }
+
+    SI I32 iround(F v) {
+        return (I32)wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_nearest((v128_t)v));
+    }
+    SI U32 round(F v) {
+        return (U32)wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_nearest((v128_t)v));
+    }
+
+    SI U16 pack(U32 v) {
+        // Keep the low half of each lane, like NEON's vmovn_u32().
+        v128_t p = wasm_i16x8_shuffle((v128_t)v, (v128_t)v, 0,2,4,6, 0,2,4,6);
+        return sk_unaligned_load<U16>(&p);  // We have two copies.  Return (the lower) one.
+    }
+    SI U8 pack(U16 v) {
+        v128_t r = widen_cast<v128_t>(v);
+        r = wasm_i8x16_shuffle(r, r, 0,2,4,6, 0,2,4,6, 0,2,4,6, 0,2,4,6);
+        return sk_unaligned_load<U8>(&r);
+    }
+
+    SI bool any(I32 c) { return wasm_v128_any_true((v128_t)c); }
+    SI bool all(I32 c) { return wasm_i32x4_all_true((v128_t)c); }
+
+    SI F floor_(F v) { return (F)wasm_f32x4_floor((v128_t)v); }
+    SI F  ceil_(F v) { return (F)wasm_f32x4_ceil ((v128_t)v); }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return V<T>{p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]]};
+    }
+    template <typename T>
+    SI V<T> gather_unaligned(const T* p, U32 ix) {
+        return gather(p, ix);
+    }
+    SI void scatter_masked(I32 src, int* dst, U32 ix, I32 mask) {
+        I32 before = gather(dst, ix);
+        I32 after = if_then_else(mask, src, before);
+        dst[ix[0]] = after[0];
+        dst[ix[1]] = after[1];
+        dst[ix[2]] = after[2];
+        dst[ix[3]] = after[3];
+    }
+    SI void load2(const uint16_t* ptr, U16* r, U16* g) {
+        v128_t _01 = wasm_v128_load(ptr);                              // r0 g0 r1 g1 r2 g2 r3 g3
+        v128_t rg  = wasm_i16x8_shuffle(_01, _01, 0,2,4,6, 1,3,5,7);  // r0 r1 r2 r3 g0 g1 g2 g3
+        *r = sk_unaligned_load<U16>((uint16_t*)&rg + 0);
+        *g = sk_unaligned_load<U16>((uint16_t*)&rg + 4);
+    }
+    SI void store2(uint16_t* ptr, U16 r, U16 g) {
+        wasm_v128_store(ptr, wasm_i16x8_shuffle(widen_cast<v128_t>(r), widen_cast<v128_t>(g),
+                                                0,8, 1,9, 2,10, 3,11));
+    }
+
+    SI void load4(const uint16_t* ptr, U16* r, U16* g, U16* b, U16* a) {
+        v128_t _01 = wasm_v128_load(ptr + 0),  // r0 g0 b0 a0 r1 g1 b1 a1
+               _23 = wasm_v128_load(ptr + 8);  // r2 g2 b2 a2 r3 g3 b3 a3
+
+        v128_t rg = wasm_i16x8_shuffle(_01, _23, 0,4,8,12, 1,5,9,13),   // r0 r1 r2 r3 g0 g1 g2 g3
+               ba = wasm_i16x8_shuffle(_01, _23, 2,6,10,14, 3,7,11,15); // b0 b1 b2 b3 a0 a1 a2 a3
+
+        *r = sk_unaligned_load<U16>((uint16_t*)&rg + 0);
+        *g = sk_unaligned_load<U16>((uint16_t*)&rg + 4);
+        *b = sk_unaligned_load<U16>((uint16_t*)&ba + 0);
+        *a = sk_unaligned_load<U16>((uint16_t*)&ba + 4);
+    }
+
+    SI void store4(uint16_t* ptr, U16 r, U16 g, U16 b, U16 a) {
+        v128_t rg = wasm_i16x8_shuffle(widen_cast<v128_t>(r), widen_cast<v128_t>(g),
+                                       0,8, 1,9, 2,10, 3,11),  // r0 g0 r1 g1 r2 g2 r3 g3
+               ba = wasm_i16x8_shuffle(widen_cast<v128_t>(b), widen_cast<v128_t>(a),
+                                       0,8, 1,9, 2,10, 3,11);  // b0 a0 b1 a1 b2 a2 b3 a3
+
+        wasm_v128_store(ptr + 0, wasm_i32x4_shuffle(rg, ba, 0,4, 1,5));
+        wasm_v128_store(ptr + 8, wasm_i32x4_shuffle(rg, ba, 2,6, 3,7));
+    }
+
+    SI void load4(const float* ptr, F* r, F* g, F* b, F* a) {
+        v128_t _0 = wasm_v128_load(ptr + 0),   // r0 g0 b0 a0
+               _1 = wasm_v128_load(ptr + 4),   // r1 g1 b1 a1
+               _2 = wasm_v128_load(ptr + 8),   // r2 g2 b2 a2
+               _3 = wasm_v128_load(ptr +12);   // r3 g3 b3 a3
+
+        v128_t rg01 = wasm_i32x4_shuffle(_0, _1, 0,4, 1,5),  // r0 r1 g0 g1
+               ba01 = wasm_i32x4_shuffle(_0, _1, 2,6, 3,7),  // b0 b1 a0 a1
+               rg23 = wasm_i32x4_shuffle(_2, _3, 0,4, 1,5),  // r2 r3 g2 g3
+               ba23 = wasm_i32x4_shuffle(_2, _3, 2,6, 3,7);  // b2 b3 a2 a3
+
+        *r = (F)wasm_i32x4_shuffle(rg01, rg23, 0,1, 4,5);
+        *g = (F)wasm_i32x4_shuffle(rg01, rg23, 2,3, 6,7);
+        *b = (F)wasm_i32x4_shuffle(ba01, ba23, 0,1, 4,5);
+        *a = (F)wasm_i32x4_shuffle(ba01, ba23, 2,3, 6,7);
+    }
+
+    SI void store4(float* ptr, F r, F g, F b, F a) {
+        v128_t rg01 = wasm_i32x4_shuffle((v128_t)r, (v128_t)g, 0,4, 1,5),  // r0 g0 r1 g1
+               rg23 = wasm_i32x4_shuffle((v128_t)r, (v128_t)g, 2,6, 3,7),  // r2 g2 r3 g3
+               ba01 = wasm_i32x4_shuffle((v128_t)b, (v128_t)a, 0,4, 1,5),  // b0 a0 b1 a1
+               ba23 = wasm_i32x4_shuffle((v128_t)b, (v128_t)a, 2,6, 3,7);  // b2 a2 b3 a3
+
+        wasm_v128_store(ptr + 0, wasm_i32x4_shuffle(rg01, ba01, 0,1, 4,5));
+        wasm_v128_store(ptr + 4, wasm_i32x4_shuffle(rg01, ba01, 2,3, 6,7));
+        wasm_v128_store(ptr + 8, wasm_i32x4_shuffle(rg23, ba23, 0,1, 4,5));
+        wasm_v128_store(ptr +12, wasm_i32x4_shuffle(rg23, ba23, 2,3, 6,7));
+    }
+
 #elif defined(SKRP_CPU_LASX)
     // These are __m256 and __m256i, but friendlier and strongly-typed.
     template <typename T> using V = Vec<8, T>;
@@ -1503,9 +1646,10 @@ static void restore_memory_contexts(
     }
 }
 
-#if defined(SKRP_CPU_SCALAR) || defined(SKRP_CPU_SSE2)
+#if defined(SKRP_CPU_SCALAR) || defined(SKRP_CPU_SSE2) || defined(SKRP_CPU_WASM)
     // In scalar and SSE2 mode, we always use precise math so we can have more predictable results.
     // Chrome will use the SSE2 implementation when --disable-skia-runtime-opts is set. (b/40042946)
+    // Wasm has no estimate instructions, so its rcp_approx is already precise.
     SI F rcp_fast(F v) { return rcp_precise(v); }
     SI F rsqrt(F v)    { return rcp_precise(sqrt_(v)); }
 #else
@@ -1534,6 +1678,10 @@ static constexpr size_t N = sizeof(F) / sizeof(float);
     // These platforms are ideal for wider stages, and their default ABI is ideal.
     #define ABI
     #define SKRP_NARROW_STAGES 0
+#elif defined(SKRP_CPU_WASM)
+    // Wasm passes every argument as a local, so all eight vectors stay out of memory.
+    #define ABI
+    #define SKRP_NARROW_STAGES 0
 #else
     // 32-bit or unknown... shunt them down the narrow path.
     // Odds are these have few registers and are better off there.
@@ -3505,6 +3653,22 @@ SI void gradient_lookup(const SkRasterPipelineContexts::GradientCtx* c, U32 idx,
         fa = (__m128)__lsx_vshuf_w(idx, zero, __lsx_vld(c->factors[3], 0));
         ba = (__m128)__lsx_vshuf_w(idx, zero, __lsx_vld(c->biases[3], 0));
     } else
+#elif defined(SKRP_CPU_WASM)
+    if (c->stopCount <= 4) {
+        // Turn each lane's index into the byte indices of that float, then swizzle.
+        v128_t bytes = (v128_t)(idx * 0x04040404 + 0x03020100);
+        auto lookup = [bytes](const float* table) {
+            return (F)wasm_i8x16_swizzle(wasm_v128_load(table), bytes);
+        };
+        fr = lookup(c->factors[0]);
+        br = lookup(c->biases[0]);
+        fg = lookup(c->factors[1]);
+        bg = lookup(c->biases[1]);
+        fb = lookup(c->factors[2]);
+        bb = lookup(c->biases[2]);
+        fa = lookup(c->factors[3]);
+        ba = lookup(c->biases[3]);
+    } else
 #endif
     {
 #if defined(SKRP_CPU_LSX)
@@ -5608,6 +5772,10 @@ SI F sqrt_(F x) {
     __m128 lo,hi;
     split(x, &lo,&hi);
     return join<F>(__lsx_vfsqrt_s(lo), __lsx_vfsqrt_s(hi));
+#elif defined(SKRP_CPU_WASM)
+    v128_t lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(wasm_f32x4_sqrt(lo), wasm_f32x4_sqrt(hi));
 #else
     return F{
         sqrtf(x[0]), sqrtf(x[1]), sqrtf(x[2]), sqrtf(x[3]),
@@ -5639,6 +5807,10 @@ SI F floor_(F x) {
     __m128 lo,hi;
     split(x, &lo,&hi);
     return join<F>(__lsx_vfrintrm_s(lo), __lsx_vfrintrm_s(hi));
+#elif defined(SKRP_CPU_WASM)
+    v128_t lo,hi;
+    split(x, &lo,&hi);
+    return join<F>(wasm_f32x4_floor(lo), wasm_f32x4_floor(hi));
 #else
     F roundtrip = cast<F>(cast<I32>(x));
     return roundtrip - if_then_else(roundtrip > x, F_(1), F_(0));
@@ -5649,7 +5821,7 @@ SI F floor_(F x) {
 // this multiply is:
 //     (2 * a * b + (1 << 15)) >> 16
 // The result is a number on [-1, 1).
-// Note: on neon this is a saturating multiply while the others are not.
+// Note: on neon and wasm this is a saturating multiply while the others are not.
 SI I16 scaled_mult(I16 a, I16 b) {
 #if defined(SKRP_CPU_SKX)
     return (I16)_mm256_mulhrs_epi16((__m256i)a, (__m256i)b);
@@ -5667,6 +5839,8 @@ SI I16 scaled_mult(I16 a, I16 b) {
 #elif defined(SKRP_CPU_LSX)
     I16 res = __lsx_vmuh_h(a, b);
     return __lsx_vslli_h(res, 1);
+#elif defined(SKRP_CPU_WASM)
+    return (I16)wasm_i16x8_q15mulr_sat((v128_t)a, (v128_t)b);
 #else
     const I32 roundingTerm = I32_(1 << 14);
     return cast<I16>((cast<I32>(a) * cast<I32>(b) + roundingTerm) >> 15);
@@ -6106,12 +6280,22 @@ SI void from_8888(U32 rgba, U16* r, U16* g, U16* b, U16* a) {
     *g = __lsx_vsrli_h(rg, 8);
     *b = __lsx_vand_v(ba, mask_00ff);
     *a = __lsx_vsrli_h(ba, 8);
+#elif defined(SKRP_CPU_WASM)
+    v128_t _01, _23;
+    split(rgba, &_01, &_23);
+    v128_t rg = wasm_i16x8_shuffle(_01, _23, 0,2,4,6,8,10,12,14),  // Low halves: r | g<<8.
+           ba = wasm_i16x8_shuffle(_01, _23, 1,3,5,7,9,11,13,15);  // High halves: b | a<<8.
+
+    *r = (U16)wasm_v128_and(rg, wasm_i16x8_splat(0xff));
+    *g = (U16)wasm_u16x8_shr(rg, 8);
+    *b = (U16)wasm_v128_and(ba, wasm_i16x8_splat(0xff));
+    *a = (U16)wasm_u16x8_shr(ba, 8);
 #else
     auto cast_U16 = [](U32 v) -> U16 {
         return cast<U16>(v);
     };
 #endif
-#if !defined(SKRP_CPU_LSX)
+#if !defined(SKRP_CPU_LSX) && !defined(SKRP_CPU_WASM)
     *r = cast_U16(rgba & 65535) & 255;
     *g = cast_U16(rgba & 65535) >>  8;
     *b = cast_U16(rgba >>   16) & 255;
@@ -6168,6 +6352,14 @@ SI void store_8888_(uint32_t* ptr, U16 r, U16 g, U16 b, U16 a) {
         cast<U8>(a),
     }};
     vst4_u8((uint8_t*)(ptr), rgba);
+#elif defined(SKRP_CPU_WASM)
+    // Narrow to bytes (r0..r7 g0..g7 and b0..b7 a0..a7), then interleave them into pixels.
+    v128_t rg = wasm_u8x16_narrow_i16x8((v128_t)r, (v128_t)g),
+           ba = wasm_u8x16_narrow_i16x8((v128_t)b, (v128_t)a);
+    wasm_v128_store(ptr + 0, wasm_i8x16_shuffle(rg, ba, 0,8,16,24, 1,9,17,25,
+                                                        2,10,18,26, 3,11,19,27));
+    wasm_v128_store(ptr + 4, wasm_i8x16_shuffle(rg, ba, 4,12,20,28, 5,13,21,29,
+                                                        6,14,22,30, 7,15,23,31));
 #else
     store(ptr, cast<U32>(r | (g<<8)) <<  0
              | cast<U32>(b | (a<<8)) << 16);
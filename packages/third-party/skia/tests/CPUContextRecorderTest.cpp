@@ -5,23 +5,38 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/core/SkBBHFactory.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkBlurTypes.h"
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkCPUContext.h"
 #include "include/core/SkCPURecorder.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkSurface.h"
+#include "include/effects/SkColorMatrix.h"
+#include "include/effects/SkGradientShader.h"
+#include "include/effects/SkImageFilters.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkCPUContextImpl.h"
 #include "src/core/SkResourceCache.h"
 
 #include "tests/Test.h"
 
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
 DEF_TEST(CPUSurface_UsesCPUContextAndRecorderToDraw_DrawsPixels, reporter) {
@@ -93,3 +108,328 @@ DEF_TEST(ImageMakeScaled_UsesCPURecorderToMakeImage_Success, reporter) {
     REPORTER_ASSERT(reporter, legacyAPI->width() == 70);
     REPORTER_ASSERT(reporter, !legacyAPI->isTextureBacked());
 }
+
+static sk_sp<SkPicture> make_tiling_test_picture() {
+    SkRTreeFactory factory;
+    SkPictureRecorder pictureRecorder;
+    SkCanvas* canvas = pictureRecorder.beginRecording(SkRect::MakeWH(300, 200), &factory);
+    SkPaint paint;
+    for (int i = 0; i < 40; ++i) {
+        paint.setColor(0xff000000 | (i * 0x0a1b2c));
+        paint.setAntiAlias(i % 2 == 0);
+        canvas->drawRect(SkRect::MakeXYWH(i * 7.f, i * 4.5f, 60, 30), paint);
+        canvas->drawCircle(280 - i * 6.f, 20 + i * 4.f, 12, paint);
+    }
+    // Dithering depends on device coordinates, which the tiles must preserve.
+    SkPaint dithered;
+    dithered.setDither(true);
+    const SkPoint points[] = {{0, 0}, {300, 0}};
+    const SkColor colors[] = {0xff102030, 0xff203850};
+    dithered.setShader(SkGradientShader::MakeLinear(points, colors, nullptr, 2,
+                                                    SkTileMode::kClamp));
+    canvas->drawRect(SkRect::MakeLTRB(0, 150, 300, 200), dithered);
+    return pictureRecorder.finishRecordingAsPicture();
+}
+
+static void check_tiled_matches_direct(skiatest::Reporter* reporter,
+                                       skcpu::Context::TilePolicy policy) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    skcpu::Context::Options opts;
+    opts.fExecutor = executor.get();
+    opts.fTilePolicy = policy;
+    auto tiledCtx = skcpu::Context::Make(opts);
+    auto directCtx = skcpu::Context::Make();
+    std::unique_ptr<skcpu::Recorder> tiled = tiledCtx->makeRecorder();
+    std::unique_ptr<skcpu::Recorder> direct = directCtx->makeRecorder();
+
+    SkImageInfo imageInfo =
+            SkImageInfo::Make(300, 200, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    auto tiledSurface = tiled->makeBitmapSurface(imageInfo);
+    auto directSurface = direct->makeBitmapSurface(imageInfo);
+    sk_sp<SkPicture> picture = make_tiling_test_picture();
+    SkMatrix matrix = SkMatrix::Translate(3, 5);
+
+    for (auto* surface : {tiledSurface.get(), directSurface.get()}) {
+        surface->getCanvas()->clear(SK_ColorWHITE);
+        surface->getCanvas()->clipRect(SkRect::MakeLTRB(10, 10, 290, 190));
+    }
+    sk_sp<SkImage> before = tiledSurface->makeImageSnapshot();
+    tiled->drawPicture(tiledSurface.get(), picture.get(), &matrix);
+    direct->drawPicture(directSurface.get(), picture.get(), &matrix);
+
+    SkPixmap tiledPixels, directPixels, beforePixels;
+    REPORTER_ASSERT(reporter, tiledSurface->peekPixels(&tiledPixels));
+    REPORTER_ASSERT(reporter, directSurface->peekPixels(&directPixels));
+    for (int y = 0; y < imageInfo.height(); ++y) {
+        REPORTER_ASSERT(reporter,
+                        !memcmp(tiledPixels.addr32(0, y),
+                                directPixels.addr32(0, y),
+                                imageInfo.minRowBytes()),
+                        "row %d differs", y);
+    }
+    // Writing through the tiles must not alter earlier snapshots.
+    REPORTER_ASSERT(reporter, before->peekPixels(&beforePixels));
+    REPORTER_ASSERT(reporter, beforePixels.getColor(150, 100) == SK_ColorWHITE);
+}
+
+DEF_TEST(CPURecorder_DrawPicture_BandsMatchDirect, reporter) {
+    skcpu::Context::TilePolicy policy;
+    policy.fSplit = skcpu::Context::TilePolicy::Split::kBands;
+    policy.fTileSize = 32;
+    check_tiled_matches_direct(reporter, policy);
+}
+
+DEF_TEST(CPURecorder_DrawPicture_TilesMatchDirect, reporter) {
+    skcpu::Context::TilePolicy policy;
+    policy.fSplit = skcpu::Context::TilePolicy::Split::kTiles;
+    policy.fTileSize = 64;
+    check_tiled_matches_direct(reporter, policy);
+}
+
+static sk_sp<SkSurface> draw_paths_with_rasterizer(skcpu::Context::PathRasterizer rasterizer) {
+    skcpu::Context::Options opts;
+    opts.fPathRasterizer = rasterizer;
+    auto ctx = skcpu::Context::Make(opts);
+    std::unique_ptr<skcpu::Recorder> recorder = ctx->makeRecorder();
+    auto surface = recorder->makeBitmapSurface(
+            SkImageInfo::Make(256, 256, kRGBA_8888_SkColorType, kPremul_SkAlphaType));
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    // Curves and an even-odd hole.
+    SkPathBuilder builder(SkPathFillType::kEvenOdd);
+    builder.addCircle(70, 70, 50.3f);
+    builder.addRect(SkRect::MakeLTRB(45.5f, 45.25f, 95.75f, 95.1f));
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawPath(builder.detach(), paint);
+
+    // A jagged star with many short edges. Its vertices are sorted by angle so it does not
+    // intersect itself, where the two rasterizers legitimately disagree the most.
+    SkRandom rand(7);
+    builder = SkPathBuilder();
+    for (int i = 0; i < 60; ++i) {
+        const float angle = i * (2 * SK_ScalarPI / 60);
+        const float radius = rand.nextRangeF(20, 60);
+        const SkPoint pt = {190 + radius * std::cos(angle), 190 + radius * std::sin(angle)};
+        i == 0 ? builder.moveTo(pt) : builder.lineTo(pt);
+    }
+    paint.setColor(0x80ff0000);
+    canvas->drawPath(builder.detach(), paint);
+
+    // Partially outside the surface, with a rotated clip.
+    canvas->save();
+    canvas->rotate(15, 128, 128);
+    canvas->clipRect(SkRect::MakeLTRB(140, -20, 300, 110), true);
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawOval(SkRect::MakeLTRB(120, -40, 290, 120), paint);
+    canvas->restore();
+
+    // Stroked, so it is filled as a path.
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(3.5f);
+    paint.setColor(SK_ColorBLACK);
+    canvas->drawPath(SkPath::Polygon({{10, 250}, {60, 150}, {110, 250}}, true), paint);
+
+    return surface;
+}
+
+DEF_TEST(CPUContext_SparseStripRasterizer_MatchesAnalytic, reporter) {
+    auto analytic = draw_paths_with_rasterizer(skcpu::Context::PathRasterizer::kAnalytic);
+    auto sparse = draw_paths_with_rasterizer(skcpu::Context::PathRasterizer::kSparseStrips);
+
+    SkPixmap a, s;
+    REPORTER_ASSERT(reporter, analytic->peekPixels(&a));
+    REPORTER_ASSERT(reporter, sparse->peekPixels(&s));
+
+    // The rasterizers compute coverage differently, so only expect edge pixels to be close and
+    // the total difference to stay small.
+    constexpr int kMaxChannelDiff = 24;
+    int64_t totalDiff = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        const uint8_t* ap = static_cast<const uint8_t*>(a.addr(0, y));
+        const uint8_t* sp = static_cast<const uint8_t*>(s.addr(0, y));
+        for (int i = 0; i < a.width() * 4; ++i) {
+            int diff = std::abs(ap[i] - sp[i]);
+            totalDiff += diff;
+            if (diff > kMaxChannelDiff) {
+                ERRORF(reporter, "pixel (%d, %d) channel %d differs by %d",
+                       i / 4, y, i % 4, diff);
+                return;
+            }
+        }
+    }
+    const double meanDiff = double(totalDiff) / (a.width() * a.height() * 4);
+    REPORTER_ASSERT(reporter, meanDiff < 0.5, "mean channel difference %g", meanDiff);
+}
+
+static sk_sp<SkSurface> draw_blurred_layer(skcpu::Recorder* recorder, SkColorType colorType) {
+    auto surface = recorder->makeBitmapSurface(
+            SkImageInfo::Make(300, 200, colorType, kPremul_SkAlphaType));
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    canvas->drawPicture(make_tiling_test_picture());
+
+    SkCanvas::SaveLayerRec rec(nullptr, nullptr, SkImageFilters::Blur(12, 7, nullptr).get(), 0);
+    canvas->saveLayer(rec);
+    canvas->restore();
+    return surface;
+}
+
+DEF_TEST(CPUContext_BlurWithExecutor_MatchesSerial, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    skcpu::Context::Options opts;
+    opts.fExecutor = executor.get();
+    auto parallelCtx = skcpu::Context::Make(opts);
+    auto serialCtx = skcpu::Context::Make();
+    std::unique_ptr<skcpu::Recorder> parallelRecorder = parallelCtx->makeRecorder();
+    std::unique_ptr<skcpu::Recorder> serialRecorder = serialCtx->makeRecorder();
+
+    for (SkColorType colorType :
+         {kN32_SkColorType, kRGBA_F16_SkColorType, kRGBA_F32_SkColorType}) {
+        auto parallel = draw_blurred_layer(parallelRecorder.get(), colorType);
+        auto serial = draw_blurred_layer(serialRecorder.get(), colorType);
+
+        SkPixmap parallelPixels, serialPixels;
+        REPORTER_ASSERT(reporter, parallel->peekPixels(&parallelPixels));
+        REPORTER_ASSERT(reporter, serial->peekPixels(&serialPixels));
+        for (int y = 0; y < parallelPixels.height(); ++y) {
+            REPORTER_ASSERT(reporter,
+                            !memcmp(parallelPixels.addr(0, y),
+                                    serialPixels.addr(0, y),
+                                    parallelPixels.info().minRowBytes()),
+                            "color type %d row %d differs", colorType, y);
+        }
+    }
+}
+
+static sk_sp<SkSurface> draw_filtered_layer(skcpu::Recorder* recorder) {
+    auto surface = recorder->makeBitmapSurface(SkImageInfo::MakeN32Premul(300, 200));
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    SkColorMatrix matrix;
+    matrix.setSaturation(0.25f);
+    sk_sp<SkImageFilter> blur = SkImageFilters::Blur(6, 3, nullptr);
+    sk_sp<SkImageFilter> graded = SkImageFilters::ColorFilter(
+            SkColorFilters::Matrix(matrix), blur);
+    sk_sp<SkImageFilter> merged = SkImageFilters::Merge(graded, nullptr);
+
+    SkPaint layerPaint;
+    layerPaint.setImageFilter(merged);
+    canvas->saveLayer(nullptr, &layerPaint);
+    canvas->drawPicture(make_tiling_test_picture());
+    canvas->restore();
+    return surface;
+}
+
+DEF_TEST(CPUContext_TiledImageFilter_MatchesWholeLayer, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    auto wholeLayerCtx = skcpu::Context::Make();
+    std::unique_ptr<skcpu::Recorder> wholeLayerRecorder = wholeLayerCtx->makeRecorder();
+    auto expected = draw_filtered_layer(wholeLayerRecorder.get());
+    SkPixmap expectedPixels;
+    REPORTER_ASSERT(reporter, expected->peekPixels(&expectedPixels));
+
+    // Tile sizes that don't divide the layer evenly, serially and on an executor.
+    for (SkExecutor* tileExecutor : {static_cast<SkExecutor*>(nullptr), executor.get()}) {
+        for (int tileSize : {37, 64}) {
+            skcpu::Context::Options opts;
+            opts.fExecutor = tileExecutor;
+            opts.fImageFilterTileSize = tileSize;
+            auto tiledCtx = skcpu::Context::Make(opts);
+            std::unique_ptr<skcpu::Recorder> tiledRecorder = tiledCtx->makeRecorder();
+            auto tiled = draw_filtered_layer(tiledRecorder.get());
+
+            SkPixmap tiledPixels;
+            REPORTER_ASSERT(reporter, tiled->peekPixels(&tiledPixels));
+            for (int y = 0; y < tiledPixels.height(); ++y) {
+                REPORTER_ASSERT(reporter,
+                                !memcmp(tiledPixels.addr(0, y),
+                                        expectedPixels.addr(0, y),
+                                        tiledPixels.info().minRowBytes()),
+                                "tile size %d (%s) row %d differs",
+                                tileSize, tileExecutor ? "parallel" : "serial", y);
+            }
+        }
+    }
+}
+
+static sk_sp<SkPicture> make_path_test_picture() {
+    SkPictureRecorder pictureRecorder;
+    SkCanvas* canvas = pictureRecorder.beginRecording(SkRect::MakeWH(256, 256));
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    SkPathBuilder builder(SkPathFillType::kEvenOdd);
+    builder.addCircle(70, 70, 50.3f);
+    builder.addRect(SkRect::MakeLTRB(45.5f, 45.25f, 95.75f, 95.1f));
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawPath(builder.detach(), paint);
+
+    SkRandom rand(7);
+    builder = SkPathBuilder();
+    for (int i = 0; i < 60; ++i) {
+        const float angle = i * (2 * SK_ScalarPI / 60);
+        const float radius = rand.nextRangeF(20, 60);
+        const SkPoint pt = {150 + radius * std::cos(angle), 150 + radius * std::sin(angle)};
+        i == 0 ? builder.moveTo(pt) : builder.lineTo(pt);
+    }
+    paint.setColor(0x80ff0000);
+    canvas->drawPath(builder.detach(), paint);
+    return pictureRecorder.finishRecordingAsPicture();
+}
+
+// Tiled playback must draw with the recorder's own context, not the default one.
+DEF_TEST(CPURecorder_DrawPicture_TilesUseRecorderOptions, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    skcpu::Context::Options tiledOpts;
+    tiledOpts.fExecutor = executor.get();
+    tiledOpts.fTilePolicy.fSplit = skcpu::Context::TilePolicy::Split::kBands;
+    tiledOpts.fTilePolicy.fTileSize = 32;
+    tiledOpts.fPathRasterizer = skcpu::Context::PathRasterizer::kSparseStrips;
+    skcpu::Context::Options directOpts;
+    directOpts.fPathRasterizer = skcpu::Context::PathRasterizer::kSparseStrips;
+
+    auto tiledCtx = skcpu::Context::Make(tiledOpts);
+    auto directCtx = skcpu::Context::Make(directOpts);
+    auto analyticCtx = skcpu::Context::Make();
+    std::unique_ptr<skcpu::Recorder> tiled = tiledCtx->makeRecorder();
+    std::unique_ptr<skcpu::Recorder> direct = directCtx->makeRecorder();
+    std::unique_ptr<skcpu::Recorder> analytic = analyticCtx->makeRecorder();
+
+    SkImageInfo imageInfo =
+            SkImageInfo::Make(256, 256, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    sk_sp<SkPicture> picture = make_path_test_picture();
+    auto draw = [&](skcpu::Recorder* recorder) {
+        auto surface = recorder->makeBitmapSurface(imageInfo);
+        surface->getCanvas()->clear(SK_ColorWHITE);
+        recorder->drawPicture(surface.get(), picture.get(), nullptr);
+        return surface;
+    };
+    auto tiledSurface = draw(tiled.get());
+    auto directSurface = draw(direct.get());
+    auto analyticSurface = draw(analytic.get());
+
+    SkPixmap tiledPixels, directPixels, analyticPixels;
+    REPORTER_ASSERT(reporter, tiledSurface->peekPixels(&tiledPixels));
+    REPORTER_ASSERT(reporter, directSurface->peekPixels(&directPixels));
+    REPORTER_ASSERT(reporter, analyticSurface->peekPixels(&analyticPixels));
+
+    // The rasterizers differ somewhere, so matching the sparse strip output shows the tiles
+    // used it.
+    bool rasterizersDiffer = false;
+    for (int y = 0; y < imageInfo.height(); ++y) {
+        REPORTER_ASSERT(reporter,
+                        !memcmp(tiledPixels.addr32(0, y),
+                                directPixels.addr32(0, y),
+                                imageInfo.minRowBytes()),
+                        "row %d differs", y);
+        rasterizersDiffer |= memcmp(directPixels.addr32(0, y),
+                                    analyticPixels.addr32(0, y),
+                                    imageInfo.minRowBytes()) != 0;
+    }
+    REPORTER_ASSERT(reporter, rasterizersDiffer);
+}
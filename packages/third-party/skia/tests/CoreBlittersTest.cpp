@@ -10,12 +10,16 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPathBuilder.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkSurface.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkCoreBlitters.h"
 #include "src/core/SkMask.h"
+#include "src/core/SkRasterPipelineBlitterCache.h"
 
+#include <cstring>
 #include <memory>
 
 static bool all_pixels_same_color(uint32_t* buffer, size_t len) {
@@ -197,3 +201,65 @@ DEF_TEST(SkARGB32Blitter_MaskAndAntiHDrawTheSame, r) {
         }
     }
 }
+
+static void draw_varied_paints(SkCanvas* canvas) {
+    const SkBlendMode modes[] = {SkBlendMode::kSrcOver, SkBlendMode::kSrc,
+                                 SkBlendMode::kMultiply, SkBlendMode::kPlus,
+                                 SkBlendMode::kClear, SkBlendMode::kScreen};
+    const SkPath triangle = SkPathBuilder().moveTo(0, 0).lineTo(7, 2).lineTo(3, 9).close()
+                                           .detach();
+    canvas->clear(SkColorSetARGB(255, 40, 80, 120));
+    for (int i = 0; i < 120; i++) {
+        SkPaint paint;
+        paint.setColor(SkColorSetARGB(i % 3 ? 255 : 128, i * 37, i * 91, i * 53));
+        paint.setBlendMode(modes[i % std::size(modes)]);
+        paint.setAntiAlias(i % 2);
+
+        float x = (i % 12) * 10.5f, y = (i / 12) * 10.25f;
+        switch (i % 3) {
+            case 0: canvas->drawRect(SkRect::MakeXYWH(x, y, 9, 9), paint); break;
+            case 1: canvas->drawRRect(SkRRect::MakeRectXY(SkRect::MakeXYWH(x, y, 9, 9), 3, 3),
+                                      paint); break;
+            case 2: canvas->drawPath(triangle.makeOffset(x, y), paint); break;
+        }
+    }
+}
+
+// Draws through the blitter cache must match freshly built blitters exactly.
+DEF_TEST(RasterPipelineBlitterCache_MatchesUncached, r) {
+    const SkImageInfo infos[] = {
+            SkImageInfo::Make(128, 128, kRGBA_F16_SkColorType, kPremul_SkAlphaType),
+            SkImageInfo::Make(128, 128, kRGB_565_SkColorType, kOpaque_SkAlphaType),
+            SkImageInfo::Make(128, 128, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType),
+            SkImageInfo::Make(128, 128, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+                              SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                    SkNamedGamut::kDisplayP3)),
+    };
+
+    SkRasterPipelineBlitterCache::PurgeThreadCache();
+    for (const SkImageInfo& info : infos) {
+        auto uncached = SkSurfaces::Raster(info);
+        auto cached = SkSurfaces::Raster(info);
+        REPORTER_ASSERT(r, uncached && cached);
+
+        {
+            SkRasterPipelineBlitterCache::ScopedEnabledOverride disable(false);
+            draw_varied_paints(uncached->getCanvas());
+        }
+        {
+            SkRasterPipelineBlitterCache::ScopedEnabledOverride enable(true);
+            draw_varied_paints(cached->getCanvas());
+        }
+
+        SkPixmap expected, actual;
+        REPORTER_ASSERT(r, uncached->peekPixels(&expected) && cached->peekPixels(&actual));
+        bool same = true;
+        for (int y = 0; y < info.height(); y++) {
+            same &= !memcmp(expected.addr(0, y), actual.addr(0, y), info.minRowBytes());
+        }
+        REPORTER_ASSERT(r, same, "color type %d", (int)info.colorType());
+    }
+
+    // Counters are shared with other threads, so only check that this thread's draws hit.
+    REPORTER_ASSERT(r, SkRasterPipelineBlitterCache::GetStats().fHits > 0);
+}
@@ -25,9 +25,12 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkDashPathEffect.h"
+#include "src/base/SkRandom.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 
 // test that we can draw an aa-rect at coordinates > 32K (bigger than fixedpoint)
 static void test_big_aa_rect(skiatest::Reporter* reporter) {
@@ -456,3 +459,78 @@ DEF_TEST(DrawPath, reporter) {
     test_halfway();
     test_big_hairpath(reporter);
 }
+
+// Rasterized rrects, circles and their circular-cornered strokes take an analytic coverage path;
+// they should match the general path rasterizer up to its own approximation of the curves.
+DEF_TEST(DrawRRect_AnalyticMatchesPath, reporter) {
+    constexpr int kSize = 96;
+    constexpr int kTolerance = 0x20;
+
+    auto draw = [](const SkRRect& rrect, const SkPaint& paint, const SkRect* clip, bool asPath) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeA8(kSize, kSize));
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bm);
+        if (clip) {
+            canvas.clipRect(*clip, true);
+        }
+        if (asPath) {
+            canvas.drawPath(SkPath::RRect(rrect), paint);
+        } else {
+            canvas.drawRRect(rrect, paint);
+        }
+        return bm;
+    };
+
+    SkRandom rand;
+    for (int i = 0; i < 200; ++i) {
+        const SkRect r = SkRect::MakeXYWH(rand.nextRangeF(2, 30), rand.nextRangeF(2, 30),
+                                          rand.nextRangeF(4, 60), rand.nextRangeF(4, 60));
+        SkVector radii[4];
+        for (SkVector& radius : radii) {
+            const float rx = rand.nextRangeF(0, 20);
+            // Half the shapes get elliptical corners, which are only analytic when filled.
+            radius = {rx, i % 2 ? rand.nextRangeF(0, 20) : rx};
+        }
+        SkRRect rrect;
+        switch (i % 4) {
+            case 0:
+                rrect.setRectRadii(r, radii);
+                break;
+            case 1:
+                rrect.setNinePatch(r, radii[0].fX, radii[0].fY, radii[1].fX, radii[1].fY);
+                break;
+            case 2:
+                rrect.setRectXY(r, radii[0].fX, radii[0].fY);
+                break;
+            case 3:
+                // Every other oval is a circle.
+                rrect.setOval(i % 8 == 3 ? SkRect::MakeXYWH(r.fLeft, r.fTop, r.width(), r.width())
+                                         : r);
+                break;
+        }
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        if (i % 3 == 1) {
+            paint.setStyle(SkPaint::kStroke_Style);
+            paint.setStrokeWidth(rand.nextRangeF(1.5f, 8));
+        } else if (i % 3 == 2) {
+            paint.setStyle(SkPaint::kStrokeAndFill_Style);
+            paint.setStrokeWidth(rand.nextRangeF(1.5f, 8));
+        }
+        const SkRect clip = SkRect::MakeLTRB(10.5f, 8.25f, 80.75f, 70.5f);
+        const SkRect* clipPtr = i % 5 == 0 ? &clip : nullptr;
+
+        SkBitmap analytic = draw(rrect, paint, clipPtr, false),
+                 path = draw(rrect, paint, clipPtr, true);
+        int maxDiff = 0;
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                maxDiff = std::max(maxDiff, std::abs(*analytic.getAddr8(x, y) -
+                                                     *path.getAddr8(x, y)));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= kTolerance, "shape %d: max difference %d", i, maxDiff);
+    }
+}
@@ -6,8 +6,10 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -16,8 +18,10 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
@@ -184,3 +188,135 @@ DEF_TEST(DrawText_noglyphs, r) {
             "\x0d\xf3\xf2\xf2\xe9\x0d\x0d\x0d\x05\x0d\x0d\xe3\xe3\xe3\xe3\xe3\xe3\xe3\xe3\xe3",
             10, 20, font, SkPaint());
 }
+
+// Solid color text under a rect clip is blended a run at a time by SkGlyphMaskBlitter. Drawing
+// under a complex clip takes the general blitter path, and the two must agree.
+DEF_TEST(DrawText_BatchedGlyphMasks, r) {
+    constexpr int kW = 160, kH = 40;
+    struct {
+        SkColorType colorType;
+        SkFont::Edging edging;
+        float tolerance;
+    } testCases[] = {
+        {kN32_SkColorType,      SkFont::Edging::kAntiAlias,         0},
+        {kN32_SkColorType,      SkFont::Edging::kSubpixelAntiAlias, 0},
+        {kRGBA_F16_SkColorType, SkFont::Edging::kAntiAlias,         1 / 256.f},
+    };
+
+    // The first clip is the whole surface. The second cuts through the glyphs horizontally and
+    // vertically, and excludes the glyphs at both ends of the string entirely.
+    const SkIRect clipRects[] = {SkIRect::MakeWH(kW, kH), SkIRect::MakeLTRB(30, 12, 100, 22)};
+
+    for (const auto& testCase : testCases) {
+        sk_sp<SkColorSpace> colorSpace = testCase.colorType == kRGBA_F16_SkColorType
+                                                 ? SkColorSpace::MakeSRGBLinear()
+                                                 : nullptr;
+        SkImageInfo info =
+                SkImageInfo::Make(kW, kH, testCase.colorType, kPremul_SkAlphaType, colorSpace);
+        SkSurfaceProps props(0, kRGB_H_SkPixelGeometry);
+
+        SkFont font = ToolUtils::DefaultFont();
+        font.setSize(14);
+        font.setEdging(testCase.edging);
+
+        for (const SkIRect& clipRect : clipRects) {
+            // The hole is at the clip's corner, above the text, so it only forces the clip to be
+            // complex.
+            SkRegion complexClip(clipRect);
+            complexClip.op(SkIRect::MakeXYWH(clipRect.fLeft, clipRect.fTop, 1, 1),
+                           SkRegion::kDifference_Op);
+
+            SkBitmap results[2];
+            for (int complex = 0; complex < 2; ++complex) {
+                auto surface = SkSurfaces::Raster(info, &props);
+                SkCanvas* canvas = surface->getCanvas();
+                canvas->clear(0xFF3366CC);
+                canvas->drawRect(SkRect::MakeWH(kW / 2, kH), SkPaint(SkColors::kWhite));
+                if (complex) {
+                    canvas->clipRegion(complexClip);
+                } else {
+                    canvas->clipIRect(clipRect);
+                }
+                SkPaint paint;
+                paint.setColor(0xC0208040);
+                canvas->drawString("Hamburgefons 123", 4, 26, font, paint);
+
+                results[complex].allocPixels(info);
+                surface->readPixels(results[complex], 0, 0);
+            }
+
+            bool matches = true;
+            for (int y = 0; y < kH && matches; ++y) {
+                for (int x = 0; x < kW; ++x) {
+                    SkColor4f a = results[0].getColor4f(x, y),
+                              b = results[1].getColor4f(x, y);
+                    if (std::fabs(a.fR - b.fR) > testCase.tolerance ||
+                        std::fabs(a.fG - b.fG) > testCase.tolerance ||
+                        std::fabs(a.fB - b.fB) > testCase.tolerance ||
+                        std::fabs(a.fA - b.fA) > testCase.tolerance) {
+                        ERRORF(r, "colorType %d edging %d clip width %d differs at (%d, %d)",
+                               testCase.colorType, (int)testCase.edging, clipRect.width(), x, y);
+                        matches = false;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Scale bucketing draws glyphs rasterized at the nearest power-of-sqrt(2) scale. Text at a bucket
+// scale must be untouched, and text between buckets must land where exact text would.
+DEF_TEST(DrawText_ScaleBucketing, r) {
+    auto draw = [](SkScalar scale, bool bucketing, SkBlendMode mode = SkBlendMode::kSrcOver) {
+        auto surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(200, 60));
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        canvas->scale(scale, scale);
+        SkFont font = ToolUtils::DefaultFont();
+        font.setSize(12);
+        font.setScaleBucketing(bucketing);
+        SkPaint paint;
+        paint.setBlendMode(mode);
+        canvas->drawString("Hamburgefons", 4, 16, font, paint);
+
+        SkBitmap bitmap;
+        bitmap.allocPixels(surface->imageInfo());
+        surface->readPixels(bitmap, 0, 0);
+        return bitmap;
+    };
+    auto inkBounds = [](const SkBitmap& bitmap) {
+        SkIRect bounds = SkIRect::MakeEmpty();
+        for (int y = 0; y < bitmap.height(); ++y) {
+            for (int x = 0; x < bitmap.width(); ++x) {
+                if (bitmap.getColor(x, y) != SK_ColorWHITE) {
+                    bounds.join(SkIRect::MakeXYWH(x, y, 1, 1));
+                }
+            }
+        }
+        return bounds;
+    };
+
+    SkBitmap exactAtBucket = draw(2, false),
+             bucketedAtBucket = draw(2, true);
+    REPORTER_ASSERT(r, compare(exactAtBucket, SkIRect::MakeWH(200, 60),
+                               bucketedAtBucket, SkIRect::MakeWH(200, 60)));
+
+    const SkIRect exact = inkBounds(draw(1.3f, false)),
+                  bucketed = inkBounds(draw(1.3f, true));
+    REPORTER_ASSERT(r, !bucketed.isEmpty());
+    REPORTER_ASSERT(r, std::abs(exact.fLeft   - bucketed.fLeft)   <= 2 &&
+                       std::abs(exact.fTop    - bucketed.fTop)    <= 2 &&
+                       std::abs(exact.fRight  - bucketed.fRight)  <= 2 &&
+                       std::abs(exact.fBottom - bucketed.fBottom) <= 2,
+                    "exact [%d %d %d %d] bucketed [%d %d %d %d]",
+                    exact.fLeft, exact.fTop, exact.fRight, exact.fBottom,
+                    bucketed.fLeft, bucketed.fTop, bucketed.fRight, bucketed.fBottom);
+
+    // Blend modes other than SrcOver are not bucketed, since they would also overwrite the
+    // uncovered pixels of each glyph's mask.
+    SkBitmap exactSrc = draw(1.3f, false, SkBlendMode::kSrc),
+             bucketedSrc = draw(1.3f, true, SkBlendMode::kSrc);
+    REPORTER_ASSERT(r, compare(exactSrc, SkIRect::MakeWH(200, 60),
+                               bucketedSrc, SkIRect::MakeWH(200, 60)));
+}
@@ -10,6 +10,8 @@
 #include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 
+#include <atomic>
+#include <memory>
 #include <thread>
 
 namespace {
@@ -150,3 +152,53 @@ DEF_TEST(ExecutorTest, reporter) {
         discard_test(reporter, makeExecutor());
     }
 }
+
+DEF_TEST(ExecutorTest_WorkStealing, reporter) {
+    auto executor = SkExecutor::MakeWorkStealingThreadPool(kNumThreads);
+
+    // Every task runs exactly once, whether added from this thread or from inside other tasks.
+    constexpr int kFlatTasks = 10000;
+    constexpr int kOuterTasks = 50;
+    constexpr int kInnerTasks = 100;
+    std::unique_ptr<std::atomic<int>[]> hits(new std::atomic<int>[kFlatTasks]());
+    std::atomic<int> nested{0};
+    {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(kFlatTasks, [&hits](int i) {
+            hits[i].fetch_add(1, std::memory_order_relaxed);
+        });
+        for (int i = 0; i < kOuterTasks; ++i) {
+            taskGroup.add([&] {
+                // Waiting here helps run the inner tasks instead of blocking a pool thread.
+                SkTaskGroup inner(*executor);
+                for (int j = 0; j < kInnerTasks; ++j) {
+                    inner.add([&nested] { nested.fetch_add(1, std::memory_order_relaxed); });
+                }
+                inner.wait();
+            });
+        }
+        taskGroup.wait();
+    }
+
+    bool allOnce = true;
+    for (int i = 0; i < kFlatTasks; ++i) {
+        allOnce &= hits[i].load() == 1;
+    }
+    REPORTER_ASSERT(reporter, allOnce);
+    REPORTER_ASSERT(reporter, nested.load() == kOuterTasks * kInnerTasks);
+
+    // Discarded work never runs, and the group still finishes.
+    std::atomic<int> ran{0};
+    {
+        SkTaskGroup taskGroup(*executor);
+        for (int i = 0; i < 1000; ++i) {
+            taskGroup.add([&ran] {
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+                ran.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        taskGroup.discardAllPendingWork();
+        taskGroup.wait();
+    }
+    REPORTER_ASSERT(reporter, ran.load() < 1000);
+}
@@ -58,8 +58,9 @@ enum {
     kLinearMetrics         = 1 << 3,
     kEmbolden              = 1 << 4,
     kBaselineSnap          = 1 << 5,
+    kScaleBucketing        = 1 << 6,
 
-    kAllBits = 0x3F,
+    kAllBits = 0x7F,
 };
 
 static void apply_flags(SkFont* font, unsigned flags) {
@@ -69,6 +70,7 @@ static void apply_flags(SkFont* font, unsigned flags) {
     font->setLinearMetrics(   SkToBool(flags & kLinearMetrics));
     font->setEmbolden(        SkToBool(flags & kEmbolden));
     font->setBaselineSnap(    SkToBool(flags & kBaselineSnap));
+    font->setScaleBucketing(  SkToBool(flags & kScaleBucketing));
 }
 
 DEF_TEST(Font_flatten, reporter) {
@@ -83,7 +85,7 @@ DEF_TEST(Font_flatten, reporter) {
     };
     const unsigned int flags[] = {
         kForceAutoHinting, kEmbeddedBitmaps, kSubpixel, kLinearMetrics, kEmbolden, kBaselineSnap,
-        kAllBits,
+        kScaleBucketing, kAllBits,
     };
     const sk_sp<SkTypeface> typefaces[] = {
         nullptr, ToolUtils::SampleUserTypeface()
@@ -8,6 +8,7 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkColorSpace.h"
@@ -17,9 +18,11 @@
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkImageFilters.h"
@@ -27,9 +30,11 @@
 #include "include/private/gpu/ganesh/GrTypesPriv.h"
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkImageFilterTypes.h"
+#include "src/core/SkImageFilter_Base.h"
 #include "src/core/SkSpecialImage.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 #if defined(SK_GANESH)
 #include "include/gpu/ganesh/GrBackendSurface.h"
@@ -240,6 +245,103 @@ static void test_image_backed(skiatest::Reporter* reporter,
     test_explicit_purging(reporter, fullImg, subsetImg);
 }
 
+DEF_TEST(ImageFilterCache_StructureHash, reporter) {
+    // Separately created filters with the same parameters share a hash.
+    auto filter1 = make_filter();
+    auto filter2 = make_filter();
+    REPORTER_ASSERT(reporter, as_IFB(filter1)->uniqueID() != as_IFB(filter2)->uniqueID());
+    REPORTER_ASSERT(reporter, as_IFB(filter1)->structureHash() != 0);
+    REPORTER_ASSERT(reporter,
+                    as_IFB(filter1)->structureHash() == as_IFB(filter2)->structureHash());
+
+    auto blur1 = SkImageFilters::Blur(3.f, 3.f, filter1);
+    auto blur2 = SkImageFilters::Blur(3.f, 3.f, filter2);
+    auto blur3 = SkImageFilters::Blur(3.f, 4.f, filter2);
+    REPORTER_ASSERT(reporter, as_IFB(blur1)->structureHash() == as_IFB(blur2)->structureHash());
+    REPORTER_ASSERT(reporter, as_IFB(blur1)->structureHash() != as_IFB(blur3)->structureHash());
+    REPORTER_ASSERT(reporter, as_IFB(blur1)->structureHash() != as_IFB(filter1)->structureHash());
+}
+
+DEF_TEST(ImageFilterCache_ContentAddressed, reporter) {
+    static const size_t kCacheSize = 1000000;
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(kCacheSize));
+    cache->setContentAddressed(true);
+    REPORTER_ASSERT(reporter, cache->isContentAddressed());
+
+    SkBitmap srcBM = create_bm();
+    const SkIRect full = SkIRect::MakeWH(kFullSize, kFullSize);
+    sk_sp<SkSpecialImage> image(SkSpecialImages::MakeFromRaster(full, srcBM, SkSurfaceProps()));
+
+    auto filter = make_filter();
+    SkImageFilterCacheKey key(0, SkMatrix::I(), full, image->uniqueID(), image->subset(),
+                              as_IFB(filter)->structureHash());
+    skif::FilterResult foundImage;
+    REPORTER_ASSERT(reporter, !cache->get(key, &foundImage));
+    cache->set(key, /*filter=*/nullptr, skif::FilterResult(image));
+    REPORTER_ASSERT(reporter, cache->getTotalBytesUsed() == image->getSize());
+
+    // Destroying the filter doesn't purge content-addressed results, and an equivalent filter
+    // finds them.
+    cache->purgeByImageFilter(filter.get());
+    filter.reset();
+    auto recreated = make_filter();
+    SkImageFilterCacheKey recreatedKey(0, SkMatrix::I(), full, image->uniqueID(), image->subset(),
+                                       as_IFB(recreated)->structureHash());
+    REPORTER_ASSERT(reporter, cache->get(recreatedKey, &foundImage));
+    REPORTER_ASSERT(reporter, foundImage.image() == image.get());
+    REPORTER_ASSERT(reporter, cache->getHitCount() == 1);
+    REPORTER_ASSERT(reporter, cache->getMissCount() == 1);
+
+    // Shrinking the budget evicts.
+    REPORTER_ASSERT(reporter, cache->setTotalByteLimit(0) == kCacheSize);
+    REPORTER_ASSERT(reporter, cache->getTotalBytesUsed() == 0);
+    REPORTER_ASSERT(reporter, !cache->get(recreatedKey, &foundImage));
+
+    // Switching modes purges.
+    cache->setTotalByteLimit(kCacheSize);
+    cache->set(recreatedKey, nullptr, skif::FilterResult(image));
+    cache->setContentAddressed(false);
+    REPORTER_ASSERT(reporter, cache->getTotalBytesUsed() == 0);
+}
+
+DEF_SERIAL_TEST(ImageFilterCache_ContentAddressedSaveLayer, reporter) {
+    const bool wasContentAddressed = SkGraphics::GetImageFilterCacheContentAddressed();
+    SkGraphics::SetImageFilterCacheContentAddressed(true);
+
+    sk_sp<SkSurface> surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(64, 64));
+    auto drawFrame = [&](SkColor color) {
+        // Each frame creates a new filter, and restoring renders the layer into a new image.
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        SkPaint layerPaint;
+        layerPaint.setImageFilter(SkImageFilters::Blur(4.f, 4.f, nullptr));
+        canvas->saveLayer(nullptr, &layerPaint);
+        SkPaint paint;
+        paint.setColor(color);
+        canvas->drawRect(SkRect::MakeXYWH(16, 16, 32, 32), paint);
+        canvas->restore();
+
+        SkBitmap bitmap;
+        bitmap.allocPixels(surface->imageInfo());
+        surface->readPixels(bitmap, 0, 0);
+        return bitmap;
+    };
+
+    const SkBitmap first = drawFrame(SK_ColorBLUE);
+    const uint64_t hits = SkGraphics::GetImageFilterCacheHitCount();
+    const SkBitmap second = drawFrame(SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, SkGraphics::GetImageFilterCacheHitCount() > hits);
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(first, second));
+
+    // A layer with different content is filtered again.
+    const uint64_t misses = SkGraphics::GetImageFilterCacheMissCount();
+    const SkBitmap third = drawFrame(SK_ColorRED);
+    REPORTER_ASSERT(reporter, SkGraphics::GetImageFilterCacheMissCount() > misses);
+    REPORTER_ASSERT(reporter, third.getColor(32, 32) != first.getColor(32, 32));
+
+    SkGraphics::SetImageFilterCacheContentAddressed(wasContentAddressed);
+}
+
 DEF_TEST(ImageFilterCache_ImageBackedRaster, reporter) {
     SkBitmap srcBM = create_bm();
 
@@ -93,6 +93,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <utility>
 #include <limits>
@@ -2448,3 +2449,47 @@ DEF_TEST(ImageFilter_DrawExtremeMatrixTransform_DoesNotAssert, reporter) {
     surface->getCanvas()->clear(SK_ColorWHITE);
     surface->getCanvas()->drawRRect(rr, p);
 }
+
+// F16 and F32 layers have their own raster blur passes; they should match the 8888 passes up to
+// the 8888 quantization.
+DEF_TEST(BlurImageFilter_FloatColorTypesMatch8888, reporter) {
+    SkBitmap checker;
+    checker.allocN32Pixels(64, 64);
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            *checker.getAddr32(x, y) = ((x / 8 + y / 8) & 1) ? SkPreMultiplyColor(0xC0204080)
+                                                              : SK_ColorTRANSPARENT;
+        }
+    }
+    sk_sp<SkImage> image = checker.asImage();
+
+    // Covers both the Gaussian and the three-box passes.
+    for (float sigma : {1.f, 6.f, 30.f}) {
+        SkBitmap results[3];
+        const SkColorType colorTypes[] = {kN32_SkColorType,
+                                          kRGBA_F16_SkColorType,
+                                          kRGBA_F32_SkColorType};
+        for (int i = 0; i < 3; ++i) {
+            auto surface = SkSurfaces::Raster(
+                    SkImageInfo::Make(96, 96, colorTypes[i], kPremul_SkAlphaType));
+            SkPaint paint;
+            paint.setImageFilter(SkImageFilters::Blur(sigma, sigma / 2, nullptr));
+            surface->getCanvas()->drawImage(image, 16, 16, SkSamplingOptions(), &paint);
+
+            results[i].allocN32Pixels(96, 96);
+            REPORTER_ASSERT(reporter, surface->readPixels(results[i], 0, 0));
+        }
+        for (int i : {1, 2}) {
+            int maxDiff = 0;
+            for (int y = 0; y < 96; ++y) {
+                const uint8_t* expected = reinterpret_cast<uint8_t*>(results[0].getAddr32(0, y));
+                const uint8_t* actual = reinterpret_cast<uint8_t*>(results[i].getAddr32(0, y));
+                for (int x = 0; x < 96 * 4; ++x) {
+                    maxDiff = std::max(maxDiff, std::abs(expected[x] - actual[x]));
+                }
+            }
+            REPORTER_ASSERT(reporter, maxDiff <= 2, "sigma %g color type %d differs by %d",
+                            sigma, colorTypes[i], maxDiff);
+        }
+    }
+}
@@ -10,6 +10,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -27,6 +28,11 @@
 #include "tests/Test.h"
 #include "tools/DecodeUtils.h"
 
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <utility>
+
 static void make_bitmap(SkBitmap* bm, int width, int height) {
     bm->allocN32Pixels(width, height);
     bm->eraseColor(SK_ColorWHITE);
@@ -245,6 +251,123 @@ static void fill_in_mips(SkMipmapBuilder* builder, sk_sp<SkImage> img) {
     }
 }
 
+static bool levels_equal(const SkMipmap* a, const SkMipmap* b) {
+    if (a->countLevels() != b->countLevels()) {
+        return false;
+    }
+    for (int i = 0; i < a->countLevels(); ++i) {
+        SkMipmap::Level la, lb;
+        if (!a->getLevel(i, &la) || !b->getLevel(i, &lb)) {
+            return false;
+        }
+        const SkPixmap& pa = la.fPixmap;
+        const SkPixmap& pb = lb.fPixmap;
+        if (pa.info() != pb.info()) {
+            return false;
+        }
+        for (int y = 0; y < pa.height(); ++y) {
+            if (memcmp(pa.addr(0, y), pb.addr(0, y), pa.info().minRowBytes()) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+DEF_TEST(MipMap_BandedBuildMatchesSerial, reporter) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (SkColorType ct : {kN32_SkColorType, kRGBA_F16_SkColorType}) {
+        // Odd dimensions exercise the 3x3, 2x3 and 3x2 kernels on the first level.
+        for (SkISize size : {SkISize{600, 500}, SkISize{601, 517}}) {
+            SkBitmap bm;
+            bm.allocPixels(SkImageInfo::Make(size, ct, kPremul_SkAlphaType));
+            SkRandom rand;
+            for (int y = 0; y < bm.height(); ++y) {
+                for (int x = 0; x < bm.width(); ++x) {
+                    bm.erase(SkPreMultiplyColor(rand.nextU()), SkIRect::MakeXYWH(x, y, 1, 1));
+                }
+            }
+
+            sk_sp<SkMipmap> serial(SkMipmap::Build(bm.pixmap(), nullptr));
+            sk_sp<SkMipmap> banded(SkMipmap::Build(bm.pixmap(), nullptr, true, executor.get()));
+            REPORTER_ASSERT(reporter, serial && banded);
+            if (!serial || !banded) {
+                return;
+            }
+            REPORTER_ASSERT(reporter, levels_equal(serial.get(), banded.get()),
+                            "ct %d, %dx%d", (int)ct, size.width(), size.height());
+        }
+    }
+}
+
+namespace {
+// Queues work until runAll() is called, so the test controls when async mipmaps complete.
+class DeferredExecutor final : public SkExecutor {
+public:
+    void add(std::function<void(void)> work) override { fWork.push_back(std::move(work)); }
+
+    void borrow() override {
+        if (!fWork.empty()) {
+            auto work = std::move(fWork.front());
+            fWork.pop_front();
+            work();
+        }
+    }
+
+    void runAll() {
+        while (!fWork.empty()) {
+            this->borrow();
+        }
+    }
+
+private:
+    std::deque<std::function<void(void)>> fWork;
+};
+}  // namespace
+
+DEF_TEST(image_mip_async, reporter) {
+    SkBitmap bm;
+    bm.allocN32Pixels(512, 512);
+    SkRandom rand;
+    for (int y = 0; y < bm.height(); y += 8) {
+        for (int x = 0; x < bm.width(); x += 8) {
+            bm.erase(SkPreMultiplyColor(rand.nextU()), SkIRect::MakeXYWH(x, y, 8, 8));
+        }
+    }
+    auto img = bm.asImage();
+
+    auto draw = [](const sk_sp<SkImage>& image, const SkSamplingOptions& sampling) {
+        SkBitmap dst;
+        dst.allocN32Pixels(64, 64);
+        dst.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas(dst).drawImageRect(image, SkRect::MakeWH(64, 64), sampling);
+        return dst;
+    };
+    auto equal = [](const SkBitmap& a, const SkBitmap& b) {
+        return memcmp(a.getPixels(), b.getPixels(), a.computeByteSize()) == 0;
+    };
+
+    const SkSamplingOptions mipSampling(SkFilterMode::kLinear, SkMipmapMode::kLinear);
+    const SkSamplingOptions baseSampling(SkFilterMode::kLinear, SkMipmapMode::kNone);
+
+    DeferredExecutor executor;
+    auto asyncImg = img->withDefaultMipmapsAsync(&executor);
+    REPORTER_ASSERT(reporter, asyncImg && asyncImg.get() != img.get());
+    REPORTER_ASSERT(reporter, !asyncImg->hasMipmaps());
+
+    // Until the levels are published, mipmapped draws sample the base level.
+    REPORTER_ASSERT(reporter, equal(draw(asyncImg, mipSampling), draw(img, baseSampling)));
+
+    executor.runAll();
+    REPORTER_ASSERT(reporter, asyncImg->hasMipmaps());
+    REPORTER_ASSERT(reporter, equal(draw(asyncImg, mipSampling),
+                                    draw(img->withDefaultMipmaps(), mipSampling)));
+
+    // Without an executor the mipmaps are built synchronously.
+    REPORTER_ASSERT(reporter, img->withDefaultMipmapsAsync(nullptr)->hasMipmaps());
+}
+
 DEF_TEST(image_mip_factory, reporter) {
     // TODO: what do to about lazy images and mipmaps?
     auto img = ToolUtils::GetResourceAsImage("images/mandrill_128.png")->makeRasterImage(nullptr);
@@ -0,0 +1,297 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkSpan.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
+#include "tests/Test.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+// The stages in this file are always the portable scalar ones, whatever backend the library was
+// built for (SSE, AVX, NEON, wasm SIMD128...). They serve as the reference that the library's
+// pipelines are compared against, pixel for pixel.
+#define SKRP_CPU_SCALAR
+#define SK_OPTS_NS RPScalarReference
+
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-function"
+#elif defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+#include "src/opts/SkRasterPipeline_opts.h"
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#elif defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+using Op = SkRasterPipelineOp;
+using MemoryCtx = SkRasterPipelineContexts::MemoryCtx;
+using MemoryCtxInfo = SkRasterPipelineContexts::MemoryCtxInfo;
+using MemoryCtxPatch = SkRasterPipelineContexts::MemoryCtxPatch;
+
+// Not a multiple of any backend's stride, so every run also exercises the tail.
+constexpr int kWidth  = 67;
+constexpr int kHeight = 3;
+
+#define M(st) (SkOpts::StageFn)SK_OPTS_NS::st,
+const SkOpts::StageFn kScalarOps[] = { SK_RASTER_PIPELINE_OPS_ALL(M) };
+#undef M
+
+struct Stage {
+    Op    op;
+    void* ctx;
+};
+
+struct Pixels {
+    std::vector<uint32_t> fStorage = std::vector<uint32_t>(kWidth * kHeight);
+    MemoryCtx             fCtx     = {fStorage.data(), kWidth};
+};
+
+// Builds the pipeline's stages, pointing its load/store stages at `dst`. The contexts it uses
+// must outlive the pipeline run.
+using PipelineFn = std::function<std::vector<Stage>(Pixels* dst)>;
+
+// Runs `stages` through SkRasterPipeline, which uses the SkOpts stage tables and picks lowp
+// whenever every stage has a lowp implementation.
+void run_library(const std::vector<Stage>& stages) {
+    SkRasterPipeline_<256> p;
+    for (const Stage& stage : stages) {
+        p.append(stage.op, stage.ctx);
+    }
+    p.run(0, 0, kWidth, kHeight);
+}
+
+// Runs `stages` as a highp program built from `ops`, patching `memoryCtxs` for the tail the same
+// way SkRasterPipeline::run() does.
+void run_highp(const SkOpts::StageFn ops[],
+               SkOpts::StageFn justReturn,
+               decltype(SkOpts::start_pipeline_highp) startPipeline,
+               const std::vector<Stage>& stages,
+               const std::vector<MemoryCtxInfo>& memoryCtxs) {
+    std::vector<SkRasterPipelineStage> program;
+    for (const Stage& stage : stages) {
+        program.push_back({ops[(int)stage.op], stage.ctx});
+    }
+    program.push_back({justReturn, nullptr});
+
+    std::vector<MemoryCtxPatch> patches(memoryCtxs.size());
+    for (size_t i = 0; i < memoryCtxs.size(); ++i) {
+        patches[i].info = memoryCtxs[i];
+        patches[i].backup = nullptr;
+        memset(patches[i].scratch, 0, sizeof(patches[i].scratch));
+    }
+
+    startPipeline(0, 0, kWidth, kHeight, program.data(),
+                  SkSpan{patches.data(), patches.size()}, /*tailPointer=*/nullptr);
+}
+
+std::vector<MemoryCtxInfo> memory_contexts(const std::vector<Stage>& stages) {
+    std::vector<MemoryCtxInfo> infos;
+    auto add = [&](MemoryCtx* ctx, bool load, bool store) {
+        for (MemoryCtxInfo& info : infos) {
+            if (info.context == ctx) {
+                info.load |= load;
+                info.store |= store;
+                return;
+            }
+        }
+        infos.push_back({ctx, /*bytesPerPixel=*/4, load, store});
+    };
+    for (const Stage& stage : stages) {
+        auto* ctx = (MemoryCtx*)stage.ctx;
+        switch (stage.op) {
+            case Op::load_8888:
+            case Op::load_8888_dst:     add(ctx, /*load=*/true,  /*store=*/false); break;
+            case Op::store_8888:        add(ctx, /*load=*/false, /*store=*/true);  break;
+            case Op::srcover_rgba_8888: add(ctx, /*load=*/true,  /*store=*/true);  break;
+            default:                    break;
+        }
+    }
+    return infos;
+}
+
+uint32_t random_premul_8888(SkRandom* rand) {
+    uint32_t a = rand->nextULessThan(256);
+    uint32_t r = rand->nextULessThan(a + 1),
+             g = rand->nextULessThan(a + 1),
+             b = rand->nextULessThan(a + 1);
+    return r | g << 8 | b << 16 | a << 24;
+}
+
+void fill_premul(Pixels* pixels, uint32_t seed) {
+    SkRandom rand(seed);
+    for (uint32_t& px : pixels->fStorage) {
+        px = random_premul_8888(&rand);
+    }
+}
+
+void compare(skiatest::Reporter* r, const char* name, const char* backend,
+             const Pixels& actual, const Pixels& expected, int tolerance) {
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            uint32_t a = actual.fStorage[y * kWidth + x],
+                     e = expected.fStorage[y * kWidth + x];
+            for (int shift = 0; shift < 32; shift += 8) {
+                int diff = std::abs((int)((a >> shift) & 0xff) - (int)((e >> shift) & 0xff));
+                if (diff > tolerance) {
+                    ERRORF(r, "%s (%s): pixel (%d, %d) is %08x, scalar reference is %08x",
+                           name, backend, x, y, a, e);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Runs the pipeline three ways -- the library's own choice of lowp or highp, the library's highp
+// stages, and the scalar highp stages -- each starting from `initialDst`, and compares both
+// library results against the scalar one. Highp uses the same math on every backend up to
+// rounding, so it may differ from the reference by at most one in a channel; lowp approximates
+// division by 255, so it gets the same one-off allowance.
+void test_pipeline(skiatest::Reporter* r, const char* name,
+                   const Pixels& initialDst, const PipelineFn& makePipeline) {
+    Pixels library = initialDst,
+           highp   = initialDst,
+           scalar  = initialDst;
+    library.fCtx.pixels = library.fStorage.data();
+    highp.fCtx.pixels   = highp.fStorage.data();
+    scalar.fCtx.pixels  = scalar.fStorage.data();
+
+    run_library(makePipeline(&library));
+
+    std::vector<Stage> highpStages = makePipeline(&highp);
+    run_highp(SkOpts::ops_highp, SkOpts::just_return_highp, SkOpts::start_pipeline_highp,
+              highpStages, memory_contexts(highpStages));
+
+    std::vector<Stage> scalarStages = makePipeline(&scalar);
+    run_highp(kScalarOps, (SkOpts::StageFn)SK_OPTS_NS::just_return, SK_OPTS_NS::start_pipeline,
+              scalarStages, memory_contexts(scalarStages));
+
+    compare(r, name, "library", library, scalar, /*tolerance=*/1);
+    compare(r, name, "highp",   highp,   scalar, /*tolerance=*/1);
+}
+
+// Fills a GradientCtx whose interval `i` runs from colors[i] at stops[i] to colors[i+1] at
+// stops[i+1]; the last interval holds its color flat. Arrays are padded to eight entries because
+// some backends look up stops with a full-register permute.
+struct GradientData {
+    float factors[4][8] = {};
+    float biases[4][8] = {};
+    float ts[8] = {};
+    SkRasterPipelineContexts::GradientCtx ctx;
+
+    GradientData(size_t stopCount, const float (*colors)[4], const float* stops) {
+        ctx.stopCount = stopCount;
+        ctx.ts = ts;
+        for (int c = 0; c < 4; ++c) {
+            ctx.factors[c] = factors[c];
+            ctx.biases[c] = biases[c];
+        }
+        for (size_t i = 0; i < stopCount; ++i) {
+            ts[i] = stops[i];
+            for (int c = 0; c < 4; ++c) {
+                if (i + 1 < stopCount && stops[i + 1] > stops[i]) {
+                    float f = (colors[i + 1][c] - colors[i][c]) / (stops[i + 1] - stops[i]);
+                    factors[c][i] = f;
+                    biases[c][i] = colors[i][c] - f * stops[i];
+                } else {
+                    biases[c][i] = colors[i][c];
+                }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+DEF_TEST(SkRasterPipelineBackend_Load8888Store8888, r) {
+    Pixels src;
+    fill_premul(&src, 1);
+
+    test_pipeline(r, "load_8888/store_8888", Pixels(), [&](Pixels* dst) {
+        return std::vector<Stage>{{Op::load_8888,  &src.fCtx},
+                                  {Op::store_8888, &dst->fCtx}};
+    });
+}
+
+DEF_TEST(SkRasterPipelineBackend_SrcOver, r) {
+    Pixels src, initialDst;
+    fill_premul(&src, 2);
+    fill_premul(&initialDst, 3);
+
+    test_pipeline(r, "srcover", initialDst, [&](Pixels* dst) {
+        return std::vector<Stage>{{Op::load_8888,     &src.fCtx},
+                                  {Op::load_8888_dst, &dst->fCtx},
+                                  {Op::srcover,       nullptr},
+                                  {Op::store_8888,    &dst->fCtx}};
+    });
+    test_pipeline(r, "srcover_rgba_8888", initialDst, [&](Pixels* dst) {
+        return std::vector<Stage>{{Op::load_8888,         &src.fCtx},
+                                  {Op::srcover_rgba_8888, &dst->fCtx}};
+    });
+}
+
+DEF_TEST(SkRasterPipelineBackend_Gradients, r) {
+    // Map device x across [0, 1) so each pixel samples the gradient at a different t.
+    float scaleTranslate[4] = {1.0f / kWidth, 1.0f / kHeight, 0, 0};
+
+    SkRasterPipelineContexts::EvenlySpaced2StopGradientCtx twoStop = {
+        {0.75f, -0.5f, 0.25f, -0.25f},
+        {0.125f, 0.75f, 0.25f, 1.0f},
+    };
+    test_pipeline(r, "evenly_spaced_2_stop_gradient", Pixels(), [&](Pixels* dst) {
+        return std::vector<Stage>{{Op::seed_shader,                   nullptr},
+                                  {Op::matrix_scale_translate,        scaleTranslate},
+                                  {Op::evenly_spaced_2_stop_gradient, &twoStop},
+                                  {Op::store_8888,                    &dst->fCtx}};
+    });
+
+    static constexpr float kColors[6][4] = {
+        {1.00f, 0.00f, 0.00f, 1.00f},
+        {0.50f, 0.50f, 0.00f, 0.75f},
+        {0.00f, 1.00f, 0.25f, 1.00f},
+        {0.10f, 0.20f, 0.30f, 0.40f},
+        {0.00f, 0.00f, 1.00f, 1.00f},
+        {0.90f, 0.80f, 0.70f, 1.00f},
+    };
+
+    // Four evenly spaced stops fit the small-table lookup that some backends special-case.
+    static constexpr float kEvenStops[4] = {0, 1.0f / 3, 2.0f / 3, 1};
+    GradientData evenlySpaced(4, kColors, kEvenStops);
+    test_pipeline(r, "evenly_spaced_gradient", Pixels(), [&](Pixels* dst) {
+        return std::vector<Stage>{{Op::seed_shader,            nullptr},
+                                  {Op::matrix_scale_translate, scaleTranslate},
+                                  {Op::evenly_spaced_gradient, &evenlySpaced.ctx},
+                                  {Op::store_8888,             &dst->fCtx}};
+    });
+
+    // Six uneven stops take the general path.
+    static constexpr float kStops[6] = {0, 0.1f, 0.3f, 0.5f, 0.8f, 0.9f};
+    GradientData general(6, kColors, kStops);
+    test_pipeline(r, "gradient", Pixels(), [&](Pixels* dst) {
+        return std::vector<Stage>{{Op::seed_shader,            nullptr},
+                                  {Op::matrix_scale_translate, scaleTranslate},
+                                  {Op::gradient,               &general.ctx},
+                                  {Op::store_8888,             &dst->fCtx}};
+    });
+}
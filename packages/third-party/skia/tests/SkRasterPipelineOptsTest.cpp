@@ -188,3 +188,207 @@ DEF_TEST(SkRasterPipelineOpts_Pow2, r) {
     F result = SK_OPTS_NS::approx_pow2(F_(160));
     REPORTER_ASSERT(r, SK_OPTS_NS::all(result == INFINITY));
 }
+
+// The tests below check the backend's primitives lane by lane against plain scalar math, so that
+// each SIMD backend (SSE, NEON, Wasm SIMD128, ...) produces the same pixels as the portable one.
+
+using U32 = SK_OPTS_NS::U32;
+using U16 = SK_OPTS_NS::U16;
+using U8 = SK_OPTS_NS::U8;
+
+static constexpr size_t kLanes = sizeof(F) / sizeof(float);
+
+template <typename V, typename T>
+static std::array<T, kLanes> to_lanes(const V& v) {
+    static_assert(sizeof(V) == kLanes * sizeof(T));
+    std::array<T, kLanes> lanes;
+    memcpy(lanes.data(), &v, sizeof(V));
+    return lanes;
+}
+
+DEF_TEST(SkRasterPipelineOpts_RoundingMatchesScalar, r) {
+    std::array<float, kLanes> src;
+    for (int base = -1024; base < 1024; base += kLanes) {
+        for (size_t i = 0; i < kLanes; ++i) {
+            // Quarter steps offset by an eighth: never a tie, and always exact in a float.
+            src[i] = (base + int(i)) * 0.25f + 0.125f;
+        }
+        F v = sk_unaligned_load<F>(src.data());
+
+        auto floors = to_lanes<F, float>(SK_OPTS_NS::floor_(v));
+        auto ceils = to_lanes<F, float>(SK_OPTS_NS::ceil_(v));
+        for (size_t i = 0; i < kLanes; ++i) {
+            REPORTER_ASSERT(r, floors[i] == std::floor(src[i]), "floor(%g) = %g", src[i], floors[i]);
+            REPORTER_ASSERT(r, ceils[i] == std::ceil(src[i]), "ceil(%g) = %g", src[i], ceils[i]);
+        }
+
+        if (base >= 0) {
+            auto irounds = to_lanes<I32, int32_t>(SK_OPTS_NS::iround(v));
+            auto rounds = to_lanes<U32, uint32_t>(SK_OPTS_NS::round(v));
+            for (size_t i = 0; i < kLanes; ++i) {
+                const int32_t expected = (int32_t)(src[i] + 0.5f);
+                REPORTER_ASSERT(r, irounds[i] == expected, "iround(%g) = %d", src[i], irounds[i]);
+                REPORTER_ASSERT(r, rounds[i] == (uint32_t)expected,
+                                "round(%g) = %u", src[i], rounds[i]);
+            }
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipelineOpts_MinMaxMatchesScalar, r) {
+    std::array<float, kLanes> fa, fb;
+    std::array<uint32_t, kLanes> ua, ub;
+    uint32_t seed = 12345;
+    auto next = [&seed] { return seed = seed * 1664525u + 1013904223u; };
+
+    for (int iter = 0; iter < 256; ++iter) {
+        for (size_t i = 0; i < kLanes; ++i) {
+            fa[i] = (int32_t)next() * (1.0f / (1 << 20));
+            fb[i] = (int32_t)next() * (1.0f / (1 << 20));
+            ua[i] = next();
+            ub[i] = next();
+        }
+        F  a = sk_unaligned_load<F>(fa.data()),  b = sk_unaligned_load<F>(fb.data());
+        U32 c = sk_unaligned_load<U32>(ua.data()), d = sk_unaligned_load<U32>(ub.data());
+        I32 e = sk_bit_cast<I32>(c), f = sk_bit_cast<I32>(d);
+
+        auto fmin = to_lanes<F, float>(SK_OPTS_NS::min(a, b)),
+             fmax = to_lanes<F, float>(SK_OPTS_NS::max(a, b));
+        auto umin = to_lanes<U32, uint32_t>(SK_OPTS_NS::min(c, d)),
+             umax = to_lanes<U32, uint32_t>(SK_OPTS_NS::max(c, d));
+        auto imin = to_lanes<I32, int32_t>(SK_OPTS_NS::min(e, f)),
+             imax = to_lanes<I32, int32_t>(SK_OPTS_NS::max(e, f));
+        for (size_t i = 0; i < kLanes; ++i) {
+            REPORTER_ASSERT(r, fmin[i] == std::min(fa[i], fb[i]));
+            REPORTER_ASSERT(r, fmax[i] == std::max(fa[i], fb[i]));
+            REPORTER_ASSERT(r, umin[i] == std::min(ua[i], ub[i]));
+            REPORTER_ASSERT(r, umax[i] == std::max(ua[i], ub[i]));
+            REPORTER_ASSERT(r, imin[i] == std::min((int32_t)ua[i], (int32_t)ub[i]));
+            REPORTER_ASSERT(r, imax[i] == std::max((int32_t)ua[i], (int32_t)ub[i]));
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipelineOpts_PackMatchesScalar, r) {
+    std::array<uint32_t, kLanes> wide;
+    std::array<uint16_t, kLanes> narrow;
+    for (uint32_t base = 0; base < 65536; base += 997) {
+        for (size_t i = 0; i < kLanes; ++i) {
+            wide[i] = std::min<uint32_t>(base + 131 * i, 65535);
+            narrow[i] = (uint16_t)((base + 37 * i) & 255);
+        }
+        auto packed16 = to_lanes<U16, uint16_t>(
+                SK_OPTS_NS::pack(sk_unaligned_load<U32>(wide.data())));
+        auto packed8 = to_lanes<U8, uint8_t>(
+                SK_OPTS_NS::pack(sk_unaligned_load<U16>(narrow.data())));
+        for (size_t i = 0; i < kLanes; ++i) {
+            REPORTER_ASSERT(r, packed16[i] == wide[i]);
+            REPORTER_ASSERT(r, packed8[i] == narrow[i]);
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipelineOpts_InterleavedLoadStoreMatchesScalar, r) {
+    std::array<uint16_t, 4 * kLanes> u16Pixels, u16Out;
+    std::array<float, 4 * kLanes> f32Pixels, f32Out;
+    for (size_t i = 0; i < 4 * kLanes; ++i) {
+        u16Pixels[i] = (uint16_t)(i * 4099 + 7);
+        f32Pixels[i] = i * 0.5f - 3.0f;
+    }
+
+    U16 r16, g16, b16, a16;
+    SK_OPTS_NS::load4(u16Pixels.data(), &r16, &g16, &b16, &a16);
+    F rf, gf, bf, af;
+    SK_OPTS_NS::load4(f32Pixels.data(), &rf, &gf, &bf, &af);
+
+    const std::array<uint16_t, kLanes> u16Planes[] = {
+            to_lanes<U16, uint16_t>(r16), to_lanes<U16, uint16_t>(g16),
+            to_lanes<U16, uint16_t>(b16), to_lanes<U16, uint16_t>(a16)};
+    const std::array<float, kLanes> f32Planes[] = {
+            to_lanes<F, float>(rf), to_lanes<F, float>(gf),
+            to_lanes<F, float>(bf), to_lanes<F, float>(af)};
+    for (size_t px = 0; px < kLanes; ++px) {
+        for (size_t ch = 0; ch < 4; ++ch) {
+            REPORTER_ASSERT(r, u16Planes[ch][px] == u16Pixels[4 * px + ch]);
+            REPORTER_ASSERT(r, f32Planes[ch][px] == f32Pixels[4 * px + ch]);
+        }
+    }
+
+    SK_OPTS_NS::store4(u16Out.data(), r16, g16, b16, a16);
+    SK_OPTS_NS::store4(f32Out.data(), rf, gf, bf, af);
+    REPORTER_ASSERT(r, u16Out == u16Pixels);
+    REPORTER_ASSERT(r, f32Out == f32Pixels);
+
+    std::array<uint16_t, 2 * kLanes> u16Pairs, u16PairsOut;
+    std::copy_n(u16Pixels.begin(), 2 * kLanes, u16Pairs.begin());
+    SK_OPTS_NS::load2(u16Pairs.data(), &r16, &g16);
+    auto rLanes = to_lanes<U16, uint16_t>(r16), gLanes = to_lanes<U16, uint16_t>(g16);
+    for (size_t px = 0; px < kLanes; ++px) {
+        REPORTER_ASSERT(r, rLanes[px] == u16Pairs[2 * px + 0]);
+        REPORTER_ASSERT(r, gLanes[px] == u16Pairs[2 * px + 1]);
+    }
+    SK_OPTS_NS::store2(u16PairsOut.data(), r16, g16);
+    REPORTER_ASSERT(r, u16PairsOut == u16Pairs);
+}
+
+#if !defined(SKRP_CPU_SCALAR) && !defined(SK_ENABLE_OPTIMIZE_SIZE) && \
+        !defined(SK_DISABLE_LOWP_RASTER_PIPELINE)
+DEF_TEST(SkRasterPipelineOpts_Lowp8888MatchesScalar, r) {
+    namespace lowp = SK_OPTS_NS::lowp;
+    static constexpr size_t kLowpLanes = sizeof(lowp::U16) / sizeof(uint16_t);
+
+    std::array<uint32_t, kLowpLanes> pixels, out;
+    for (size_t i = 0; i < kLowpLanes; ++i) {
+        pixels[i] = 0x01234567u * (uint32_t)(i + 1) ^ 0x89abcdefu;
+    }
+
+    lowp::U16 cr, cg, cb, ca;
+    lowp::load_8888_(pixels.data(), &cr, &cg, &cb, &ca);
+    std::array<uint16_t, kLowpLanes> planes[4];
+    memcpy(planes[0].data(), &cr, sizeof(cr));
+    memcpy(planes[1].data(), &cg, sizeof(cg));
+    memcpy(planes[2].data(), &cb, sizeof(cb));
+    memcpy(planes[3].data(), &ca, sizeof(ca));
+    for (size_t px = 0; px < kLowpLanes; ++px) {
+        for (size_t ch = 0; ch < 4; ++ch) {
+            REPORTER_ASSERT(r, planes[ch][px] == ((pixels[px] >> (8 * ch)) & 0xff));
+        }
+    }
+
+    lowp::store_8888_(out.data(), cr, cg, cb, ca);
+    REPORTER_ASSERT(r, out == pixels);
+
+    // Out-of-range channels clamp to 255 on store.
+    lowp::store_8888_(out.data(), cr + 256, cg, cb, ca * 4);
+    for (size_t px = 0; px < kLowpLanes; ++px) {
+        const uint32_t a = std::min<uint32_t>(planes[3][px] * 4, 255);
+        REPORTER_ASSERT(r, out[px] == ((pixels[px] & 0x00ffff00) | 0xff | (a << 24)));
+    }
+}
+
+DEF_TEST(SkRasterPipelineOpts_LowpScaledMultMatchesScalar, r) {
+    namespace lowp = SK_OPTS_NS::lowp;
+    static constexpr size_t kLowpLanes = sizeof(lowp::I16) / sizeof(int16_t);
+
+    std::array<int16_t, kLowpLanes> a, b, result;
+    uint32_t seed = 6789;
+    for (int iter = 0; iter < 1024; ++iter) {
+        for (size_t i = 0; i < kLowpLanes; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            a[i] = (int16_t)(seed >> 16);
+            b[i] = (int16_t)seed;
+            if (a[i] == INT16_MIN && b[i] == INT16_MIN) {
+                b[i] = INT16_MAX;  // -1 * -1 is the one product where backends may saturate.
+            }
+        }
+        lowp::I16 product = lowp::scaled_mult(sk_unaligned_load<lowp::I16>(a.data()),
+                                              sk_unaligned_load<lowp::I16>(b.data()));
+        memcpy(result.data(), &product, sizeof(product));
+        for (size_t i = 0; i < kLowpLanes; ++i) {
+            const int expected = (2 * a[i] * b[i] + (1 << 15)) >> 16;
+            REPORTER_ASSERT(r, result[i] == expected,
+                            "scaled_mult(%d, %d) = %d", a[i], b[i], result[i]);
+        }
+    }
+}
+#endif
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
@@ -16,6 +17,7 @@
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkWriteBuffer.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
@@ -61,3 +63,190 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+DEF_TEST(SkStrikeCache_ShardedCountLimit, Reporter) {
+    SkStrikeCache cache;
+
+    sk_sp<SkTypeface> typeface = ToolUtils::DefaultPortableTypeface();
+    SkPaint defaultPaint;
+
+    // Enough sizes that the strikes land in several shards.
+    constexpr int kStrikeCount = 4 * SkStrikeCache::kShardCount;
+    for (int i = 0; i < kStrikeCount; ++i) {
+        SkFont font{typeface, 10.0f + i};
+        SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+                font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I());
+        strikeSpec.findOrCreateStrike(&cache);
+    }
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == kStrikeCount);
+
+    cache.setCacheCountLimit(4);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() <= 4,
+                    "count %d", cache.getCacheCountUsed());
+
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
+
+DEF_TEST(SkStrikeCache_ThreadCacheDoesNotOwnStrikes, Reporter) {
+    SkStrikeCache cache;
+
+    SkFont font{ToolUtils::DefaultPortableTypeface(), 12};
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+
+    // The second lookup is answered by this thread's cache.
+    sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+    REPORTER_ASSERT(Reporter, strikeSpec.findOrCreateStrike(&cache) == strike);
+
+    // Once purged, only this test holds the strike, and it is not handed out again.
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, strike->unique());
+    sk_sp<SkStrike> recreated = strikeSpec.findOrCreateStrike(&cache);
+    REPORTER_ASSERT(Reporter, recreated != strike);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 1);
+}
+
+DEF_TEST(SkStrikeCache_DirectMaskCPUGlyph, Reporter) {
+    SkStrikeCache cache;
+
+    SkFont font{ToolUtils::DefaultPortableTypeface(), 24};
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+    sk_sp<SkStrike> strike = strikeSpec.findOrCreateStrike(&cache);
+
+    const SkPackedGlyphID packedID{font.unicharToGlyph('A')};
+    const SkGlyph* found = nullptr;
+    REPORTER_ASSERT(Reporter, !strike->directMaskCPUGlyph(packedID, &found));
+
+    strike->lock();
+    SkGlyphDigest digest = strike->digestFor(skglyph::kDirectMaskCPU, packedID);
+    const SkGlyph* glyph = strike->glyph(digest);
+    strike->unlock();
+
+    REPORTER_ASSERT(Reporter, digest.actionFor(skglyph::kDirectMaskCPU) ==
+                              skglyph::GlyphAction::kAccept);
+    REPORTER_ASSERT(Reporter, strike->directMaskCPUGlyph(packedID, &found) && found == glyph);
+    REPORTER_ASSERT(Reporter, glyph->image() != nullptr);
+
+    // Empty glyphs are dropped, and that is remembered without the lock too.
+    const SkPackedGlyphID spaceID{font.unicharToGlyph(' ')};
+    strike->lock();
+    digest = strike->digestFor(skglyph::kDirectMaskCPU, spaceID);
+    strike->unlock();
+    REPORTER_ASSERT(Reporter, digest.actionFor(skglyph::kDirectMaskCPU) ==
+                              skglyph::GlyphAction::kDrop);
+    found = glyph;
+    REPORTER_ASSERT(Reporter, strike->directMaskCPUGlyph(spaceID, &found) && found == nullptr);
+
+    // Subpixel variants of the same glyph all stay resolved.
+    for (int i = 0; i < 4; ++i) {
+        const SkPackedGlyphID variant{font.unicharToGlyph('B'), (uint32_t)i, 0u};
+        strike->lock();
+        strike->digestFor(skglyph::kDirectMaskCPU, variant);
+        strike->unlock();
+    }
+    for (int i = 0; i < 4; ++i) {
+        const SkPackedGlyphID variant{font.unicharToGlyph('B'), (uint32_t)i, 0u};
+        REPORTER_ASSERT(Reporter, strike->directMaskCPUGlyph(variant, &found) && found,
+                        "variant %d", i);
+    }
+}
+
+DEF_TEST(SkStrikeCache_Snapshot, Reporter) {
+    sk_sp<SkTypeface> typeface = ToolUtils::CreateTypefaceFromResource("fonts/Roboto-Regular.ttf");
+    sk_sp<SkTypeface> otherTypeface = ToolUtils::CreateTypefaceFromResource("fonts/Em.ttf");
+    if (!typeface || !otherTypeface) {
+        INFOF(Reporter, "Could not load fonts; skipping test.");
+        return;
+    }
+    const sk_sp<SkTypeface> typefaces[] = {typeface};
+    const sk_sp<SkTypeface> otherTypefaces[] = {otherTypeface};
+
+    SkFont font{typeface, 18};
+    SkPaint defaultPaint;
+    SkStrikeSpec strikeSpec = SkStrikeSpec::MakeMask(
+            font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I());
+    const SkPackedGlyphID packedID{font.unicharToGlyph('g')};
+
+    auto glyphImage = [&](SkStrike* strike) {
+        strike->lock();
+        SkGlyphDigest digest = strike->digestFor(skglyph::kDirectMaskCPU, packedID);
+        const SkGlyph* glyph = strike->glyph(digest);
+        sk_sp<SkData> image;
+        if (glyph->image() != nullptr) {
+            image = SkData::MakeWithCopy(glyph->image(), glyph->imageSize());
+        }
+        strike->unlock();
+        return image;
+    };
+
+    // The glyphs whose images a strike has generated, without generating any.
+    auto flattenedImages = [](const SkStrike& strike) {
+        SkBinaryWriteBuffer buffer{nullptr, 0, {}};
+        strike.flattenGlyphImages(buffer);
+        return buffer.snapshotAsData();
+    };
+
+    SkStrikeCache sourceCache;
+    sk_sp<SkStrike> sourceStrike = strikeSpec.findOrCreateStrike(&sourceCache);
+    sk_sp<SkData> expected = glyphImage(sourceStrike.get());
+    REPORTER_ASSERT(Reporter, expected != nullptr);
+
+    sk_sp<SkData> snapshot = sourceCache.serializeSnapshot(typefaces);
+    REPORTER_ASSERT(Reporter, snapshot != nullptr);
+    if (!snapshot) {
+        return;
+    }
+
+    {
+        SkStrikeCache cache;
+        REPORTER_ASSERT(Reporter, cache.preloadSnapshot(*snapshot, typefaces) == 1);
+        sk_sp<SkStrike> strike = cache.findStrike(strikeSpec.descriptor());
+        REPORTER_ASSERT(Reporter, strike != nullptr);
+        if (strike) {
+            // The image came from the snapshot, not from running the scaler in digestFor().
+            sk_sp<SkData> preloaded = flattenedImages(*strike);
+            REPORTER_ASSERT(Reporter, preloaded->equals(flattenedImages(*sourceStrike).get()));
+
+            sk_sp<SkData> actual = glyphImage(strike.get());
+            REPORTER_ASSERT(Reporter, actual != nullptr && actual->equals(expected.get()));
+        }
+
+        // Preloading again does not replace the strike.
+        REPORTER_ASSERT(Reporter, cache.preloadSnapshot(*snapshot, typefaces) == 0);
+    }
+
+    {
+        // The snapshot's typeface data does not match.
+        SkStrikeCache cache;
+        REPORTER_ASSERT(Reporter, cache.preloadSnapshot(*snapshot, otherTypefaces) == 0);
+        REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    }
+
+    {
+        // A snapshot from another milestone is ignored. The milestone follows the magic and the
+        // format version.
+        sk_sp<SkData> otherMilestone = SkData::MakeWithCopy(snapshot->data(), snapshot->size());
+        static_cast<uint32_t*>(otherMilestone->writable_data())[2] += 1;
+        SkStrikeCache cache;
+        REPORTER_ASSERT(Reporter, cache.preloadSnapshot(*otherMilestone, typefaces) == 0);
+        REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    }
+
+    {
+        // A corrupted snapshot fails its checksum.
+        sk_sp<SkData> corrupt = SkData::MakeWithCopy(snapshot->data(), snapshot->size());
+        static_cast<uint8_t*>(corrupt->writable_data())[corrupt->size() / 2] ^= 0xFF;
+        SkStrikeCache cache;
+        REPORTER_ASSERT(Reporter, cache.preloadSnapshot(*corrupt, typefaces) == 0);
+        REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    }
+}